@@ -0,0 +1,28 @@
+@echo off
+rem Runs a map headless with the gameplay budget gate on (see UGameplayBudgetSubsystem), exits with 1 when over budget.
+rem Usage: RunGameplayBudgetGate.bat <EngineDir> [Map=/Game/Maps/ShowcaseMap] [Frames=3000]
+
+setlocal
+if "%~1"=="" (
+	echo Usage: %~nx0 ^<EngineDir^> [Map=/Game/Maps/ShowcaseMap] [Frames=3000]
+	exit /b 2
+)
+
+set ENGINE_DIR=%~1
+set MAP=%~2
+if "%MAP%"=="" set MAP=/Game/Maps/ShowcaseMap
+set FRAMES=%~3
+if "%FRAMES%"=="" set FRAMES=3000
+
+rem Written by the game when the run ends, a report left by an earlier run must not be mistaken for this one's
+set REPORT=%~dp0..\Saved\Profiling\GameplayBudgets.txt
+if exist "%REPORT%" del "%REPORT%"
+
+"%ENGINE_DIR%\Binaries\Win64\UnrealEditor.exe" "%~dp0..\GAS_Demo.uproject" %MAP% -game -nullrhi -nosound -unattended -nosplash -GameplayBudgetGate -csvCaptureFrames=%FRAMES% -ExitAfterCsvProfiling -log
+set RESULT=%ERRORLEVEL%
+
+rem Observed per frame numbers of the run, what the budgets in Config/DefaultGameplayBudgets.ini are set from
+if exist "%REPORT%" type "%REPORT%"
+
+if not "%RESULT%"=="0" echo Gameplay budget gate failed (exit code %RESULT%), see GameplayBudget errors in the log
+exit /b %RESULT%
@@ -0,0 +1,35 @@
+#!/bin/sh
+# Runs a map headless with the gameplay budget gate on (see UGameplayBudgetSubsystem), exits with 1 when over budget.
+# Usage: RunGameplayBudgetGate.sh <EngineDir> [Map=/Game/Maps/ShowcaseMap] [Frames=3000]
+
+if [ -z "$1" ]; then
+	echo "Usage: $0 <EngineDir> [Map=/Game/Maps/ShowcaseMap] [Frames=3000]"
+	exit 2
+fi
+
+ENGINE_DIR="$1"
+MAP="${2:-/Game/Maps/ShowcaseMap}"
+FRAMES="${3:-3000}"
+PROJECT="$(cd "$(dirname "$0")/.." && pwd)/GAS_Demo.uproject"
+
+case "$(uname)" in
+	Darwin) EDITOR="$ENGINE_DIR/Binaries/Mac/UnrealEditor.app/Contents/MacOS/UnrealEditor" ;;
+	*) EDITOR="$ENGINE_DIR/Binaries/Linux/UnrealEditor" ;;
+esac
+
+# Written by the game when the run ends, a report left by an earlier run must not be mistaken for this one's
+REPORT="$(dirname "$PROJECT")/Saved/Profiling/GameplayBudgets.txt"
+rm -f "$REPORT"
+
+"$EDITOR" "$PROJECT" "$MAP" -game -nullrhi -nosound -unattended -nosplash -GameplayBudgetGate -csvCaptureFrames="$FRAMES" -ExitAfterCsvProfiling -log
+RESULT=$?
+
+# Observed per frame numbers of the run, what the budgets in Config/DefaultGameplayBudgets.ini are set from
+if [ -f "$REPORT" ]; then
+	cat "$REPORT"
+fi
+
+if [ "$RESULT" -ne 0 ]; then
+	echo "Gameplay budget gate failed (exit code $RESULT), see GameplayBudget errors in the log"
+fi
+exit $RESULT
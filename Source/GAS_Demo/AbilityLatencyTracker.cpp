@@ -0,0 +1,229 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+
+#include "AbilityLatencyTracker.h"
+#include "CharacterBase.h"
+#include "Abilities/GameplayAbility.h"
+#include "GameFramework/PlayerState.h"
+#include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CVarLatencyStats(
+	TEXT("GAS.Latency.Stats"),
+	TEXT("Prints input to ability latency histograms. Use 'GAS.Latency.Stats reset' to clear them, 'GAS.Latency.Stats csv' to save them to Saved/Profiling."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		UAbilityLatencyTracker& Tracker = UAbilityLatencyTracker::Get();
+
+		if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+		{
+			Tracker.ResetStats();
+			return;
+		}
+
+		if (Args.Num() > 0 && Args[0] == TEXT("csv"))
+		{
+			const FString Path = Tracker.WriteCSV();
+			Ar.Logf(TEXT("%s"), Path.IsEmpty() ? TEXT("Failed to write latency CSV") : *FString::Printf(TEXT("Latency CSV written to %s"), *Path));
+			return;
+		}
+
+		Tracker.DumpStats(Ar);
+	}));
+
+static const TCHAR* GetStageName(EAbilityLatencyStage Stage)
+{
+	switch (Stage)
+	{
+	case EAbilityLatencyStage::Activation: return TEXT("Activation");
+	case EAbilityLatencyStage::Montage: return TEXT("Montage");
+	case EAbilityLatencyStage::Damage: return TEXT("Damage");
+	default: return TEXT("Unknown");
+	}
+}
+
+const double FLatencyHistogram::BucketLimitsMs[FLatencyHistogram::NumBuckets - 1] = { 8.0, 16.0, 33.0, 50.0, 67.0, 100.0, 150.0, 200.0, 300.0, 500.0, 1000.0 };
+
+void FLatencyHistogram::AddSample(double Milliseconds)
+{
+	int32 Bucket = 0;
+	while (Bucket < NumBuckets - 1 && Milliseconds > BucketLimitsMs[Bucket])
+	{
+		++Bucket;
+	}
+
+	Buckets[Bucket]++;
+	MinMs = Count == 0 ? Milliseconds : FMath::Min(MinMs, Milliseconds);
+	MaxMs = Count == 0 ? Milliseconds : FMath::Max(MaxMs, Milliseconds);
+	SumMs += Milliseconds;
+	Count++;
+}
+
+double FLatencyHistogram::GetPercentile(double Percentile) const
+{
+	if (Count == 0) return 0.0;
+
+	const uint32 Target = FMath::Max<uint32>(1, FMath::CeilToInt(Percentile * Count));
+	uint32 Accumulated = 0;
+	for (int32 Bucket = 0; Bucket < NumBuckets - 1; ++Bucket)
+	{
+		Accumulated += Buckets[Bucket];
+		if (Accumulated >= Target)
+			return FMath::Min(BucketLimitsMs[Bucket], MaxMs);
+	}
+
+	return MaxMs;
+}
+
+UAbilityLatencyTracker::UAbilityLatencyTracker()
+{
+	//Default values, can be overriden in DefaultGame.ini under [/Script/GAS_Demo.AbilityLatencyTracker]
+	TrackedInputActions = { FName(TEXT("Attack")), FName(TEXT("Interact")), FName(TEXT("Punch")) };
+	SampleTimeout = 2.f;
+}
+
+UAbilityLatencyTracker& UAbilityLatencyTracker::Get()
+{
+	check(GEngine);
+
+	UAbilityLatencyTracker* This = GEngine->GetEngineSubsystem<UAbilityLatencyTracker>();
+	check(This);
+
+	return *This;
+}
+
+int32 UAbilityLatencyTracker::GetSampleKey(const ACharacterBase* Character)
+{
+	//PlayerId is replicated, so a character and its server copy share the same key
+	const APlayerState* PlayerState = Character ? Character->GetPlayerState() : nullptr;
+	return PlayerState ? PlayerState->GetPlayerId() : INDEX_NONE;
+}
+
+void UAbilityLatencyTracker::MarkInput(const ACharacterBase* Character, FName ActionName)
+{
+	const int32 Key = GetSampleKey(Character);
+	if (Key == INDEX_NONE) return;
+
+	FLatencySample& Sample = Samples.FindOrAdd(Key);
+	Sample = FLatencySample();
+	Sample.InputTime = FPlatformTime::Seconds();
+}
+
+void UAbilityLatencyTracker::RecordActivation(const ACharacterBase* Character, const UGameplayAbility* Ability)
+{
+	/* Function RecordActivation
+	* Arguments: const ACharacterBase* Character - locally controlled character, const UGameplayAbility* Ability - activated ability
+	* Output: none (the first ability activated after an input owns the sample)
+	*/
+
+	FLatencySample* Sample = Samples.Find(GetSampleKey(Character));
+	if (!Sample || !Ability || !Sample->Ability.IsNone()) return;
+
+	const double Now = FPlatformTime::Seconds();
+	if (Now - Sample->InputTime > SampleTimeout) return;
+
+	Sample->Ability = Ability->GetClass()->GetFName();
+	AddStageSample(Sample->Ability, EAbilityLatencyStage::Activation, (Now - Sample->InputTime) * 1000.0);
+}
+
+void UAbilityLatencyTracker::RecordMontageStart(const ACharacterBase* Character)
+{
+	const double Now = FPlatformTime::Seconds();
+	FLatencySample* Sample = FindActiveSample(Character, Now);
+	if (!Sample || Sample->bMontageRecorded) return;
+
+	Sample->bMontageRecorded = true;
+	AddStageSample(Sample->Ability, EAbilityLatencyStage::Montage, (Now - Sample->InputTime) * 1000.0);
+}
+
+void UAbilityLatencyTracker::RecordDamage(const ACharacterBase* Instigator)
+{
+	const double Now = FPlatformTime::Seconds();
+	FLatencySample* Sample = FindActiveSample(Instigator, Now);
+	if (!Sample || Sample->bDamageRecorded) return;
+
+	Sample->bDamageRecorded = true;
+	AddStageSample(Sample->Ability, EAbilityLatencyStage::Damage, (Now - Sample->InputTime) * 1000.0);
+}
+
+UAbilityLatencyTracker::FLatencySample* UAbilityLatencyTracker::FindActiveSample(const ACharacterBase* Character, double Now)
+{
+	FLatencySample* Sample = Samples.Find(GetSampleKey(Character));
+	if (!Sample || Sample->Ability.IsNone() || Now - Sample->InputTime > SampleTimeout) return nullptr;
+
+	return Sample;
+}
+
+void UAbilityLatencyTracker::AddStageSample(FName Ability, EAbilityLatencyStage Stage, double Milliseconds)
+{
+	Histograms.FindOrAdd(Ability).Stages[(int32)Stage].AddSample(Milliseconds);
+}
+
+void UAbilityLatencyTracker::DumpStats(FOutputDevice& Ar) const
+{
+	if (Histograms.Num() == 0)
+	{
+		Ar.Log(TEXT("No latency samples recorded yet"));
+		return;
+	}
+
+	for (const TPair<FName, FAbilityLatency>& Pair : Histograms)
+	{
+		Ar.Logf(TEXT("%s"), *Pair.Key.ToString());
+
+		for (int32 Stage = 0; Stage < (int32)EAbilityLatencyStage::Num; ++Stage)
+		{
+			const FLatencyHistogram& Histogram = Pair.Value.Stages[Stage];
+			if (Histogram.Count == 0) continue;
+
+			Ar.Logf(TEXT("  Input->%-10s samples: %u, avg: %.1fms, min: %.1fms, max: %.1fms, p50: <=%.0fms, p90: <=%.0fms, p99: <=%.0fms"),
+				GetStageName((EAbilityLatencyStage)Stage), Histogram.Count, Histogram.GetAverage(), Histogram.MinMs, Histogram.MaxMs,
+				Histogram.GetPercentile(0.5), Histogram.GetPercentile(0.9), Histogram.GetPercentile(0.99));
+		}
+	}
+}
+
+FString UAbilityLatencyTracker::WriteCSV() const
+{
+	/* Function WriteCSV
+	* Arguments: none
+	* Output: path of the written file (one row per ability and stage, bucket counts as the last columns), empty on failure
+	*/
+
+	FString Csv = TEXT("Ability,Stage,Count,AvgMs,MinMs,MaxMs,P50Ms,P90Ms,P99Ms");
+	for (int32 Bucket = 0; Bucket < FLatencyHistogram::NumBuckets - 1; ++Bucket)
+	{
+		Csv += FString::Printf(TEXT(",Le%.0fMs"), FLatencyHistogram::BucketLimitsMs[Bucket]);
+	}
+	Csv += TEXT(",Over\n");
+
+	for (const TPair<FName, FAbilityLatency>& Pair : Histograms)
+	{
+		for (int32 Stage = 0; Stage < (int32)EAbilityLatencyStage::Num; ++Stage)
+		{
+			const FLatencyHistogram& Histogram = Pair.Value.Stages[Stage];
+			if (Histogram.Count == 0) continue;
+
+			Csv += FString::Printf(TEXT("%s,%s,%u,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f"), *Pair.Key.ToString(), GetStageName((EAbilityLatencyStage)Stage),
+				Histogram.Count, Histogram.GetAverage(), Histogram.MinMs, Histogram.MaxMs,
+				Histogram.GetPercentile(0.5), Histogram.GetPercentile(0.9), Histogram.GetPercentile(0.99));
+
+			for (int32 Bucket = 0; Bucket < FLatencyHistogram::NumBuckets; ++Bucket)
+			{
+				Csv += FString::Printf(TEXT(",%u"), Histogram.Buckets[Bucket]);
+			}
+			Csv += TEXT("\n");
+		}
+	}
+
+	const FString Path = FPaths::ProfilingDir() / FString::Printf(TEXT("AbilityLatency-%s.csv"), *FDateTime::Now().ToString());
+	return FFileHelper::SaveStringToFile(Csv, *Path) ? Path : FString();
+}
+
+void UAbilityLatencyTracker::ResetStats()
+{
+	Samples.Reset();
+	Histograms.Reset();
+}
@@ -0,0 +1,129 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/EngineSubsystem.h"
+#include "AbilityLatencyTracker.generated.h"
+
+class ACharacterBase;
+class UGameplayAbility;
+
+/** Stages measured from the input press */
+enum class EAbilityLatencyStage : uint8
+{
+	Activation,
+	Montage,
+	Damage,
+	Num
+};
+
+/** Latency histogram with fixed millisecond buckets (the last bucket has no upper limit) */
+struct GAS_DEMO_API FLatencyHistogram
+{
+	static constexpr int32 NumBuckets = 12;
+
+	/** Upper limit (in ms) of every bucket but the last one */
+	static const double BucketLimitsMs[NumBuckets - 1];
+
+	void AddSample(double Milliseconds);
+
+	/** Estimated percentile (0-1) in ms: upper limit of the bucket holding it (max sample for the last bucket) */
+	double GetPercentile(double Percentile) const;
+
+	double GetAverage() const { return Count > 0 ? SumMs / Count : 0.0; }
+
+	uint32 Buckets[NumBuckets] = {};
+	uint32 Count = 0;
+	double SumMs = 0.0;
+	double MinMs = 0.0;
+	double MaxMs = 0.0;
+};
+
+UCLASS(config = Game)
+class GAS_DEMO_API UAbilityLatencyTracker : public UEngineSubsystem
+{
+	GENERATED_BODY()
+
+/*
+* Class UAbilityLatencyTracker
+* Measures how long it takes from an input press to the ability it triggers being activated, its first montage
+* starting and its first damage being applied, stored in one latency histogram per ability class and stage.
+*
+* Samples are keyed by the instigator's PlayerId (same on server and client), and times come from the process clock.
+* So when server and client run in the same process (PIE or loopback with NetEmulation.PktLag), the damage stage
+* (recorded on the server in ACharacterBase::HandleDamage) lands in the same sample as the client's input.
+* With a remote server, only the activation and montage stages are recorded.
+*
+* Use the console command GAS.Latency.Stats to print the histograms ('reset' clears them, 'csv' saves them to Saved/Profiling).
+*/
+
+public:
+	UAbilityLatencyTracker();
+
+	/** Utility function to retrieve the tracker from GEngine */
+	static UAbilityLatencyTracker& Get();
+
+	/** Input actions timestamped by ACharacterBase::SetupPlayerInputComponent */
+	const TArray<FName>& GetTrackedInputActions() const { return TrackedInputActions; }
+
+	/** Starts a new sample for Character (overrides any pending sample) */
+	void MarkInput(const ACharacterBase* Character, FName ActionName);
+
+	/** Records the activation stage if Character has a pending input sample */
+	void RecordActivation(const ACharacterBase* Character, const UGameplayAbility* Ability);
+
+	/** Records the montage stage of Character's current sample */
+	void RecordMontageStart(const ACharacterBase* Character);
+
+	/** Records the damage stage of Instigator's current sample */
+	void RecordDamage(const ACharacterBase* Instigator);
+
+	/** Prints every histogram to the output device */
+	void DumpStats(FOutputDevice& Ar) const;
+
+	/** Writes every histogram to a CSV file in the profiling directory, returns the file path (empty on failure) */
+	FString WriteCSV() const;
+
+	/** Clears every histogram and pending sample */
+	void ResetStats();
+
+protected:
+
+	/** Input actions that start a latency sample, can be overriden in DefaultGame.ini under [/Script/GAS_Demo.AbilityLatencyTracker] */
+	UPROPERTY(Config)
+	TArray<FName> TrackedInputActions;
+
+	/** Stages happening later than this (in seconds) after the input are not attributed to it */
+	UPROPERTY(Config)
+	float SampleTimeout;
+
+private:
+
+	struct FLatencySample
+	{
+		double InputTime = 0.0;
+		FName Ability;
+		bool bMontageRecorded = false;
+		bool bDamageRecorded = false;
+	};
+
+	struct FAbilityLatency
+	{
+		FLatencyHistogram Stages[(int32)EAbilityLatencyStage::Num];
+	};
+
+	/** Returns the key used for Character's samples, INDEX_NONE if it has no PlayerState */
+	static int32 GetSampleKey(const ACharacterBase* Character);
+
+	/** Returns Character's sample if its ability was activated and it hasn't timed out */
+	FLatencySample* FindActiveSample(const ACharacterBase* Character, double Now);
+
+	void AddStageSample(FName Ability, EAbilityLatencyStage Stage, double Milliseconds);
+
+	/** Pending samples by PlayerId */
+	TMap<int32, FLatencySample> Samples;
+
+	/** Histograms by ability class name */
+	TMap<FName, FAbilityLatency> Histograms;
+};
@@ -0,0 +1,78 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+
+#include "AbilityTask_MeleeSweep.h"
+#include "MeleeTraceSubsystem.h"
+#include "GameFramework/Character.h"
+#include "Components/SkeletalMeshComponent.h"
+
+UAbilityTask_MeleeSweep* UAbilityTask_MeleeSweep::MeleeSweep(UGameplayAbility* OwningAbility, FName TaskInstanceName, USceneComponent* WeaponMesh, FName StartSocket, FName EndSocket, float Radius, int32 NumSamples, TEnumAsByte<ECollisionChannel> TraceChannel)
+{
+	UAbilityTask_MeleeSweep* Task = NewAbilityTask<UAbilityTask_MeleeSweep>(OwningAbility, TaskInstanceName);
+	Task->WeaponMesh = WeaponMesh;
+	Task->StartSocket = StartSocket;
+	Task->EndSocket = EndSocket;
+	Task->Radius = Radius;
+	Task->NumSamples = NumSamples;
+	Task->TraceChannel = TraceChannel;
+	Task->SwingId = 0;
+	return Task;
+}
+
+void UAbilityTask_MeleeSweep::Activate()
+{
+	/* Function Activate
+	* Arguments: none
+	* Output: none (registers the swing in the world's UMeleeTraceSubsystem, on authority only)
+	*/
+
+	if (!Ability || !Ability->GetCurrentActorInfo()->IsNetAuthority()) return;
+
+	AActor* Avatar = GetAvatarActor();
+	UMeleeTraceSubsystem* MeleeTraceSubsystem = GetWorld() ? GetWorld()->GetSubsystem<UMeleeTraceSubsystem>() : nullptr;
+	if (!Avatar || !MeleeTraceSubsystem) return;
+
+	//Unarmed attacks sweep between sockets of the character's own mesh
+	if (!WeaponMesh)
+	{
+		if (ACharacter* Character = Cast<ACharacter>(Avatar))
+			WeaponMesh = Character->GetMesh();
+	}
+
+	FMeleeSwingParams Params;
+	Params.Mesh = WeaponMesh;
+	Params.StartSocket = StartSocket;
+	Params.EndSocket = EndSocket;
+	Params.Radius = Radius;
+	Params.NumSamples = NumSamples;
+	Params.TraceChannel = TraceChannel;
+	Params.Attacker = Avatar;
+
+	SwingId = MeleeTraceSubsystem->BeginSwing(Params, FOnMeleeSwingHits::CreateUObject(this, &UAbilityTask_MeleeSweep::OnSwingHits));
+}
+
+void UAbilityTask_MeleeSweep::OnSwingHits(const TArray<FHitResult>& NewHits)
+{
+	if (!ShouldBroadcastAbilityTaskDelegates()) return;
+
+	FGameplayAbilityTargetDataHandle TargetData;
+	for (const FHitResult& Hit : NewHits)
+	{
+		TargetData.Add(new FGameplayAbilityTargetData_SingleTargetHit(Hit));
+	}
+
+	OnHit.Broadcast(TargetData);
+}
+
+void UAbilityTask_MeleeSweep::OnDestroy(bool bInOwnerFinished)
+{
+	if (SwingId != 0)
+	{
+		if (UMeleeTraceSubsystem* MeleeTraceSubsystem = GetWorld() ? GetWorld()->GetSubsystem<UMeleeTraceSubsystem>() : nullptr)
+			MeleeTraceSubsystem->EndSwing(SwingId);
+
+		SwingId = 0;
+	}
+
+	Super::OnDestroy(bInOwnerFinished);
+}
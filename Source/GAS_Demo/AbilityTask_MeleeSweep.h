@@ -0,0 +1,73 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Abilities/Tasks/AbilityTask.h"
+#include "Abilities/GameplayAbilityTargetTypes.h"
+#include "AbilityTask_MeleeSweep.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FMeleeSweepHitDelegate, const FGameplayAbilityTargetDataHandle&, TargetData);
+
+UCLASS()
+class GAS_DEMO_API UAbilityTask_MeleeSweep : public UAbilityTask
+{
+	GENERATED_BODY()
+
+/*
+* Class UAbilityTask_MeleeSweep
+* Melee hit detection for the weapon's GrantedAbility (replaces the anim notify + synchronous trace approach):
+* while active, the blade between two sockets of WeaponMesh is swept every frame by UMeleeTraceSubsystem
+* (async traces batched with every other attacker), and the targets it touches are sent through OnHit as
+* target data (one FGameplayAbilityTargetData_SingleTargetHit per target), ready to be used with
+* ApplyGameplayEffectToTarget on the damage effect. Each target is only reported once per task.
+*
+* Start it when the damage window of the montage opens and end it when it closes (EndTask).
+* Sweeps only run with authority, the server decides what a swing hits.
+*/
+
+public:
+
+	/**
+	* Called with the targets hit since the last call. With async traces (the default) this is one frame after the
+	* blade touched them, so damage applied from here lands a frame late; hits of the frame the task ends in are lost.
+	*/
+	UPROPERTY(BlueprintAssignable)
+	FMeleeSweepHitDelegate OnHit;
+
+	/**
+	* Sweeps the blade of a melee weapon until the task is ended
+	*
+	* @param WeaponMesh  Component holding the sockets, the avatar's mesh is used if none is given (unarmed attacks)
+	* @param StartSocket  Socket at the base of the blade
+	* @param EndSocket  Socket at the tip of the blade
+	* @param Radius  Radius of the swept spheres
+	* @param NumSamples  Number of points swept along the blade
+	* @param TraceChannel  Channel the targets block or overlap
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Ability|Tasks", meta = (HidePin = "OwningAbility", DefaultToSelf = "OwningAbility", BlueprintInternalUseOnly = "TRUE"))
+	static UAbilityTask_MeleeSweep* MeleeSweep(UGameplayAbility* OwningAbility, FName TaskInstanceName, USceneComponent* WeaponMesh, FName StartSocket, FName EndSocket, float Radius = 10.f, int32 NumSamples = 4, TEnumAsByte<ECollisionChannel> TraceChannel = ECC_Pawn);
+
+	virtual void Activate() override;
+
+protected:
+
+	virtual void OnDestroy(bool bInOwnerFinished) override;
+
+private:
+
+	/** Builds the target data of NewHits and broadcasts OnHit */
+	void OnSwingHits(const TArray<FHitResult>& NewHits);
+
+	UPROPERTY()
+	USceneComponent* WeaponMesh;
+
+	FName StartSocket;
+	FName EndSocket;
+	float Radius;
+	int32 NumSamples;
+	TEnumAsByte<ECollisionChannel> TraceChannel;
+
+	/** Swing registered in UMeleeTraceSubsystem, 0 if none */
+	uint32 SwingId;
+};
@@ -2,4 +2,690 @@
 
 
 #include "BaseAbilitySystemComponent.h"
+#include "GASGameplayAbility.h"
+#include "GAS_DemoAssetManager.h"
+#include "GameplayBudgetSubsystem.h"
+#include "CharacterMemoryReport.h"
+#include "PeriodicEffectScheduler.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "CharacterBase.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/PlayerController.h"
+#include "TimerManager.h"
+#include "UObject/UObjectIterator.h"
 
+static TAutoConsoleVariable<int32> CVarPoolAbilityInstances(
+	TEXT("GAS.Abilities.PoolInstances"),
+	1,
+	TEXT("Recycle instances of InstancedPerExecution abilities (1) or allocate a new instance on every activation (0)."));
+
+static TAutoConsoleVariable<int32> CVarBatchAbilityRPCs(
+	TEXT("GAS.Abilities.BatchRPCs"),
+	1,
+	TEXT("Batch the activation, target data and end server RPCs of abilities with bBatchActivationRPCs (1) or send them one by one (0)."));
+
+static TAutoConsoleVariable<int32> CVarMeasureTargetDataBytes(
+	TEXT("GAS.Abilities.MeasureTargetDataBytes"),
+	0,
+	TEXT("Serialize target data sent to the server once more to count its size in GAS.Abilities.RPCStats (debug only)."));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CVarAbilityRPCStats(
+	TEXT("GAS.Abilities.RPCStats"),
+	TEXT("Prints server ability RPCs per activation sent by local clients. Use 'GAS.Abilities.RPCStats reset' to clear counters."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+		{
+			UBaseAbilitySystemComponent::ResetRPCStats();
+			return;
+		}
+
+		UBaseAbilitySystemComponent::DumpRPCStats(Ar);
+	}));
+
+static TAutoConsoleVariable<int32> CVarAIReplicationMode(
+	TEXT("GAS.Replication.AIMode"),
+	0,
+	TEXT("Effect replication mode of AI and unpossessed characters: Minimal (0), Mixed (1), or Full for every character, players included, as before modes were picked per controller (2). Applied on possession."));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CVarReplicationStats(
+	TEXT("GAS.Replication.Stats"),
+	TEXT("Prints the effect replication mode of every AbilitySystemComponent and the server's outgoing bandwidth."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		UBaseAbilitySystemComponent::DumpReplicationStats(World, Ar);
+	}));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CVarReplicationSpawnNPCs(
+	TEXT("GAS.Replication.SpawnNPCs"),
+	TEXT("Spawns AI-controlled copies of the game mode pawn around the first player (server only), optionally with a GameplayEffect applied to each. ")
+	TEXT("Usage: GAS.Replication.SpawnNPCs [Count=200] [EffectClassPath], 'GAS.Replication.SpawnNPCs clear' destroys them. ")
+	TEXT("The replication mode is picked on possession: set GAS.Replication.AIMode before spawning."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		if (Args.Num() > 0 && Args[0] == TEXT("clear"))
+		{
+			UBaseAbilitySystemComponent::DestroyReplicationTestNPCs(Ar);
+			return;
+		}
+
+		const int32 Count = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 200;
+		TSubclassOf<UGameplayEffect> Effect = Args.Num() > 1 ? LoadClass<UGameplayEffect>(nullptr, *Args[1]) : nullptr;
+		if (Args.Num() > 1 && !Effect)
+		{
+			Ar.Logf(TEXT("No GameplayEffect class at %s"), *Args[1]);
+			return;
+		}
+
+		UBaseAbilitySystemComponent::SpawnReplicationTestNPCs(World, Count, Effect, Ar);
+	}));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CVarReplicationMeasure(
+	TEXT("GAS.Replication.Measure"),
+	TEXT("Averages the server's outgoing bandwidth over a few seconds and logs it with the replication modes in use. Usage: GAS.Replication.Measure [Seconds=10]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		const float Seconds = Args.Num() > 0 ? FMath::Max(1.f, FCString::Atof(*Args[0])) : 10.f;
+		UBaseAbilitySystemComponent::MeasureReplicationBandwidth(World, Seconds, Ar);
+	}));
+
+//Characters spawned by GAS.Replication.SpawnNPCs, destroyed by 'GAS.Replication.SpawnNPCs clear'
+static TArray<TWeakObjectPtr<ACharacterBase>> ReplicationTestNPCs;
+
+static FTimerHandle ReplicationMeasureTimer;
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CVarAbilityPoolStats(
+	TEXT("GAS.Abilities.PoolStats"),
+	TEXT("Prints ability instance allocations per activation. Use 'GAS.Abilities.PoolStats reset' to clear counters."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+		{
+			UBaseAbilitySystemComponent::ResetPoolStats();
+			return;
+		}
+
+		UBaseAbilitySystemComponent::DumpPoolStats(Ar);
+	}));
+
+uint64 UBaseAbilitySystemComponent::StatInstanceRequests = 0;
+uint64 UBaseAbilitySystemComponent::StatInstanceAllocations = 0;
+uint64 UBaseAbilitySystemComponent::StatPoolReuses = 0;
+uint64 UBaseAbilitySystemComponent::StatPoolReleases = 0;
+uint64 UBaseAbilitySystemComponent::StatActivationRequests = 0;
+uint64 UBaseAbilitySystemComponent::StatServerRPCs = 0;
+uint64 UBaseAbilitySystemComponent::StatBatchedCalls = 0;
+uint64 UBaseAbilitySystemComponent::StatTargetDataBytes = 0;
+
+UBaseAbilitySystemComponent::UBaseAbilitySystemComponent()
+{
+	MaxPooledInstancesPerClass = 4;
+}
+
+void UBaseAbilitySystemComponent::InitializeComponent()
+{
+	//GAS global data may still be initializing over the first frames (bDeferAbilitySystemGlobalsInit), it must be done before any ability runs
+	UGAS_DemoAssetManager::Get().FlushDeferredAbilitySystemGlobalsInit();
+
+	Super::InitializeComponent();
+}
+
+UGameplayAbility* UBaseAbilitySystemComponent::CreateNewInstanceOfAbility(FGameplayAbilitySpec& Spec, const UGameplayAbility* Ability)
+{
+	/* Function CreateNewInstanceOfAbility
+	* Arguments: FGameplayAbilitySpec& Spec - spec being activated, const UGameplayAbility* Ability - ability CDO
+	* Output: a pooled instance when available, a new instance otherwise
+	*/
+
+	StatInstanceRequests++;
+
+	const UGASGameplayAbility* ProjectAbility = Cast<UGASGameplayAbility>(Ability);
+	if (ProjectAbility && ProjectAbility->CanPoolInstances() && CVarPoolAbilityInstances.GetValueOnGameThread() != 0)
+	{
+		if (UGameplayAbility* PooledInstance = AcquirePooledInstance(Ability->GetClass()))
+		{
+			//Same bookkeeping the base class does for non replicated instances
+			Spec.NonReplicatedInstances.Add(PooledInstance);
+			StatPoolReuses++;
+			return PooledInstance;
+		}
+	}
+
+	StatInstanceAllocations++;
+	return Super::CreateNewInstanceOfAbility(Spec, Ability);
+}
+
+void UBaseAbilitySystemComponent::NotifyAbilityActivated(const FGameplayAbilitySpecHandle Handle, UGameplayAbility* Ability)
+{
+	UGameplayBudgetSubsystem::Record(EGameplayFrameStat::AbilityActivations);
+
+	Super::NotifyAbilityActivated(Handle, Ability);
+}
+
+FActiveGameplayEffectHandle UBaseAbilitySystemComponent::ApplyGameplayEffectSpecToSelf(const FGameplayEffectSpec& GameplayEffect, FPredictionKey PredictionKey)
+{
+	//Every application ends up here, ApplyGameplayEffectSpecToTarget included
+	LLM_SCOPE_BYTAG(GASDemo_Effects);
+	const FActiveGameplayEffectHandle Handle = Super::ApplyGameplayEffectSpecToSelf(GameplayEffect, PredictionKey);
+	if (!Handle.WasSuccessfullyApplied()) return Handle;
+
+	UGameplayBudgetSubsystem::Record(EGameplayFrameStat::EffectsApplied);
+
+	//Periodic effects opted into the scheduler are ticked by its timing wheel instead of their own timer
+	UPeriodicEffectScheduler* PeriodicScheduler = GetWorld() ? GetWorld()->GetSubsystem<UPeriodicEffectScheduler>() : nullptr;
+	if (PeriodicScheduler && PeriodicScheduler->ShouldScheduleSpec(GameplayEffect, this))
+		PeriodicScheduler->ScheduleCarrierTicks(GameplayEffect, this, Handle);
+
+	return Handle;
+}
+
+void UBaseAbilitySystemComponent::NotifyAbilityEnded(FGameplayAbilitySpecHandle Handle, UGameplayAbility* Ability, bool bWasCancelled)
+{
+	/* Function NotifyAbilityEnded
+	* Arguments: FGameplayAbilitySpecHandle Handle - spec of the ended ability, UGameplayAbility* Ability - ended instance, bool bWasCancelled
+	* Output: none (poolable instances go back to the pool instead of being marked as garbage)
+	*/
+
+	UGASGameplayAbility* PooledAbility = Cast<UGASGameplayAbility>(Ability);
+	const bool bPool = PooledAbility && PooledAbility->IsInstantiated() && PooledAbility->CanPoolInstances()
+		&& CVarPoolAbilityInstances.GetValueOnGameThread() != 0;
+
+	if (!bPool)
+	{
+		Super::NotifyAbilityEnded(Handle, Ability, bWasCancelled);
+		return;
+	}
+
+	//The base class takes InstancedPerExecution instances out of their spec and marks them as garbage once they end.
+	//Nothing can collect them before this function returns, so the ones kept in the pool are simply unmarked
+	Super::NotifyAbilityEnded(Handle, Ability, bWasCancelled);
+
+	FAbilityInstancePool& Pool = AbilityInstancePools.FindOrAdd(Ability->GetClass());
+	if (Pool.Instances.Num() < MaxPooledInstancesPerClass)
+	{
+		Ability->ClearGarbage();
+		Pool.Instances.Add(Ability);
+		StatPoolReleases++;
+	}
+}
+
+UGameplayAbility* UBaseAbilitySystemComponent::AcquirePooledInstance(UClass* AbilityClass)
+{
+	FAbilityInstancePool* Pool = AbilityInstancePools.Find(AbilityClass);
+	if (!Pool) return nullptr;
+
+	while (Pool->Instances.Num() > 0)
+	{
+		//Instances can be destroyed while pooled (e.g. ClearAbility running while they were ending)
+		UGameplayAbility* Instance = Pool->Instances.Pop(false);
+		if (IsValid(Instance) && !Instance->IsActive())
+			return Instance;
+	}
+
+	return nullptr;
+}
+
+void UBaseAbilitySystemComponent::DumpPoolStats(FOutputDevice& Ar)
+{
+	Ar.Logf(TEXT("Ability instances (InstancedPerExecution activations): %llu, allocated: %llu, reused from pool: %llu, returned to pool: %llu"),
+		StatInstanceRequests, StatInstanceAllocations, StatPoolReuses, StatPoolReleases);
+
+	if (StatInstanceRequests > 0)
+		Ar.Logf(TEXT("  Allocations per activation: %.3f (pooling %s)"), (double)StatInstanceAllocations / (double)StatInstanceRequests,
+			CVarPoolAbilityInstances.GetValueOnGameThread() != 0 ? TEXT("on") : TEXT("off"));
+}
+
+void UBaseAbilitySystemComponent::ResetPoolStats()
+{
+	StatInstanceRequests = 0;
+	StatInstanceAllocations = 0;
+	StatPoolReuses = 0;
+	StatPoolReleases = 0;
+}
+
+void UBaseAbilitySystemComponent::OnGiveAbility(FGameplayAbilitySpec& AbilitySpec)
+{
+	//Indexed before Super so abilities activated on give (passives) can already be found
+	AddToSpecIndices(AbilitySpec);
+
+	Super::OnGiveAbility(AbilitySpec);
+}
+
+void UBaseAbilitySystemComponent::OnRemoveAbility(FGameplayAbilitySpec& AbilitySpec)
+{
+	RemoveFromSpecIndices(AbilitySpec.Handle);
+
+	Super::OnRemoveAbility(AbilitySpec);
+}
+
+void UBaseAbilitySystemComponent::AddToSpecIndices(const FGameplayAbilitySpec& Spec)
+{
+	if (!Spec.Ability || !Spec.Handle.IsValid()) return;
+
+	//Clients can receive the same spec again, keep a single entry per handle
+	RemoveFromSpecIndices(Spec.Handle);
+
+	FIndexedAbilitySpec& Entry = SpecIndex.Add(Spec.Handle);
+	Entry.AbilityClass = Spec.Ability->GetClass();
+	Entry.SourceObject = TObjectKey<UObject>(Spec.SourceObject.Get());
+	Entry.InputID = Spec.InputID;
+
+	SpecsByClass.Add(Entry.AbilityClass, Spec.Handle);
+	SpecsBySourceObject.Add(Entry.SourceObject, Spec.Handle);
+	if (Entry.InputID != INDEX_NONE)
+		SpecsByInputID.Add(Entry.InputID, Spec.Handle);
+}
+
+void UBaseAbilitySystemComponent::RemoveFromSpecIndices(FGameplayAbilitySpecHandle Handle)
+{
+	FIndexedAbilitySpec Entry;
+	if (!SpecIndex.RemoveAndCopyValue(Handle, Entry)) return;
+
+	SpecsByClass.RemoveSingle(Entry.AbilityClass, Handle);
+	SpecsBySourceObject.RemoveSingle(Entry.SourceObject, Handle);
+	if (Entry.InputID != INDEX_NONE)
+		SpecsByInputID.RemoveSingle(Entry.InputID, Handle);
+}
+
+void UBaseAbilitySystemComponent::ReindexAbilitySpec(const FGameplayAbilitySpec& Spec)
+{
+	AddToSpecIndices(Spec);
+}
+
+void UBaseAbilitySystemComponent::FindAbilitySpecHandlesByClass(TSubclassOf<UGameplayAbility> AbilityClass, TArray<FGameplayAbilitySpecHandle>& OutHandles, const UObject* SourceObject) const
+{
+	/* Function FindAbilitySpecHandlesByClass
+	* Arguments: TSubclassOf<UGameplayAbility> AbilityClass - exact class to look for, TArray<FGameplayAbilitySpecHandle>& OutHandles - results,
+	* const UObject* SourceObject - optional source object filter
+	* Output: none (matching handles are appended to OutHandles)
+	*/
+
+	const TObjectKey<UObject> SourceKey(SourceObject);
+
+	for (auto It = SpecsByClass.CreateConstKeyIterator(AbilityClass.Get()); It; ++It)
+	{
+		if (SourceObject && SpecIndex.FindChecked(It.Value()).SourceObject != SourceKey) continue;
+
+		OutHandles.Add(It.Value());
+	}
+}
+
+void UBaseAbilitySystemComponent::FindAbilitySpecHandlesBySourceObject(const UObject* SourceObject, TArray<FGameplayAbilitySpecHandle>& OutHandles) const
+{
+	SpecsBySourceObject.MultiFind(TObjectKey<UObject>(SourceObject), OutHandles);
+}
+
+void UBaseAbilitySystemComponent::FindAbilitySpecHandlesByInputID(int32 InputID, TArray<FGameplayAbilitySpecHandle>& OutHandles) const
+{
+	SpecsByInputID.MultiFind(InputID, OutHandles);
+}
+
+int32 UBaseAbilitySystemComponent::ClearAbilitiesByClass(const TArray<TSubclassOf<UGameplayAbility>>& AbilityClasses, const UObject* SourceObject)
+{
+	/* Function ClearAbilitiesByClass
+	* Arguments: const TArray<TSubclassOf<UGameplayAbility>>& AbilityClasses - classes to clear, const UObject* SourceObject - source filter
+	* Output: number of specs cleared (only on authority, same as ClearAbility)
+	*/
+
+	TArray<FGameplayAbilitySpecHandle> AbilitiesToRemove;
+	for (const TSubclassOf<UGameplayAbility>& AbilityClass : AbilityClasses)
+	{
+		FindAbilitySpecHandlesByClass(AbilityClass, AbilitiesToRemove, SourceObject);
+	}
+
+	//The same class can be listed twice
+	int32 NumCleared = 0;
+	TSet<FGameplayAbilitySpecHandle> Cleared;
+	for (const FGameplayAbilitySpecHandle& Handle : AbilitiesToRemove)
+	{
+		bool bAlreadyCleared = false;
+		Cleared.Add(Handle, &bAlreadyCleared);
+		if (bAlreadyCleared) continue;
+
+		ClearAbility(Handle);
+		NumCleared++;
+	}
+
+	return NumCleared;
+}
+
+void UBaseAbilitySystemComponent::AbilityLocalInputPressed(int32 InputID)
+{
+	//Open a batch for the opted in ability bound to this input: its activation, and the target data and end it
+	//sends within this call, go out as one RPC when the batcher goes out of scope
+	TOptional<FScopedServerAbilityRPCBatcher> Batcher;
+
+	if (ShouldDoServerAbilityRPCBatch())
+	{
+		TArray<FGameplayAbilitySpecHandle> Handles;
+		FindAbilitySpecHandlesByInputID(InputID, Handles);
+
+		for (const FGameplayAbilitySpecHandle& Handle : Handles)
+		{
+			const FGameplayAbilitySpec* Spec = FindAbilitySpecFromHandle(Handle);
+			if (Spec && !Spec->IsActive() && ShouldBatchAbilityRPCs(*Spec))
+			{
+				Batcher.Emplace(this, Handle);
+				break;
+			}
+		}
+	}
+
+	Super::AbilityLocalInputPressed(InputID);
+}
+
+bool UBaseAbilitySystemComponent::BatchRPCTryActivateAbility(FGameplayAbilitySpecHandle AbilityHandle, bool bEndAbilityImmediately)
+{
+	/* Function BatchRPCTryActivateAbility
+	* Arguments: FGameplayAbilitySpecHandle AbilityHandle - spec to activate, bool bEndAbilityImmediately - end it within the batch
+	* Output: true if the ability was activated
+	*/
+
+	return BatchRPCTryActivateAbilityWithTargetData(AbilityHandle, FGameplayAbilityTargetDataHandle(), bEndAbilityImmediately);
+}
+
+bool UBaseAbilitySystemComponent::BatchRPCTryActivateAbilityWithTargetData(FGameplayAbilitySpecHandle AbilityHandle, const FGameplayAbilityTargetDataHandle& TargetData, bool bEndAbilityImmediately)
+{
+	/* Function BatchRPCTryActivateAbilityWithTargetData
+	* Arguments: FGameplayAbilitySpecHandle AbilityHandle - spec to activate, const FGameplayAbilityTargetDataHandle& TargetData - sent
+	*   after the activation (nothing sent if empty), bool bEndAbilityImmediately - end it within the batch
+	* Output: true if the ability was activated
+	*/
+
+	const FGameplayAbilitySpec* Spec = FindAbilitySpecFromHandle(AbilityHandle);
+	if (!Spec) return false;
+
+	TOptional<FScopedServerAbilityRPCBatcher> Batcher;
+	if (ShouldBatchAbilityRPCs(*Spec))
+		Batcher.Emplace(this, AbilityHandle);
+
+	const bool bActivated = TryActivateAbility(AbilityHandle, true);
+	if (!bActivated || (TargetData.Num() == 0 && !bEndAbilityImmediately))
+		return bActivated;
+
+	//Activation callbacks can change the spec array, look it up again. InstancedPerExecution abilities have no primary instance, the new one is the last
+	Spec = FindAbilitySpecFromHandle(AbilityHandle);
+	UGASGameplayAbility* Ability = Spec ? Cast<UGASGameplayAbility>(Spec->GetPrimaryInstance()) : nullptr;
+	if (!Ability && Spec && Spec->GetAbilityInstances().Num() > 0)
+		Ability = Cast<UGASGameplayAbility>(Spec->GetAbilityInstances().Last());
+
+	//Only clients send target data, the server already has it
+	if (Ability && TargetData.Num() > 0 && !IsOwnerActorAuthoritative())
+	{
+		//Same keys as UAbilityTask_WaitTargetData
+		FScopedPredictionWindow ScopedPrediction(this, true);
+		CallServerSetReplicatedTargetData(AbilityHandle, Ability->GetCurrentActivationInfo().GetActivationPredictionKey(), TargetData, FGameplayTag(), ScopedPredictionKey);
+	}
+
+	if (Ability && bEndAbilityImmediately)
+		Ability->ExternalEndAbility();
+
+	return bActivated;
+}
+
+bool UBaseAbilitySystemComponent::BatchRPCTryActivateAbilityByClass(TSubclassOf<UGameplayAbility> AbilityClass, bool bEndAbilityImmediately)
+{
+	TArray<FGameplayAbilitySpecHandle> Handles;
+	FindAbilitySpecHandlesByClass(AbilityClass, Handles);
+
+	return Handles.Num() > 0 && BatchRPCTryActivateAbility(Handles[0], bEndAbilityImmediately);
+}
+
+bool UBaseAbilitySystemComponent::ShouldDoServerAbilityRPCBatch() const
+{
+	//Only clients send server RPCs, a listen server host would just send the batch to itself
+	return CVarBatchAbilityRPCs.GetValueOnGameThread() != 0 && !IsOwnerActorAuthoritative();
+}
+
+bool UBaseAbilitySystemComponent::ShouldBatchAbilityRPCs(const FGameplayAbilitySpec& Spec) const
+{
+	const UGASGameplayAbility* Ability = Cast<UGASGameplayAbility>(Spec.Ability);
+	return Ability && Ability->ShouldBatchRPCs();
+}
+
+bool UBaseAbilitySystemComponent::IsBatchingAbilityRPCs(FGameplayAbilitySpecHandle AbilityHandle, bool bRequireStarted) const
+{
+	//Same rule as the base class: target data and end are only batched once the batch saw the activation
+	return LocalServerAbilityRPCBatchData.ContainsByPredicate([AbilityHandle, bRequireStarted](const FServerAbilityRPCBatch& Batch)
+	{
+		return Batch.AbilitySpecHandle == AbilityHandle && (!bRequireStarted || Batch.Started);
+	});
+}
+
+void UBaseAbilitySystemComponent::RecordServerRPC(bool bBatched)
+{
+	if (bBatched)
+		StatBatchedCalls++;
+	else
+		StatServerRPCs++;
+}
+
+void UBaseAbilitySystemComponent::CallServerTryActivateAbility(FGameplayAbilitySpecHandle AbilityToActivate, bool InputPressed, FPredictionKey PredictionKey)
+{
+	StatActivationRequests++;
+	RecordServerRPC(IsBatchingAbilityRPCs(AbilityToActivate, false));
+
+	Super::CallServerTryActivateAbility(AbilityToActivate, InputPressed, PredictionKey);
+}
+
+void UBaseAbilitySystemComponent::CallServerSetReplicatedTargetData(FGameplayAbilitySpecHandle AbilityHandle, FPredictionKey AbilityOriginalPredictionKey, const FGameplayAbilityTargetDataHandle& ReplicatedTargetDataHandle, FGameplayTag ApplicationTag, FPredictionKey CurrentPredictionKey)
+{
+	RecordServerRPC(IsBatchingAbilityRPCs(AbilityHandle, true));
+
+	UNetConnection* Connection = GetOwner() ? GetOwner()->GetNetConnection() : nullptr;
+	if (CVarMeasureTargetDataBytes.GetValueOnGameThread() != 0 && Connection)
+	{
+		FNetBitWriter Writer(Connection->PackageMap, 0);
+		FGameplayAbilityTargetDataHandle TargetDataCopy = ReplicatedTargetDataHandle;
+		bool bSuccess = false;
+		TargetDataCopy.NetSerialize(Writer, Connection->PackageMap, bSuccess);
+		StatTargetDataBytes += Writer.GetNumBytes();
+	}
+
+	Super::CallServerSetReplicatedTargetData(AbilityHandle, AbilityOriginalPredictionKey, ReplicatedTargetDataHandle, ApplicationTag, CurrentPredictionKey);
+}
+
+void UBaseAbilitySystemComponent::CallServerEndAbility(FGameplayAbilitySpecHandle AbilityToEnd, FGameplayAbilityActivationInfo ActivationInfo, FPredictionKey PredictionKey)
+{
+	RecordServerRPC(IsBatchingAbilityRPCs(AbilityToEnd, true));
+
+	Super::CallServerEndAbility(AbilityToEnd, ActivationInfo, PredictionKey);
+}
+
+void UBaseAbilitySystemComponent::EndServerAbilityRPCBatch(FGameplayAbilitySpecHandle AbilityHandle)
+{
+	//The whole batch goes out as a single ServerAbilityRPCBatch
+	if (IsBatchingAbilityRPCs(AbilityHandle, false))
+		StatServerRPCs++;
+
+	Super::EndServerAbilityRPCBatch(AbilityHandle);
+}
+
+void UBaseAbilitySystemComponent::DumpRPCStats(FOutputDevice& Ar)
+{
+	Ar.Logf(TEXT("Server ability RPCs: %llu activations, %llu RPCs sent, %llu calls merged into batches (batching %s)"),
+		StatActivationRequests, StatServerRPCs, StatBatchedCalls, CVarBatchAbilityRPCs.GetValueOnGameThread() != 0 ? TEXT("on") : TEXT("off"));
+
+	if (StatActivationRequests > 0)
+		Ar.Logf(TEXT("  RPCs per activation: %.2f"), (double)StatServerRPCs / (double)StatActivationRequests);
+
+	if (StatTargetDataBytes > 0)
+		Ar.Logf(TEXT("  Target data payload: %llu bytes (%.1f per activation)"), StatTargetDataBytes, (double)StatTargetDataBytes / (double)FMath::Max<uint64>(1, StatActivationRequests));
+}
+
+void UBaseAbilitySystemComponent::ResetRPCStats()
+{
+	StatActivationRequests = 0;
+	StatServerRPCs = 0;
+	StatBatchedCalls = 0;
+	StatTargetDataBytes = 0;
+}
+
+EGameplayEffectReplicationMode UBaseAbilitySystemComponent::GetReplicationModeForController(const AController* Controller)
+{
+	/* Function GetReplicationModeForController
+	* Arguments: const AController* Controller - controller possessing the ASC's avatar
+	* Output: Mixed for player controllers, Minimal for AI and unpossessed characters (see GAS.Replication.AIMode to compare with other modes)
+	*/
+
+	const int32 AIMode = CVarAIReplicationMode.GetValueOnGameThread();
+	if (AIMode >= 2)
+		return EGameplayEffectReplicationMode::Full;
+
+	//Mixed needs the controller to own the avatar (done by APawn::PossessedBy) so the owning client gets its effects
+	if (Cast<APlayerController>(Controller) || AIMode == 1)
+		return EGameplayEffectReplicationMode::Mixed;
+
+	return EGameplayEffectReplicationMode::Minimal;
+}
+
+void UBaseAbilitySystemComponent::DumpReplicationStats(UWorld* World, FOutputDevice& Ar)
+{
+	if (!World) return;
+
+	int32 NumByMode[3] = {};
+	int32 NumMinimalEffects = 0;
+
+	for (TObjectIterator<UBaseAbilitySystemComponent> It; It; ++It)
+	{
+		if (It->GetWorld() != World || It->IsTemplate()) continue;
+
+		const int32 Mode = FMath::Clamp((int32)It->GetEffectReplicationMode(), 0, 2);
+		NumByMode[Mode]++;
+
+		//Active effects that Full mode would replicate to every client
+		if (It->GetEffectReplicationMode() == EGameplayEffectReplicationMode::Minimal)
+			NumMinimalEffects += It->GetNumActiveGameplayEffects();
+	}
+
+	Ar.Logf(TEXT("AbilitySystemComponents: %d Minimal, %d Mixed, %d Full"),
+		NumByMode[(int32)EGameplayEffectReplicationMode::Minimal], NumByMode[(int32)EGameplayEffectReplicationMode::Mixed], NumByMode[(int32)EGameplayEffectReplicationMode::Full]);
+	Ar.Logf(TEXT("  Active effects not replicated (Minimal mode): %d"), NumMinimalEffects);
+
+	const UNetDriver* NetDriver = World->GetNetDriver();
+	if (NetDriver && NetDriver->IsServer())
+	{
+		Ar.Logf(TEXT("  Server out: %u bytes/s, %u packets/s to %d clients"), NetDriver->OutBytesPerSecond, NetDriver->OutPacketsPerSecond, NetDriver->ClientConnections.Num());
+	}
+	else
+	{
+		Ar.Log(TEXT("  Not a server world: bandwidth is only reported on the server"));
+	}
+}
+
+void UBaseAbilitySystemComponent::SpawnReplicationTestNPCs(UWorld* World, int32 Count, TSubclassOf<UGameplayEffect> Effect, FOutputDevice& Ar)
+{
+	/* Function SpawnReplicationTestNPCs
+	* Arguments: UWorld* World - server world to spawn in
+	*			 int32 Count - characters to spawn
+	*			 TSubclassOf<UGameplayEffect> Effect - applied to every spawned character once possessed (optional), gives them active effects to replicate
+	* Output: none (characters are kept until DestroyReplicationTestNPCs)
+	*/
+
+	const AGameModeBase* GameMode = World ? World->GetAuthGameMode() : nullptr;
+	APlayerController* PlayerController = World ? World->GetFirstPlayerController() : nullptr;
+	if (!GameMode || !PlayerController || !PlayerController->GetPawn())
+	{
+		Ar.Log(TEXT("GAS.Replication.SpawnNPCs needs a server world with a player pawn"));
+		return;
+	}
+
+	UClass* CharacterClass = GameMode->DefaultPawnClass.Get();
+	if (!CharacterClass || !CharacterClass->IsChildOf(ACharacterBase::StaticClass()))
+	{
+		Ar.Log(TEXT("The game mode pawn class isn't a ACharacterBase"));
+		return;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	//Grid around the player, close enough to stay relevant to its connection
+	const FVector Center = PlayerController->GetPawn()->GetActorLocation();
+	const int32 RowSize = FMath::CeilToInt(FMath::Sqrt((float)Count));
+
+	int32 NumSpawned = 0;
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		const FVector Location = Center + FVector((Index % RowSize - RowSize / 2) * 200.f, (Index / RowSize + 1) * 200.f, 0.f);
+		ACharacterBase* Character = World->SpawnActor<ACharacterBase>(CharacterClass, FTransform(Location), SpawnParams);
+		if (!Character) continue;
+
+		//Possession by the AI controller picks the replication mode
+		Character->SpawnDefaultController();
+		ReplicationTestNPCs.Add(Character);
+		NumSpawned++;
+
+		UAbilitySystemComponent* ASC = Character->GetAbilitySystemComponent();
+		if (Effect && ASC)
+			ASC->ApplyGameplayEffectToSelf(Effect.GetDefaultObject(), 1.f, ASC->MakeEffectContext());
+	}
+
+	Ar.Logf(TEXT("Spawned %d NPCs (%d alive from GAS.Replication.SpawnNPCs), AIMode %d"),
+		NumSpawned, ReplicationTestNPCs.Num(), CVarAIReplicationMode.GetValueOnGameThread());
+}
+
+void UBaseAbilitySystemComponent::DestroyReplicationTestNPCs(FOutputDevice& Ar)
+{
+	int32 NumDestroyed = 0;
+	for (const TWeakObjectPtr<ACharacterBase>& Character : ReplicationTestNPCs)
+	{
+		if (!Character.IsValid()) continue;
+
+		if (AController* Controller = Character->GetController())
+			Controller->Destroy();
+		Character->Destroy();
+		NumDestroyed++;
+	}
+	ReplicationTestNPCs.Reset();
+
+	Ar.Logf(TEXT("Destroyed %d NPCs"), NumDestroyed);
+}
+
+void UBaseAbilitySystemComponent::MeasureReplicationBandwidth(UWorld* World, float Seconds, FOutputDevice& Ar)
+{
+	/* Function MeasureReplicationBandwidth
+	* Arguments: UWorld* World - server world
+	*			 float Seconds - measuring window
+	* Output: none (the average is logged when the window ends, Ar may be gone by then)
+	*/
+
+	const UNetDriver* NetDriver = World ? World->GetNetDriver() : nullptr;
+	if (!NetDriver || !NetDriver->IsServer())
+	{
+		Ar.Log(TEXT("GAS.Replication.Measure needs a server world (listen or dedicated)"));
+		return;
+	}
+
+	FTimerManager& TimerManager = World->GetTimerManager();
+	if (TimerManager.IsTimerActive(ReplicationMeasureTimer))
+	{
+		Ar.Log(TEXT("A measure is already running"));
+		return;
+	}
+
+	const uint64 StartBytes = NetDriver->OutTotalBytes;
+	const uint64 StartPackets = NetDriver->OutTotalPackets;
+	const double StartTime = FPlatformTime::Seconds();
+	TWeakObjectPtr<UWorld> WeakWorld(World);
+
+	TimerManager.SetTimer(ReplicationMeasureTimer, FTimerDelegate::CreateLambda([WeakWorld, StartBytes, StartPackets, StartTime]()
+	{
+		UWorld* World = WeakWorld.Get();
+		const UNetDriver* NetDriver = World ? World->GetNetDriver() : nullptr;
+		if (!NetDriver) return;
+
+		const double Elapsed = FMath::Max(FPlatformTime::Seconds() - StartTime, 0.001);
+		const uint64 Bytes = (uint64)NetDriver->OutTotalBytes - StartBytes;
+		const uint64 Packets = (uint64)NetDriver->OutTotalPackets - StartPackets;
+
+		UE_LOG(LogTemp, Display, TEXT("GAS.Replication.Measure: %.0f bytes/s, %.1f packets/s over %.1fs to %d clients (AIMode %d, %d test NPCs)"),
+			Bytes / Elapsed, Packets / Elapsed, Elapsed, NetDriver->ClientConnections.Num(), CVarAIReplicationMode.GetValueOnGameThread(), ReplicationTestNPCs.Num());
+		DumpReplicationStats(World, *GLog);
+	}), Seconds, false);
+
+	Ar.Logf(TEXT("Measuring the server's outgoing bandwidth for %.1fs"), Seconds);
+}
@@ -6,6 +6,26 @@
 #include "AbilitySystemComponent.h"
 #include "BaseAbilitySystemComponent.generated.h"
 
+class UGASGameplayAbility;
+
+/** Recycled instances of one ability class */
+USTRUCT()
+struct FAbilityInstancePool
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<UGameplayAbility*> Instances;
+};
+
+/** Index entry of a given ability spec, see UBaseAbilitySystemComponent */
+struct FIndexedAbilitySpec
+{
+	const UClass* AbilityClass = nullptr;
+	TObjectKey<UObject> SourceObject;
+	int32 InputID = INDEX_NONE;
+};
+
 /**
  * 
  */
@@ -13,5 +33,182 @@ UCLASS()
 class GAS_DEMO_API UBaseAbilitySystemComponent : public UAbilitySystemComponent
 {
 	GENERATED_BODY()
-	
+
+/*
+* Class UBaseAbilitySystemComponent
+* Project's AbilitySystemComponent (created by ACharacterBase).
+* Keeps a pool of ability instances per class for InstancedPerExecution abilities that allow it
+* (see UGASGameplayAbility::CanPoolInstances): ended instances are reset and reused on the next activation
+* instead of allocating a new UObject every time.
+*
+* Use the console command GAS.Abilities.PoolStats to check allocations per activation,
+* pooling can be turned off with GAS.Abilities.PoolInstances 0 to compare.
+*
+* Also indexes granted ability specs by ability class, source object and input ID (maintained in OnGiveAbility and
+* OnRemoveAbility, so on clients too) so spec queries don't have to walk GetActivatableAbilities().
+* The input ID index uses the InputID the spec was given with: call ReindexAbilitySpec after changing it.
+*
+* Abilities with bBatchActivationRPCs send their activation, target data and end to the server as one
+* ServerAbilityRPCBatch RPC (the engine's batching, enabled here) when activated from input or through
+* BatchRPCTryActivateAbility. Use GAS.Abilities.RPCStats to check server RPCs per activation, batching can be
+* turned off with GAS.Abilities.BatchRPCs 0 to compare. The automation test GASDemo.Abilities.RPCBatching runs a melee
+* attack both ways in a client/server PIE session and reports its RPCs and bytes.
+*
+* Periodic effects listed in the UPeriodicEffectScheduler's ScheduledEffects are ticked by its timing wheel once applied.
+*
+* Replication mode is picked by the owning character from its controller (GetReplicationModeForController):
+* Mixed for players (their own effects replicate to them only), Minimal for AI (no effects replicated at all).
+* Tags and cues are replicated to every client in both modes. Use GAS.Replication.Stats to check the server's
+* outgoing bandwidth, GAS.Replication.AIMode 1 gives AI Mixed replication and 2 goes back to Full replication for every
+* character to compare. To compare on a loopback server: set the mode, GAS.Replication.SpawnNPCs 200 [EffectClassPath]
+* with a client connected, then GAS.Replication.Measure; 'GAS.Replication.SpawnNPCs clear' before switching modes.
+* The automation test GASDemo.Replication.Bandwidth does all of it for each mode.
+*/
+
+public:
+	UBaseAbilitySystemComponent();
+
+	//~ Begin UAbilitySystemComponent
+	virtual void InitializeComponent() override;
+	virtual UGameplayAbility* CreateNewInstanceOfAbility(FGameplayAbilitySpec& Spec, const UGameplayAbility* Ability) override;
+	virtual void NotifyAbilityActivated(const FGameplayAbilitySpecHandle Handle, UGameplayAbility* Ability) override;
+	virtual void NotifyAbilityEnded(FGameplayAbilitySpecHandle Handle, UGameplayAbility* Ability, bool bWasCancelled) override;
+	virtual FActiveGameplayEffectHandle ApplyGameplayEffectSpecToSelf(const FGameplayEffectSpec& GameplayEffect, FPredictionKey PredictionKey = FPredictionKey()) override;
+	virtual void AbilityLocalInputPressed(int32 InputID) override;
+	virtual bool ShouldDoServerAbilityRPCBatch() const override;
+	virtual void CallServerTryActivateAbility(FGameplayAbilitySpecHandle AbilityToActivate, bool InputPressed, FPredictionKey PredictionKey) override;
+	virtual void CallServerSetReplicatedTargetData(FGameplayAbilitySpecHandle AbilityHandle, FPredictionKey AbilityOriginalPredictionKey, const FGameplayAbilityTargetDataHandle& ReplicatedTargetDataHandle, FGameplayTag ApplicationTag, FPredictionKey CurrentPredictionKey) override;
+	virtual void CallServerEndAbility(FGameplayAbilitySpecHandle AbilityToEnd, FGameplayAbilityActivationInfo ActivationInfo, FPredictionKey PredictionKey) override;
+	virtual void EndServerAbilityRPCBatch(FGameplayAbilitySpecHandle AbilityHandle) override;
+	//~ End UAbilitySystemComponent
+
+	/**
+	* Activates an ability with its activation, target data and end RPCs batched (if the ability opts in)
+	*
+	* @param AbilityHandle  Spec to activate
+	* @param bEndAbilityImmediately  End the ability right after activating it, so the end is part of the batch
+	* @return true if the ability was activated
+	*/
+	UFUNCTION(BlueprintCallable, Category = Abilities)
+	bool BatchRPCTryActivateAbility(FGameplayAbilitySpecHandle AbilityHandle, bool bEndAbilityImmediately);
+
+	/**
+	* Same as BatchRPCTryActivateAbility, TargetData (e.g. the hits of an instant melee attack) is sent to the server
+	* between the activation and the end so the batch carries all three
+	*/
+	UFUNCTION(BlueprintCallable, Category = Abilities)
+	bool BatchRPCTryActivateAbilityWithTargetData(FGameplayAbilitySpecHandle AbilityHandle, const FGameplayAbilityTargetDataHandle& TargetData, bool bEndAbilityImmediately);
+
+	/** Same as BatchRPCTryActivateAbility for the first spec of AbilityClass */
+	UFUNCTION(BlueprintCallable, Category = Abilities)
+	bool BatchRPCTryActivateAbilityByClass(TSubclassOf<UGameplayAbility> AbilityClass, bool bEndAbilityImmediately);
+
+	/** Replication mode to use for an ASC whose avatar is possessed by Controller (nullptr = not possessed) */
+	static EGameplayEffectReplicationMode GetReplicationModeForController(const AController* Controller);
+
+	/** Replication mode currently in use */
+	EGameplayEffectReplicationMode GetEffectReplicationMode() const { return ReplicationMode; }
+
+	/** Prints the replication mode of every ASC in World and the net driver's outgoing bandwidth */
+	static void DumpReplicationStats(UWorld* World, FOutputDevice& Ar);
+
+	/** Spawns Count AI-controlled copies of the game mode pawn near the first player, Effect (optional) is applied to each */
+	static void SpawnReplicationTestNPCs(UWorld* World, int32 Count, TSubclassOf<UGameplayEffect> Effect, FOutputDevice& Ar);
+
+	/** Destroys the characters spawned by SpawnReplicationTestNPCs and their controllers */
+	static void DestroyReplicationTestNPCs(FOutputDevice& Ar);
+
+	/** Logs the server's average outgoing bandwidth once Seconds have passed */
+	static void MeasureReplicationBandwidth(UWorld* World, float Seconds, FOutputDevice& Ar);
+
+	/** Prints server ability RPC stats (all ASCs) to the output device */
+	static void DumpRPCStats(FOutputDevice& Ar);
+
+	/** Clears the counters shown in DumpRPCStats */
+	static void ResetRPCStats();
+
+	/** Counters shown in DumpRPCStats: activations sent to the server, server RPCs sent (a batch counts once), target data bytes */
+	static uint64 GetActivationRequestCount() { return StatActivationRequests; }
+	static uint64 GetServerRPCCount() { return StatServerRPCs; }
+	static uint64 GetTargetDataBytes() { return StatTargetDataBytes; }
+
+	/** Appends the handles of every spec of AbilityClass (optionally only the ones given by SourceObject) */
+	void FindAbilitySpecHandlesByClass(TSubclassOf<UGameplayAbility> AbilityClass, TArray<FGameplayAbilitySpecHandle>& OutHandles, const UObject* SourceObject = nullptr) const;
+
+	/** Appends the handles of every spec given by SourceObject */
+	void FindAbilitySpecHandlesBySourceObject(const UObject* SourceObject, TArray<FGameplayAbilitySpecHandle>& OutHandles) const;
+
+	/** Appends the handles of every spec bound to InputID */
+	void FindAbilitySpecHandlesByInputID(int32 InputID, TArray<FGameplayAbilitySpecHandle>& OutHandles) const;
+
+	/**
+	* Clears every spec of the given ability classes given by SourceObject
+	*
+	* @param AbilityClasses  Classes of the abilities to clear
+	* @param SourceObject  Only specs given with this source object are cleared
+	* @return Number of specs cleared
+	*/
+	int32 ClearAbilitiesByClass(const TArray<TSubclassOf<UGameplayAbility>>& AbilityClasses, const UObject* SourceObject);
+
+	/** Updates the index entry of a spec after its InputID or SourceObject were changed */
+	void ReindexAbilitySpec(const FGameplayAbilitySpec& Spec);
+
+	/** Prints instance pooling stats (all ASCs) to the output device */
+	static void DumpPoolStats(FOutputDevice& Ar);
+
+	/** Clears the counters shown in DumpPoolStats */
+	static void ResetPoolStats();
+
+protected:
+
+	//~ Begin UAbilitySystemComponent
+	virtual void OnGiveAbility(FGameplayAbilitySpec& AbilitySpec) override;
+	virtual void OnRemoveAbility(FGameplayAbilitySpec& AbilitySpec) override;
+	//~ End UAbilitySystemComponent
+
+	/** Max number of ended instances kept per ability class, extra instances are left to the garbage collector */
+	UPROPERTY(EditDefaultsOnly, Category = Abilities)
+	int32 MaxPooledInstancesPerClass;
+
+private:
+
+	/** Returns true if the spec's ability opted into RPC batching */
+	bool ShouldBatchAbilityRPCs(const FGameplayAbilitySpec& Spec) const;
+
+	/** Returns true if calls for AbilityHandle are currently added to a batch (that saw the activation if bRequireStarted) instead of being sent */
+	bool IsBatchingAbilityRPCs(FGameplayAbilitySpecHandle AbilityHandle, bool bRequireStarted) const;
+
+	/** Records one server RPC call (batched or sent on its own) */
+	static void RecordServerRPC(bool bBatched);
+
+	/** Returns a pooled instance of AbilityClass, nullptr if there is none */
+	UGameplayAbility* AcquirePooledInstance(UClass* AbilityClass);
+
+	/** Adds Spec to every index */
+	void AddToSpecIndices(const FGameplayAbilitySpec& Spec);
+
+	/** Removes Handle from every index */
+	void RemoveFromSpecIndices(FGameplayAbilitySpecHandle Handle);
+
+	/** Indexed data of every granted spec */
+	TMap<FGameplayAbilitySpecHandle, FIndexedAbilitySpec> SpecIndex;
+
+	//Lookups to spec handles
+	TMultiMap<const UClass*, FGameplayAbilitySpecHandle> SpecsByClass;
+	TMultiMap<TObjectKey<UObject>, FGameplayAbilitySpecHandle> SpecsBySourceObject;
+	TMultiMap<int32, FGameplayAbilitySpecHandle> SpecsByInputID;
+
+	/** Ended instances ready to be reused, by ability class */
+	UPROPERTY(Transient)
+	TMap<UClass*, FAbilityInstancePool> AbilityInstancePools;
+
+	//Stats counters (shared by every ASC), see DumpPoolStats
+	static uint64 StatInstanceRequests;
+	static uint64 StatInstanceAllocations;
+	static uint64 StatPoolReuses;
+	static uint64 StatPoolReleases;
+	static uint64 StatActivationRequests;
+	static uint64 StatServerRPCs;
+	static uint64 StatBatchedCalls;
+	static uint64 StatTargetDataBytes;
 };
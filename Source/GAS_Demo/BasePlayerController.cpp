@@ -2,6 +2,10 @@
 
 #include "BasePlayerController.h"
 #include "ItemBase.h"
+#include "ProgressionSaveSubsystem.h"
+#include "GASDemoTrace.h"
+#include "GameplayBudgetSubsystem.h"
+#include "CharacterMemoryReport.h"
 
 bool ABasePlayerController::AddInventoryItem(UItemBase* Item, int32 ItemCount)
 {
@@ -10,6 +14,11 @@ bool ABasePlayerController::AddInventoryItem(UItemBase* Item, int32 ItemCount)
 	* Output: true if item was added successfully, false on failure
 	*/
 
+	LLM_SCOPE_BYTAG(GASDemo_Inventory);
+	GASDEMO_TRACE_SCOPE("AddInventoryItem");
+	GASDEMO_TRACE_COUNTER_INCREMENT(GASDemo_InventoryOperations);
+	UGameplayBudgetSubsystem::Record(EGameplayFrameStat::InventoryOperations);
+
 	if (!Item || ItemCount <= 0)
 	{
 		return false;
@@ -31,9 +40,11 @@ bool ABasePlayerController::AddInventoryItem(UItemBase* Item, int32 ItemCount)
 		//Otherwise, directly add item to inventory
 		InventoryData.Add(Item, ItemCount);
 	}
+	GASDEMO_TRACE_COUNTER_ADD(GASDemo_InventoryItemsAdded, ItemCount);
 
 	//call Update inventory load and return true for success
 	UpdateInventoryLoad();
+	UProgressionSaveSubsystem::MarkDirty(GetPawn(), EProgressionDirty::Inventory, Item);
 	return true;
 }
 
@@ -45,6 +56,10 @@ bool ABasePlayerController::RemoveInventoryItem(UItemBase* Item, int32 RemoveCou
 	* Output: true if item was removed successfully, false on failure
 	*/
 
+	GASDEMO_TRACE_SCOPE("RemoveInventoryItem");
+	GASDEMO_TRACE_COUNTER_INCREMENT(GASDemo_InventoryOperations);
+	UGameplayBudgetSubsystem::Record(EGameplayFrameStat::InventoryOperations);
+
 	if (!Item || RemoveCount <= 0)
 	{
 		//Arguments are not valid, return false
@@ -57,7 +72,9 @@ bool ABasePlayerController::RemoveInventoryItem(UItemBase* Item, int32 RemoveCou
 		//If item is found then remove the quantity specified in RemoveCount
 		if (Pair.Key->ItemName == Item->ItemName)
 		{
+			GASDEMO_TRACE_COUNTER_ADD(GASDemo_InventoryItemsRemoved, FMath::Min(RemoveCount, Pair.Value));
 			Pair.Value -= RemoveCount; //Once updated ItemCount, if it is 0 or less then remove it from the Inventory
+			UProgressionSaveSubsystem::MarkDirty(GetPawn(), EProgressionDirty::Inventory, Pair.Key);
 			if (Pair.Value <= 0)
 			{
 				InventoryData.Remove(Pair.Key);
@@ -157,6 +174,24 @@ void ABasePlayerController::UpdateInventoryLoad()
 }
 
 
+void ABasePlayerController::RestoreInventory(TMap<UItemBase*, int32>&& Items)
+{
+	/* Function RestoreInventory
+	* Arguments: TMap<UItemBase*, int32>&& Items - every item of the inventory and its count
+	* Output: none (AddInventoryItem looks items up by name, too slow to rebuild a large inventory one item at a time)
+	*/
+
+	LLM_SCOPE_BYTAG(GASDemo_Inventory);
+	GASDEMO_TRACE_SCOPE("RestoreInventory");
+	GASDEMO_TRACE_BOOKMARK("RestoreInventory: %d items", Items.Num());
+	GASDEMO_TRACE_COUNTER_INCREMENT(GASDemo_InventoryOperations);
+	UGameplayBudgetSubsystem::Record(EGameplayFrameStat::InventoryOperations);
+
+	InventoryData = MoveTemp(Items);
+	UpdateInventoryLoad();
+}
+
+
 void ABasePlayerController::BeginPlay()
 {
 	Super::BeginPlay();
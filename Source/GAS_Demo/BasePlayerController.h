@@ -58,6 +58,9 @@ public:
 	/** Utility function used to update CurrentInventoryLoad : not meant to be used outside code */
 	void UpdateInventoryLoad();
 
+	/** Replaces the whole inventory in one go (used when loading a save, see UProgressionSaveSubsystem) */
+	void RestoreInventory(TMap<UItemBase*, int32>&& Items);
+
 private:
 
 	/** Max inventory capacity */
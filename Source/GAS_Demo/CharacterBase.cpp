@@ -6,14 +6,29 @@
 #include "Components/InputComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "GameFramework/Controller.h"
+#include "Engine/GameInstance.h"
 #include "GameFramework/SpringArmComponent.h"
 #include "AttributeSet.h"
+#include "CharacterSignificanceSubsystem.h"
+#include "CharacterSpatialGridSubsystem.h"
+#include "RegenerationSubsystem.h"
+#include "AbilityLatencyTracker.h"
+#include "ProgressionSaveSubsystem.h"
+#include "GASDemoTrace.h"
+#include "CharacterMemoryReport.h"
+#include "ZeroAllocationScope.h"
+#include "BaseAbilitySystemComponent.h"
+#include "Animation/AnimInstance.h"
 
 //////////////////////////////////////////////////////////////////////////
 // ACharacterBase
 
 ACharacterBase::ACharacterBase()
 {
+	// Allocations of the character are tagged by system, see CharacterMemoryReport.h
+	// (the actor itself is allocated before this scope, under the tag of whoever spawns it)
+	LLM_SCOPE_BYTAG(GASDemo_Character);
+
 	// Set size for collision capsule
 	GetCapsuleComponent()->InitCapsuleSize(42.f, 96.0f);
 
@@ -41,26 +56,45 @@ ACharacterBase::ACharacterBase()
 	// as some characters such as enemies should not have a camera
 	// Leaving this here for simplicity sake as this is just expanding from the Third Person template
 
-	// Create a camera boom (pulls in towards the player if there is a collision)
-	CameraBoom = CreateDefaultSubobject<USpringArmComponent>(TEXT("CameraBoom"));
-	CameraBoom->SetupAttachment(RootComponent);
-	CameraBoom->TargetArmLength = 400.0f; // The camera follows at this distance behind the character	
-	CameraBoom->bUsePawnControlRotation = true; // Rotate the arm based on the controller
-
-	// Create a follow camera
-	FollowCamera = CreateDefaultSubobject<UCameraComponent>(TEXT("FollowCamera"));
-	FollowCamera->SetupAttachment(CameraBoom, USpringArmComponent::SocketName); // Attach the camera to the end of the boom and let the boom adjust to match the controller orientation
-	FollowCamera->bUsePawnControlRotation = false; // Camera does not rotate relative to arm
+	{
+		LLM_SCOPE_BYTAG(GASDemo_Camera);
+
+		// Create a camera boom (pulls in towards the player if there is a collision)
+		CameraBoom = CreateDefaultSubobject<USpringArmComponent>(TEXT("CameraBoom"));
+		CameraBoom->SetupAttachment(RootComponent);
+		CameraBoom->TargetArmLength = 400.0f; // The camera follows at this distance behind the character	
+		CameraBoom->bUsePawnControlRotation = true; // Rotate the arm based on the controller
+
+		// Create a follow camera
+		FollowCamera = CreateDefaultSubobject<UCameraComponent>(TEXT("FollowCamera"));
+		FollowCamera->SetupAttachment(CameraBoom, USpringArmComponent::SocketName); // Attach the camera to the end of the boom and let the boom adjust to match the controller orientation
+		FollowCamera->bUsePawnControlRotation = false; // Camera does not rotate relative to arm
+	}
 
 	// Note: The skeletal mesh and anim blueprint references on the Mesh component (inherited from Character) 
 	// are set in the derived blueprint asset named ThirdPersonCharacter (to avoid direct content references in C++)
 
-	AbilitySystemComponent = CreateDefaultSubobject<UAbilitySystemComponent>(TEXT("AbilitySystemComp"));
+	{
+		LLM_SCOPE_BYTAG(GASDemo_AbilitySystem);
+
+		// The project ASC recycles InstancedPerExecution ability instances, see UBaseAbilitySystemComponent
+		AbilitySystemComponent = CreateDefaultSubobject<UBaseAbilitySystemComponent>(TEXT("AbilitySystemComp"));
+		// Unpossessed characters don't need any effect replicated, PossessedBy picks the mode for their controller
+		AbilitySystemComponent->SetReplicationMode(EGameplayEffectReplicationMode::Minimal);
 
-	AttributeSet = CreateDefaultSubobject<UGASAttributeSet>(TEXT("Attributes"));
+		AttributeSet = CreateDefaultSubobject<UGASAttributeSet>(TEXT("Attributes"));
+	}
 
 	CharacterLevel = 1;
 	bAbilitiesInitialized = false;
+
+	SignificanceBucket = ECharacterSignificance::High;
+	LastCosmeticCueTime = -1.f;
+	SignificanceSubsystem = nullptr;
+
+	// Regeneration is opt-in: 0 means this character still relies on its own GameplayEffects (if any)
+	StaminaRegenRate = 0.f;
+	ManaRegenRate = 0.f;
 }
 
 
@@ -71,6 +105,101 @@ void ACharacterBase::BeginPlay()
 	// Way 1 of initializing attributes, if starting from a DataTable use this for simplicity sake
 	//if (AbilitySystemComponent)
 	//	AttributeSet = AbilitySystemComponent->GetSet<UGASAttributeSet>();
+
+	// Let the significance subsystem scale down our update rate when we are far away or hidden
+	SignificanceSubsystem = GetWorld()->GetSubsystem<UCharacterSignificanceSubsystem>();
+	if (SignificanceSubsystem)
+		SignificanceSubsystem->RegisterCharacter(this);
+
+	// AoE abilities find their targets through the spatial grid instead of physics overlaps
+	if (UCharacterSpatialGridSubsystem* SpatialGrid = GetWorld()->GetSubsystem<UCharacterSpatialGridSubsystem>())
+		SpatialGrid->RegisterCharacter(this);
+
+	// Mirror our owned tags into a bitset so hot tag checks (ability activation) don't walk tag containers
+	if (AbilitySystemComponent)
+	{
+		OwnedTagBits.Initialize();
+
+		FGameplayTagContainer OwnedTags;
+		AbilitySystemComponent->GetOwnedGameplayTags(OwnedTags);
+		for (const FGameplayTag& Tag : OwnedTags)
+			OwnedTagBits.AddTagWithParents(Tag);
+
+		OwnedTagChangedHandle = AbilitySystemComponent->RegisterGenericGameplayTagEvent().AddUObject(this, &ACharacterBase::OnOwnedTagCountChanged);
+	}
+
+	// Input to activation/montage/damage latency, see UAbilityLatencyTracker
+	if (AbilitySystemComponent)
+		AbilitySystemComponent->AbilityActivatedCallbacks.AddUObject(this, &ACharacterBase::OnAbilityActivatedForLatency);
+
+	if (UAnimInstance* AnimInstance = GetMesh() ? GetMesh()->GetAnimInstance() : nullptr)
+		AnimInstance->OnMontageStarted.AddDynamic(this, &ACharacterBase::OnMontageStartedForLatency);
+}
+
+void ACharacterBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (SignificanceSubsystem)
+	{
+		SignificanceSubsystem->UnregisterCharacter(this);
+		SignificanceSubsystem = nullptr;
+	}
+
+	if (UCharacterSpatialGridSubsystem* SpatialGrid = GetWorld()->GetSubsystem<UCharacterSpatialGridSubsystem>())
+		SpatialGrid->UnregisterCharacter(this);
+
+	if (URegenerationSubsystem* Regeneration = GetWorld()->GetSubsystem<URegenerationSubsystem>())
+		Regeneration->UnregisterRegeneration(AbilitySystemComponent);
+
+	// Cached specs hold a context instigated by our ASC, they are rebuilt if the character plays again
+	EffectSpecCache.Reset();
+
+	if (AbilitySystemComponent && OwnedTagChangedHandle.IsValid())
+	{
+		AbilitySystemComponent->RegisterGenericGameplayTagEvent().Remove(OwnedTagChangedHandle);
+		OwnedTagChangedHandle.Reset();
+	}
+
+	// Changes not autosaved yet are saved before the character goes away
+	UGameInstance* GameInstance = GetGameInstance();
+	if (UProgressionSaveSubsystem* ProgressionSave = GameInstance ? GameInstance->GetSubsystem<UProgressionSaveSubsystem>() : nullptr)
+		ProgressionSave->StopAutosave(this);
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ACharacterBase::Tick(float DeltaSeconds)
+{
+	// Tick cost is recorded so GAS.Significance.Stats can estimate the time saved by skipped ticks
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	Super::Tick(DeltaSeconds);
+
+	if (SignificanceSubsystem)
+		SignificanceSubsystem->RecordCharacterTick(FPlatformTime::Cycles64() - StartCycles);
+}
+
+void ACharacterBase::OnOwnedTagCountChanged(const FGameplayTag Tag, int32 NewCount)
+{
+	// The ASC tag map counts parents too and reports each of them here, so a single bit per event is enough
+	OwnedTagBits.SetTag(Tag, NewCount > 0);
+}
+
+void ACharacterBase::OnTrackedInputPressed(FName ActionName)
+{
+	UAbilityLatencyTracker::Get().MarkInput(this, ActionName);
+}
+
+void ACharacterBase::OnAbilityActivatedForLatency(UGameplayAbility* Ability)
+{
+	// Server copies of remote players also activate their abilities, only the input side is measured
+	if (IsLocallyControlled())
+		UAbilityLatencyTracker::Get().RecordActivation(this, Ability);
+}
+
+void ACharacterBase::OnMontageStartedForLatency(UAnimMontage* Montage)
+{
+	if (IsLocallyControlled())
+		UAbilityLatencyTracker::Get().RecordMontageStart(this);
 }
 
 void ACharacterBase::PossessedBy(AController* NewController)
@@ -78,13 +207,44 @@ void ACharacterBase::PossessedBy(AController* NewController)
 	Super::PossessedBy(NewController);
 
 	if (AbilitySystemComponent)
+	{
+		// Mixed for players (effects only replicate to their owner), Minimal for AI: tags and cues still reach every client
+		AbilitySystemComponent->SetReplicationMode(UBaseAbilitySystemComponent::GetReplicationModeForController(NewController));
 		AbilitySystemComponent->InitAbilityActorInfo(this, this);
+	}
 
 	// Way 2 of initalizing attributes, use this if need more control when initializing attibutes
 	InitializeAttributes();
 
 	// Grant the character's AbilitySystemComponent it's default abilities
 	GiveDefaultAbilities();
+
+	// Stamina and Mana regeneration is handled for every character in a single batched pass
+	// rather than through a periodic GameplayEffect per character (PossessedBy only runs on authority)
+	if (StaminaRegenRate != 0.f || ManaRegenRate != 0.f)
+	{
+		if (URegenerationSubsystem* Regeneration = GetWorld()->GetSubsystem<URegenerationSubsystem>())
+			Regeneration->RegisterRegeneration(AbilitySystemComponent, StaminaRegenRate, ManaRegenRate);
+	}
+
+	// The grid caches our team, which can come from the controller
+	if (UCharacterSpatialGridSubsystem* SpatialGrid = GetWorld()->GetSubsystem<UCharacterSpatialGridSubsystem>())
+		SpatialGrid->RefreshCharacterTeam(this);
+}
+
+void ACharacterBase::UnPossessed()
+{
+	Super::UnPossessed();
+
+	if (AbilitySystemComponent)
+		AbilitySystemComponent->SetReplicationMode(UBaseAbilitySystemComponent::GetReplicationModeForController(nullptr));
+
+	// Registered again by the next PossessedBy, an unpossessed character doesn't regenerate
+	if (URegenerationSubsystem* Regeneration = GetWorld()->GetSubsystem<URegenerationSubsystem>())
+		Regeneration->UnregisterRegeneration(AbilitySystemComponent);
+
+	if (UCharacterSpatialGridSubsystem* SpatialGrid = GetWorld()->GetSubsystem<UCharacterSpatialGridSubsystem>())
+		SpatialGrid->RefreshCharacterTeam(this);
 }
 
 void ACharacterBase::InitializeAttributes()
@@ -94,6 +254,10 @@ void ACharacterBase::InitializeAttributes()
 	* Output: none (Gives the character default attributes)
 	*/
 
+	GASDEMO_TRACE_SCOPE("InitializeAttributes");
+	LLM_SCOPE_BYTAG(GASDemo_Effects);
+	GASDEMO_TRACE_COUNTER_INCREMENT(GASDemo_AttributeInitializations);
+
 	if (AbilitySystemComponent && DefaultAttributeEffect)
 	{
 		/*
@@ -108,9 +272,8 @@ void ACharacterBase::InitializeAttributes()
 		* "backend")
 		*/
 
-		FGameplayEffectContextHandle EffectContext = AbilitySystemComponent->MakeEffectContext();
-		EffectContext.AddSourceObject(this);
-		FGameplayEffectSpecHandle SpecHandle = AbilitySystemComponent->MakeOutgoingSpec(DefaultAttributeEffect, GetCharacterLevel(), EffectContext);
+		// The spec is only built once per level and then re-applied, see FGameplayEffectSpecCache
+		FGameplayEffectSpecHandle SpecHandle = EffectSpecCache.FindOrMake(AbilitySystemComponent, DefaultAttributeEffect.GetDefaultObject(), GetCharacterLevel(), this);
 
 		if (SpecHandle.IsValid())
 			FActiveGameplayEffectHandle GEHandle = AbilitySystemComponent->ApplyGameplayEffectSpecToTarget(*SpecHandle.Data.Get(), AbilitySystemComponent);
@@ -124,6 +287,8 @@ void ACharacterBase::GiveDefaultAbilities()
 	* Output: none (Gives the character default abilities and sets bAbilitiesInitialized to true)
 	*/
 
+	LLM_SCOPE_BYTAG(GASDemo_AbilitySystem);
+
 	// Make sure our AbilitySystemComponent exists and that we haven't initialized abilities
 	if (AbilitySystemComponent && !bAbilitiesInitialized)
 	{
@@ -148,19 +313,9 @@ void ACharacterBase::RemoveStartupGameplayAbilities()
 
 	if (AbilitySystemComponent)
 	{
-		TArray<FGameplayAbilitySpecHandle> AbilitiesToRemove;
-		for (const FGameplayAbilitySpec& Spec : AbilitySystemComponent->GetActivatableAbilities())
-		{
-			if ((Spec.SourceObject == this) && DefaultAbilities.Contains(Spec.Ability->GetClass()))
-			{
-				AbilitiesToRemove.Add(Spec.Handle);
-			}
-		}
-
-		for (int i = 0; i < AbilitiesToRemove.Num(); i++) 
-		{
-			AbilitySystemComponent->ClearAbility(AbilitiesToRemove[i]);
-		}
+		// Specs are looked up through the ASC's class index (only the specs we gave, with this character as source)
+		// instead of checking DefaultAbilities for every activatable ability
+		AbilitySystemComponent->ClearAbilitiesByClass(DefaultAbilities, this);
 
 		FGameplayEffectQuery Query;
 		Query.EffectSource = this;
@@ -179,23 +334,25 @@ void ACharacterBase::ResetAttributes()
 
 	if (AbilitySystemComponent && AttributeSet)
 	{
-		//Create an effect context and define the source object at this actor
-		FGameplayEffectContextHandle EffectContext = AbilitySystemComponent->MakeEffectContext();
-		EffectContext.AddSourceObject(this);
-
 		// Learning-Tip: Try to review this portion of the code while reviewing the Blueprint version
 		// of a GameplayEffect and try to find the parallelisms.
-		UGameplayEffect* Effect = NewObject<UGameplayEffect>(GetTransientPackage(), FName(TEXT("FullHeal")));
+		// The effect itself (Override Health) is built only once by UGameplayEffectCache, its magnitude
+		// is a SetByCaller value that we fill in with the current MaxHealth before applying the spec.
+		static const FGameplayEffectModSignature FullHealSignature = FGameplayEffectModSignature()
+			.Add(UGASAttributeSet::GetHealthAttribute(), EGameplayModOp::Override);
 
-		FGameplayModifierInfo ModifierInfo;
-		ModifierInfo.Attribute = AttributeSet->GetHealthAttribute();
-		ModifierInfo.ModifierOp = EGameplayModOp::Override;
-		ModifierInfo.ModifierMagnitude = FGameplayEffectModifierMagnitude(GetMaxHealth());
+		UGameplayEffect* Effect = UGameplayEffectCache::Get().FindOrCreateEffect(FullHealSignature, FName(TEXT("FullHeal")));
 
-		Effect->Modifiers.Add(ModifierInfo);
-		
-		AbilitySystemComponent->ApplyGameplayEffectToSelf(Effect, 1, EffectContext);
+		//Spec's context defines this actor as source object
+		FGameplayEffectSpecHandle SpecHandle = EffectSpecCache.FindOrMake(AbilitySystemComponent, Effect, 1, this);
 
+		if (SpecHandle.IsValid())
+		{
+			// The cached spec is shared, the magnitude is set on a copy
+			FGameplayEffectSpec Spec(*SpecHandle.Data.Get());
+			UGameplayEffectCache::SetModifierMagnitude(Spec, UGASAttributeSet::GetHealthAttribute(), GetMaxHealth());
+			AbilitySystemComponent->ApplyGameplayEffectSpecToSelf(Spec);
+		}
 	}
 }
 
@@ -248,9 +405,14 @@ bool ACharacterBase::SetCharacterLevel(int32 newLevel)
 	// (like certain boss battles : make sure to give the player 
 	// their original level back when ending the encounter or the
 	// boss would be really unfair!)
+
+	GASDEMO_TRACE_SCOPE("SetCharacterLevel");
 	
 	if (newLevel > 0 && newLevel != CharacterLevel)
 	{
+		GASDEMO_TRACE_COUNTER_INCREMENT(GASDemo_LevelChanges);
+		GASDEMO_TRACE_BOOKMARK("SetCharacterLevel: %d -> %d", CharacterLevel, newLevel);
+
 		//Based on EPIC's ARPG demo, we're removing abilities first and adding them again
 		//to refresh attributes and stats
 		RemoveStartupGameplayAbilities();
@@ -260,6 +422,7 @@ bool ACharacterBase::SetCharacterLevel(int32 newLevel)
 		InitializeAttributes();
 		GiveDefaultAbilities();
 
+		UProgressionSaveSubsystem::MarkDirty(this, EProgressionDirty::Level | EProgressionDirty::Attributes);
 		return true;
 	}
 
@@ -274,11 +437,18 @@ bool ACharacterBase::SetCharacterLevel(int32 newLevel)
 */
 void ACharacterBase::HandleDamage(float DamageAmount, const FHitResult& HitInfo, ACharacterBase* InstigatorCharacter, AActor* DamageCauser)
 {
+	GASDEMO_ZERO_ALLOC_SCOPE("HandleDamage");
+
+	// Damage is applied on the server, samples are matched to the instigator's input by PlayerId
+	UAbilityLatencyTracker::Get().RecordDamage(InstigatorCharacter);
+
 	OnDamaged(DamageAmount, HitInfo, InstigatorCharacter, DamageCauser);
 }
 
 void ACharacterBase::HandleHealthChanged(float DamageAmount)
 {
+	GASDEMO_ZERO_ALLOC_SCOPE("HandleHealthChanged");
+
 	if (bAbilitiesInitialized)
 	{
 		OnHealthChanged(DamageAmount);
@@ -300,24 +470,6 @@ UAbilitySystemComponent* ACharacterBase::GetAbilitySystemComponent() const
 }
 
 
-FGameplayModifierInfo ACharacterBase::MakeEquipChangeModInfo(const float magnitude, FGameplayAttribute AttributeToCapture)
-{
-	/* Function MakeEquipChangeModInfo
-	* Arguments: const float magnitude - the target GameplayModifier magnitude value, FGameplayAttribute
-	* AttributeToCapture - The attribute to be affected
-	* Output: FGameplayModifierInfo to be applier on the FGameplayEffectContext to apply on the target's
-	* AbilitySystemComponent
-	*/
-
-	FGameplayModifierInfo ModifierInfo;
-
-	ModifierInfo.ModifierMagnitude = FGameplayEffectModifierMagnitude(magnitude);
-	ModifierInfo.ModifierOp = EGameplayModOp::Additive;
-	ModifierInfo.Attribute = AttributeToCapture;
-
-	return ModifierInfo;
-}
-
 void ACharacterBase::OnEquipmentChanged(UWeaponBase* Equipment, EEquipmentChangeStatus EquipActionType)
 {
 	/* Function OnEquipmentChanged
@@ -327,6 +479,9 @@ void ACharacterBase::OnEquipmentChanged(UWeaponBase* Equipment, EEquipmentChange
 	* for calculations handling on combat)
 	*/
 
+	LLM_SCOPE_BYTAG(GASDemo_Equipment);
+	GASDEMO_TRACE_SCOPE_META("OnEquipmentChanged", "%s %s", EquipActionType == EEquipmentChangeStatus::Unequip ? TEXT("Unequip") : TEXT("Equip"), *GetNameSafe(Equipment));
+
 	//Variables to capture equipment stats and apply stats changes to character
 	//For Stats like Health, Stamina, Mana (that have a separate current value for 
 	//gameplay calculations) we only affect max value.
@@ -352,6 +507,8 @@ void ACharacterBase::OnEquipmentChanged(UWeaponBase* Equipment, EEquipmentChange
 
 	if (!Equipment) return;
 
+	GASDEMO_TRACE_COUNTER_INCREMENT(GASDemo_EquipmentChanges);
+
 	int32 AttributModCoefficient = 1;
 	if (EquipActionType == EEquipmentChangeStatus::Unequip)
 		AttributModCoefficient = -1;
@@ -385,35 +542,65 @@ void ACharacterBase::OnEquipmentChanged(UWeaponBase* Equipment, EEquipmentChange
 
 	if (AbilitySystemComponent && AttributeSet)
 	{
-		FGameplayEffectContextHandle EffectContext = AbilitySystemComponent->MakeEffectContext();
-		UGameplayEffect* Effect = NewObject<UGameplayEffect>(GetTransientPackage(), FName(TEXT("EquipmentEffect")));
+		//Every equipment change modifies the same attributes, so the effect is only built once by
+		//UGameplayEffectCache and each magnitude below is sent as a SetByCaller value
+		static const FGameplayEffectModSignature EquipmentSignature = FGameplayEffectModSignature()
+			//Stats attributes modifiers
+			.Add(UGASAttributeSet::GetStrengthAttribute(), EGameplayModOp::Additive)
+			.Add(UGASAttributeSet::GetDexterityAttribute(), EGameplayModOp::Additive)
+			.Add(UGASAttributeSet::GetVitalityAttribute(), EGameplayModOp::Additive)
+			.Add(UGASAttributeSet::GetEnduranceAttribute(), EGameplayModOp::Additive)
+			.Add(UGASAttributeSet::GetIntelligenceAttribute(), EGameplayModOp::Additive)
+			.Add(UGASAttributeSet::GetMindAttribute(), EGameplayModOp::Additive)
+			.Add(UGASAttributeSet::GetAgilityAttribute(), EGameplayModOp::Additive)
+			.Add(UGASAttributeSet::GetMinWeaponDamageAttribute(), EGameplayModOp::Additive)
+			.Add(UGASAttributeSet::GetMaxWeaponDamageAttribute(), EGameplayModOp::Additive)
+			//Raw attributes modifiers
+			.Add(UGASAttributeSet::GetAttackPowerAttribute(), EGameplayModOp::Additive)
+			.Add(UGASAttributeSet::GetDefenseAttribute(), EGameplayModOp::Additive)
+			.Add(UGASAttributeSet::GetCriticalRateAttribute(), EGameplayModOp::Additive)
+			//Base attributes modifiers
+			.Add(UGASAttributeSet::GetMaxHealthAttribute(), EGameplayModOp::Additive)
+			.Add(UGASAttributeSet::GetMaxStaminaAttribute(), EGameplayModOp::Additive)
+			.Add(UGASAttributeSet::GetMaxManaAttribute(), EGameplayModOp::Additive);
+
+		UGameplayEffect* Effect = UGameplayEffectCache::Get().FindOrCreateEffect(EquipmentSignature, FName(TEXT("EquipmentEffect")));
+		FGameplayEffectSpecHandle SpecHandle = EffectSpecCache.FindOrMake(AbilitySystemComponent, Effect, 1);
+
+		if (!SpecHandle.IsValid()) return;
+
+		//Magnitudes are set on a copy, the cached spec is shared with whoever got its handle before
+		FGameplayEffectSpec Spec(*SpecHandle.Data.Get());
 
 		//Stats attributes modifiers
-		Effect->Modifiers.Add(MakeEquipChangeModInfo(Strength * AttributModCoefficient, AttributeSet->GetStrengthAttribute()));
-		Effect->Modifiers.Add(MakeEquipChangeModInfo(Dexterity * AttributModCoefficient, AttributeSet->GetDexterityAttribute()));
-		Effect->Modifiers.Add(MakeEquipChangeModInfo(Vitality * AttributModCoefficient, AttributeSet->GetVitalityAttribute()));
-		Effect->Modifiers.Add(MakeEquipChangeModInfo(Endurance * AttributModCoefficient, AttributeSet->GetEnduranceAttribute()));
-		Effect->Modifiers.Add(MakeEquipChangeModInfo(Intelligence * AttributModCoefficient, AttributeSet->GetIntelligenceAttribute()));
-		Effect->Modifiers.Add(MakeEquipChangeModInfo(Mind * AttributModCoefficient, AttributeSet->GetMindAttribute()));
-		Effect->Modifiers.Add(MakeEquipChangeModInfo(Agility * AttributModCoefficient, AttributeSet->GetAgilityAttribute()));
+		UGameplayEffectCache::SetModifierMagnitude(Spec, AttributeSet->GetStrengthAttribute(), Strength * AttributModCoefficient);
+		UGameplayEffectCache::SetModifierMagnitude(Spec, AttributeSet->GetDexterityAttribute(), Dexterity * AttributModCoefficient);
+		UGameplayEffectCache::SetModifierMagnitude(Spec, AttributeSet->GetVitalityAttribute(), Vitality * AttributModCoefficient);
+		UGameplayEffectCache::SetModifierMagnitude(Spec, AttributeSet->GetEnduranceAttribute(), Endurance * AttributModCoefficient);
+		UGameplayEffectCache::SetModifierMagnitude(Spec, AttributeSet->GetIntelligenceAttribute(), Intelligence * AttributModCoefficient);
+		UGameplayEffectCache::SetModifierMagnitude(Spec, AttributeSet->GetMindAttribute(), Mind * AttributModCoefficient);
+		UGameplayEffectCache::SetModifierMagnitude(Spec, AttributeSet->GetAgilityAttribute(), Agility * AttributModCoefficient);
 
-		Effect->Modifiers.Add(MakeEquipChangeModInfo(MinWeaponDamage * AttributModCoefficient, AttributeSet->GetMinWeaponDamageAttribute()));
-		Effect->Modifiers.Add(MakeEquipChangeModInfo(MaxWeaponDamage * AttributModCoefficient, AttributeSet->GetMaxWeaponDamageAttribute()));
+		UGameplayEffectCache::SetModifierMagnitude(Spec, AttributeSet->GetMinWeaponDamageAttribute(), MinWeaponDamage * AttributModCoefficient);
+		UGameplayEffectCache::SetModifierMagnitude(Spec, AttributeSet->GetMaxWeaponDamageAttribute(), MaxWeaponDamage * AttributModCoefficient);
 
 		//Raw attributes modifiers: these can be increased through equipment directly but also calculated
 		//based on current stats
-		Effect->Modifiers.Add(MakeEquipChangeModInfo(AttackPower * AttributModCoefficient, AttributeSet->GetAttackPowerAttribute()));
-		Effect->Modifiers.Add(MakeEquipChangeModInfo(Defense * AttributModCoefficient, AttributeSet->GetDefenseAttribute()));
-		Effect->Modifiers.Add(MakeEquipChangeModInfo(CriticalRate * AttributModCoefficient, AttributeSet->GetCriticalRateAttribute()));
+		UGameplayEffectCache::SetModifierMagnitude(Spec, AttributeSet->GetAttackPowerAttribute(), AttackPower * AttributModCoefficient);
+		UGameplayEffectCache::SetModifierMagnitude(Spec, AttributeSet->GetDefenseAttribute(), Defense * AttributModCoefficient);
+		UGameplayEffectCache::SetModifierMagnitude(Spec, AttributeSet->GetCriticalRateAttribute(), CriticalRate * AttributModCoefficient);
 
 		//Base attributes modifiers: these can be increased through equipment directly but also calculated
 		//based on current stats
-		Effect->Modifiers.Add(MakeEquipChangeModInfo(Health * AttributModCoefficient, AttributeSet->GetMaxHealthAttribute()));
-		Effect->Modifiers.Add(MakeEquipChangeModInfo(Stamina * AttributModCoefficient, AttributeSet->GetMaxStaminaAttribute()));
-		Effect->Modifiers.Add(MakeEquipChangeModInfo(Mana * AttributModCoefficient, AttributeSet->GetMaxManaAttribute()));
+		UGameplayEffectCache::SetModifierMagnitude(Spec, AttributeSet->GetMaxHealthAttribute(), Health * AttributModCoefficient);
+		UGameplayEffectCache::SetModifierMagnitude(Spec, AttributeSet->GetMaxStaminaAttribute(), Stamina * AttributModCoefficient);
+		UGameplayEffectCache::SetModifierMagnitude(Spec, AttributeSet->GetMaxManaAttribute(), Mana * AttributModCoefficient);
+
+		//When done with setting all modifiers for all attributes, apply effect to self
+		AbilitySystemComponent->ApplyGameplayEffectSpecToSelf(Spec);
 
-		//When done with creating all modifiers for all attributes, apply effect to self
-		AbilitySystemComponent->ApplyGameplayEffectToSelf(Effect, 1, EffectContext);
+		//Equipment bonuses are part of the attribute base values we autosave
+		UProgressionSaveSubsystem::MarkDirty(this, EProgressionDirty::Attributes);
 	}
 }
 
@@ -460,6 +647,16 @@ void ACharacterBase::SetupPlayerInputComponent(class UInputComponent* PlayerInpu
 	// handle touch devices
 	PlayerInputComponent->BindTouch(IE_Pressed, this, &ACharacterBase::TouchStarted);
 	PlayerInputComponent->BindTouch(IE_Released, this, &ACharacterBase::TouchStopped);
+
+	// Timestamp ability inputs (Blueprint input events and ability input binds) for latency measurement,
+	// these bindings don't consume the input so the actual handlers still run
+	for (const FName& ActionName : UAbilityLatencyTracker::Get().GetTrackedInputActions())
+	{
+		FInputActionBinding LatencyBinding(ActionName, IE_Pressed);
+		LatencyBinding.bConsumeInput = false;
+		LatencyBinding.ActionDelegate.GetDelegateForManualSet().BindUObject(this, &ACharacterBase::OnTrackedInputPressed, ActionName);
+		PlayerInputComponent->AddActionBinding(LatencyBinding);
+	}
 }
 
 void ACharacterBase::TouchStarted(ETouchIndex::Type FingerIndex, FVector Location)
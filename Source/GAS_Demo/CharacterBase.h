@@ -10,6 +10,8 @@
 #include "WeaponBase.h"
 #include "DataTypes.h"
 #include "GameplayEffect.h"
+#include "GameplayEffectCache.h"
+#include "GameplayTagBitset.h"
 #include "CharacterBase.generated.h"
 
 UCLASS(config = Game)
@@ -42,7 +44,7 @@ class GAS_DEMO_API ACharacterBase : public ACharacter, public IAbilitySystemInte
 
 	/** AbilitySystemComponent */
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = Abilities, meta = (AllowPrivateAccess = "true"))
-	UAbilitySystemComponent* AbilitySystemComponent;
+	class UBaseAbilitySystemComponent* AbilitySystemComponent;
 
 	/** Sample Attribute Set */
 	UPROPERTY()
@@ -61,8 +63,44 @@ public:
 	virtual UAbilitySystemComponent* GetAbilitySystemComponent() const override;
 	//~ End IAbilitySystemInterface
 
+	/** Significance bucket of this character, updated by UCharacterSignificanceSubsystem */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Significance)
+	ECharacterSignificance SignificanceBucket;
+
+	/** Last time (world seconds) a cosmetic GameplayCue was executed on this character, used for cue throttling */
+	float LastCosmeticCueTime;
+
+	virtual void Tick(float DeltaSeconds) override;
+
+	/** Bitset mirror of the tags owned by our AbilitySystemComponent (parents included), for FCompiledTagQuery checks */
+	const FGameplayTagBitset& GetOwnedTagBits() const { return OwnedTagBits; }
+
 protected:
 	virtual void BeginPlay();
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Subsystem handling this character's update rate, cached on BeginPlay */
+	UPROPERTY(Transient)
+	class UCharacterSignificanceSubsystem* SignificanceSubsystem;
+
+	/** Keeps OwnedTagBits in sync, bound to the ASC generic tag event (fired for each tag and parent whose count goes from/to 0) */
+	void OnOwnedTagCountChanged(const FGameplayTag Tag, int32 NewCount);
+
+	/** Owned tags as bits, see GetOwnedTagBits */
+	FGameplayTagBitset OwnedTagBits;
+
+	/** Handle of the OnOwnedTagCountChanged binding */
+	FDelegateHandle OwnedTagChangedHandle;
+
+	/** Timestamps a tracked input action for UAbilityLatencyTracker (bound without consuming the input) */
+	void OnTrackedInputPressed(FName ActionName);
+
+	/** Forwards ability activations of the locally controlled character to UAbilityLatencyTracker */
+	void OnAbilityActivatedForLatency(UGameplayAbility* Ability);
+
+	/** Forwards montage starts of the locally controlled character to UAbilityLatencyTracker */
+	UFUNCTION()
+	void OnMontageStartedForLatency(UAnimMontage* Montage);
 
 	/** Called for forwards/backward input */
 	void MoveForward(float Value);
@@ -88,11 +126,6 @@ protected:
 	/** Handler for when a touch input stops. */
 	void TouchStopped(ETouchIndex::Type FingerIndex, FVector Location);
 
-	/** Utility function to create FGameplayModifierInfo for used with GameplayEffect
-	* For use with OnEquipmentChanged, should NOT be called in blureprint
-	*/
-	FGameplayModifierInfo MakeEquipChangeModInfo(const float magniture, FGameplayAttribute AttributeToCapture);
-
 	/** Utility function to check if the character is alive */
 	UFUNCTION(BlueprintCallable)
 	bool IsAlive();
@@ -103,6 +136,9 @@ protected:
 	/** Character's level */
 	int32 CharacterLevel;
 
+	/** Prebuilt specs for the effects this character applies to itself (attributes init, reset and equipment) */
+	FGameplayEffectSpecCache EffectSpecCache;
+
 protected:
 	// APawn interface
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
@@ -119,6 +155,7 @@ public:
 	void OnEquipmentChanged(UWeaponBase* Equipment, EEquipmentChangeStatus EquipActionType);
 
 	virtual void PossessedBy(AController* NewController) override;
+	virtual void UnPossessed() override;
 	virtual void InitializeAttributes();
 	virtual void GiveDefaultAbilities();
 
@@ -206,6 +243,14 @@ public:
 	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = Abilities)
 	TSubclassOf<class UGameplayEffect> DefaultAttributeEffect;
 
+	/** Stamina regenerated per second by URegenerationSubsystem (paused by Character.Attribute.Stamina.PauseRecharge) */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = Regeneration)
+	float StaminaRegenRate;
+
+	/** Mana regenerated per second by URegenerationSubsystem */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = Regeneration)
+	float ManaRegenRate;
+
 	/** Container for the default abilities to be granted to the character at the start of game execution */
 	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = Abilities)
 	TArray<TSubclassOf<class UGameplayAbility>> DefaultAbilities;
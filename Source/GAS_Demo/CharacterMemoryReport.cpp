@@ -0,0 +1,150 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+
+#include "CharacterMemoryReport.h"
+#include "CharacterBase.h"
+#include "EquipmentComponent.h"
+#include "AbilitySystemComponent.h"
+#include "Abilities/GameplayAbility.h"
+#include "AttributeSet.h"
+#include "Camera/CameraComponent.h"
+#include "GameFramework/SpringArmComponent.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "Serialization/ArchiveCountMem.h"
+
+LLM_DEFINE_TAG(GASDemo_Character);
+LLM_DEFINE_TAG(GASDemo_Camera);
+LLM_DEFINE_TAG(GASDemo_AbilitySystem);
+LLM_DEFINE_TAG(GASDemo_Effects);
+LLM_DEFINE_TAG(GASDemo_Equipment);
+LLM_DEFINE_TAG(GASDemo_Inventory);
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CVarMemoryCharacters(
+	TEXT("GAS.Memory.Characters"),
+	TEXT("Prints the memory held by every character of the world, split by system (actor, camera, ASC, ability instances, attribute sets, equipment, other components)."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		if (!World) return;
+
+		FCharacterMemoryBreakdown Total;
+		int32 NumCharacters = 0;
+		for (TActorIterator<ACharacterBase> It(World); It; ++It)
+		{
+			const FCharacterMemoryBreakdown Breakdown = FCharacterMemoryBreakdown::Measure(*It);
+			Breakdown.Log(Ar, *It->GetName());
+
+			Total += Breakdown;
+			NumCharacters++;
+		}
+
+		if (NumCharacters == 0)
+		{
+			Ar.Log(TEXT("No character in this world"));
+			return;
+		}
+
+		Total.Log(Ar, *FString::Printf(TEXT("Total (%d characters)"), NumCharacters));
+		Total.Log(Ar, TEXT("Average per character"), NumCharacters);
+		Ar.Log(TEXT("Run with -llm and use 'stat LLMFULL' to see the GASDemo/* allocation tags"));
+	}));
+
+/** Memory held by Object and what its serialized properties allocate */
+static SIZE_T GetObjectBytes(const UObject* Object)
+{
+	if (!Object) return 0;
+
+	FArchiveCountMem CountMem(const_cast<UObject*>(Object));
+	return CountMem.GetMax();
+}
+
+FCharacterMemoryBreakdown FCharacterMemoryBreakdown::Measure(const ACharacterBase* Character)
+{
+	/* Function Measure
+	* Arguments: const ACharacterBase* Character - character to measure
+	* Output: the memory held by each of its systems (empty breakdown for a null character)
+	*/
+
+	FCharacterMemoryBreakdown Breakdown;
+	if (!Character) return Breakdown;
+
+	Breakdown.Actor = GetObjectBytes(Character);
+
+	const UAbilitySystemComponent* AbilitySystemComponent = Character->GetAbilitySystemComponent();
+
+	TInlineComponentArray<UActorComponent*> Components(Character);
+	for (const UActorComponent* Component : Components)
+	{
+		const SIZE_T Bytes = GetObjectBytes(Component);
+
+		if (Component == Character->GetCameraBoom() || Component == Character->GetFollowCamera())
+			Breakdown.Camera += Bytes;
+		else if (Component == AbilitySystemComponent)
+			Breakdown.AbilitySystem += Bytes;
+		else if (Component->IsA<UEquipmentComponent>())
+			Breakdown.Equipment += Bytes;
+		else
+			Breakdown.OtherComponents += Bytes;
+	}
+
+	if (!AbilitySystemComponent) return Breakdown;
+
+	for (const UAttributeSet* AttributeSet : AbilitySystemComponent->GetSpawnedAttributes())
+	{
+		Breakdown.AttributeSets += GetObjectBytes(AttributeSet);
+	}
+
+	//Specs live in the ASC (already counted there), their instances are separate objects
+	const TArray<FGameplayAbilitySpec>& Specs = AbilitySystemComponent->GetActivatableAbilities();
+	Breakdown.NumAbilitySpecs = Specs.Num();
+	Breakdown.AbilitySpecs = Specs.GetAllocatedSize();
+	for (const FGameplayAbilitySpec& Spec : Specs)
+	{
+		Breakdown.AbilitySpecs += Spec.ReplicatedInstances.GetAllocatedSize() + Spec.NonReplicatedInstances.GetAllocatedSize();
+
+		for (const UGameplayAbility* Instance : Spec.GetAbilityInstances())
+		{
+			Breakdown.AbilityInstances += GetObjectBytes(Instance);
+		}
+	}
+
+	const TArray<FActiveGameplayEffectHandle> EffectHandles = AbilitySystemComponent->GetActiveEffects(FGameplayEffectQuery());
+	Breakdown.NumActiveEffects = EffectHandles.Num();
+	for (const FActiveGameplayEffectHandle& Handle : EffectHandles)
+	{
+		if (const FActiveGameplayEffect* Effect = AbilitySystemComponent->GetActiveGameplayEffect(Handle))
+		{
+			Breakdown.ActiveEffects += sizeof(FActiveGameplayEffect) + Effect->Spec.Modifiers.GetAllocatedSize()
+				+ Effect->Spec.SetByCallerNameMagnitudes.GetAllocatedSize() + Effect->Spec.SetByCallerTagMagnitudes.GetAllocatedSize();
+		}
+	}
+
+	return Breakdown;
+}
+
+FCharacterMemoryBreakdown& FCharacterMemoryBreakdown::operator+=(const FCharacterMemoryBreakdown& Other)
+{
+	Actor += Other.Actor;
+	Camera += Other.Camera;
+	AbilitySystem += Other.AbilitySystem;
+	AbilityInstances += Other.AbilityInstances;
+	AttributeSets += Other.AttributeSets;
+	Equipment += Other.Equipment;
+	OtherComponents += Other.OtherComponents;
+	ActiveEffects += Other.ActiveEffects;
+	NumActiveEffects += Other.NumActiveEffects;
+	AbilitySpecs += Other.AbilitySpecs;
+	NumAbilitySpecs += Other.NumAbilitySpecs;
+	return *this;
+}
+
+void FCharacterMemoryBreakdown::Log(FOutputDevice& Ar, const TCHAR* Label, int32 Divisor) const
+{
+	const double Scale = 1.0 / (1024.0 * FMath::Max(1, Divisor));
+
+	Ar.Logf(TEXT("%s: %.1fKB | actor %.1fKB | camera %.1fKB | ASC %.1fKB (%.1f effects: %.1fKB, %.1f specs: %.1fKB) | ability instances %.1fKB | attribute sets %.1fKB | equipment %.1fKB | other components %.1fKB"),
+		Label, GetTotal() * Scale, Actor * Scale, Camera * Scale, AbilitySystem * Scale,
+		(double)NumActiveEffects / FMath::Max(1, Divisor), ActiveEffects * Scale, (double)NumAbilitySpecs / FMath::Max(1, Divisor), AbilitySpecs * Scale,
+		AbilityInstances * Scale, AttributeSets * Scale, Equipment * Scale, OtherComponents * Scale);
+}
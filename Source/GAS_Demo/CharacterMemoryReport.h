@@ -0,0 +1,63 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+
+class ACharacterBase;
+
+/*
+* Low Level Memory tracker tags of the character systems (run with -llm, see them with stat LLMFULL or in Insights).
+* Allocations are tagged where each system allocates: the character constructor (Character, Camera, AbilitySystem),
+* granting abilities (AbilitySystem), applying effects (Effects), equipping (Equipment) and inventory changes (Inventory).
+* Components added by Blueprint construction scripts are tagged by whoever spawns the character.
+*
+* The constructor scope doesn't cover the character object itself: NewObject allocates it before the constructor runs,
+* so it lands in the tag active around SpawnActor. Code that wants the whole character under GASDemo_Character tags the
+* spawn (as the GASDemo.Memory.CharacterSpawn automation test does).
+*/
+LLM_DECLARE_TAG_API(GASDemo_Character, GAS_DEMO_API);
+LLM_DECLARE_TAG_API(GASDemo_Camera, GAS_DEMO_API);
+LLM_DECLARE_TAG_API(GASDemo_AbilitySystem, GAS_DEMO_API);
+LLM_DECLARE_TAG_API(GASDemo_Effects, GAS_DEMO_API);
+LLM_DECLARE_TAG_API(GASDemo_Equipment, GAS_DEMO_API);
+LLM_DECLARE_TAG_API(GASDemo_Inventory, GAS_DEMO_API);
+
+/**
+* Memory held by one character (or the sum of several), split by system.
+* UObjects are measured with FArchiveCountMem: the object itself plus what its serialized properties allocate
+* (arrays, maps, strings...), native only members aren't seen. Shared data (weapons, effect definitions, meshes) isn't counted.
+*
+* Use GAS.Memory.Characters to print it for every character of the world. The memory bound of spawning characters is
+* checked on the GASDemo_* tags by the GASDemo.Memory.CharacterSpawn automation test.
+*/
+struct GAS_DEMO_API FCharacterMemoryBreakdown
+{
+	/** Measures Character, its components, attribute sets and ability instances */
+	static FCharacterMemoryBreakdown Measure(const ACharacterBase* Character);
+
+	/** Total of the top level systems (effects and specs are part of AbilitySystem) */
+	SIZE_T GetTotal() const { return Actor + Camera + AbilitySystem + AbilityInstances + AttributeSets + Equipment + OtherComponents; }
+
+	FCharacterMemoryBreakdown& operator+=(const FCharacterMemoryBreakdown& Other);
+
+	/** Prints the breakdown on one line, divided by Divisor (to print averages) */
+	void Log(FOutputDevice& Ar, const TCHAR* Label, int32 Divisor = 1) const;
+
+	SIZE_T Actor = 0;
+	SIZE_T Camera = 0;
+	SIZE_T AbilitySystem = 0;
+	SIZE_T AbilityInstances = 0;
+	SIZE_T AttributeSets = 0;
+	SIZE_T Equipment = 0;
+	SIZE_T OtherComponents = 0;
+
+	/** Active effects held by the ASC (estimated from their spec arrays) */
+	SIZE_T ActiveEffects = 0;
+	int32 NumActiveEffects = 0;
+
+	/** Ability specs held by the ASC */
+	SIZE_T AbilitySpecs = 0;
+	int32 NumAbilitySpecs = 0;
+};
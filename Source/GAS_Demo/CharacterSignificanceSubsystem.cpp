@@ -0,0 +1,290 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+
+#include "CharacterSignificanceSubsystem.h"
+#include "CharacterBase.h"
+#include "AbilitySystemComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+const FName UCharacterSignificanceSubsystem::SignificanceTag = FName(TEXT("GAS.Character"));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CVarSignificanceStats(
+	TEXT("GAS.Significance.Stats"),
+	TEXT("Prints the number of characters in each significance bucket and the estimated frame time saved. Use 'GAS.Significance.Stats reset' to clear counters."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		UCharacterSignificanceSubsystem* Subsystem = World ? World->GetSubsystem<UCharacterSignificanceSubsystem>() : nullptr;
+		if (!Subsystem)
+		{
+			Ar.Log(TEXT("No CharacterSignificanceSubsystem in this world"));
+			return;
+		}
+
+		if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+		{
+			Subsystem->ResetStats();
+			return;
+		}
+
+		Subsystem->DumpStats(Ar);
+	}));
+
+UCharacterSignificanceSubsystem::UCharacterSignificanceSubsystem()
+{
+	//Default values, can be overriden in DefaultGame.ini under [/Script/GAS_Demo.CharacterSignificanceSubsystem]
+	HighSignificanceDistance = 2000.f;
+	MediumSignificanceDistance = 5000.f;
+	CullDistance = 12000.f;
+	VisibilityGracePeriod = 0.5f;
+
+	HighSettings.TickInterval = 0.f;
+
+	MediumSettings.TickInterval = 1.f / 30.f;
+	MediumSettings.MinCosmeticCueInterval = 0.1f;
+
+	LowSettings.TickInterval = 1.f / 10.f;
+	LowSettings.MinCosmeticCueInterval = 0.5f;
+
+	CulledSettings.TickInterval = 0.5f;
+	CulledSettings.bSuppressCosmeticCues = true;
+
+	FMemory::Memzero(BucketPopulation);
+	StatFrames = 0;
+	ExpectedCharacterTicks = 0;
+	CharacterTicks = 0;
+	CharacterTickCycles = 0;
+	SuppressedCues = 0;
+}
+
+bool UCharacterSignificanceSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	//Significance only makes sense for game worlds that have a viewer
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && !IsRunningDedicatedServer() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UCharacterSignificanceSubsystem::Deinitialize()
+{
+	if (USignificanceManager* SignificanceManager = USignificanceManager::Get(GetWorld()))
+	{
+		SignificanceManager->UnregisterAll(SignificanceTag);
+	}
+
+	RegisteredCharacters.Reset();
+
+	Super::Deinitialize();
+}
+
+void UCharacterSignificanceSubsystem::RegisterCharacter(ACharacterBase* Character)
+{
+	/* Function RegisterCharacter
+	* Arguments: ACharacterBase Character - character to track
+	* Output: none (Character will be bucketed on the next significance update)
+	*/
+
+	USignificanceManager* SignificanceManager = USignificanceManager::Get(GetWorld());
+	if (!Character || !SignificanceManager) return;
+
+	SignificanceManager->RegisterObject(Character, SignificanceTag,
+		[this](USignificanceManager::FManagedObjectInfo* ObjectInfo, const FTransform& Viewpoint)
+		{
+			return CalculateSignificance(ObjectInfo, Viewpoint);
+		},
+		USignificanceManager::EPostSignificanceType::Sequential,
+		[this](USignificanceManager::FManagedObjectInfo* ObjectInfo, float OldSignificance, float Significance, bool bFinal)
+		{
+			PostSignificanceUpdate(ObjectInfo, OldSignificance, Significance, bFinal);
+		});
+
+	//Characters start at full rate until the first update says otherwise
+	Character->SignificanceBucket = ECharacterSignificance::High;
+	BucketPopulation[(uint8)ECharacterSignificance::High]++;
+	RegisteredCharacters.Add(Character);
+}
+
+void UCharacterSignificanceSubsystem::UnregisterCharacter(ACharacterBase* Character)
+{
+	/* Function UnregisterCharacter
+	* Arguments: ACharacterBase Character - character to stop tracking
+	* Output: none
+	*/
+
+	if (!Character || RegisteredCharacters.RemoveSwap(Character) == 0) return;
+
+	BucketPopulation[(uint8)Character->SignificanceBucket]--;
+
+	if (USignificanceManager* SignificanceManager = USignificanceManager::Get(GetWorld()))
+	{
+		SignificanceManager->UnregisterObject(Character);
+	}
+}
+
+void UCharacterSignificanceSubsystem::Tick(float DeltaTime)
+{
+	USignificanceManager* SignificanceManager = USignificanceManager::Get(GetWorld());
+	if (!SignificanceManager || RegisteredCharacters.Num() == 0) return;
+
+	//Gather the viewpoints of every local player (split-screen can have more than one)
+	Viewpoints.Reset();
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		APlayerController* PlayerController = It->Get();
+		if (PlayerController && PlayerController->IsLocalController())
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+			Viewpoints.Emplace(ViewRotation, ViewLocation);
+		}
+	}
+
+	if (Viewpoints.Num() > 0)
+	{
+		SignificanceManager->Update(Viewpoints);
+	}
+
+	//Every registered character would tick once per frame at full rate
+	StatFrames++;
+	ExpectedCharacterTicks += RegisteredCharacters.Num();
+}
+
+TStatId UCharacterSignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCharacterSignificanceSubsystem, STATGROUP_Tickables);
+}
+
+float UCharacterSignificanceSubsystem::CalculateSignificance(USignificanceManager::FManagedObjectInfo* ObjectInfo, const FTransform& Viewpoint) const
+{
+	/* Function CalculateSignificance
+	* Arguments: FManagedObjectInfo ObjectInfo - registered character, FTransform Viewpoint - one of the local viewpoints
+	* Output: ECharacterSignificance value as float, the SignificanceManager keeps the highest one over all viewpoints
+	*/
+
+	const ACharacterBase* Character = Cast<ACharacterBase>(ObjectInfo->GetObject());
+	if (!Character) return (float)ECharacterSignificance::Culled;
+
+	//Our own characters are always updated at full rate
+	if (Character->IsLocallyControlled()) return (float)ECharacterSignificance::High;
+
+	const float DistanceSquared = FVector::DistSquared(Character->GetActorLocation(), Viewpoint.GetLocation());
+	if (DistanceSquared > FMath::Square(CullDistance)) return (float)ECharacterSignificance::Culled;
+
+	//Characters that are not on screen can't be more than Low significance
+	if (!Character->WasRecentlyRendered(VisibilityGracePeriod)) return (float)ECharacterSignificance::Low;
+
+	if (DistanceSquared <= FMath::Square(HighSignificanceDistance)) return (float)ECharacterSignificance::High;
+	if (DistanceSquared <= FMath::Square(MediumSignificanceDistance)) return (float)ECharacterSignificance::Medium;
+
+	return (float)ECharacterSignificance::Low;
+}
+
+void UCharacterSignificanceSubsystem::PostSignificanceUpdate(USignificanceManager::FManagedObjectInfo* ObjectInfo, float OldSignificance, float Significance, bool bFinal)
+{
+	ACharacterBase* Character = Cast<ACharacterBase>(ObjectInfo->GetObject());
+	if (!Character) return;
+
+	const ECharacterSignificance NewBucket = (ECharacterSignificance)FMath::Clamp(FMath::RoundToInt(Significance), 0, 3);
+	if (NewBucket == Character->SignificanceBucket) return;
+
+	BucketPopulation[(uint8)Character->SignificanceBucket]--;
+	BucketPopulation[(uint8)NewBucket]++;
+
+	Character->SignificanceBucket = NewBucket;
+	ApplyBucket(Character, NewBucket);
+}
+
+void UCharacterSignificanceSubsystem::ApplyBucket(ACharacterBase* Character, ECharacterSignificance Bucket) const
+{
+	/* Function ApplyBucket
+	* Arguments: ACharacterBase Character - character to update, ECharacterSignificance Bucket - its new bucket
+	* Output: none (scales down the tick rate of a simulated character and its most expensive components)
+	*/
+
+	//Only simulated proxies are throttled: on the authority (listen server, standalone) and the owning client
+	//these ticks drive gameplay (ability tasks, montage notifies, regeneration, movement) and must stay at full rate.
+	//Cosmetic GameplayCues are still throttled by bucket for every character, see UGASGameplayCueManager
+	if (Character->GetLocalRole() != ROLE_SimulatedProxy) return;
+
+	const float TickInterval = GetBucketSettings(Bucket).TickInterval;
+
+	Character->SetActorTickInterval(TickInterval);
+
+	if (USkeletalMeshComponent* Mesh = Character->GetMesh())
+	{
+		Mesh->SetComponentTickInterval(TickInterval);
+	}
+
+	if (UAbilitySystemComponent* AbilitySystemComponent = Character->GetAbilitySystemComponent())
+	{
+		AbilitySystemComponent->SetComponentTickInterval(TickInterval);
+	}
+
+	if (UCharacterMovementComponent* Movement = Character->GetCharacterMovement())
+	{
+		Movement->SetComponentTickInterval(TickInterval);
+	}
+}
+
+const FSignificanceBucketSettings& UCharacterSignificanceSubsystem::GetBucketSettings(ECharacterSignificance Bucket) const
+{
+	switch (Bucket)
+	{
+	case ECharacterSignificance::High:
+		return HighSettings;
+	case ECharacterSignificance::Medium:
+		return MediumSettings;
+	case ECharacterSignificance::Low:
+		return LowSettings;
+	default:
+		return CulledSettings;
+	}
+}
+
+void UCharacterSignificanceSubsystem::RecordCharacterTick(uint64 Cycles)
+{
+	CharacterTicks++;
+	CharacterTickCycles += Cycles;
+}
+
+void UCharacterSignificanceSubsystem::DumpStats(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("Character significance: %d registered"), RegisteredCharacters.Num());
+
+	const TCHAR* BucketNames[] = { TEXT("Culled"), TEXT("Low"), TEXT("Medium"), TEXT("High") };
+	for (int32 Index = 3; Index >= 0; --Index)
+	{
+		const FSignificanceBucketSettings& Settings = GetBucketSettings((ECharacterSignificance)Index);
+		Ar.Logf(TEXT("  %-6s: %5d characters (tick interval %.3fs, cue interval %.2fs%s)"),
+			BucketNames[Index], BucketPopulation[Index], Settings.TickInterval, Settings.MinCosmeticCueInterval,
+			Settings.bSuppressCosmeticCues ? TEXT(", cues suppressed") : TEXT(""));
+	}
+
+	if (StatFrames == 0 || CharacterTicks == 0)
+	{
+		Ar.Log(TEXT("  No frames recorded yet"));
+		return;
+	}
+
+	//Saved time is estimated as the actor ticks that were skipped times the measured average actor tick cost
+	const double AverageTickMs = FPlatformTime::ToMilliseconds64(CharacterTickCycles) / (double)CharacterTicks;
+	const uint64 SkippedTicks = ExpectedCharacterTicks > CharacterTicks ? ExpectedCharacterTicks - CharacterTicks : 0;
+	const double SavedMsPerFrame = (double)SkippedTicks * AverageTickMs / (double)StatFrames;
+
+	Ar.Logf(TEXT("  Frames: %llu, actor ticks: %llu of %llu (%.1f%% skipped)"),
+		StatFrames, CharacterTicks, ExpectedCharacterTicks, 100.0 * (double)SkippedTicks / (double)ExpectedCharacterTicks);
+	Ar.Logf(TEXT("  Avg actor tick: %.4fms, estimated time saved: %.3fms/frame"), AverageTickMs, SavedMsPerFrame);
+	Ar.Logf(TEXT("  Cosmetic cues throttled: %llu"), SuppressedCues);
+}
+
+void UCharacterSignificanceSubsystem::ResetStats()
+{
+	StatFrames = 0;
+	ExpectedCharacterTicks = 0;
+	CharacterTicks = 0;
+	CharacterTickCycles = 0;
+	SuppressedCues = 0;
+}
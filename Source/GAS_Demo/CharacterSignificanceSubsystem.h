@@ -0,0 +1,143 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SignificanceManager.h"
+#include "DataTypes.h"
+#include "CharacterSignificanceSubsystem.generated.h"
+
+class ACharacterBase;
+
+/** Update settings applied to a character while it is in a given significance bucket */
+USTRUCT(BlueprintType)
+struct FSignificanceBucketSettings
+{
+	GENERATED_BODY()
+
+public:
+	/** Tick interval for the character, its mesh and its AbilitySystemComponent (0 = every frame) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	float TickInterval = 0.f;
+
+	/** Min time between two cosmetic (Executed) GameplayCues on the same character (0 = no throttling) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	float MinCosmeticCueInterval = 0.f;
+
+	/** If true Executed GameplayCues are skipped entirely on characters in this bucket */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	bool bSuppressCosmeticCues = false;
+};
+
+UCLASS(config = Game)
+class GAS_DEMO_API UCharacterSignificanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+/*
+* Class UCharacterSignificanceSubsystem
+* Registers every ACharacterBase with the SignificanceManager plugin and buckets them by distance
+* to the local viewpoints and by visibility (see ECharacterSignificance).
+* Once a character changes bucket, cosmetic GameplayCues on it are throttled (see UGASGameplayCueManager) and,
+* for simulated proxies only, its update rate is scaled down through FSignificanceBucketSettings
+* (actor, mesh, movement and AbilitySystemComponent tick intervals). Characters simulated locally (authority or
+* autonomous) keep full rate ticks, their gameplay timing must not depend on where the camera is.
+*
+* Use the console command GAS.Significance.Stats to check bucket populations and frame time saved.
+*/
+
+public:
+	UCharacterSignificanceSubsystem();
+
+	//~ Begin USubsystem
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Deinitialize() override;
+	//~ End USubsystem
+
+	//~ Begin FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject
+
+	/** Starts tracking Character's significance, called on the character's BeginPlay */
+	void RegisterCharacter(ACharacterBase* Character);
+
+	/** Stops tracking Character's significance, called on the character's EndPlay */
+	void UnregisterCharacter(ACharacterBase* Character);
+
+	/** Returns the settings used for the given bucket */
+	const FSignificanceBucketSettings& GetBucketSettings(ECharacterSignificance Bucket) const;
+
+	/** Used by ACharacterBase::Tick to measure how much an actor tick costs */
+	void RecordCharacterTick(uint64 Cycles);
+
+	/** Used by UGASGameplayCueManager when a cosmetic cue was throttled */
+	void RecordSuppressedCue() { ++SuppressedCues; }
+
+	/** Prints bucket populations and time saved to the output device */
+	void DumpStats(FOutputDevice& Ar) const;
+
+	/** Clears the counters shown in DumpStats */
+	void ResetStats();
+
+	/** Tag used to register characters in the SignificanceManager */
+	static const FName SignificanceTag;
+
+protected:
+
+	/** Significance function, returns the bucket (as float) of the character seen from Viewpoint */
+	float CalculateSignificance(USignificanceManager::FManagedObjectInfo* ObjectInfo, const FTransform& Viewpoint) const;
+
+	/** Post significance function, applies the new bucket settings if the bucket changed */
+	void PostSignificanceUpdate(USignificanceManager::FManagedObjectInfo* ObjectInfo, float OldSignificance, float Significance, bool bFinal);
+
+	/** Applies Bucket's tick intervals to Character and its components (simulated proxies only) */
+	void ApplyBucket(ACharacterBase* Character, ECharacterSignificance Bucket) const;
+
+	/** Distance (in cm) under which visible characters are considered High significance */
+	UPROPERTY(Config)
+	float HighSignificanceDistance;
+
+	/** Distance (in cm) under which visible characters are considered Medium significance */
+	UPROPERTY(Config)
+	float MediumSignificanceDistance;
+
+	/** Distance (in cm) beyond which characters are Culled, even if visible */
+	UPROPERTY(Config)
+	float CullDistance;
+
+	/** Time (in seconds) a character is still considered visible after it was last rendered */
+	UPROPERTY(Config)
+	float VisibilityGracePeriod;
+
+	UPROPERTY(Config)
+	FSignificanceBucketSettings HighSettings;
+
+	UPROPERTY(Config)
+	FSignificanceBucketSettings MediumSettings;
+
+	UPROPERTY(Config)
+	FSignificanceBucketSettings LowSettings;
+
+	UPROPERTY(Config)
+	FSignificanceBucketSettings CulledSettings;
+
+private:
+
+	/** Reused every frame to avoid reallocating the viewpoints */
+	TArray<FTransform> Viewpoints;
+
+	/** Characters currently registered */
+	TArray<TWeakObjectPtr<ACharacterBase>> RegisteredCharacters;
+
+	/** Number of characters in each bucket, indexed by ECharacterSignificance */
+	int32 BucketPopulation[4];
+
+	//Stats counters, see DumpStats
+	uint64 StatFrames;
+	uint64 ExpectedCharacterTicks;
+	uint64 CharacterTicks;
+	uint64 CharacterTickCycles;
+	uint64 SuppressedCues;
+};
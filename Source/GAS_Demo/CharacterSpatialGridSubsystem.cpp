@@ -0,0 +1,323 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+
+#include "CharacterSpatialGridSubsystem.h"
+#include "CharacterBase.h"
+#include "GenericTeamAgentInterface.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CVarSpatialStats(
+	TEXT("GAS.Spatial.Stats"),
+	TEXT("Prints character spatial grid stats. Use 'GAS.Spatial.Stats reset' to clear counters."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		UCharacterSpatialGridSubsystem* Subsystem = World ? World->GetSubsystem<UCharacterSpatialGridSubsystem>() : nullptr;
+		if (!Subsystem)
+		{
+			Ar.Log(TEXT("No CharacterSpatialGridSubsystem in this world"));
+			return;
+		}
+
+		if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+		{
+			Subsystem->ResetStats();
+			return;
+		}
+
+		Subsystem->DumpStats(Ar);
+	}));
+
+/** Team of Character, cached in its grid entry: call RefreshCharacterTeam when it may have changed */
+static uint8 GetCharacterTeam(const ACharacterBase* Character)
+{
+	//Player controllers don't usually implement the team interface, the character can
+	if (const IGenericTeamAgentInterface* TeamAgent = Cast<const IGenericTeamAgentInterface>(Character))
+		return TeamAgent->GetGenericTeamId().GetId();
+
+	if (const IGenericTeamAgentInterface* TeamAgent = Cast<const IGenericTeamAgentInterface>(Character->GetController()))
+		return TeamAgent->GetGenericTeamId().GetId();
+
+	return FGenericTeamId::NoTeam.GetId();
+}
+
+UCharacterSpatialGridSubsystem::UCharacterSpatialGridSubsystem()
+{
+	//Default values, can be overriden in DefaultGame.ini under [/Script/GAS_Demo.CharacterSpatialGridSubsystem]
+	CellSize = 1000.f;
+
+	InvCellSize = 1.f / CellSize;
+	StatQueries = 0;
+	StatCandidates = 0;
+	StatFrames = 0;
+	StatCellChanges = 0;
+	StatUpdateCycles = 0;
+}
+
+bool UCharacterSpatialGridSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UCharacterSpatialGridSubsystem::Deinitialize()
+{
+	Entries.Empty();
+	EntryIndices.Empty();
+	Cells.Empty();
+
+	Super::Deinitialize();
+}
+
+FIntPoint UCharacterSpatialGridSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X * InvCellSize), FMath::FloorToInt(Location.Y * InvCellSize));
+}
+
+void UCharacterSpatialGridSubsystem::RegisterCharacter(ACharacterBase* Character)
+{
+	if (!Character || EntryIndices.Contains(Character)) return;
+
+	//Config is loaded after the constructor ran
+	InvCellSize = 1.f / FMath::Max(CellSize, 1.f);
+
+	FGridEntry Entry;
+	Entry.Character = Character;
+	Entry.Key = Character;
+	Entry.Location = Character->GetActorLocation();
+	Entry.Cell = GetCell(Entry.Location);
+	Entry.IndexInCell = INDEX_NONE;
+	Entry.Team = GetCharacterTeam(Character);
+
+	const int32 EntryIndex = Entries.Add(Entry);
+	EntryIndices.Add(Character, EntryIndex);
+	AddToCell(EntryIndex);
+}
+
+void UCharacterSpatialGridSubsystem::UnregisterCharacter(ACharacterBase* Character)
+{
+	if (const int32* EntryIndex = EntryIndices.Find(Character))
+		RemoveEntry(*EntryIndex);
+}
+
+void UCharacterSpatialGridSubsystem::RefreshCharacterTeam(ACharacterBase* Character)
+{
+	if (const int32* EntryIndex = EntryIndices.Find(Character))
+		Entries[*EntryIndex].Team = GetCharacterTeam(Character);
+}
+
+uint8 UCharacterSpatialGridSubsystem::GetCachedTeam(const ACharacterBase* Character) const
+{
+	const int32* EntryIndex = EntryIndices.Find(Character);
+	return EntryIndex ? Entries[*EntryIndex].Team : GetCharacterTeam(Character);
+}
+
+void UCharacterSpatialGridSubsystem::AddToCell(int32 EntryIndex)
+{
+	FGridEntry& Entry = Entries[EntryIndex];
+	TArray<int32>& Cell = Cells.FindOrAdd(Entry.Cell);
+	Entry.IndexInCell = Cell.Add(EntryIndex);
+}
+
+void UCharacterSpatialGridSubsystem::RemoveFromCell(int32 EntryIndex)
+{
+	/* Function RemoveFromCell
+	* Arguments: int32 EntryIndex - entry to remove from its current cell
+	* Output: none (swaps the last entry of the cell into its slot, empty cells are dropped)
+	*/
+
+	FGridEntry& Entry = Entries[EntryIndex];
+	TArray<int32>* Cell = Cells.Find(Entry.Cell);
+	if (!Cell || !Cell->IsValidIndex(Entry.IndexInCell)) return;
+
+	Cell->RemoveAtSwap(Entry.IndexInCell, 1, false);
+	if (Cell->IsValidIndex(Entry.IndexInCell))
+		Entries[(*Cell)[Entry.IndexInCell]].IndexInCell = Entry.IndexInCell;
+
+	if (Cell->Num() == 0)
+		Cells.Remove(Entry.Cell);
+
+	Entry.IndexInCell = INDEX_NONE;
+}
+
+void UCharacterSpatialGridSubsystem::RemoveEntry(int32 EntryIndex)
+{
+	RemoveFromCell(EntryIndex);
+	EntryIndices.Remove(Entries[EntryIndex].Key);
+	Entries.RemoveAt(EntryIndex);
+}
+
+void UCharacterSpatialGridSubsystem::Tick(float DeltaTime)
+{
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	RemovedEntries.Reset();
+
+	for (TSparseArray<FGridEntry>::TIterator It(Entries); It; ++It)
+	{
+		FGridEntry& Entry = *It;
+		const ACharacterBase* Character = Entry.Character.Get();
+		if (!Character)
+		{
+			RemovedEntries.Add(It.GetIndex());
+			continue;
+		}
+
+		Entry.Location = Character->GetActorLocation();
+
+		//Only touch the cells when the character crossed a cell border
+		const FIntPoint NewCell = GetCell(Entry.Location);
+		if (NewCell != Entry.Cell)
+		{
+			RemoveFromCell(It.GetIndex());
+			Entry.Cell = NewCell;
+			AddToCell(It.GetIndex());
+			StatCellChanges++;
+		}
+	}
+
+	//Characters destroyed without EndPlay (shouldn't happen, but the grid must not keep stale entries)
+	for (const int32 EntryIndex : RemovedEntries)
+	{
+		RemoveEntry(EntryIndex);
+	}
+
+	StatFrames++;
+	StatUpdateCycles += FPlatformTime::Cycles64() - StartCycles;
+}
+
+TStatId UCharacterSpatialGridSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCharacterSpatialGridSubsystem, STATGROUP_Tickables);
+}
+
+template<typename VisitorType>
+void UCharacterSpatialGridSubsystem::ForEachCandidate(const ACharacterBase* Instigator, const FBox& Bounds, const FSpatialQueryFilter& Filter, VisitorType&& Visitor) const
+{
+	const FIntPoint MinCell = GetCell(Bounds.Min);
+	const FIntPoint MaxCell = GetCell(Bounds.Max);
+	const uint8 InstigatorTeam = Instigator ? GetCachedTeam(Instigator) : FGenericTeamId::NoTeam.GetId();
+
+	StatQueries++;
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			const TArray<int32>* Cell = Cells.Find(FIntPoint(X, Y));
+			if (!Cell) continue;
+
+			for (const int32 EntryIndex : *Cell)
+			{
+				const FGridEntry& Entry = Entries[EntryIndex];
+				StatCandidates++;
+
+				if (Entry.Location.Z < Bounds.Min.Z || Entry.Location.Z > Bounds.Max.Z) continue;
+
+				//NoTeam characters are never on the same team as anyone
+				const bool bSameTeam = Entry.Team == InstigatorTeam && Entry.Team != FGenericTeamId::NoTeam.GetId();
+				if ((Filter.TeamFilter == ESpatialTeamFilter::SameTeam && !bSameTeam) || (Filter.TeamFilter == ESpatialTeamFilter::OtherTeams && bSameTeam))
+					continue;
+
+				ACharacterBase* Character = Entry.Character.Get();
+				if (!Character || (Filter.bIgnoreInstigator && Character == Instigator)) continue;
+
+				Visitor(Entry, Character);
+			}
+		}
+	}
+}
+
+void UCharacterSpatialGridSubsystem::QueryRadius(const ACharacterBase* Instigator, const FVector& Origin, float Radius, const FSpatialQueryFilter& Filter, TArray<ACharacterBase*>& OutTargets) const
+{
+	const float RadiusSquared = Radius * Radius;
+
+	ForEachCandidate(Instigator, FBox(Origin - FVector(Radius), Origin + FVector(Radius)), Filter, [&](const FGridEntry& Entry, ACharacterBase* Character)
+	{
+		//IsAlive reads an attribute, keep it after the cheap distance check
+		if (FVector::DistSquared(Entry.Location, Origin) <= RadiusSquared && (!Filter.bAliveOnly || Character->IsAlive()))
+			OutTargets.Add(Character);
+	});
+}
+
+void UCharacterSpatialGridSubsystem::QueryCone(const ACharacterBase* Instigator, const FVector& Origin, const FVector& Direction, float Length, float HalfAngle, const FSpatialQueryFilter& Filter, TArray<ACharacterBase*>& OutTargets) const
+{
+	/* Function QueryCone
+	* Arguments: Instigator - team and ignore reference, Origin - apex of the cone, Direction - cone axis, Length - cone range,
+	*            HalfAngle - cone half angle in degrees, Filter - team/alive filters, OutTargets - receives the characters found
+	* Output: none
+	*/
+
+	const FVector Axis = Direction.GetSafeNormal();
+	if (Axis.IsZero()) return;
+
+	const float LengthSquared = Length * Length;
+	const float CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(FMath::Clamp(HalfAngle, 0.f, 180.f)));
+
+	ForEachCandidate(Instigator, FBox(Origin - FVector(Length), Origin + FVector(Length)), Filter, [&](const FGridEntry& Entry, ACharacterBase* Character)
+	{
+		const FVector ToTarget = Entry.Location - Origin;
+		const float DistanceSquared = ToTarget.SizeSquared();
+		if (DistanceSquared > LengthSquared) return;
+
+		//Dot < Cos * Distance compared as signed squares to skip the sqrt (a target on the apex is always inside)
+		const float Dot = FVector::DotProduct(ToTarget, Axis);
+		if (DistanceSquared > KINDA_SMALL_NUMBER && Dot * FMath::Abs(Dot) < CosHalfAngle * FMath::Abs(CosHalfAngle) * DistanceSquared)
+			return;
+
+		if (!Filter.bAliveOnly || Character->IsAlive())
+			OutTargets.Add(Character);
+	});
+}
+
+void UCharacterSpatialGridSubsystem::QueryBox(const ACharacterBase* Instigator, const FVector& Center, const FVector& Extent, const FRotator& Rotation, const FSpatialQueryFilter& Filter, TArray<ACharacterBase*>& OutTargets) const
+{
+	const FTransform BoxTransform(Rotation, Center);
+	const FBox Bounds = FBox(-Extent, Extent).TransformBy(BoxTransform);
+
+	ForEachCandidate(Instigator, Bounds, Filter, [&](const FGridEntry& Entry, ACharacterBase* Character)
+	{
+		const FVector Local = BoxTransform.InverseTransformPositionNoScale(Entry.Location);
+		if (FMath::Abs(Local.X) > Extent.X || FMath::Abs(Local.Y) > Extent.Y || FMath::Abs(Local.Z) > Extent.Z) return;
+
+		if (!Filter.bAliveOnly || Character->IsAlive())
+			OutTargets.Add(Character);
+	});
+}
+
+FGameplayAbilityTargetDataHandle UCharacterSpatialGridSubsystem::MakeTargetData(const TArray<ACharacterBase*>& Targets)
+{
+	FGameplayAbilityTargetData_ActorArray* TargetData = new FGameplayAbilityTargetData_ActorArray();
+	TargetData->TargetActorArray.Reserve(Targets.Num());
+	for (ACharacterBase* Target : Targets)
+	{
+		TargetData->TargetActorArray.Add(Target);
+	}
+
+	return FGameplayAbilityTargetDataHandle(TargetData);
+}
+
+void UCharacterSpatialGridSubsystem::DumpStats(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("Spatial grid: %d characters in %d cells (cell size %.0f)"), Entries.Num(), Cells.Num(), CellSize);
+
+	if (StatFrames > 0)
+	{
+		Ar.Logf(TEXT("  Update: %.4fms/frame, %.2f cell changes/frame over %llu frames"),
+			FPlatformTime::ToMilliseconds64(StatUpdateCycles) / (double)StatFrames, (double)StatCellChanges / (double)StatFrames, StatFrames);
+	}
+
+	if (StatQueries > 0)
+	{
+		Ar.Logf(TEXT("  Queries: %llu, %.2f candidates tested per query"), StatQueries, (double)StatCandidates / (double)StatQueries);
+	}
+}
+
+void UCharacterSpatialGridSubsystem::ResetStats()
+{
+	StatQueries = 0;
+	StatCandidates = 0;
+	StatFrames = 0;
+	StatCellChanges = 0;
+	StatUpdateCycles = 0;
+}
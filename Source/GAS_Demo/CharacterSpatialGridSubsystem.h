@@ -0,0 +1,159 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Abilities/GameplayAbilityTargetTypes.h"
+#include "DataTypes.h"
+#include "CharacterSpatialGridSubsystem.generated.h"
+
+class ACharacterBase;
+
+/** Filters applied to the characters found by a spatial query */
+USTRUCT(BlueprintType)
+struct FSpatialQueryFilter
+{
+	GENERATED_BODY()
+
+public:
+	/** Team check against the instigator's team (characters without team count as other teams) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	ESpatialTeamFilter TeamFilter = ESpatialTeamFilter::Any;
+
+	/** Skip dead characters (see ACharacterBase::IsAlive) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bAliveOnly = true;
+
+	/** Never return the instigator itself */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bIgnoreInstigator = true;
+};
+
+UCLASS(config = Game)
+class GAS_DEMO_API UCharacterSpatialGridSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+/*
+* Class UCharacterSpatialGridSubsystem
+* AoE target acquisition without physics overlaps or actor iterators: every ACharacterBase registers itself
+* on BeginPlay in a uniform 2D spatial hash (cells of CellSize on X/Y). Each frame the cached locations are
+* refreshed and a character only moves between cells when it actually crosses a cell border.
+*
+* Radius, cone and box queries only visit the cells overlapping the query bounds, then test the cached
+* locations (so results may be one frame behind) and apply team and IsAlive filters. MakeTargetData turns
+* the result into target data for ApplyGameplayEffectToTarget, so AoE abilities feed their damage effect directly.
+*
+* Teams come from IGenericTeamAgentInterface, on the character or on its controller. They are read when a character
+* registers and cached in its entry, the character refreshes it on possession (RefreshCharacterTeam).
+* Use GAS.Spatial.Stats to check the grid, the automation test GASDemo.Spatial.Benchmark compares it against physics
+* overlaps with 1k and 10k characters.
+*/
+
+public:
+	UCharacterSpatialGridSubsystem();
+
+	//~ Begin USubsystem
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Deinitialize() override;
+	//~ End USubsystem
+
+	//~ Begin FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject
+
+	/** Adds Character to the grid, called on the character's BeginPlay */
+	void RegisterCharacter(ACharacterBase* Character);
+
+	/** Removes Character from the grid, called on the character's EndPlay */
+	void UnregisterCharacter(ACharacterBase* Character);
+
+	/** Reads the team of Character again, called when its controller changes */
+	void RefreshCharacterTeam(ACharacterBase* Character);
+
+	/** Characters within Radius of Origin */
+	UFUNCTION(BlueprintCallable, Category = "Abilities|Targeting")
+	void QueryRadius(const ACharacterBase* Instigator, const FVector& Origin, float Radius, const FSpatialQueryFilter& Filter, TArray<ACharacterBase*>& OutTargets) const;
+
+	/** Characters within Length of Origin and HalfAngle (degrees) of Direction */
+	UFUNCTION(BlueprintCallable, Category = "Abilities|Targeting")
+	void QueryCone(const ACharacterBase* Instigator, const FVector& Origin, const FVector& Direction, float Length, float HalfAngle, const FSpatialQueryFilter& Filter, TArray<ACharacterBase*>& OutTargets) const;
+
+	/** Characters inside the box of half size Extent centered on Center and rotated by Rotation */
+	UFUNCTION(BlueprintCallable, Category = "Abilities|Targeting")
+	void QueryBox(const ACharacterBase* Instigator, const FVector& Center, const FVector& Extent, const FRotator& Rotation, const FSpatialQueryFilter& Filter, TArray<ACharacterBase*>& OutTargets) const;
+
+	/** Target data (one actor array) for the characters returned by a query */
+	UFUNCTION(BlueprintPure, Category = "Abilities|Targeting")
+	static FGameplayAbilityTargetDataHandle MakeTargetData(const TArray<ACharacterBase*>& Targets);
+
+	/** Number of characters in the grid */
+	int32 GetNumCharacters() const { return Entries.Num(); }
+
+	/** Prints grid stats to the output device */
+	void DumpStats(FOutputDevice& Ar) const;
+
+	/** Clears the counters shown in DumpStats */
+	void ResetStats();
+
+protected:
+
+	/** Size of a grid cell in cm, roughly the usual AoE radius works best */
+	UPROPERTY(Config)
+	float CellSize;
+
+private:
+
+	struct FGridEntry
+	{
+		TWeakObjectPtr<ACharacterBase> Character;
+
+		/** Key of this entry in EntryIndices, still valid once Character is gone */
+		TObjectKey<ACharacterBase> Key;
+
+		FVector Location;
+		FIntPoint Cell;
+
+		/** Index of this entry in its cell */
+		int32 IndexInCell;
+
+		/** FGenericTeamId of the character */
+		uint8 Team;
+	};
+
+	FIntPoint GetCell(const FVector& Location) const;
+
+	/** Team cached in the entry of Character, read from the character if it isn't registered */
+	uint8 GetCachedTeam(const ACharacterBase* Character) const;
+
+	void AddToCell(int32 EntryIndex);
+	void RemoveFromCell(int32 EntryIndex);
+	void RemoveEntry(int32 EntryIndex);
+
+	/** Calls Visitor on the entries of every cell overlapping Bounds (X/Y only) that pass Filter */
+	template<typename VisitorType>
+	void ForEachCandidate(const ACharacterBase* Instigator, const FBox& Bounds, const FSpatialQueryFilter& Filter, VisitorType&& Visitor) const;
+
+	/** Every registered character, indices are stable */
+	TSparseArray<FGridEntry> Entries;
+
+	/** Entry index of each registered character */
+	TMap<TObjectKey<ACharacterBase>, int32> EntryIndices;
+
+	/** Entry indices of each non empty cell */
+	TMap<FIntPoint, TArray<int32>> Cells;
+
+	float InvCellSize;
+
+	/** Scratch array reused every frame */
+	TArray<int32> RemovedEntries;
+
+	//Stats counters, see DumpStats
+	mutable uint64 StatQueries;
+	mutable uint64 StatCandidates;
+	uint64 StatFrames;
+	uint64 StatCellChanges;
+	uint64 StatUpdateCycles;
+};
@@ -0,0 +1,555 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+
+#include "CombatBenchmarkCommandlet.h"
+#include "CountingMalloc.h"
+#include "ZeroAllocationScope.h"
+#include "CharacterBase.h"
+#include "EquipmentComponent.h"
+#include "WeaponBase.h"
+#include "GECSampleDamageExecition.h"
+#include "GameplayEffectCache.h"
+#include "GAS_DemoAssetManager.h"
+#include "GAS_DemoGameMode.h"
+#include "AbilitySystemComponent.h"
+#include "GameplayEffect.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/WorldSettings.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Misc/App.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeExit.h"
+#include "UObject/UObjectArray.h"
+
+/** Counts every UObject created while it is alive */
+class FObjectCreateCounter : public FUObjectArray::FUObjectCreateListener
+{
+public:
+	FObjectCreateCounter() { GUObjectArray.AddUObjectCreateListener(this); }
+	virtual ~FObjectCreateCounter() { Unregister(); }
+
+	virtual void NotifyUObjectCreated(const UObjectBase* Object, int32 Index) override { ++NumCreated; }
+	virtual void OnUObjectArrayShutdown() override { Unregister(); }
+
+	uint64 GetNumCreated() const { return NumCreated; }
+
+private:
+	void Unregister()
+	{
+		if (!bRegistered) return;
+
+		GUObjectArray.RemoveUObjectCreateListener(this);
+		bRegistered = false;
+	}
+
+	uint64 NumCreated = 0;
+	bool bRegistered = true;
+};
+
+/** Garbage collections forced by the benchmark (between stages and every GCInterval hits) */
+struct FBenchmarkGarbageCollection
+{
+	void Collect()
+	{
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		const double Ms = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles);
+
+		Count++;
+		TotalMs += Ms;
+		MaxMs = FMath::Max(MaxMs, Ms);
+	}
+
+	int32 Count = 0;
+	double TotalMs = 0.0;
+	double MaxMs = 0.0;
+};
+
+/** Allocations counted by FCountingMalloc, 0 when allocations aren't counted */
+static uint64 GetCountedAllocations()
+{
+	const FCountingMalloc* CountingMalloc = FCountingMalloc::Get();
+	return CountingMalloc ? CountingMalloc->GetNumAllocations() : 0;
+}
+
+static uint64 GetCountedBytes()
+{
+	const FCountingMalloc* CountingMalloc = FCountingMalloc::Get();
+	return CountingMalloc ? CountingMalloc->GetAllocatedBytes() : 0;
+}
+
+/** Latency samples and allocation counters of one benchmark stage */
+struct FBenchmarkStage
+{
+	FBenchmarkStage(const TCHAR* InName, int32 ExpectedSamples, const FObjectCreateCounter& InObjectCounter)
+		: Name(InName), ObjectCounter(InObjectCounter)
+	{
+		//Reserved upfront so recording samples doesn't show up in the stage allocations
+		SamplesUs.Reserve(ExpectedSamples);
+	}
+
+	void Begin()
+	{
+		StartCycles = FPlatformTime::Cycles64();
+		StartAllocations = GetCountedAllocations();
+		StartAllocatedBytes = GetCountedBytes();
+		StartObjects = ObjectCounter.GetNumCreated();
+	}
+
+	void End()
+	{
+		TotalCycles = FPlatformTime::Cycles64() - StartCycles - ExcludedCycles;
+		Allocations = GetCountedAllocations() - StartAllocations - ExcludedAllocations;
+		AllocatedBytes = GetCountedBytes() - StartAllocatedBytes - ExcludedAllocatedBytes;
+		ObjectsCreated = ObjectCounter.GetNumCreated() - StartObjects - ExcludedObjects;
+	}
+
+	void AddSample(uint64 SampleStartCycles)
+	{
+		SamplesUs.Add(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - SampleStartCycles) * 1000.0);
+	}
+
+	/** Runs Work without counting its time, allocations and objects in the stage (GC passes, reviving targets) */
+	template<typename WorkType>
+	void RunExcluded(WorkType&& Work)
+	{
+		const uint64 WorkStartCycles = FPlatformTime::Cycles64();
+		const uint64 WorkStartAllocations = GetCountedAllocations();
+		const uint64 WorkStartAllocatedBytes = GetCountedBytes();
+		const uint64 WorkStartObjects = ObjectCounter.GetNumCreated();
+
+		Work();
+
+		ExcludedCycles += FPlatformTime::Cycles64() - WorkStartCycles;
+		ExcludedAllocations += GetCountedAllocations() - WorkStartAllocations;
+		ExcludedAllocatedBytes += GetCountedBytes() - WorkStartAllocatedBytes;
+		ExcludedObjects += ObjectCounter.GetNumCreated() - WorkStartObjects;
+	}
+
+	double GetTotalMs() const { return FPlatformTime::ToMilliseconds64(TotalCycles); }
+
+	/** Samples per second over the stage time */
+	double GetThroughput() const { return TotalCycles > 0 ? SamplesUs.Num() / (GetTotalMs() / 1000.0) : 0.0; }
+
+	TSharedRef<FJsonObject> ToJson();
+
+	const TCHAR* Name;
+	TArray<float> SamplesUs;
+
+	uint64 TotalCycles = 0;
+	uint64 Allocations = 0;
+	uint64 AllocatedBytes = 0;
+	uint64 ObjectsCreated = 0;
+
+private:
+	const FObjectCreateCounter& ObjectCounter;
+
+	uint64 StartCycles = 0;
+	uint64 StartAllocations = 0;
+	uint64 StartAllocatedBytes = 0;
+	uint64 StartObjects = 0;
+
+	uint64 ExcludedCycles = 0;
+	uint64 ExcludedAllocations = 0;
+	uint64 ExcludedAllocatedBytes = 0;
+	uint64 ExcludedObjects = 0;
+};
+
+/** Returns the given percentile (0-1) of sorted samples, 0 if there are none */
+static double GetSortedPercentile(const TArray<float>& SortedSamples, double Percentile)
+{
+	if (SortedSamples.Num() == 0) return 0.0;
+
+	const int32 Index = FMath::Clamp(FMath::CeilToInt(Percentile * SortedSamples.Num()) - 1, 0, SortedSamples.Num() - 1);
+	return SortedSamples[Index];
+}
+
+TSharedRef<FJsonObject> FBenchmarkStage::ToJson()
+{
+	SamplesUs.Sort();
+
+	double SumUs = 0.0;
+	for (const float SampleUs : SamplesUs)
+	{
+		SumUs += SampleUs;
+	}
+
+	const int32 Count = SamplesUs.Num();
+
+	TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+	Json->SetStringField(TEXT("name"), Name);
+	Json->SetNumberField(TEXT("count"), Count);
+	Json->SetNumberField(TEXT("totalMs"), GetTotalMs());
+	Json->SetNumberField(TEXT("perSecond"), GetThroughput());
+	Json->SetNumberField(TEXT("avgUs"), Count > 0 ? SumUs / Count : 0.0);
+	Json->SetNumberField(TEXT("p50Us"), GetSortedPercentile(SamplesUs, 0.5));
+	Json->SetNumberField(TEXT("p90Us"), GetSortedPercentile(SamplesUs, 0.9));
+	Json->SetNumberField(TEXT("p99Us"), GetSortedPercentile(SamplesUs, 0.99));
+	Json->SetNumberField(TEXT("maxUs"), Count > 0 ? SamplesUs.Last() : 0.0);
+	if (FCountingMalloc::Get())
+	{
+		Json->SetNumberField(TEXT("allocations"), Allocations);
+		Json->SetNumberField(TEXT("allocationsPerSample"), Count > 0 ? (double)Allocations / Count : 0.0);
+		Json->SetNumberField(TEXT("allocatedBytes"), AllocatedBytes);
+	}
+	Json->SetNumberField(TEXT("objectsCreated"), ObjectsCreated);
+	return Json;
+}
+
+/** Loads every weapon known to the asset manager (kept alive for the whole run, GC passes happen before they are slotted) */
+static void LoadWeapons(TArray<UWeaponBase*>& OutWeapons)
+{
+	UGAS_DemoAssetManager& AssetManager = UGAS_DemoAssetManager::Get();
+
+	//Commandlets run before the asset registry is done scanning
+	AssetManager.GetAssetRegistry().SearchAllAssets(true);
+	AssetManager.ScanPrimaryAssetTypesFromConfig();
+
+	TArray<FPrimaryAssetId> WeaponIds;
+	AssetManager.GetPrimaryAssetIdList(UGAS_DemoAssetManager::WeaponItemType, WeaponIds);
+
+	for (const FPrimaryAssetId& WeaponId : WeaponIds)
+	{
+		const FSoftObjectPath WeaponPath = AssetManager.GetPrimaryAssetPath(WeaponId);
+		if (UWeaponBase* Weapon = Cast<UWeaponBase>(WeaponPath.TryLoad()))
+		{
+			Weapon->AddToRoot();
+			OutWeapons.Add(Weapon);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("CombatBenchmark: failed to load %s"), *WeaponId.ToString());
+		}
+	}
+}
+
+/** Instant effect whose only execution is UGECSampleDamageExecition (kept alive for the whole run) */
+static const UGameplayEffect* CreateDamageEffect()
+{
+	UGameplayEffect* Effect = NewObject<UGameplayEffect>(GetTransientPackage(), TEXT("GE_CombatBenchmarkDamage"));
+	Effect->DurationPolicy = EGameplayEffectDurationType::Instant;
+
+	FGameplayEffectExecutionDefinition Execution;
+	Execution.CalculationClass = UGECSampleDamageExecition::StaticClass();
+	Effect->Executions.Add(Execution);
+
+	Effect->AddToRoot();
+	return Effect;
+}
+
+UCombatBenchmarkCommandlet::UCombatBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UCombatBenchmarkCommandlet::Main(const FString& Params)
+{
+	/* Function Main
+	* Arguments: const FString& Params - command line, see the class comment for the supported options
+	* Output: 0 on success, 1 on failure
+	*/
+
+	int32 NumCharacters = 100;
+	int32 NumHits = 1000000;
+	int32 NumWarmupHits = 1000;
+	int32 GCInterval = 100000;
+	FString CharacterClassPath;
+	FString DamageEffectPath;
+	FString OutputPath = FPaths::ProfilingDir() / FString::Printf(TEXT("CombatBenchmark-%s.json"), *FDateTime::Now().ToString());
+
+	FParse::Value(*Params, TEXT("Characters="), NumCharacters);
+	FParse::Value(*Params, TEXT("Hits="), NumHits);
+	FParse::Value(*Params, TEXT("Warmup="), NumWarmupHits);
+	FParse::Value(*Params, TEXT("GCInterval="), GCInterval);
+	FParse::Value(*Params, TEXT("CharacterClass="), CharacterClassPath);
+	FParse::Value(*Params, TEXT("DamageEffect="), DamageEffectPath);
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+	const bool bZeroAllocationChecks = FParse::Param(*Params, TEXT("ZeroAlloc"));
+	const bool bCountAllocations = bZeroAllocationChecks || FParse::Param(*Params, TEXT("CountAllocations"));
+
+	//Characters hit the next one in the list, so at least two of them are needed
+	NumCharacters = FMath::Max(NumCharacters, 2);
+	NumHits = FMath::Max(NumHits, 1);
+	NumWarmupHits = FMath::Max(NumWarmupHits, 0);
+
+	//Before anything is loaded or spawned, see FCountingMalloc
+	if (bCountAllocations)
+		FCountingMalloc::Install();
+	ON_SCOPE_EXIT { FCountingMalloc::Uninstall(); };
+
+	FObjectCreateCounter ObjectCounter;
+
+	UClass* CharacterClass = CharacterClassPath.IsEmpty()
+		? GetDefault<AGAS_DemoGameMode>()->DefaultPawnClass.Get()
+		: LoadClass<ACharacterBase>(nullptr, *CharacterClassPath);
+
+	if (!CharacterClass || !CharacterClass->IsChildOf(ACharacterBase::StaticClass()))
+	{
+		UE_LOG(LogTemp, Error, TEXT("CombatBenchmark: %s is not a ACharacterBase class, use -CharacterClass="),
+			CharacterClass ? *CharacterClass->GetPathName() : *CharacterClassPath);
+		return 1;
+	}
+
+	if (!CharacterClass->GetDefaultObject<ACharacterBase>()->DefaultAttributeEffect)
+	{
+		UE_LOG(LogTemp, Error, TEXT("CombatBenchmark: %s has no DefaultAttributeEffect, damage would have nothing to act on"), *CharacterClass->GetPathName());
+		return 1;
+	}
+
+	const UGameplayEffect* DamageEffect = nullptr;
+	if (DamageEffectPath.IsEmpty())
+	{
+		DamageEffect = CreateDamageEffect();
+	}
+	else if (UClass* DamageEffectClass = LoadClass<UGameplayEffect>(nullptr, *DamageEffectPath))
+	{
+		DamageEffect = DamageEffectClass->GetDefaultObject<UGameplayEffect>();
+	}
+
+	if (!DamageEffect)
+	{
+		UE_LOG(LogTemp, Error, TEXT("CombatBenchmark: failed to load damage effect %s"), *DamageEffectPath);
+		return 1;
+	}
+
+	TArray<UWeaponBase*> Weapons;
+	LoadWeapons(Weapons);
+	if (Weapons.Num() == 0)
+		UE_LOG(LogTemp, Warning, TEXT("CombatBenchmark: no weapon found, characters fight bare-handed"));
+
+	//Empty game world without game mode: actors BeginPlay is dispatched by the world settings directly
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("CombatBenchmark"));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+	World->GetWorldSettings()->NotifyBeginPlay();
+
+	FBenchmarkGarbageCollection GarbageCollection;
+	GarbageCollection.Collect();
+
+	//Spawn: actor and components construction, BeginPlay
+	FBenchmarkStage SpawnStage(TEXT("Spawn"), NumCharacters, ObjectCounter);
+	TArray<ACharacterBase*> Characters;
+	Characters.Reserve(NumCharacters);
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	SpawnStage.Begin();
+	for (int32 Index = 0; Index < NumCharacters; ++Index)
+	{
+		const FVector Location((Index % 32) * 200.f, (Index / 32) * 200.f, 100.f);
+
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		ACharacterBase* Character = World->SpawnActor<ACharacterBase>(CharacterClass, FTransform(Location), SpawnParams);
+		SpawnStage.AddSample(StartCycles);
+
+		if (Character)
+			Characters.Add(Character);
+	}
+	SpawnStage.End();
+	GarbageCollection.Collect();
+
+	//Possess: ACharacterBase::PossessedBy (ASC actor info, DefaultAttributeEffect, default abilities)
+	FBenchmarkStage PossessStage(TEXT("Possess"), Characters.Num(), ObjectCounter);
+	PossessStage.Begin();
+	for (ACharacterBase* Character : Characters)
+	{
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		Character->SpawnDefaultController();
+		PossessStage.AddSample(StartCycles);
+	}
+	PossessStage.End();
+	GarbageCollection.Collect();
+
+	if (Characters.Num() == 0 || !Characters[0]->GetController())
+	{
+		UE_LOG(LogTemp, Error, TEXT("CombatBenchmark: characters couldn't be spawned or possessed (check the AIControllerClass of %s)"), *CharacterClass->GetPathName());
+		World->DestroyWorld(false);
+		GEngine->DestroyWorldContext(World);
+		return 1;
+	}
+
+	//Equip: slot and equip a weapon through the UEquipmentComponent, then apply its stats
+	FBenchmarkStage EquipStage(TEXT("Equip"), Weapons.Num() > 0 ? Characters.Num() : 0, ObjectCounter);
+	EquipStage.Begin();
+	for (int32 Index = 0; Index < Characters.Num() && Weapons.Num() > 0; ++Index)
+	{
+		ACharacterBase* Character = Characters[Index];
+		UWeaponBase* Weapon = Weapons[Index % Weapons.Num()];
+
+		UEquipmentComponent* Equipment = Character->FindComponentByClass<UEquipmentComponent>();
+		if (!Equipment)
+		{
+			EquipStage.RunExcluded([&]()
+			{
+				Equipment = NewObject<UEquipmentComponent>(Character);
+				Equipment->RegisterComponent();
+			});
+		}
+
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		Equipment->SlotWeapon(Weapon);
+		Equipment->EquipNextWeapon();
+		Character->OnEquipmentChanged(Weapon, EEquipmentChangeStatus::Equip);
+		EquipStage.AddSample(StartCycles);
+	}
+	EquipStage.End();
+	GarbageCollection.Collect();
+
+	//Damage: every character hits the next one, targets are healed back outside of the measured time
+	TArray<UAbilitySystemComponent*> AbilitySystems;
+	TArray<FGameplayEffectSpecCache> SpecCaches;
+	for (ACharacterBase* Character : Characters)
+	{
+		AbilitySystems.Add(Character->GetAbilitySystemComponent());
+	}
+	SpecCaches.SetNum(Characters.Num());
+
+	int32 NumRevives = 0;
+	FBenchmarkStage DamageStage(TEXT("Damage"), NumHits, ObjectCounter);
+
+	auto ApplyHit = [&](int32 Hit, bool bRecord)
+	{
+		const int32 AttackerIndex = Hit % Characters.Num();
+		const int32 TargetIndex = (AttackerIndex + 1) % Characters.Num();
+		ACharacterBase* Attacker = Characters[AttackerIndex];
+		ACharacterBase* Target = Characters[TargetIndex];
+
+		//Built once per attacker, the same way characters cache the specs they apply to themselves
+		const FGameplayEffectSpecHandle SpecHandle = SpecCaches[AttackerIndex].FindOrMake(AbilitySystems[AttackerIndex], DamageEffect, Attacker->GetCharacterLevel(), Attacker);
+
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		AbilitySystems[AttackerIndex]->ApplyGameplayEffectSpecToTarget(*SpecHandle.Data.Get(), AbilitySystems[TargetIndex]);
+		if (bRecord)
+			DamageStage.AddSample(StartCycles);
+
+		if (Target->GetCurrentHealth() <= Target->GetMaxHealth() * 0.25f)
+		{
+			DamageStage.RunExcluded([&]()
+			{
+				Target->ResetAttributes();
+				NumRevives++;
+			});
+		}
+	};
+
+	for (int32 Hit = 0; Hit < NumWarmupHits; ++Hit)
+	{
+		ApplyHit(Hit, false);
+	}
+	GarbageCollection.Collect();
+
+	//The warmup hits already warmed the hot paths up, every allocation from here on is a violation
+#if GASDEMO_ZERO_ALLOC_CHECKS
+	if (bZeroAllocationChecks)
+		FZeroAllocationScope::Start(0);
+#endif
+
+	DamageStage.Begin();
+	for (int32 Hit = 0; Hit < NumHits; ++Hit)
+	{
+		ApplyHit(Hit, true);
+
+		if (GCInterval > 0 && (Hit + 1) % GCInterval == 0)
+			DamageStage.RunExcluded([&]() { GarbageCollection.Collect(); });
+	}
+	DamageStage.End();
+
+#if GASDEMO_ZERO_ALLOC_CHECKS
+	if (bZeroAllocationChecks)
+		FZeroAllocationScope::Stop();
+#endif
+
+	GarbageCollection.Collect();
+
+	World->DestroyWorld(false);
+	GEngine->DestroyWorldContext(World);
+
+	//Report
+	TSharedRef<FJsonObject> Build = MakeShared<FJsonObject>();
+	Build->SetStringField(TEXT("version"), FApp::GetBuildVersion());
+	Build->SetStringField(TEXT("configuration"), LexToString(FApp::GetBuildConfiguration()));
+	Build->SetNumberField(TEXT("changelist"), FEngineVersion::Current().GetChangelist());
+	Build->SetStringField(TEXT("platform"), ANSI_TO_TCHAR(FPlatformProperties::IniPlatformName()));
+
+	TSharedRef<FJsonObject> Settings = MakeShared<FJsonObject>();
+	Settings->SetNumberField(TEXT("characters"), Characters.Num());
+	Settings->SetNumberField(TEXT("hits"), NumHits);
+	Settings->SetNumberField(TEXT("warmupHits"), NumWarmupHits);
+	Settings->SetNumberField(TEXT("gcInterval"), GCInterval);
+	Settings->SetNumberField(TEXT("weapons"), Weapons.Num());
+	Settings->SetStringField(TEXT("characterClass"), CharacterClass->GetPathName());
+	Settings->SetStringField(TEXT("damageEffect"), DamageEffect->GetPathName());
+
+	TArray<TSharedPtr<FJsonValue>> Stages;
+	for (FBenchmarkStage* Stage : { &SpawnStage, &PossessStage, &EquipStage, &DamageStage })
+	{
+		Stages.Add(MakeShared<FJsonValueObject>(Stage->ToJson()));
+
+		UE_LOG(LogTemp, Display, TEXT("CombatBenchmark: %-8s %8d samples, %10.0f/s, p50: %.2fus, p99: %.2fus, %llu allocations, %llu objects"),
+			Stage->Name, Stage->SamplesUs.Num(), Stage->GetThroughput(), GetSortedPercentile(Stage->SamplesUs, 0.5),
+			GetSortedPercentile(Stage->SamplesUs, 0.99), Stage->Allocations, Stage->ObjectsCreated);
+	}
+
+	TSharedRef<FJsonObject> GarbageCollectionJson = MakeShared<FJsonObject>();
+	GarbageCollectionJson->SetNumberField(TEXT("count"), GarbageCollection.Count);
+	GarbageCollectionJson->SetNumberField(TEXT("totalMs"), GarbageCollection.TotalMs);
+	GarbageCollectionJson->SetNumberField(TEXT("avgMs"), GarbageCollection.Count > 0 ? GarbageCollection.TotalMs / GarbageCollection.Count : 0.0);
+	GarbageCollectionJson->SetNumberField(TEXT("maxMs"), GarbageCollection.MaxMs);
+
+	const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+	TSharedRef<FJsonObject> Memory = MakeShared<FJsonObject>();
+	Memory->SetNumberField(TEXT("usedPhysicalMB"), MemoryStats.UsedPhysical / (1024.0 * 1024.0));
+	Memory->SetNumberField(TEXT("peakUsedPhysicalMB"), MemoryStats.PeakUsedPhysical / (1024.0 * 1024.0));
+
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetObjectField(TEXT("build"), Build);
+	Report->SetObjectField(TEXT("settings"), Settings);
+	Report->SetNumberField(TEXT("damageHitsPerSecond"), DamageStage.GetThroughput());
+	Report->SetNumberField(TEXT("revives"), NumRevives);
+	Report->SetArrayField(TEXT("stages"), Stages);
+	Report->SetObjectField(TEXT("garbageCollection"), GarbageCollectionJson);
+	Report->SetObjectField(TEXT("memory"), Memory);
+
+	uint64 ZeroAllocationViolations = 0;
+#if GASDEMO_ZERO_ALLOC_CHECKS
+	if (bZeroAllocationChecks)
+	{
+		FZeroAllocationScope::Report(*GLog);
+		ZeroAllocationViolations = FZeroAllocationScope::GetNumViolations();
+		Report->SetNumberField(TEXT("zeroAllocationViolations"), ZeroAllocationViolations);
+	}
+#endif
+
+	FString Json;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+	FJsonSerializer::Serialize(Report, Writer);
+
+	UE_LOG(LogTemp, Display, TEXT("CombatBenchmark: %s"), *Json);
+
+	if (!FFileHelper::SaveStringToFile(Json, *OutputPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("CombatBenchmark: failed to write %s"), *OutputPath);
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("CombatBenchmark: report written to %s"), *OutputPath);
+
+	if (ZeroAllocationViolations > 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("CombatBenchmark: %llu allocations in zero allocation scopes, see the call stacks above"), ZeroAllocationViolations);
+		return 1;
+	}
+
+	return 0;
+}
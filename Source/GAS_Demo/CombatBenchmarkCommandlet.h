@@ -0,0 +1,38 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "CombatBenchmarkCommandlet.generated.h"
+
+UCLASS()
+class GAS_DEMO_API UCombatBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+/*
+* Class UCombatBenchmarkCommandlet
+* Headless combat benchmark: spawns characters in an empty game world (possessed by AI controllers, so they go
+* through PossessedBy and their DefaultAttributeEffect), equips them with the asset manager's weapons through their
+* UEquipmentComponent and makes them hit each other with a UGECSampleDamageExecition driven damage effect.
+*
+* Every stage (spawn, possess, equip, damage) reports its throughput, p50/p90/p99 latency, UObjects created and,
+* with -CountAllocations, heap allocations (counted by FCountingMalloc), along with the time spent in garbage collection.
+* The report is written as JSON to Saved/Profiling (and to the log) so runs of different builds can be compared.
+*
+* UnrealEditor-Cmd GAS_Demo.uproject -run=CombatBenchmark -nullrhi [-Characters=100] [-Hits=1000000] [-Warmup=1000]
+*	[-GCInterval=100000] [-CharacterClass=/Game/Path.Class_C] [-DamageEffect=/Game/Path.Class_C] [-Output=Path] [-CountAllocations] [-ZeroAlloc]
+*
+* The character class defaults to the game mode's pawn, the damage effect to an instant effect whose only
+* execution is UGECSampleDamageExecition.
+*
+* With -ZeroAlloc (which implies -CountAllocations) the damage stage also runs the zero allocation checks (see ZeroAllocationScope.h): any allocation in
+* the damage and attribute hot paths after the warmup hits prints its call stack and fails the run (exit code 1).
+*/
+
+public:
+	UCombatBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,82 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+
+#include "CountingMalloc.h"
+
+FCountingMalloc* FCountingMalloc::Instance = nullptr;
+
+FCountingMalloc* FCountingMalloc::Install()
+{
+	check(IsInGameThread());
+
+	if (!IsRunningCommandlet())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FCountingMalloc can only be installed by commandlets, allocations won't be counted"));
+		return nullptr;
+	}
+
+	if (!Instance)
+	{
+		Instance = new FCountingMalloc(GMalloc);
+		GMalloc = Instance;
+	}
+
+	return Instance;
+}
+
+void FCountingMalloc::Uninstall()
+{
+	check(IsInGameThread());
+
+	if (!Instance) return;
+
+	//Another proxy installed on top of this one keeps forwarding to it
+	if (GMalloc == Instance)
+		GMalloc = Instance->Inner;
+
+	Instance->SetAllocationHook(nullptr);
+
+	//Leaked on purpose: a thread may still be inside the proxy, and it only forwards to Inner from now on
+	Instance = nullptr;
+}
+
+void* FCountingMalloc::Malloc(SIZE_T Count, uint32 Alignment)
+{
+	CountAllocation(Count);
+	return Inner->Malloc(Count, Alignment);
+}
+
+void* FCountingMalloc::TryMalloc(SIZE_T Count, uint32 Alignment)
+{
+	CountAllocation(Count);
+	return Inner->TryMalloc(Count, Alignment);
+}
+
+void* FCountingMalloc::Realloc(void* Original, SIZE_T Count, uint32 Alignment)
+{
+	//Realloc(nullptr) allocates, Realloc(Ptr, 0) frees
+	if (Count > 0)
+		CountAllocation(Count);
+	else if (Original)
+		NumFrees.fetch_add(1, std::memory_order_relaxed);
+
+	return Inner->Realloc(Original, Count, Alignment);
+}
+
+void* FCountingMalloc::TryRealloc(void* Original, SIZE_T Count, uint32 Alignment)
+{
+	if (Count > 0)
+		CountAllocation(Count);
+	else if (Original)
+		NumFrees.fetch_add(1, std::memory_order_relaxed);
+
+	return Inner->TryRealloc(Original, Count, Alignment);
+}
+
+void FCountingMalloc::Free(void* Original)
+{
+	if (Original)
+		NumFrees.fetch_add(1, std::memory_order_relaxed);
+
+	Inner->Free(Original);
+}
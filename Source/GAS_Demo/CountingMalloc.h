@@ -0,0 +1,91 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/MemoryBase.h"
+#include <atomic>
+
+/**
+* FMalloc proxy counting every allocation going through GMalloc (all threads), used by benchmarks to report how many
+* heap allocations a piece of code does. Counting adds two atomic increments to every allocation, so it is only
+* installed on demand (see Install) and game sessions never pay for it.
+*
+* Swapping GMalloc is only safe while no other thread is allocating, which is never the case once a game or editor
+* is running (and game modules only load after the engine's worker threads started). The proxy is therefore limited
+* to commandlets, which install it first thing in Main before creating a world or loading anything (so the worker
+* threads are idle), and uninstall it before returning.
+*/
+class GAS_DEMO_API FCountingMalloc final : public FMalloc
+{
+public:
+	/**
+	* Wraps GMalloc with the counting proxy, commandlets only (see above): call it at the start of Main and match it with Uninstall
+	*
+	* @return The installed proxy, nullptr if not running a commandlet
+	*/
+	static FCountingMalloc* Install();
+
+	/** Puts back the allocator wrapped by Install, blocks allocated through the proxy can still be freed afterwards */
+	static void Uninstall();
+
+	/** Returns the installed proxy, nullptr if not installed */
+	static FCountingMalloc* Get() { return Instance; }
+
+	/** Called for every allocation counted, from the allocating thread (must not allocate itself) */
+	using FAllocationHook = void(*)(SIZE_T Size);
+
+	/** Sets the function called for every allocation, nullptr removes it */
+	void SetAllocationHook(FAllocationHook Hook) { AllocationHook.store(Hook, std::memory_order_release); }
+
+	/** Allocations made since the proxy was installed (reallocations of an existing block count as one) */
+	uint64 GetNumAllocations() const { return NumAllocations.load(std::memory_order_relaxed); }
+
+	/** Bytes requested by those allocations */
+	uint64 GetAllocatedBytes() const { return AllocatedBytes.load(std::memory_order_relaxed); }
+
+	uint64 GetNumFrees() const { return NumFrees.load(std::memory_order_relaxed); }
+
+	// FMalloc interface
+	virtual void* Malloc(SIZE_T Count, uint32 Alignment) override;
+	virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override;
+	virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override;
+	virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override;
+	virtual void Free(void* Original) override;
+	virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+	virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+	virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+	virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+	virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+	virtual void InitializeStatsMetadata() override { Inner->InitializeStatsMetadata(); }
+	virtual void UpdateStats() override { Inner->UpdateStats(); }
+	virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { Inner->GetAllocatorStats(OutStats); }
+	virtual void DumpAllocatorStats(FOutputDevice& Ar) override { Inner->DumpAllocatorStats(Ar); }
+	virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+	virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+	virtual const TCHAR* GetDescriptiveName() override { return Inner->GetDescriptiveName(); }
+	virtual void OnMallocInitialized() override { Inner->OnMallocInitialized(); }
+	virtual void OnPreFork() override { Inner->OnPreFork(); }
+	virtual void OnPostFork() override { Inner->OnPostFork(); }
+
+private:
+	explicit FCountingMalloc(FMalloc* InInner) : Inner(InInner) {}
+
+	void CountAllocation(SIZE_T Count)
+	{
+		NumAllocations.fetch_add(1, std::memory_order_relaxed);
+		AllocatedBytes.fetch_add(Count, std::memory_order_relaxed);
+
+		if (FAllocationHook Hook = AllocationHook.load(std::memory_order_acquire))
+			Hook(Count);
+	}
+
+	static FCountingMalloc* Instance;
+
+	FMalloc* Inner;
+
+	std::atomic<uint64> NumAllocations{ 0 };
+	std::atomic<uint64> AllocatedBytes{ 0 };
+	std::atomic<uint64> NumFrees{ 0 };
+	std::atomic<FAllocationHook> AllocationHook{ nullptr };
+};
@@ -13,6 +13,25 @@ enum EEquipmentChangeStatus
 	Unequip   UMETA(DisplayName = "UnEquip")
 };
 
+/** Significance buckets used to scale down the update rate of characters far from (or hidden to) the viewer, higher is more significant */
+UENUM(BlueprintType)
+enum class ECharacterSignificance : uint8
+{
+	Culled   UMETA(DisplayName = "Culled"),
+	Low   UMETA(DisplayName = "Low"),
+	Medium   UMETA(DisplayName = "Medium"),
+	High   UMETA(DisplayName = "High")
+};
+
+/** Team filter used by spatial target queries, see UCharacterSpatialGridSubsystem */
+UENUM(BlueprintType)
+enum class ESpatialTeamFilter : uint8
+{
+	Any   UMETA(DisplayName = "Any"),
+	SameTeam   UMETA(DisplayName = "Same Team"),
+	OtherTeams   UMETA(DisplayName = "Other Teams")
+};
+
 /** Struct used for defining weapon damages, these define a min and max range from which base attack is calculated */
 USTRUCT(BlueprintType)
 struct FWeaponCapturedDamage
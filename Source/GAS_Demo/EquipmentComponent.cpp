@@ -3,13 +3,15 @@
 
 #include "EquipmentComponent.h"
 #include "CharacterBase.h"
+#include "GAS_DemoAssetManager.h"
+#include "ProgressionSaveSubsystem.h"
+#include "CharacterMemoryReport.h"
 
 // Sets default values for this component's properties
 UEquipmentComponent::UEquipmentComponent()
 {
-	// Set this component to be initialized when the game starts, and to be ticked every frame.  You can turn these features
-	// off to improve performance if you don't need them.
-	PrimaryComponentTick.bCanEverTick = true;
+	// Equipment changes are all event driven, this component doesn't need to be ticked
+	PrimaryComponentTick.bCanEverTick = false;
 
 	EquippedWeaponItem = nullptr;
 
@@ -34,15 +36,6 @@ void UEquipmentComponent::BeginPlay()
 }
 
 
-// Called every frame
-void UEquipmentComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
-{
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-
-	// ...
-}
-
-
 bool UEquipmentComponent::EquipWeapon(UWeaponBase* WeaponToEquip)
 {
 	/* Function EquipWeapon
@@ -50,6 +43,8 @@ bool UEquipmentComponent::EquipWeapon(UWeaponBase* WeaponToEquip)
 	* Output: true if Weapon was successfully equipped, false on failure
 	*/
 
+	LLM_SCOPE_BYTAG(GASDemo_Equipment);
+
 	if (!WeaponToEquip) return false;
 
 	if (EquippedWeaponItem)
@@ -67,11 +62,13 @@ bool UEquipmentComponent::EquipWeapon(UWeaponBase* WeaponToEquip)
 
 	// Make sure we could correctly retrieve ability system component
 	// and weapon to equip has a GrantedAbility, then give ability
-	if (MyAbilitySystemComp && WeaponToEquip->GrantedAbility)
+	TSubclassOf<UGameplayAbility> GrantedAbility = WeaponToEquip->GetGrantedAbilityClass();
+	if (MyAbilitySystemComp && GrantedAbility)
 	{
-		AttackAbilitySpecHandle = MyAbilitySystemComp->GiveAbility(WeaponToEquip->GrantedAbility);
+		AttackAbilitySpecHandle = MyAbilitySystemComp->GiveAbility(GrantedAbility);
 	}
 
+	UProgressionSaveSubsystem::MarkDirty(MyChar, EProgressionDirty::Equipment);
 	return true;
 }
 
@@ -98,6 +95,7 @@ void UEquipmentComponent::RemoveWeapon()
 	if (MyAbilitySystemComp) {
 		MyAbilitySystemComp->ClearAbility(AttackAbilitySpecHandle);
 		EquippedWeaponItem = nullptr;
+		UProgressionSaveSubsystem::MarkDirty(MyChar, EProgressionDirty::Equipment);
 	}
 }
 
@@ -113,12 +111,15 @@ bool UEquipmentComponent::EquipConsumable(UItemBase* ItemToEquip)
 	//Failed to Cast Owner to ACharacterBase
 	if (!MyOwner) return false;
 
+	UProgressionSaveSubsystem::MarkDirty(MyOwner, EProgressionDirty::Equipment);
+
 	//Running IsValid to make sure we DO have an item to equip and isn't pending removal or garbage collection
 	//if it is valid we equip item, otherwise return false for non-success
 
 	if (IsValid(ItemToEquip))
 	{
-		if (ItemToEquip->GrantedAbility && MyOwner->GetAbilitySystemComponent()) 
+		TSubclassOf<UGameplayAbility> GrantedAbility = ItemToEquip->GetGrantedAbilityClass();
+		if (GrantedAbility && MyOwner->GetAbilitySystemComponent()) 
 		{
 			//Before giving new abilities make sure we remove previous granted abilities
 			if (EquippedConsumableSpecHandle.IsValid())
@@ -127,7 +128,7 @@ bool UEquipmentComponent::EquipConsumable(UItemBase* ItemToEquip)
 			}
 
 			//Grant Item's Ability to the player
-			FGameplayAbilitySpec GrantedAbilitySpec = FGameplayAbilitySpec(ItemToEquip->GrantedAbility.GetDefaultObject(), 1, 0);
+			FGameplayAbilitySpec GrantedAbilitySpec = FGameplayAbilitySpec(GrantedAbility.GetDefaultObject(), 1, 0);
 			EquippedConsumableSpecHandle = MyOwner->GetAbilitySystemComponent()->GiveAbility(GrantedAbilitySpec);
 		}
 
@@ -171,6 +172,7 @@ void UEquipmentComponent::RemoveConsumable(UItemBase* Item)
 			UnequipConsumable();
 			//Update SlottedConsumables
 			SlottedConsumables.Remove(Item);
+			UProgressionSaveSubsystem::MarkDirty(GetOwner(), EProgressionDirty::Equipment);
 		}
 	}
 }
@@ -246,9 +248,17 @@ void UEquipmentComponent::SlotWeapon(UWeaponBase* Weapon)
 	* any Items we pickup directly
 	*/
 
+	LLM_SCOPE_BYTAG(GASDemo_Equipment);
+
 	//Make sure we don't slot the same weapon more than once
 	if (SlottedWeapons.Find(Weapon) == INDEX_NONE)
+	{
 		SlottedWeapons.Add(Weapon);
+		UProgressionSaveSubsystem::MarkDirty(GetOwner(), EProgressionDirty::Equipment);
+
+		//Slotted weapons can be equipped at any time: stream their ability and actor in ahead of time
+		UGAS_DemoAssetManager::Get().LoadItemBundles(Weapon, { UGAS_DemoAssetManager::GameplayBundle, UGAS_DemoAssetManager::WorldBundle });
+	}
 }
 
 void UEquipmentComponent::SlotItem(UItemBase* Item)
@@ -258,9 +268,63 @@ void UEquipmentComponent::SlotItem(UItemBase* Item)
 	* Output: none (use for slotting an item into SlottedConsumables)
 	*/
 
+	LLM_SCOPE_BYTAG(GASDemo_Equipment);
+
 	//Just make sure we don't slot the same item more than once
 	if (SlottedConsumables.Find(Item) == INDEX_NONE)
 	{
 		SlottedConsumables.Add(Item);
+		UProgressionSaveSubsystem::MarkDirty(GetOwner(), EProgressionDirty::Equipment);
+
+		UGAS_DemoAssetManager::Get().LoadItemBundles(Item, { UGAS_DemoAssetManager::GameplayBundle });
+	}
+}
+
+void UEquipmentComponent::RestoreEquipment(const TArray<UWeaponBase*>& Weapons, const TArray<UItemBase*>& Consumables, int32 WeaponIndex, int32 ConsumableIndex)
+{
+	/* Function RestoreEquipment
+	* Arguments: Weapons/Consumables - slots to restore (nullptr entries are kept as empty slots),
+	* int32 WeaponIndex/ConsumableIndex - slots to equip
+	* Output: none
+	*/
+
+	RemoveWeapon();
+
+	ACharacterBase* MyOwner = Cast<ACharacterBase>(GetOwner());
+	if (MyOwner && MyOwner->GetAbilitySystemComponent() && EquippedConsumableSpecHandle.IsValid())
+	{
+		MyOwner->GetAbilitySystemComponent()->ClearAbility(EquippedConsumableSpecHandle);
+		EquippedConsumableSpecHandle = FGameplayAbilitySpecHandle();
+	}
+	UnequipConsumable();
+
+	//Slots keep their position so the saved equipped indexes still match, index 0 stays the bare-handed slot
+	SlottedWeapons = Weapons;
+	if (SlottedWeapons.Num() == 0 || SlottedWeapons[0] != nullptr)
+	{
+		SlottedWeapons.Insert(nullptr, 0);
+	}
+	SlottedConsumables = Consumables;
+
+	UGAS_DemoAssetManager& AssetManager = UGAS_DemoAssetManager::Get();
+	for (UWeaponBase* Weapon : SlottedWeapons)
+	{
+		if (Weapon) AssetManager.LoadItemBundles(Weapon, { UGAS_DemoAssetManager::GameplayBundle, UGAS_DemoAssetManager::WorldBundle });
+	}
+	for (UItemBase* Item : SlottedConsumables)
+	{
+		if (Item) AssetManager.LoadItemBundles(Item, { UGAS_DemoAssetManager::GameplayBundle });
+	}
+
+	EquippedWeaponIndex = SlottedWeapons.IsValidIndex(WeaponIndex) ? WeaponIndex : 0;
+	if (SlottedWeapons[EquippedWeaponIndex])
+	{
+		EquipWeapon(SlottedWeapons[EquippedWeaponIndex]);
+	}
+
+	EquippedConsumableIndex = SlottedConsumables.IsValidIndex(ConsumableIndex) ? ConsumableIndex : 0;
+	if (SlottedConsumables.IsValidIndex(EquippedConsumableIndex) && SlottedConsumables[EquippedConsumableIndex])
+	{
+		EquipConsumable(SlottedConsumables[EquippedConsumableIndex]);
 	}
 }
\ No newline at end of file
@@ -31,9 +31,6 @@ protected:
 	virtual void BeginPlay() override;
 
 public:	
-	// Called every frame
-	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
-
 	/**
 	* Used to equip a weapon from the inventory into the character
 	* returns true if weapon was successfully equipped, false on failure
@@ -86,6 +83,22 @@ public:
 	UFUNCTION(BlueprintCallable, Category = SlottedItems)
 	void SlotItem(UItemBase* Item);
 
+	/**
+	* Replaces every slot and equipped item (used when loading a save, see UProgressionSaveSubsystem)
+	* Equipment bonuses are NOT applied: saved attribute base values already include them
+	*
+	* @param Weapons  Weapon slots, in order (nullptr for the bare-handed slot or a weapon that couldn't be loaded)
+	* @param Consumables  Consumable slots, in order
+	* @param WeaponIndex  Slot of the weapon to equip
+	* @param ConsumableIndex  Slot of the consumable to equip
+	*/
+	void RestoreEquipment(const TArray<UWeaponBase*>& Weapons, const TArray<UItemBase*>& Consumables, int32 WeaponIndex, int32 ConsumableIndex);
+
+	const TArray<UWeaponBase*>& GetSlottedWeapons() const { return SlottedWeapons; }
+	const TArray<UItemBase*>& GetSlottedConsumables() const { return SlottedConsumables; }
+	int32 GetEquippedWeaponIndex() const { return EquippedWeaponIndex; }
+	int32 GetEquippedConsumableIndex() const { return EquippedConsumableIndex; }
+
 public:
 	/** Reference to the currently equipped weapon */
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = Weapons)
@@ -5,6 +5,10 @@
 #include "CharacterBase.h"
 #include "GameplayEffect.h"
 #include "GameplayEffectExtension.h"
+#include "GASDemoTrace.h"
+#include "GameplayBudgetSubsystem.h"
+#include "ZeroAllocationScope.h"
+#include "ProgressionSaveSubsystem.h"
 
 
 /* 
@@ -65,8 +69,19 @@ void UGASAttributeSet::PostGameplayEffectExecute(const FGameplayEffectModCallbac
 	* Output: none (handle any calculations just before executing the GameplayEffect that will affect any Attribute)
 	*/
 
+	GASDEMO_ZERO_ALLOC_SCOPE("PostGameplayEffectExecute");
+	GASDEMO_TRACE_SCOPE_META("PostGameplayEffectExecute", "%s <- %s", *Data.EvaluatedData.Attribute.GetName(), *GetNameSafe(Data.EffectSpec.Def));
+	GASDEMO_TRACE_COUNTER_INCREMENT(GASDemo_AttributeChanges);
+	UGameplayBudgetSubsystem::Record(EGameplayFrameStat::AttributeChanges);
+
 	Super::PostGameplayEffectExecute(Data);
 
+	//Damage, costs and regeneration only flag the progression here, autosave writes it at most once per AutosaveInterval
+	if (Data.EvaluatedData.Attribute == GetHealthAttribute() || Data.EvaluatedData.Attribute == GetManaAttribute() || Data.EvaluatedData.Attribute == GetStaminaAttribute())
+	{
+		UProgressionSaveSubsystem::MarkDirty(GetOwningActor(), EProgressionDirty::Attributes);
+	}
+
 	FGameplayEffectContextHandle Context = Data.EffectSpec.GetContext();
 	UAbilitySystemComponent* Source = Context.GetOriginalInstigatorAbilitySystemComponent();
 
@@ -0,0 +1,77 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+
+#include "GASDemoTestsCommandlet.h"
+#include "CountingMalloc.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/ScopeExit.h"
+
+UGASDemoTestsCommandlet::UGASDemoTestsCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UGASDemoTestsCommandlet::Main(const FString& Params)
+{
+	/* Function Main
+	* Arguments: const FString& Params - command line, see the class comment for the supported options
+	* Output: 0 if every test run passed, 1 otherwise
+	*/
+
+#if WITH_DEV_AUTOMATION_TESTS
+	//Before any test creates a world or loads anything, see FCountingMalloc
+	FCountingMalloc::Install();
+	ON_SCOPE_EXIT { FCountingMalloc::Uninstall(); };
+
+	FString Filter = TEXT("GASDemo.");
+	FParse::Value(*Params, TEXT("Filter="), Filter);
+
+	FAutomationTestFramework& Framework = FAutomationTestFramework::Get();
+	Framework.SetRequestedTestFilter(EAutomationTestFlags::FilterMask);
+
+	TArray<FAutomationTestInfo> TestInfos;
+	Framework.GetValidTestNames(TestInfos);
+
+	int32 NumTests = 0;
+	int32 NumFailed = 0;
+	for (const FAutomationTestInfo& TestInfo : TestInfos)
+	{
+		if (!TestInfo.GetFullTestPath().StartsWith(Filter)) continue;
+
+		Framework.StartTestByName(TestInfo.GetTestName(), 0);
+		while (!Framework.ExecuteLatentCommands()) {}
+
+		FAutomationTestExecutionInfo ExecutionInfo;
+		const bool bSucceeded = Framework.StopTest(ExecutionInfo);
+
+		for (const FAutomationExecutionEntry& Entry : ExecutionInfo.GetEntries())
+		{
+			if (Entry.Event.Type == EAutomationEventType::Error)
+				UE_LOG(LogTemp, Error, TEXT("  %s"), *Entry.Event.Message);
+			else if (Entry.Event.Type == EAutomationEventType::Warning)
+				UE_LOG(LogTemp, Warning, TEXT("  %s"), *Entry.Event.Message);
+			else
+				UE_LOG(LogTemp, Display, TEXT("  %s"), *Entry.Event.Message);
+		}
+
+		UE_LOG(LogTemp, Display, TEXT("GASDemoTests: %s %s"), *TestInfo.GetFullTestPath(), bSucceeded ? TEXT("passed") : TEXT("FAILED"));
+		NumTests++;
+		NumFailed += bSucceeded ? 0 : 1;
+	}
+
+	if (NumTests == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("GASDemoTests: no test matches %s"), *Filter);
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("GASDemoTests: %d tests, %d failed"), NumTests, NumFailed);
+	return NumFailed > 0 ? 1 : 0;
+#else
+	UE_LOG(LogTemp, Error, TEXT("GASDemoTests: automation tests aren't compiled in this build"));
+	return 1;
+#endif
+}
@@ -0,0 +1,30 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "GASDemoTestsCommandlet.generated.h"
+
+UCLASS()
+class GAS_DEMO_API UGASDemoTestsCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+/*
+* Class UGASDemoTestsCommandlet
+* Runs the automation tests whose name starts with Filter in a commandlet process, with FCountingMalloc installed
+* first thing (see CountingMalloc.h), so the tests checking heap allocations (GASDemo.ZeroAlloc.Damage) see them.
+* In an editor or game process those tests only warn. Tests limited to the editor context (PIE sessions) aren't
+* listed, latent commands run back to back without engine ticks.
+*
+* UnrealEditor-Cmd GAS_Demo.uproject -run=GASDemoTests -nullrhi [-Filter=GASDemo.ZeroAlloc]
+*
+* Every test's errors and warnings are logged. The exit code is 1 if a test failed or none matched the filter.
+*/
+
+public:
+	UGASDemoTestsCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,20 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+
+#include "GASDemoTrace.h"
+
+#if GASDEMO_TRACE_ENABLED
+
+UE_TRACE_CHANNEL_DEFINE(GASDemoChannel)
+
+TRACE_DECLARE_INT_COUNTER(GASDemo_EquipmentChanges, TEXT("GASDemo/EquipmentChanges"));
+TRACE_DECLARE_INT_COUNTER(GASDemo_AttributeInitializations, TEXT("GASDemo/AttributeInitializations"));
+TRACE_DECLARE_INT_COUNTER(GASDemo_LevelChanges, TEXT("GASDemo/LevelChanges"));
+TRACE_DECLARE_INT_COUNTER(GASDemo_AttributeChanges, TEXT("GASDemo/AttributeChanges"));
+TRACE_DECLARE_INT_COUNTER(GASDemo_DamageExecutions, TEXT("GASDemo/DamageExecutions"));
+TRACE_DECLARE_INT_COUNTER(GASDemo_InventoryOperations, TEXT("GASDemo/InventoryOperations"));
+TRACE_DECLARE_INT_COUNTER(GASDemo_InventoryItemsAdded, TEXT("GASDemo/InventoryItemsAdded"));
+TRACE_DECLARE_INT_COUNTER(GASDemo_InventoryItemsRemoved, TEXT("GASDemo/InventoryItemsRemoved"));
+TRACE_DECLARE_INT_COUNTER(GASDemo_MeleeHitTargets, TEXT("GASDemo/MeleeHitTargets"));
+
+#endif
@@ -0,0 +1,86 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "ProfilingDebugging/MiscTrace.h"
+
+/*
+* Unreal Insights instrumentation of the gameplay hot paths (equipment, attributes, damage, inventory).
+*
+* Everything is traced on the GASDemo channel, which is off by default: start the game with -trace=default,gasdemo
+* (CPU scopes also need the cpu channel and bookmarks the bookmark channel, both part of default). While the channel
+* is off, every scope, counter and bookmark below is a single channel check, their metadata is only formatted when
+* the channel is on.
+*
+* A scope with metadata is traced as a fixed name scope (so it aggregates in the timing view) wrapping a scope
+* named after its metadata, e.g. PostGameplayEffectExecute > "Health <- GE_Damage". Every distinct name is a new
+* timer in the trace, so metadata is limited to asset names (attributes, effects, equipment): values such as item
+* counts or levels go to counters or bookmarks instead.
+*/
+
+#define GASDEMO_TRACE_ENABLED (CPUPROFILERTRACE_ENABLED && COUNTERSTRACE_ENABLED && MISCTRACE_ENABLED)
+
+#if GASDEMO_TRACE_ENABLED
+
+UE_TRACE_CHANNEL_EXTERN(GASDemoChannel, GAS_DEMO_API)
+
+//Counters of gameplay events, only updated while the channel is on (totals since it was enabled)
+TRACE_DECLARE_INT_COUNTER_EXTERN(GASDemo_EquipmentChanges);
+TRACE_DECLARE_INT_COUNTER_EXTERN(GASDemo_AttributeInitializations);
+TRACE_DECLARE_INT_COUNTER_EXTERN(GASDemo_LevelChanges);
+TRACE_DECLARE_INT_COUNTER_EXTERN(GASDemo_AttributeChanges);
+TRACE_DECLARE_INT_COUNTER_EXTERN(GASDemo_DamageExecutions);
+TRACE_DECLARE_INT_COUNTER_EXTERN(GASDemo_InventoryOperations);
+TRACE_DECLARE_INT_COUNTER_EXTERN(GASDemo_InventoryItemsAdded);
+TRACE_DECLARE_INT_COUNTER_EXTERN(GASDemo_InventoryItemsRemoved);
+TRACE_DECLARE_INT_COUNTER_EXTERN(GASDemo_MeleeHitTargets);
+
+#define GASDEMO_TRACE_IS_ENABLED() UE_TRACE_CHANNELEXPR_IS_ENABLED(GASDemoChannel)
+
+/** Named CPU scope, Name is a string literal */
+#define GASDEMO_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR(Name, GASDemoChannel)
+
+/** Named CPU scope wrapping a scope named after its metadata (printf style Format literal and arguments, only evaluated while the channel is on), see above for what metadata can hold */
+#define GASDEMO_TRACE_SCOPE_META(Name, Format, ...) \
+	GASDEMO_TRACE_SCOPE(Name); \
+	TOptional<FCpuProfilerTrace::FDynamicEventScope> PREPROCESSOR_JOIN(GASDemoTraceMetadataScope, __LINE__); \
+	if (GASDEMO_TRACE_IS_ENABLED()) \
+	{ \
+		PREPROCESSOR_JOIN(GASDemoTraceMetadataScope, __LINE__).Emplace(*FString::Printf(TEXT(Format), ##__VA_ARGS__), GASDemoChannel); \
+	}
+
+#define GASDEMO_TRACE_COUNTER_ADD(Counter, Amount) \
+	do \
+	{ \
+		if (GASDEMO_TRACE_IS_ENABLED()) \
+		{ \
+			TRACE_COUNTER_ADD(Counter, Amount); \
+		} \
+	} while (0)
+
+#define GASDEMO_TRACE_COUNTER_INCREMENT(Counter) GASDEMO_TRACE_COUNTER_ADD(Counter, 1)
+
+/** Bookmark of a rare event in the timeline (printf style Format literal and arguments, only evaluated while the channel is on) */
+#define GASDEMO_TRACE_BOOKMARK(Format, ...) \
+	do \
+	{ \
+		if (GASDEMO_TRACE_IS_ENABLED()) \
+		{ \
+			TRACE_BOOKMARK(TEXT(Format), ##__VA_ARGS__); \
+		} \
+	} while (0)
+
+#else
+
+#define GASDEMO_TRACE_IS_ENABLED() false
+#define GASDEMO_TRACE_SCOPE(Name)
+#define GASDEMO_TRACE_SCOPE_META(Name, Format, ...)
+#define GASDEMO_TRACE_COUNTER_ADD(Counter, Amount) do {} while (0)
+#define GASDEMO_TRACE_COUNTER_INCREMENT(Counter) do {} while (0)
+#define GASDEMO_TRACE_BOOKMARK(Format, ...) do {} while (0)
+
+#endif
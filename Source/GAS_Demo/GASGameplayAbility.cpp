@@ -2,4 +2,114 @@
 
 
 #include "GASGameplayAbility.h"
+#include "AbilitySystemComponent.h"
+#include "CharacterBase.h"
+#include "Engine/World.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "GameplayTask.h"
+#include "TimerManager.h"
 
+UGASGameplayAbility::UGASGameplayAbility()
+{
+	//Project defaults: predicted locally, no instance replication (instancing policy is left to each ability)
+	NetExecutionPolicy = EGameplayAbilityNetExecutionPolicy::LocalPredicted;
+	ReplicationPolicy = EGameplayAbilityReplicationPolicy::ReplicateNo;
+
+	bPoolInstances = true;
+	bBatchActivationRPCs = false;
+}
+
+bool UGASGameplayAbility::DoesAbilitySatisfyTagRequirements(const UAbilitySystemComponent& AbilitySystemComponent, const FGameplayTagContainer* SourceTags, const FGameplayTagContainer* TargetTags, OUT FGameplayTagContainer* OptionalRelevantTags) const
+{
+	/* Function DoesAbilitySatisfyTagRequirements
+	* Arguments: const UAbilitySystemComponent& AbilitySystemComponent - ASC trying to activate this ability,
+	* SourceTags, TargetTags - optional tags of the activation, OptionalRelevantTags - filled with the failure reason
+	* Output: true if the ability's tag requirements are met
+	*/
+
+	const ACharacterBase* Character = Cast<ACharacterBase>(AbilitySystemComponent.GetAvatarActor_Direct());
+
+	const bool bOnlyOwnerRequirements = SourceRequiredTags.IsEmpty() && SourceBlockedTags.IsEmpty()
+		&& TargetRequiredTags.IsEmpty() && TargetBlockedTags.IsEmpty();
+
+	if (Character && Character->GetOwnedTagBits().IsInitialized() && bOnlyOwnerRequirements)
+	{
+		const FCompiledTagQuery& Query = GetCompiledActivationQuery();
+		if (Query.IsValid() && !AbilitySystemComponent.AreAbilityTagsBlocked(AbilityTags) && Query.Matches(Character->GetOwnedTagBits()))
+			return true;
+
+		//Failed (or not compiled): the regular check fills OptionalRelevantTags with the failure reason
+	}
+
+	return Super::DoesAbilitySatisfyTagRequirements(AbilitySystemComponent, SourceTags, TargetTags, OptionalRelevantTags);
+}
+
+const FCompiledTagQuery& UGASGameplayAbility::GetCompiledActivationQuery() const
+{
+	if (!bActivationQueryCompiled)
+	{
+		CompiledActivationQuery = FCompiledTagQuery::FromRequirements(ActivationRequiredTags, ActivationBlockedTags);
+		bActivationQueryCompiled = true;
+	}
+
+	return CompiledActivationQuery;
+}
+
+bool UGASGameplayAbility::CanPoolInstances() const
+{
+	return bPoolInstances
+		&& GetInstancingPolicy() == EGameplayAbilityInstancingPolicy::InstancedPerExecution
+		&& GetReplicationPolicy() == EGameplayAbilityReplicationPolicy::ReplicateNo;
+}
+
+void UGASGameplayAbility::EndAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, bool bReplicateEndAbility, bool bWasCancelled)
+{
+	//Super ends tasks/timers and notifies the ASC, which puts pooled instances back in its pool
+	const bool bReturningToPool = IsInstantiated() && CanPoolInstances() && IsEndAbilityValid(Handle, ActorInfo);
+
+	Super::EndAbility(Handle, ActorInfo, ActivationInfo, bReplicateEndAbility, bWasCancelled);
+
+	if (bReturningToPool)
+		ResetPooledInstance();
+}
+
+void UGASGameplayAbility::ExternalEndAbility()
+{
+	if (IsInstantiated() && IsActive())
+		EndAbility(CurrentSpecHandle, CurrentActorInfo, CurrentActivationInfo, true, false);
+}
+
+void UGASGameplayAbility::ResetPooledInstance()
+{
+	/* Function ResetPooledInstance
+	* Arguments: none
+	* Output: none (stops pending work and copies every variable declared in Blueprint back from the class default object)
+	*/
+
+	//EndAbility already did this, but OnEndAbility handlers may have started new ones after it
+	if (UWorld* World = GetWorld())
+	{
+		World->GetLatentActionManager().RemoveActionsForObject(this);
+		World->GetTimerManager().ClearAllTimersForObject(this);
+	}
+
+	//Popped first: ending a task removes it from ActiveTasks through OnGameplayTaskDeactivated
+	while (ActiveTasks.Num() > 0)
+	{
+		if (UGameplayTask* Task = ActiveTasks.Pop(false))
+			Task->TaskOwnerEnded();
+	}
+
+	const UObject* ClassDefaults = GetClass()->GetDefaultObject();
+
+	for (TFieldIterator<FProperty> It(GetClass()); It; ++It)
+	{
+		//Native state is reset by UGameplayAbility itself on activation and end
+		if (!Cast<UBlueprintGeneratedClass>(It->GetOwnerClass())) continue;
+
+		//Copying those would point the instance at the CDO's subobjects, the instance keeps its own
+		if (It->HasAnyPropertyFlags(CPF_InstancedReference | CPF_ContainsInstancedReference)) continue;
+
+		It->CopyCompleteValue_InContainer(this, ClassDefaults);
+	}
+}
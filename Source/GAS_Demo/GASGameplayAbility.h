@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Abilities/GameplayAbility.h"
+#include "GameplayTagBitset.h"
 #include "GASGameplayAbility.generated.h"
 
 /**
@@ -13,5 +14,70 @@ UCLASS()
 class GAS_DEMO_API UGASGameplayAbility : public UGameplayAbility
 {
 	GENERATED_BODY()
-	
+
+/*
+* Class UGASGameplayAbility
+* Base class for the demo's abilities.
+* Activation tag requirements (ActivationRequiredTags / ActivationBlockedTags) are compiled once into bit masks
+* and checked against the avatar's owned tags bitset (ACharacterBase::GetOwnedTagBits) instead of searching
+* the ASC tag map on every activation attempt. Abilities using Source/Target tag requirements, avatars that
+* are not ACharacterBase and failed checks (which have to report the failure tags) use the regular path.
+*
+* The automation tests GASDemo.Tags.Bitset.* check that both paths agree and compare their cost.
+*
+* Instancing: abilities keep the engine's InstancingPolicy default (InstancedPerExecution, a new UObject on every
+* attack/roll) unless their Blueprint overrides it. InstancedPerExecution instances are recycled by
+* UBaseAbilitySystemComponent when bPoolInstances is set, EndAbility then resets the instance (Blueprint variables,
+* latent actions, timers and tasks) before it goes back to the pool.
+*/
+
+public:
+	UGASGameplayAbility();
+
+	//~ Begin UGameplayAbility
+	virtual bool DoesAbilitySatisfyTagRequirements(const UAbilitySystemComponent& AbilitySystemComponent, const FGameplayTagContainer* SourceTags = nullptr, const FGameplayTagContainer* TargetTags = nullptr, OUT FGameplayTagContainer* OptionalRelevantTags = nullptr) const override;
+	virtual void EndAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, bool bReplicateEndAbility, bool bWasCancelled) override;
+	//~ End UGameplayAbility
+
+	/** Activation requirements compiled into bit masks, compiled on first use */
+	const FCompiledTagQuery& GetCompiledActivationQuery() const;
+
+	/** Tags that block the activation of this ability (protected in UGameplayAbility) */
+	const FGameplayTagContainer& GetActivationBlockedTags() const { return ActivationBlockedTags; }
+
+	/** True if instances of this ability are recycled instead of garbage collected (InstancedPerExecution, not replicated, bPoolInstances) */
+	bool CanPoolInstances() const;
+
+	/** True if this ability sends its activation, target data and end to the server as a single batched RPC */
+	bool ShouldBatchRPCs() const { return bBatchActivationRPCs; }
+
+	/** Ends the ability from outside (used to end abilities right after a batched activation) */
+	UFUNCTION(BlueprintCallable, Category = Ability)
+	void ExternalEndAbility();
+
+protected:
+
+	/**
+	* Batch the activation, target data and end server RPCs of this ability into one RPC when it is activated
+	* through UBaseAbilitySystemComponent (input or BatchRPCTryActivateAbility). Only useful for abilities that
+	* send their target data and end within the frame they are activated (e.g. instant melee/hitscan attacks).
+	*/
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Advanced)
+	bool bBatchActivationRPCs;
+
+	/** Recycle instances of this ability when it is InstancedPerExecution (replicated instances are never pooled) */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Advanced)
+	bool bPoolInstances;
+
+	/**
+	* Called at the end of EndAbility on pooled instances: stops what could still be pending (latent actions, timers,
+	* tasks) and resets every Blueprint variable to its class default. Instanced subobjects are kept, the instance
+	* owns its own copies.
+	*/
+	virtual void ResetPooledInstance();
+
+private:
+
+	mutable FCompiledTagQuery CompiledActivationQuery;
+	mutable bool bActivationQueryCompiled = false;
 };
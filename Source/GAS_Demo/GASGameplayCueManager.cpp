@@ -0,0 +1,314 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+
+#include "GASGameplayCueManager.h"
+#include "CharacterBase.h"
+#include "CharacterSignificanceSubsystem.h"
+#include "AbilitySystemGlobals.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CVarCueStats(
+	TEXT("GAS.Cues.Stats"),
+	TEXT("Prints GameplayCue routing stats (coalesced/capped cues, notify actor spawns, frame time). Use 'GAS.Cues.Stats reset' to clear counters."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		UGASGameplayCueManager* CueManager = Cast<UGASGameplayCueManager>(UAbilitySystemGlobals::Get().GetGameplayCueManager());
+		if (!CueManager)
+		{
+			Ar.Log(TEXT("GlobalGameplayCueManagerClass is not UGASGameplayCueManager"));
+			return;
+		}
+
+		if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+		{
+			CueManager->ResetStats();
+			return;
+		}
+
+		CueManager->DumpStats(Ar);
+	}));
+
+UGASGameplayCueManager::UGASGameplayCueManager()
+{
+	//Default values, can be overriden in DefaultGame.ini under [/Script/GAS_Demo.GASGameplayCueManager]
+	bCoalesceExecutedCues = true;
+	MaxCosmeticCuesPerFrame = 32;
+
+	CurrentFrame = 0;
+	CuesThisFrame = 0;
+	FrameCueCycles = 0;
+	bPreallocating = false;
+	bAppliedPreallocatedCueActors = false;
+
+	ResetStats();
+}
+
+void UGASGameplayCueManager::OnCreated()
+{
+	Super::OnCreated();
+
+	FWorldDelegates::OnWorldInitializedActors.AddUObject(this, &UGASGameplayCueManager::OnWorldInitializedActors);
+	FWorldDelegates::OnWorldTickStart.AddUObject(this, &UGASGameplayCueManager::OnWorldTickStart);
+	FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &UGASGameplayCueManager::OnWorldPostActorTick);
+}
+
+void UGASGameplayCueManager::HandleGameplayCue(AActor* TargetActor, FGameplayTag GameplayCueTag, EGameplayCueEvent::Type EventType, const FGameplayCueParameters& Parameters, EGameplayCueExecutionOptions Options)
+{
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	UpdateFrame();
+
+	if (EventType == EGameplayCueEvent::Executed)
+	{
+		//Held until the end of the frame, later executions on the same target are merged into it
+		if (bCoalesceExecutedCues && TargetActor && !CoalesceExcludedCueTags.HasTagExact(GameplayCueTag))
+		{
+			const TPair<TObjectKey<AActor>, FGameplayTag> Key(TargetActor, GameplayCueTag);
+			if (const int32* PendingIndex = PendingExecutedCueIndices.Find(Key))
+			{
+				FPendingExecutedCue& Pending = PendingExecutedCues[*PendingIndex];
+				MergeExecutedCueParameters(Pending.Parameters, Parameters);
+				Pending.bLocallyRelevant |= IsLocallyRelevant(TargetActor, Parameters);
+				StatCoalescedCues++;
+			}
+			else
+			{
+				PendingExecutedCueIndices.Add(Key, PendingExecutedCues.Num());
+				PendingExecutedCues.Add({ TargetActor, GameplayCueTag, Parameters, Options, IsLocallyRelevant(TargetActor, Parameters) });
+			}
+
+			FrameCueCycles += FPlatformTime::Cycles64() - StartCycles;
+			return;
+		}
+
+		if (!CanRouteExecutedCue(TargetActor, IsLocallyRelevant(TargetActor, Parameters)))
+		{
+			return;
+		}
+	}
+
+	StatRoutedCues++;
+	Super::HandleGameplayCue(TargetActor, GameplayCueTag, EventType, Parameters, Options);
+
+	FrameCueCycles += FPlatformTime::Cycles64() - StartCycles;
+}
+
+bool UGASGameplayCueManager::CanRouteExecutedCue(AActor* TargetActor, bool bLocallyRelevant)
+{
+	/* Function CanRouteExecutedCue
+	* Arguments: AActor* TargetActor - target of the cue
+	*			 bool bLocallyRelevant - the cue targets or comes from the local player
+	* Output: true if the cue can be routed (counted against this frame's cap), false if it is capped or throttled
+	*/
+
+	if (MaxCosmeticCuesPerFrame > 0 && CuesThisFrame >= MaxCosmeticCuesPerFrame && !bLocallyRelevant)
+	{
+		StatCappedCues++;
+		return false;
+	}
+
+	if (ShouldThrottleCosmeticCue(TargetActor))
+		return false;
+
+	CuesThisFrame++;
+	return true;
+}
+
+void UGASGameplayCueManager::MergeExecutedCueParameters(FGameplayCueParameters& Merged, const FGameplayCueParameters& Parameters)
+{
+	/* Function MergeExecutedCueParameters
+	* Arguments: FGameplayCueParameters& Merged - parameters of the cue held for this frame
+	*			 const FGameplayCueParameters& Parameters - parameters of another execution of the same cue
+	* Output: none (a damage number cue shows the frame's total, location, instigator and context come from the latest execution)
+	*/
+
+	const float RawMagnitude = Merged.RawMagnitude + Parameters.RawMagnitude;
+	const float NormalizedMagnitude = FMath::Max(Merged.NormalizedMagnitude, Parameters.NormalizedMagnitude);
+	FGameplayTagContainer SourceTags = MoveTemp(Merged.AggregatedSourceTags);
+	FGameplayTagContainer TargetTags = MoveTemp(Merged.AggregatedTargetTags);
+
+	Merged = Parameters;
+	Merged.RawMagnitude = RawMagnitude;
+	Merged.NormalizedMagnitude = NormalizedMagnitude;
+	Merged.AggregatedSourceTags.AppendTags(SourceTags);
+	Merged.AggregatedTargetTags.AppendTags(TargetTags);
+}
+
+void UGASGameplayCueManager::FlushPendingExecutedCues()
+{
+	if (PendingExecutedCues.Num() == 0) return;
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	//Swapped first: routing a cue can execute other cues, those are held for the next flush
+	Swap(FlushingExecutedCues, PendingExecutedCues);
+	PendingExecutedCueIndices.Reset();
+
+	for (FPendingExecutedCue& Pending : FlushingExecutedCues)
+	{
+		AActor* TargetActor = Pending.TargetActor.Get();
+		if (!TargetActor || !CanRouteExecutedCue(TargetActor, Pending.bLocallyRelevant)) continue;
+
+		StatRoutedCues++;
+		Super::HandleGameplayCue(TargetActor, Pending.GameplayCueTag, EGameplayCueEvent::Executed, Pending.Parameters, Pending.Options);
+	}
+	FlushingExecutedCues.Reset();
+
+	FrameCueCycles += FPlatformTime::Cycles64() - StartCycles;
+}
+
+void UGASGameplayCueManager::OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	FlushPendingExecutedCues();
+}
+
+void UGASGameplayCueManager::OnWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (!World || !World->IsGameWorld() || World->GetNetMode() == NM_DedicatedServer) return;
+
+	TGuardValue<bool> PreallocationGuard(bPreallocating, true);
+	UpdatePreallocation(World);
+}
+
+void UGASGameplayCueManager::UpdateFrame()
+{
+	if (CurrentFrame == GFrameCounter) return;
+
+	//Cues executed after the last world tick of the previous frame
+	FlushPendingExecutedCues();
+
+	if (FrameCueCycles > 0)
+	{
+		StatFrames++;
+		StatCueCycles += FrameCueCycles;
+		StatMaxFrameCueCycles = FMath::Max(StatMaxFrameCueCycles, FrameCueCycles);
+	}
+
+	CurrentFrame = GFrameCounter;
+	CuesThisFrame = 0;
+	FrameCueCycles = 0;
+}
+
+bool UGASGameplayCueManager::IsLocallyRelevant(const AActor* TargetActor, const FGameplayCueParameters& Parameters)
+{
+	const APawn* TargetPawn = Cast<APawn>(TargetActor);
+	const APawn* InstigatorPawn = Cast<APawn>(Parameters.Instigator.Get());
+
+	return (TargetPawn && TargetPawn->IsLocallyControlled()) || (InstigatorPawn && InstigatorPawn->IsLocallyControlled());
+}
+
+bool UGASGameplayCueManager::ShouldThrottleCosmeticCue(AActor* TargetActor)
+{
+	/* Function ShouldThrottleCosmeticCue
+	* Arguments: AActor TargetActor - target of the cue
+	* Output: true if the cue should be skipped, false otherwise
+	*/
+
+	ACharacterBase* Character = Cast<ACharacterBase>(TargetActor);
+	if (!Character) return false;
+
+	UWorld* World = Character->GetWorld();
+	UCharacterSignificanceSubsystem* Significance = World ? World->GetSubsystem<UCharacterSignificanceSubsystem>() : nullptr;
+	if (!Significance) return false;
+
+	const FSignificanceBucketSettings& Settings = Significance->GetBucketSettings(Character->SignificanceBucket);
+	const float CurrentTime = World->GetTimeSeconds();
+
+	if (Settings.bSuppressCosmeticCues ||
+		(Settings.MinCosmeticCueInterval > 0.f && CurrentTime - Character->LastCosmeticCueTime < Settings.MinCosmeticCueInterval))
+	{
+		Significance->RecordSuppressedCue();
+		return true;
+	}
+
+	Character->LastCosmeticCueTime = CurrentTime;
+	return false;
+}
+
+AGameplayCueNotify_Actor* UGASGameplayCueManager::GetInstancedCueActor(AActor* TargetActor, UClass* GameplayCueNotifyActorClass, const FGameplayCueParameters& Parameters)
+{
+	//A shorter recycle list after the call means the instance came from the pool
+	UWorld* World = TargetActor ? TargetActor->GetWorld() : nullptr;
+	const auto* PooledInstances = World ? GetPreallocationInfo(World).PreallocatedInstances.Find(GameplayCueNotifyActorClass) : nullptr;
+	const int32 PooledBefore = PooledInstances ? PooledInstances->Num() : 0;
+
+	AGameplayCueNotify_Actor* Instance = Super::GetInstancedCueActor(TargetActor, GameplayCueNotifyActorClass, Parameters);
+
+	PooledInstances = World ? GetPreallocationInfo(World).PreallocatedInstances.Find(GameplayCueNotifyActorClass) : nullptr;
+	if (Instance && PooledInstances && PooledInstances->Num() < PooledBefore)
+		StatPoolReuses++;
+
+	return Instance;
+}
+
+void UGASGameplayCueManager::OnWorldInitializedActors(const UWorld::FActorsInitializedParams& Params)
+{
+	UWorld* World = Params.World;
+	if (!World || !World->IsGameWorld() || World->GetNetMode() == NM_DedicatedServer) return;
+
+	World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &UGASGameplayCueManager::OnActorSpawned));
+
+	ApplyPreallocatedCueActors();
+}
+
+void UGASGameplayCueManager::ApplyPreallocatedCueActors()
+{
+	/* Function ApplyPreallocatedCueActors
+	* Arguments: none
+	* Output: none (each listed class gets at least its configured NumPreallocatedInstances, the engine then fills the pools)
+	*/
+
+	if (bAppliedPreallocatedCueActors) return;
+	bAppliedPreallocatedCueActors = true;
+
+	for (const FPreallocatedCueActor& Entry : PreallocatedCueActors)
+	{
+		UClass* CueClass = Entry.CueClass.LoadSynchronous();
+		AGameplayCueNotify_Actor* CueCDO = CueClass ? CueClass->GetDefaultObject<AGameplayCueNotify_Actor>() : nullptr;
+		if (!CueCDO)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("PreallocatedCueActors: %s isn't a GameplayCueNotify_Actor class, static notifies have no instances to preallocate"), *Entry.CueClass.ToString());
+			continue;
+		}
+
+		//The engine reads the count from the class default object
+		CueCDO->NumPreallocatedInstances = FMath::Max(CueCDO->NumPreallocatedInstances, Entry.Count);
+		CheckForPreallocation(CueClass);
+	}
+}
+
+void UGASGameplayCueManager::OnActorSpawned(AActor* SpawnedActor)
+{
+	if (!Cast<AGameplayCueNotify_Actor>(SpawnedActor)) return;
+
+	if (bPreallocating)
+		StatPreallocatedActors++;
+	else
+		StatSpawnedActors++;
+}
+
+void UGASGameplayCueManager::DumpStats(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("GameplayCues routed: %llu, coalesced: %llu, capped: %llu (cap %d per frame)"), StatRoutedCues, StatCoalescedCues, StatCappedCues, MaxCosmeticCuesPerFrame);
+	Ar.Logf(TEXT("  Notify actors spawned: %llu, reused from pool: %llu, preallocated: %llu"), StatSpawnedActors, StatPoolReuses, StatPreallocatedActors);
+
+	if (StatFrames > 0)
+	{
+		Ar.Logf(TEXT("  Cue time: avg %.4fms per frame with cues, max %.4fms (%llu frames)"),
+			FPlatformTime::ToMilliseconds64(StatCueCycles) / (double)StatFrames, FPlatformTime::ToMilliseconds64(StatMaxFrameCueCycles), StatFrames);
+	}
+}
+
+void UGASGameplayCueManager::ResetStats()
+{
+	StatRoutedCues = 0;
+	StatCoalescedCues = 0;
+	StatCappedCues = 0;
+	StatSpawnedActors = 0;
+	StatPreallocatedActors = 0;
+	StatPoolReuses = 0;
+	StatFrames = 0;
+	StatCueCycles = 0;
+	StatMaxFrameCueCycles = 0;
+}
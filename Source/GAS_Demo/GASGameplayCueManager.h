@@ -0,0 +1,166 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayCueManager.h"
+#include "GameplayCueNotify_Actor.h"
+#include "Engine/World.h"
+#include "GASGameplayCueManager.generated.h"
+
+/** Executed cue held until the end of the frame, with the parameters of every execution coalesced into it */
+struct FPendingExecutedCue
+{
+	TWeakObjectPtr<AActor> TargetActor;
+	FGameplayTag GameplayCueTag;
+	FGameplayCueParameters Parameters;
+	EGameplayCueExecutionOptions Options;
+
+	/** One of the executions targets or comes from a locally controlled pawn */
+	bool bLocallyRelevant;
+};
+
+/** Notify actor class and the number of its instances kept in the recycle pool of each game world */
+USTRUCT()
+struct FPreallocatedCueActor
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY()
+	TSoftClassPtr<AGameplayCueNotify_Actor> CueClass;
+
+	UPROPERTY()
+	int32 Count = 0;
+};
+
+/**
+ *
+ */
+UCLASS(config = Game)
+class GAS_DEMO_API UGASGameplayCueManager : public UGameplayCueManager
+{
+	GENERATED_BODY()
+
+/*
+* Class UGASGameplayCueManager
+* Project's GameplayCueManager (set as GlobalGameplayCueManagerClass in DefaultGame.ini)
+* Throttles cosmetic GameplayCues on characters with low significance, see UCharacterSignificanceSubsystem.
+* Only Executed cues (one-shot hits, poison ticks...) are throttled: OnActive/WhileActive/Removed events
+* are always routed so persistent cues never get stuck on or off.
+*
+* On top of that, for Executed cues:
+* 1) Identical cues (same tag on the same target) are coalesced into one per frame. They are routed once the world's
+*    actors have ticked, with the parameters of every execution merged (MergeExecutedCueParameters): magnitudes add
+*    up, tags are combined, the rest comes from the latest execution.
+* 2) At most MaxCosmeticCuesPerFrame are routed per frame, cues on or from the local player are never capped
+* Notify actors are preallocated by the engine (AGameplayCueNotify_Actor::NumPreallocatedInstances, set on each cue
+* Blueprint): UpdatePreallocation is called at the start of every game world tick, it spawns one instance per call
+* until each class has its count in the recycle pool. PreallocatedCueActors (DefaultGame.ini) raises the count of
+* the listed classes from config, so frequent cues (hits, damage over time) are preallocated without editing their
+* Blueprints.
+*
+* Use the console command GAS.Cues.Stats to check routed/coalesced/capped cues, notify actor spawns and cue frame time.
+*/
+
+public:
+	UGASGameplayCueManager();
+
+	//~ Begin UGameplayCueManager
+	virtual void OnCreated() override;
+	virtual void HandleGameplayCue(AActor* TargetActor, FGameplayTag GameplayCueTag, EGameplayCueEvent::Type EventType, const FGameplayCueParameters& Parameters, EGameplayCueExecutionOptions Options = EGameplayCueExecutionOptions::Default) override;
+	virtual AGameplayCueNotify_Actor* GetInstancedCueActor(AActor* TargetActor, UClass* GameplayCueNotifyActorClass, const FGameplayCueParameters& Parameters) override;
+	//~ End UGameplayCueManager
+
+	/** Prints cue routing stats to the output device */
+	void DumpStats(FOutputDevice& Ar) const;
+
+	/** Clears the counters shown in DumpStats */
+	void ResetStats();
+
+protected:
+
+	/** Returns true if the Executed cue on TargetActor should be skipped because of its significance bucket, records the cue time otherwise */
+	bool ShouldThrottleCosmeticCue(AActor* TargetActor);
+
+	/** Returns true if the cue targets or comes from a locally controlled pawn (those are never capped) */
+	static bool IsLocallyRelevant(const AActor* TargetActor, const FGameplayCueParameters& Parameters);
+
+	/** Merges the parameters of another execution of the same cue into Merged */
+	static void MergeExecutedCueParameters(FGameplayCueParameters& Merged, const FGameplayCueParameters& Parameters);
+
+	/** Returns true if an Executed cue can be routed this frame (cap and significance), counts it if so */
+	bool CanRouteExecutedCue(AActor* TargetActor, bool bLocallyRelevant);
+
+	/** Routes the coalesced Executed cues held this frame */
+	void FlushPendingExecutedCues();
+
+	/** Starts counting notify actor spawns in World once its actors are initialized */
+	void OnWorldInitializedActors(const UWorld::FActorsInitializedParams& Params);
+
+	/** Lets the engine preallocate notify actors (NumPreallocatedInstances), one spawn per tick */
+	void OnWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+	/** Routes the cues coalesced during the world's actor tick */
+	void OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+	/** Counts notify actors spawned by the cue system */
+	void OnActorSpawned(AActor* SpawnedActor);
+
+	/** Resets the per frame coalescing and cap state when a new frame starts */
+	void UpdateFrame();
+
+	/** Coalesce Executed cues with the same tag on the same target within a frame */
+	UPROPERTY(Config)
+	bool bCoalesceExecutedCues;
+
+	/** Cues that are never coalesced (e.g. cues showing a different value on every execution) */
+	UPROPERTY(Config)
+	FGameplayTagContainer CoalesceExcludedCueTags;
+
+	/** Max number of Executed cues routed per frame (0 = no cap) */
+	UPROPERTY(Config)
+	int32 MaxCosmeticCuesPerFrame;
+
+	/** Notify actors preallocated in every game world, on top of the NumPreallocatedInstances set on their Blueprint */
+	UPROPERTY(Config)
+	TArray<FPreallocatedCueActor> PreallocatedCueActors;
+
+	/** Loads the PreallocatedCueActors classes and registers them for preallocation (once) */
+	void ApplyPreallocatedCueActors();
+
+private:
+
+	/** Frame the coalescing and cap state belongs to */
+	uint64 CurrentFrame;
+
+	/** Executed cues waiting for the end of the frame, and their index by target and tag */
+	TArray<FPendingExecutedCue> PendingExecutedCues;
+	TMap<TPair<TObjectKey<AActor>, FGameplayTag>, int32> PendingExecutedCueIndices;
+
+	/** Cues being routed by FlushPendingExecutedCues (kept to reuse its allocation) */
+	TArray<FPendingExecutedCue> FlushingExecutedCues;
+
+	/** Number of Executed cues routed this frame */
+	int32 CuesThisFrame;
+
+	/** Cycles spent routing cues this frame */
+	uint64 FrameCueCycles;
+
+	/** True while the engine preallocates notify actors (those spawns are counted separately) */
+	bool bPreallocating;
+
+	/** True once PreallocatedCueActors was applied */
+	bool bAppliedPreallocatedCueActors;
+
+	//Stats counters, see DumpStats
+	uint64 StatRoutedCues;
+	uint64 StatCoalescedCues;
+	uint64 StatCappedCues;
+	uint64 StatSpawnedActors;
+	uint64 StatPreallocatedActors;
+	uint64 StatPoolReuses;
+	uint64 StatFrames;
+	uint64 StatCueCycles;
+	uint64 StatMaxFrameCueCycles;
+};
@@ -16,5 +16,15 @@ public class GAS_Demo : ModuleRules
 		PublicDependencyModuleNames.AddRange(new string[] { "AIModule", "NavigationSystem" });
 		//Slate
 		PublicDependencyModuleNames.AddRange(new string[] { "SlateCore" });
+		//Significance (update rate LOD for characters)
+		PublicDependencyModuleNames.AddRange(new string[] { "SignificanceManager" });
+		//Json (benchmark reports)
+		PrivateDependencyModuleNames.AddRange(new string[] { "Json" });
+
+		//Automation tests (Tests folder) include the module's headers
+		PrivateIncludePaths.Add(ModuleDirectory);
+		//Automation tests running a PIE session, Blueprint graph edits of the item reference migration commandlet
+		if (Target.bBuildEditor)
+			PrivateDependencyModuleNames.AddRange(new string[] { "UnrealEd", "BlueprintGraph" });
 	}
 }
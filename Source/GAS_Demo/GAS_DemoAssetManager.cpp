@@ -3,10 +3,50 @@
 
 #include "GAS_DemoAssetManager.h"
 #include "AbilitySystemGlobals.h"
+#include "ItemBase.h"
+#include "WeaponBase.h"
+#include "ItemStatTableCommandlet.h"
+#include "Engine/World.h"
+#include "GameDelegates.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectArray.h"
+#include "Containers/Ticker.h"
+#if WITH_EDITOR
+#include "Editor.h"
+#endif
 
 const FPrimaryAssetType UGAS_DemoAssetManager::WeaponItemType = TEXT("Weapon");
 const FPrimaryAssetType UGAS_DemoAssetManager::ConsumableItemType = TEXT("Consumable");
 
+const FName UGAS_DemoAssetManager::UIBundle = FName(TEXT("UI"));
+const FName UGAS_DemoAssetManager::GameplayBundle = FName(TEXT("Gameplay"));
+const FName UGAS_DemoAssetManager::WorldBundle = FName(TEXT("World"));
+
+const FName UGAS_DemoAssetManager::ItemIdTag = FName(TEXT("ItemId"));
+const FName UGAS_DemoAssetManager::ItemNameTag = FName(TEXT("ItemName"));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CVarItemsMemReport(
+	TEXT("GAS.Items.MemReport"),
+	TEXT("Loads every item of the catalog (as a full inventory listing would) and reports the memory it takes. ")
+	TEXT("Usage: GAS.Items.MemReport [ui|all], 'ui' only loads the UI bundle, 'all' loads every bundle (same as the old hard references)."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		const bool bAllBundles = Args.Num() > 0 && Args[0] == TEXT("all");
+
+		TArray<FName> Bundles = { UGAS_DemoAssetManager::UIBundle };
+		if (bAllBundles)
+			Bundles.Append({ UGAS_DemoAssetManager::GameplayBundle, UGAS_DemoAssetManager::WorldBundle });
+
+		const FItemLoadReport Report = UGAS_DemoAssetManager::Get().MeasureItemLoad(Bundles);
+
+		Ar.Logf(TEXT("Loaded %d items with bundles [%s] in %.2fms"), Report.NumItems,
+			*FString::JoinBy(Bundles, TEXT(", "), [](const FName& Bundle) { return Bundle.ToString(); }), Report.LoadMs);
+		Ar.Logf(TEXT("  %d assets, %.2fMB resource size, %d new UObjects, %.2fMB physical memory delta"),
+			Report.NumAssets, Report.ResourceBytes / (1024.0 * 1024.0), Report.NumNewObjects, Report.PhysicalBytesDelta / (1024.0 * 1024.0));
+		Ar.Logf(TEXT("  %d ability classes and %d weapon actor classes resident, %d items still saved with hard references"),
+			Report.NumAbilityClassesLoaded, Report.NumWeaponActorClassesLoaded, Report.NumHardReferences);
+	}));
+
 UGAS_DemoAssetManager& UGAS_DemoAssetManager::Get()
 {
 	UGAS_DemoAssetManager* This = Cast<UGAS_DemoAssetManager>(GEngine->AssetManager);
@@ -22,10 +62,405 @@ UGAS_DemoAssetManager& UGAS_DemoAssetManager::Get()
 }
 
 
+/** Records the duration of a startup phase in UGAS_DemoAssetManager (see GAS.Startup.Stats) */
+struct FStartupPhaseScope
+{
+	FStartupPhaseScope(UGAS_DemoAssetManager& InAssetManager, const TCHAR* InPhaseName)
+		: AssetManager(InAssetManager), PhaseName(InPhaseName), StartTime(FPlatformTime::Seconds())
+	{}
+
+	~FStartupPhaseScope()
+	{
+		AssetManager.RecordStartupPhase(PhaseName, FPlatformTime::Seconds() - StartTime);
+	}
+
+	UGAS_DemoAssetManager& AssetManager;
+	const TCHAR* PhaseName;
+	double StartTime;
+};
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CVarStartupStats(
+	TEXT("GAS.Startup.Stats"),
+	TEXT("Prints how long each startup phase of the asset manager took (including deferred GAS initialization)."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		UGAS_DemoAssetManager::Get().DumpStartupPhases(Ar);
+	}));
+
+UGAS_DemoAssetManager::UGAS_DemoAssetManager()
+{
+	//Default values, can be overriden in DefaultGame.ini under [/Script/GAS_Demo.GAS_DemoAssetManager]
+	bDeferAbilitySystemGlobalsInit = false;
+}
+
 void UGAS_DemoAssetManager::StartInitialLoading()
 {
-	Super::StartInitialLoading();
+	{
+		FStartupPhaseScope Scope(*this, TEXT("Asset manager scan"));
+		Super::StartInitialLoading();
+	}
+
+	if (bDeferAbilitySystemGlobalsInit)
+	{
+		//Curve tables, attribute defaults, cue manager scan and global tags are done over the next frames
+		DeferredInitStep = 0;
+		DeferredInitTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UGAS_DemoAssetManager::TickDeferredAbilitySystemGlobalsInit));
+	}
+	else
+	{
+		FStartupPhaseScope Scope(*this, TEXT("GAS global data"));
+		UAbilitySystemGlobals::Get().InitGlobalData();
+		bAbilitySystemGlobalsReady = true;
+	}
+
+#if WITH_EDITOR
+	//Cooks regenerate the table before cooking anything, so the staged Data/ItemStats.bin matches the cooked weapons
+	if (IsRunningCookCommandlet())
+		FGameDelegates::Get().GetModifyCookDelegate().AddStatic(&UItemStatTableCommandlet::OnModifyCook);
+#endif
+
+	//Stats of every weapon without loading them, generated by UItemStatTableCommandlet
+	{
+		FStartupPhaseScope Scope(*this, TEXT("Item stat table"));
+		if (ItemStatTable.LoadFromFile(FItemStatTable::GetDefaultPath()))
+			UE_LOG(LogTemp, Log, TEXT("Item stat table: %d weapons (%.1fKB)"), ItemStatTable.GetNumItems(), ItemStatTable.GetAllocatedSize() / 1024.0);
+	}
+
+#if WITH_EDITOR
+	//Only cooks generate the table on their own: the editor rewrites it when weapons changed, once scanned and before PIE
+	if (GIsEditor && !IsRunningCommandlet())
+	{
+		CallOrRegister_OnCompletedInitialScan(FSimpleMulticastDelegate::FDelegate::CreateUObject(this, &UGAS_DemoAssetManager::RefreshItemStatTable));
+		FEditorDelegates::PreBeginPIE.AddWeakLambda(this, [this](const bool bIsSimulating) { RefreshItemStatTable(); });
+	}
+#endif
+
+	//In the editor the asset registry may still be scanning, cooked builds complete right away
+	CallOrRegister_OnCompletedInitialScan(FSimpleMulticastDelegate::FDelegate::CreateUObject(this, &UGAS_DemoAssetManager::BuildItemRegistry));
+
+	DumpStartupPhases(*GLog);
+}
+
+FItemLoadReport UGAS_DemoAssetManager::MeasureItemLoad(const TArray<FName>& Bundles)
+{
+	/* Function MeasureItemLoad
+	* Arguments: const TArray<FName>& Bundles - bundles loaded with the items
+	* Output: load time, memory and classes resident once the whole catalog is loaded
+	*/
+
+	FItemLoadReport Report;
+
+	TArray<FPrimaryAssetId> ItemIds;
+	for (const FPrimaryAssetType& ItemType : GetItemTypes())
+	{
+		GetPrimaryAssetIdList(ItemType, ItemIds);
+	}
+	Report.NumItems = ItemIds.Num();
+
+	//Start from a clean state so runs can be compared (items held by an inventory stay loaded)
+	UnloadPrimaryAssets(ItemIds);
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	const uint64 UsedMemoryBefore = FPlatformMemory::GetStats().UsedPhysical;
+	const int32 ObjectsBefore = GUObjectArray.GetObjectArrayNumMinusAvailable();
+	const double StartTime = FPlatformTime::Seconds();
+
+	TSharedPtr<FStreamableHandle> Handle = LoadPrimaryAssets(ItemIds, Bundles);
+	if (Handle.IsValid())
+		Handle->WaitUntilComplete();
+
+	Report.LoadMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	Report.NumNewObjects = GUObjectArray.GetObjectArrayNumMinusAvailable() - ObjectsBefore;
+	Report.PhysicalBytesDelta = (int64)FPlatformMemory::GetStats().UsedPhysical - (int64)UsedMemoryBefore;
+
+	TArray<UObject*> LoadedAssets;
+	if (Handle.IsValid())
+		Handle->GetLoadedAssets(LoadedAssets);
+	Report.NumAssets = LoadedAssets.Num();
+
+	//Resource size of the loaded assets (textures mostly, Blueprint classes report their CDO)
+	for (UObject* Asset : LoadedAssets)
+	{
+		if (Asset)
+			Report.ResourceBytes += Asset->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+	}
+
+	//Resident classes: loaded by their bundle, by a hard reference of the item, or already held by something else
+	TSet<const UClass*> AbilityClasses;
+	TSet<const UClass*> WeaponActorClasses;
+	for (const FPrimaryAssetId& ItemId : ItemIds)
+	{
+		const UItemBase* Item = GetPrimaryAssetObject<UItemBase>(ItemId);
+		if (!Item) continue;
+
+		Report.NumHardReferences += Item->HasDeprecatedHardReferences() ? 1 : 0;
+		if (const UClass* AbilityClass = Item->GrantedAbilityClass.Get())
+			AbilityClasses.Add(AbilityClass);
+
+		const UWeaponBase* Weapon = Cast<UWeaponBase>(Item);
+		if (const UClass* ActorClass = Weapon ? Weapon->WeaponActorClass.Get() : nullptr)
+			WeaponActorClasses.Add(ActorClass);
+	}
+	Report.NumAbilityClassesLoaded = AbilityClasses.Num();
+	Report.NumWeaponActorClassesLoaded = WeaponActorClasses.Num();
+
+	return Report;
+}
+
+#if WITH_EDITOR
+void UGAS_DemoAssetManager::RefreshItemStatTable()
+{
+	/* Function RefreshItemStatTable
+	* Arguments: none
+	* Output: none (writes the table file again and reloads it if it is stale, see UItemStatTableCommandlet::IsItemStatTableStale)
+	*/
+
+	const FString TablePath = FItemStatTable::GetDefaultPath();
+	if (!UItemStatTableCommandlet::IsItemStatTableStale(ItemStatTable, TablePath)) return;
+
+	const double StartTime = FPlatformTime::Seconds();
+	if (UItemStatTableCommandlet::WriteItemStatTable(TablePath))
+		ItemStatTable.LoadFromFile(TablePath);
+
+	UE_LOG(LogTemp, Log, TEXT("Item stat table: refreshed for the editor in %.2fms (%d weapons)"), (FPlatformTime::Seconds() - StartTime) * 1000.0, ItemStatTable.GetNumItems());
+}
+#endif
+
+void UGAS_DemoAssetManager::RecordStartupPhase(const TCHAR* PhaseName, double Seconds)
+{
+	StartupPhases.Emplace(PhaseName, Seconds);
+}
+
+void UGAS_DemoAssetManager::DumpStartupPhases(FOutputDevice& Ar) const
+{
+	double TotalSeconds = 0.0;
+	for (const TPair<FString, double>& Phase : StartupPhases)
+	{
+		TotalSeconds += Phase.Value;
+	}
+
+	Ar.Logf(TEXT("Asset manager startup: %.2fms over %d phases%s"), TotalSeconds * 1000.0, StartupPhases.Num(),
+		bAbilitySystemGlobalsReady ? TEXT("") : TEXT(" (GAS global data init still deferred)"));
+
+	for (const TPair<FString, double>& Phase : StartupPhases)
+	{
+		Ar.Logf(TEXT("  %-40s %8.2fms"), *Phase.Key, Phase.Value * 1000.0);
+	}
+}
+
+bool UGAS_DemoAssetManager::TickDeferredAbilitySystemGlobalsInit(float DeltaTime)
+{
+	RunDeferredInitStep();
+
+	//Returning false removes the ticker
+	if (bAbilitySystemGlobalsReady)
+		DeferredInitTickerHandle.Reset();
 
-	UAbilitySystemGlobals::Get().InitGlobalData();
+	return !bAbilitySystemGlobalsReady;
 }
 
+void UGAS_DemoAssetManager::RunDeferredInitStep()
+{
+	/* Function RunDeferredInitStep
+	* Arguments: none
+	* Output: none (runs the next step of the deferred GAS global data init, one per frame)
+	*/
+
+	UAbilitySystemGlobals& Globals = UAbilitySystemGlobals::Get();
+
+	switch (DeferredInitStep++)
+	{
+	case 0:
+	{
+		//Creating the cue manager scans the cue notify paths, by far the longest part
+		FStartupPhaseScope Scope(*this, TEXT("Deferred: GameplayCue manager"));
+		Globals.GetGameplayCueManager();
+		break;
+	}
+
+	case 1:
+	{
+		FStartupPhaseScope Scope(*this, TEXT("Deferred: global curve tables"));
+		Globals.GetGlobalCurveTable();
+		Globals.GetGlobalAttributeMetaDataTable();
+		Globals.GetGameplayTagResponseTable();
+		break;
+	}
+
+	default:
+	{
+		//Everything left (attribute defaults, global tags, target data structs): the getters above are already resolved
+		{
+			FStartupPhaseScope Scope(*this, TEXT("Deferred: GAS global data"));
+			Globals.InitGlobalData();
+		}
+		bAbilitySystemGlobalsReady = true;
+
+		DumpStartupPhases(*GLog);
+		break;
+	}
+	}
+}
+
+void UGAS_DemoAssetManager::FlushDeferredAbilitySystemGlobalsInit()
+{
+	if (bAbilitySystemGlobalsReady) return;
+
+	while (!bAbilitySystemGlobalsReady)
+	{
+		RunDeferredInitStep();
+	}
+
+	if (DeferredInitTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(DeferredInitTickerHandle);
+		DeferredInitTickerHandle.Reset();
+	}
+}
+
+void FItemRegistry::AddItems(const FPrimaryAssetType& ItemType, const TArray<FAssetData>& Assets)
+{
+	/* Function AddItems
+	* Arguments: const FPrimaryAssetType& ItemType - type of the items, const TArray<FAssetData>& Assets - scanned item assets
+	* Output: none (reads ItemId/ItemName tags, the assets are never loaded)
+	*/
+
+	AssetIdsByItemId.Reserve(AssetIdsByItemId.Num() + Assets.Num());
+	ItemIdsByName.Reserve(ItemIdsByName.Num() + Assets.Num());
+
+	for (const FAssetData& AssetData : Assets)
+	{
+		int32 ItemId = INDEX_NONE;
+		if (!AssetData.GetTagValue(UGAS_DemoAssetManager::ItemIdTag, ItemId))
+		{
+			NumMissingIds++;
+			MissingIdAssets.Add(AssetData);
+			continue;
+		}
+
+		FString ItemName;
+		AssetData.GetTagValue(UGAS_DemoAssetManager::ItemNameTag, ItemName);
+
+		//Same id as UItemBase::GetPrimaryAssetId
+		AddItem(ItemId, ItemName, FPrimaryAssetId(ItemType, AssetData.AssetName));
+	}
+}
+
+void FItemRegistry::AddItem(int32 ItemId, const FString& ItemName, const FPrimaryAssetId& AssetId)
+{
+	if (const FPrimaryAssetId* ExistingAssetId = AssetIdsByItemId.Find(ItemId))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Item registry: ItemId %d of %s is already used by %s, %s can't be found by ItemId"),
+			ItemId, *AssetId.ToString(), *ExistingAssetId->ToString(), *AssetId.ToString());
+		NumDuplicateIds++;
+		return;
+	}
+	AssetIdsByItemId.Add(ItemId, AssetId);
+
+	//Unnamed items have an empty tag, or "None" from the editor path
+	const FName Name(*ItemName);
+	if (Name.IsNone()) return;
+
+	if (const int32* ExistingItemId = ItemIdsByName.Find(Name))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Item registry: ItemName %s of %s is already used by ItemId %d, name lookups return ItemId %d"),
+			*ItemName, *AssetId.ToString(), *ExistingItemId, *ExistingItemId);
+		NumDuplicateNames++;
+		return;
+	}
+	ItemIdsByName.Add(Name, ItemId);
+}
+
+void UGAS_DemoAssetManager::BuildItemRegistry()
+{
+	if (bItemRegistryReady) return;
+
+	{
+		FStartupPhaseScope Scope(*this, TEXT("Item registry"));
+
+		ScanItemRegistry(ItemRegistry);
+
+		ItemRegistry.AssetIdsByItemId.Compact();
+		ItemRegistry.ItemIdsByName.Compact();
+		bItemRegistryReady = true;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Item registry: %d items indexed (%d duplicate ItemIds, %d duplicate names, %d items without ItemId tag)"),
+		ItemRegistry.AssetIdsByItemId.Num(), ItemRegistry.NumDuplicateIds, ItemRegistry.NumDuplicateNames, ItemRegistry.NumMissingIds);
+}
+
+void UGAS_DemoAssetManager::ScanItemRegistry(FItemRegistry& OutRegistry)
+{
+	/* Function ScanItemRegistry
+	* Arguments: FItemRegistry& OutRegistry - receives every scanned item
+	* Output: none (items are indexed from their registry tags, see below for items saved without them)
+	*/
+
+	TArray<FAssetData> Assets;
+	for (const FPrimaryAssetType& ItemType : GetItemTypes())
+	{
+		Assets.Reset();
+		GetPrimaryAssetDataList(ItemType, Assets);
+		OutRegistry.AddItems(ItemType, Assets);
+	}
+
+	if (OutRegistry.MissingIdAssets.Num() == 0) return;
+
+	//ItemId only becomes a tag once an item is resaved. Cooking resaves every item, so only editor builds can get here:
+	//the untagged items are loaded to read it, a resave (ResavePackages commandlet on the items folders) removes this cost
+#if WITH_EDITOR
+	for (const FAssetData& AssetData : OutRegistry.MissingIdAssets)
+	{
+		const UItemBase* Item = Cast<UItemBase>(AssetData.GetAsset());
+		if (!Item) continue;
+
+		OutRegistry.AddItem(Item->ItemId, Item->ItemName.ToString(), Item->GetPrimaryAssetId());
+	}
+#endif
+
+	UE_LOG(LogTemp, Warning, TEXT("Item registry: %d items have no ItemId tag and %s, resave them: %s"), OutRegistry.MissingIdAssets.Num(),
+		WITH_EDITOR ? TEXT("were loaded to read it") : TEXT("can't be found by ItemId"),
+		*FString::JoinBy(OutRegistry.MissingIdAssets, TEXT(", "), [](const FAssetData& AssetData) { return AssetData.AssetName.ToString(); }));
+}
+
+FPrimaryAssetId UGAS_DemoAssetManager::FindItemAssetId(int32 ItemId) const
+{
+	const FPrimaryAssetId* AssetId = ItemRegistry.AssetIdsByItemId.Find(ItemId);
+	return AssetId ? *AssetId : FPrimaryAssetId();
+}
+
+int32 UGAS_DemoAssetManager::FindItemIdByName(FName ItemName) const
+{
+	const int32* ItemId = ItemRegistry.ItemIdsByName.Find(ItemName);
+	return ItemId ? *ItemId : INDEX_NONE;
+}
+
+TSharedPtr<FStreamableHandle> UGAS_DemoAssetManager::LoadItemById(int32 ItemId, const TArray<FName>& Bundles, FStreamableDelegate OnLoaded)
+{
+	const FPrimaryAssetId AssetId = FindItemAssetId(ItemId);
+	if (!AssetId.IsValid()) return nullptr;
+
+	return LoadPrimaryAsset(AssetId, Bundles, OnLoaded);
+}
+
+TSharedPtr<FStreamableHandle> UGAS_DemoAssetManager::LoadItemBundles(const UItemBase* Item, const TArray<FName>& Bundles, FStreamableDelegate OnLoaded)
+{
+	/* Function LoadItemBundles
+	* Arguments: const UItemBase* Item - item to load bundles of, const TArray<FName>& Bundles - bundles to add,
+	*            FStreamableDelegate OnLoaded - completion callback
+	* Output: streaming handle of the load, invalid if nothing had to be loaded
+	*/
+
+	if (!Item)
+	{
+		OnLoaded.ExecuteIfBound();
+		return nullptr;
+	}
+
+	const FPrimaryAssetId ItemId = Item->GetPrimaryAssetId();
+
+	//Items already managed keep their current bundles, the others (loaded through a hard reference) start managed here
+	return GetPrimaryAssetHandle(ItemId).IsValid()
+		? ChangeBundleStateForPrimaryAssets({ ItemId }, Bundles, {}, false, OnLoaded)
+		: LoadPrimaryAsset(ItemId, Bundles, OnLoaded);
+}
@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "Engine/AssetManager.h"
+#include "ItemStatTable.h"
+#include "Containers/Ticker.h"
 #include "GAS_DemoAssetManager.generated.h"
 
 /**
@@ -12,7 +14,49 @@
 
 class UItemBase;
 
-UCLASS()
+/** ItemId lookup tables built from asset registry tags, see UGAS_DemoAssetManager::GetItemRegistry */
+struct GAS_DEMO_API FItemRegistry
+{
+	/** Primary asset of every item by ItemId */
+	TMap<int32, FPrimaryAssetId> AssetIdsByItemId;
+
+	/** ItemId of every item by ItemName */
+	TMap<FName, int32> ItemIdsByName;
+
+	/** Items skipped because their ItemId was already used, and names not indexed because another item had them first */
+	int32 NumDuplicateIds = 0;
+	int32 NumDuplicateNames = 0;
+
+	/** Items without ItemId tag (saved before ItemId was searchable), see UGAS_DemoAssetManager::ScanItemRegistry */
+	int32 NumMissingIds = 0;
+	TArray<FAssetData> MissingIdAssets;
+
+	/** Adds every item of Assets (of type ItemType) to the tables, using only their registry tags */
+	void AddItems(const FPrimaryAssetType& ItemType, const TArray<FAssetData>& Assets);
+
+	/** Adds one item, duplicate ItemIds and names are logged and the first item keeps them */
+	void AddItem(int32 ItemId, const FString& ItemName, const FPrimaryAssetId& AssetId);
+};
+
+/** What loading the whole item catalog costs, see UGAS_DemoAssetManager::MeasureItemLoad */
+struct GAS_DEMO_API FItemLoadReport
+{
+	int32 NumItems = 0;
+	int32 NumAssets = 0;
+	int32 NumNewObjects = 0;
+	double LoadMs = 0.0;
+	int64 ResourceBytes = 0;
+	int64 PhysicalBytesDelta = 0;
+
+	/** Items still saved with the deprecated hard GrantedAbility/WeaponActor */
+	int32 NumHardReferences = 0;
+
+	/** Distinct ability and weapon actor classes of the items resident once loaded, requested bundle or not */
+	int32 NumAbilityClassesLoaded = 0;
+	int32 NumWeaponActorClassesLoaded = 0;
+};
+
+UCLASS(config = Game)
 class GAS_DEMO_API UGAS_DemoAssetManager : public UAssetManager
 {
 	GENERATED_BODY()
@@ -21,17 +65,118 @@ class GAS_DEMO_API UGAS_DemoAssetManager : public UAssetManager
 * Class GAS_DemoAssetManager
 * AssetManager class used to define DataAsset types (used mainly for items
 * and weapons)
+*
+* Every startup phase is timed and summarized in the log at boot (GAS.Startup.Stats prints it again).
+* With bDeferAbilitySystemGlobalsInit, UAbilitySystemGlobals::InitGlobalData is split in steps run over the
+* frames following boot instead of blocking StartInitialLoading; UBaseAbilitySystemComponent flushes whatever
+* is left when it is initialized, so it is always complete before the first ability activation.
 */
 
 public:
 
-	UGAS_DemoAssetManager() {}
+	UGAS_DemoAssetManager();
+
+	/** Registry tags read from item assets (properties marked AssetRegistrySearchable on UItemBase) */
+	static const FName ItemIdTag;
+	static const FName ItemNameTag;
 
 	static const FPrimaryAssetType WeaponItemType;
 	static const FPrimaryAssetType ConsumableItemType;
 
+	/** Asset bundles of items: UI (icon), Gameplay (GrantedAbilityClass) and World (WeaponActorClass) */
+	static const FName UIBundle;
+	static const FName GameplayBundle;
+	static const FName WorldBundle;
+
 	virtual void StartInitialLoading() override;
 
 	static UGAS_DemoAssetManager& Get();
+
+	/**
+	* Asynchronously loads Bundles of Item, on top of the bundles already loaded for it
+	*
+	* @param Item  Item whose bundles to load
+	* @param Bundles  Bundles to add (UIBundle, GameplayBundle, WorldBundle)
+	* @param OnLoaded  Called once loaded (right away if nothing had to be loaded)
+	* @return The streaming handle, invalid if nothing had to be loaded
+	*/
+	TSharedPtr<FStreamableHandle> LoadItemBundles(const UItemBase* Item, const TArray<FName>& Bundles, FStreamableDelegate OnLoaded = FStreamableDelegate());
+
+	/** Item asset types scanned by the asset manager (WeaponItemType and ConsumableItemType) */
+	static TArray<FPrimaryAssetType> GetItemTypes() { return { WeaponItemType, ConsumableItemType }; }
+
+	/** Unloads every item, then loads them all with Bundles (as a full inventory listing would) and measures it */
+	FItemLoadReport MeasureItemLoad(const TArray<FName>& Bundles);
+
+	/** True once the item registry was built (after the initial asset scan) */
+	bool IsItemRegistryReady() const { return bItemRegistryReady; }
+
+	/** Item lookup tables, immutable once built */
+	const FItemRegistry& GetItemRegistry() const { return ItemRegistry; }
+
+	/** Indexes every scanned item asset into OutRegistry, what BuildItemRegistry runs once the initial scan is done */
+	void ScanItemRegistry(FItemRegistry& OutRegistry);
+
+	/** Returns the primary asset of the item with ItemId without loading it, invalid if unknown */
+	FPrimaryAssetId FindItemAssetId(int32 ItemId) const;
+
+	/** Returns the ItemId of the item named ItemName, INDEX_NONE if unknown */
+	int32 FindItemIdByName(FName ItemName) const;
+
+	/** Asynchronously loads the item with ItemId (with Bundles), returns the streaming handle (invalid if unknown or already loaded) */
+	TSharedPtr<FStreamableHandle> LoadItemById(int32 ItemId, const TArray<FName>& Bundles, FStreamableDelegate OnLoaded = FStreamableDelegate());
+
+	/** True once UAbilitySystemGlobals::InitGlobalData has run */
+	bool IsAbilitySystemGlobalsReady() const { return bAbilitySystemGlobalsReady; }
+
+	/** Completes the deferred GAS global data init right away (no-op if already done) */
+	void FlushDeferredAbilitySystemGlobalsInit();
+
+	/** Adds a startup phase to the boot summary */
+	void RecordStartupPhase(const TCHAR* PhaseName, double Seconds);
+
+	/** Prints the duration of every startup phase */
+	void DumpStartupPhases(FOutputDevice& Ar) const;
+
+	/** Packed stats of every weapon by ItemId (see FItemStatTable), empty if the table wasn't generated (kept up to date in the editor) */
+	const FItemStatTable& GetItemStatTable() const { return ItemStatTable; }
+
+protected:
+
+	/** Run the non-essential parts of the GAS global data init over the frames following boot, can be overriden in DefaultGame.ini under [/Script/GAS_Demo.GAS_DemoAssetManager] */
+	UPROPERTY(Config)
+	bool bDeferAbilitySystemGlobalsInit;
+
+private:
+
+	/** Ticker running one deferred init step per frame */
+	bool TickDeferredAbilitySystemGlobalsInit(float DeltaTime);
+
+	/** Runs the next deferred init step, the last one sets bAbilitySystemGlobalsReady */
+	void RunDeferredInitStep();
+
+	/** Builds ItemRegistry from the scanned item assets, called once the initial asset scan is done */
+	void BuildItemRegistry();
+
+#if WITH_EDITOR
+	/** Regenerates ItemStatTable if weapons changed since it was written, after the initial asset scan and before PIE */
+	void RefreshItemStatTable();
+#endif
+
+	FItemRegistry ItemRegistry;
+
+	bool bItemRegistryReady = false;
+
+	bool bAbilitySystemGlobalsReady = false;
+
+	int32 DeferredInitStep = 0;
+
+	FTSTicker::FDelegateHandle DeferredInitTickerHandle;
+
+	/** Name and duration (seconds) of every startup phase, in order */
+	TArray<TPair<FString, double>> StartupPhases;
+
+	/** Bulk loaded in StartInitialLoading from FItemStatTable::GetDefaultPath */
+	FItemStatTable ItemStatTable;
 	
 };
@@ -5,6 +5,9 @@
 #include "GASAttributeSet.h"
 #include "AbilitySystemComponent.h"
 #include "CharacterBase.h"
+#include "GASDemoTrace.h"
+#include "GameplayBudgetSubsystem.h"
+#include "ZeroAllocationScope.h"
 
 /*
 * Before proceeding any further, there is a lot of templates and boilerplate code used in this class
@@ -67,6 +70,11 @@ UGECSampleDamageExecition::UGECSampleDamageExecition()
 //3. Override the Execute_Implementation function from the base class
 void UGECSampleDamageExecition::Execute_Implementation(const FGameplayEffectCustomExecutionParameters& ExecutionParams, OUT FGameplayEffectCustomExecutionOutput& OutExecutionOutput) const
 {
+	GASDEMO_ZERO_ALLOC_SCOPE("GECSampleDamageExecition::Execute");
+	GASDEMO_TRACE_SCOPE_META("GECSampleDamageExecition::Execute", "%s", *GetNameSafe(ExecutionParams.GetOwningSpec().Def));
+	GASDEMO_TRACE_COUNTER_INCREMENT(GASDemo_DamageExecutions);
+	UGameplayBudgetSubsystem::Record(EGameplayFrameStat::DamageExecutions);
+
 	//4. FGameplayEffectCustomExecutionParameters is a data structure that will hold all the relevant AbilitySystemsComponents data
 	//create variables to capture the AbilitySystemComponents from Target and Source : this is basically boilerplate code
 	UAbilitySystemComponent* TargetAbilitySystemComponent = ExecutionParams.GetTargetAbilitySystemComponent();
@@ -0,0 +1,293 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+
+#include "GameplayBudgetSubsystem.h"
+#include "ItemBase.h"
+#include "Abilities/GameplayAbility.h"
+#include "AttributeSet.h"
+#include "GameplayEffect.h"
+#include "GameplayTask.h"
+#include "Components/ActorComponent.h"
+#include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "UObject/UObjectGlobals.h"
+
+CSV_DEFINE_CATEGORY(GASDemo, true);
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CVarBudgetStats(
+	TEXT("GAS.Budget.Stats"),
+	TEXT("Prints gameplay events per frame against their budgets. Use 'GAS.Budget.Stats reset' to clear them."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		UGameplayBudgetSubsystem* Budgets = GEngine ? GEngine->GetEngineSubsystem<UGameplayBudgetSubsystem>() : nullptr;
+		if (!Budgets) return;
+
+		if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+		{
+			Budgets->ResetStats();
+			return;
+		}
+
+		Budgets->DumpStats(Ar);
+	}));
+
+int32 UGameplayBudgetSubsystem::FrameCounts[UGameplayBudgetSubsystem::MaxContexts][(int32)EGameplayFrameStat::Num] = {};
+
+/** Collects the lines of DumpStats for the report file */
+struct FBudgetReportOutput : public FOutputDevice
+{
+	FString Text;
+
+	virtual void Serialize(const TCHAR* Line, ELogVerbosity::Type Verbosity, const FName& Category) override
+	{
+		Text += Line;
+		Text += LINE_TERMINATOR;
+	}
+};
+
+static FString GetFrameStatName(int32 Stat)
+{
+	return StaticEnum<EGameplayFrameStat>()->GetNameStringByValue(Stat);
+}
+
+UGameplayBudgetSubsystem::UGameplayBudgetSubsystem()
+{
+	//Default values, can be overriden in DefaultGameplayBudgets.ini under [/Script/GAS_Demo.GameplayBudgetSubsystem]
+	bFailOnBudgetExceeded = false;
+	FramesOverBudgetAllowed = 0;
+	IgnoreFramesAfterMapLoad = 60;
+
+	bGateFailed = false;
+	bListeningToObjects = false;
+
+	ResetStats();
+}
+
+void UGameplayBudgetSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	for (int32 Context = 0; Context < MaxContexts; ++Context)
+	{
+		Contexts[Context].FramesToIgnore = IgnoreFramesAfterMapLoad;
+
+		for (int32 Stat = 0; Stat < (int32)EGameplayFrameStat::Num; ++Stat)
+		{
+			CsvStatNames[Context][Stat] = Context == 0 ? FName(*GetFrameStatName(Stat)) : FName(*FString::Printf(TEXT("%s_PIE%d"), *GetFrameStatName(Stat), Context - 1));
+		}
+	}
+
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &UGameplayBudgetSubsystem::OnEndFrame);
+	PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &UGameplayBudgetSubsystem::OnPostLoadMap);
+
+	GUObjectArray.AddUObjectCreateListener(this);
+	bListeningToObjects = true;
+}
+
+void UGameplayBudgetSubsystem::Deinitialize()
+{
+	//Passing gate runs end through -ExitAfterCsvProfiling: their numbers are what the budgets are tuned from
+	if (IsGateEnabled() && !bGateFailed)
+	{
+		UE_LOG(LogTemp, Display, TEXT("GameplayBudget: gate passed"));
+		SaveStatsReport();
+	}
+
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+	OnUObjectArrayShutdown();
+
+	Super::Deinitialize();
+}
+
+bool UGameplayBudgetSubsystem::IsGateEnabled() const
+{
+	return bFailOnBudgetExceeded || FParse::Param(FCommandLine::Get(), TEXT("GameplayBudgetGate"));
+}
+
+void UGameplayBudgetSubsystem::NotifyUObjectCreated(const UObjectBase* Object, int32 Index)
+{
+	//Objects created by the loader aren't created by gameplay code
+	if (!IsInGameThread() || (Object->GetFlags() & (RF_NeedLoad | RF_WasLoaded | RF_ClassDefaultObject | RF_ArchetypeObject)) != 0) return;
+
+	//Engine, editor and UI objects (widgets, packages, render resources...) aren't part of the gameplay budgets
+	const UClass* Class = Object->GetClass();
+	if (Class->IsChildOf<AActor>() || Class->IsChildOf<UActorComponent>() || Class->IsChildOf<UGameplayAbility>() || Class->IsChildOf<UGameplayEffect>()
+		|| Class->IsChildOf<UAttributeSet>() || Class->IsChildOf<UGameplayTask>() || Class->IsChildOf<UItemBase>())
+		Record(EGameplayFrameStat::TransientObjects);
+}
+
+void UGameplayBudgetSubsystem::OnUObjectArrayShutdown()
+{
+	if (!bListeningToObjects) return;
+
+	GUObjectArray.RemoveUObjectCreateListener(this);
+	bListeningToObjects = false;
+}
+
+void UGameplayBudgetSubsystem::OnPostLoadMap(UWorld* World)
+{
+	//Only the context of the loaded world skips its spawning spikes, other PIE instances keep being checked
+	const FWorldContext* WorldContext = GEngine && World ? GEngine->GetWorldContextFromWorld(World) : nullptr;
+	const int32 Context = WorldContext ? FMath::Clamp(WorldContext->PIEInstance + 1, 0, MaxContexts - 1) : 0;
+	Contexts[Context].FramesToIgnore = IgnoreFramesAfterMapLoad;
+}
+
+FString UGameplayBudgetSubsystem::GetContextName(int32 Context)
+{
+	return Context == 0 ? FString(TEXT("Game")) : FString::Printf(TEXT("PIE %d"), Context - 1);
+}
+
+void UGameplayBudgetSubsystem::OnEndFrame()
+{
+	/* Function OnEndFrame
+	* Arguments: none
+	* Output: none (emits the frame counts of every context as CSV stats, checks them against the budgets and fails
+	* the run if the gate is on and too many frames of a context went over budget)
+	*/
+
+	StatFrames++;
+
+	bool bExceeded = false;
+	for (int32 Context = 0; Context < MaxContexts; ++Context)
+	{
+		bExceeded |= EndContextFrame(Context);
+	}
+
+	if (!bExceeded || bGateFailed || !IsGateEnabled()) return;
+
+	bGateFailed = true;
+	UE_LOG(LogTemp, Error, TEXT("GameplayBudget: more than %d frames over budget, failing the run"), FramesOverBudgetAllowed);
+	SaveStatsReport();
+
+	FPlatformMisc::RequestExitWithStatus(false, 1);
+}
+
+bool UGameplayBudgetSubsystem::EndContextFrame(int32 Context)
+{
+	FContextStats& ContextStats = Contexts[Context];
+	int32* Counts = FrameCounts[Context];
+
+	if (!ContextStats.bActive)
+	{
+		//The game context is always reported, PIE contexts once they record something
+		bool bHasEvents = Context == 0;
+		for (int32 Stat = 0; Stat < (int32)EGameplayFrameStat::Num && !bHasEvents; ++Stat)
+		{
+			bHasEvents = Counts[Stat] != 0;
+		}
+		if (!bHasEvents) return false;
+
+		ContextStats.bActive = true;
+	}
+
+#if CSV_PROFILER
+	for (int32 Stat = 0; Stat < (int32)EGameplayFrameStat::Num; ++Stat)
+	{
+		FCsvProfiler::RecordCustomStat(CsvStatNames[Context][Stat], CSV_CATEGORY_INDEX(GASDemo), Counts[Stat], ECsvCustomStatOp::Set);
+	}
+#endif
+
+	const bool bCheckBudgets = ContextStats.FramesToIgnore <= 0;
+	if (!bCheckBudgets)
+		ContextStats.FramesToIgnore--;
+
+	bool bOverBudget = false;
+	for (int32 Stat = 0; Stat < (int32)EGameplayFrameStat::Num; ++Stat)
+	{
+		const int32 Count = Counts[Stat];
+		Counts[Stat] = 0;
+
+		FFrameStatTotals& StatTotals = ContextStats.Totals[Stat];
+		StatTotals.Total += Count;
+		StatTotals.MaxPerFrame = FMath::Max(StatTotals.MaxPerFrame, Count);
+
+		const int32* Budget = FrameBudgets.Find((EGameplayFrameStat)Stat);
+		if (!bCheckBudgets || !Budget || Count <= *Budget) continue;
+
+		//Only the first frame over budget of each stat is logged, GAS.Budget.Stats has the totals
+		if (StatTotals.FramesOverBudget == 0)
+			UE_LOG(LogTemp, Warning, TEXT("GameplayBudget: %s over budget in %s (%d in one frame, budget %d)"), *GetFrameStatName(Stat), *GetContextName(Context), Count, *Budget);
+
+		StatTotals.FramesOverBudget++;
+		bOverBudget = true;
+	}
+
+	ContextStats.Frames++;
+	if (bCheckBudgets)
+		ContextStats.FramesChecked++;
+
+	if (!bOverBudget) return false;
+
+	ContextStats.FramesOverBudget++;
+	return ContextStats.FramesOverBudget > FramesOverBudgetAllowed;
+}
+
+void UGameplayBudgetSubsystem::DumpStats(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("Frames: %llu, %d over budget allowed per context, gate: %s"), StatFrames, FramesOverBudgetAllowed, IsGateEnabled() ? TEXT("on") : TEXT("off"));
+
+	for (int32 Context = 0; Context < MaxContexts; ++Context)
+	{
+		const FContextStats& ContextStats = Contexts[Context];
+		if (!ContextStats.bActive) continue;
+
+		Ar.Logf(TEXT("%s: %llu frames (%llu checked against budgets), %d over budget"),
+			*GetContextName(Context), ContextStats.Frames, ContextStats.FramesChecked, ContextStats.FramesOverBudget);
+
+		for (int32 Stat = 0; Stat < (int32)EGameplayFrameStat::Num; ++Stat)
+		{
+			const FFrameStatTotals& StatTotals = ContextStats.Totals[Stat];
+			const int32* Budget = FrameBudgets.Find((EGameplayFrameStat)Stat);
+
+			Ar.Logf(TEXT("  %-20s budget: %6s, max/frame: %6d, avg/frame: %8.2f, frames over budget: %d"),
+				*GetFrameStatName(Stat), Budget ? *FString::FromInt(*Budget) : TEXT("none"), StatTotals.MaxPerFrame,
+				ContextStats.Frames > 0 ? (double)StatTotals.Total / ContextStats.Frames : 0.0, StatTotals.FramesOverBudget);
+		}
+	}
+}
+
+FString UGameplayBudgetSubsystem::GetStatsReportPath()
+{
+	return FPaths::ProfilingDir() / TEXT("GameplayBudgets.txt");
+}
+
+void UGameplayBudgetSubsystem::SaveStatsReport() const
+{
+	/* Function SaveStatsReport
+	* Arguments: none
+	* Output: none (prints DumpStats to the log and writes it to GetStatsReportPath, with the map and command line of the run)
+	*/
+
+	FBudgetReportOutput Report;
+	Report.Logf(TEXT("Command line: %s"), FCommandLine::Get());
+	Report.Logf(TEXT("Gate: %s"), bGateFailed ? TEXT("failed") : TEXT("passed"));
+	DumpStats(Report);
+
+	DumpStats(*GLog);
+	if (!FFileHelper::SaveStringToFile(Report.Text, *GetStatsReportPath()))
+		UE_LOG(LogTemp, Warning, TEXT("GameplayBudget: failed to write %s"), *GetStatsReportPath());
+}
+
+void UGameplayBudgetSubsystem::ResetStats()
+{
+	for (FContextStats& ContextStats : Contexts)
+	{
+		for (FFrameStatTotals& StatTotals : ContextStats.Totals)
+		{
+			StatTotals = FFrameStatTotals();
+		}
+
+		ContextStats.Frames = 0;
+		ContextStats.FramesChecked = 0;
+		ContextStats.FramesOverBudget = 0;
+	}
+
+	StatFrames = 0;
+}
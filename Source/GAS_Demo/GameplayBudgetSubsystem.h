@@ -0,0 +1,156 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CoreGlobals.h"
+#include "Subsystems/EngineSubsystem.h"
+#include "UObject/UObjectArray.h"
+#include "GameplayBudgetSubsystem.generated.h"
+
+/** Gameplay events counted every frame */
+UENUM()
+enum class EGameplayFrameStat : uint8
+{
+	DamageExecutions,
+	EffectsApplied,
+	AttributeChanges,
+	InventoryOperations,
+	AbilityActivations,
+	TransientObjects,
+	Num UMETA(Hidden)
+};
+
+UCLASS(config = GameplayBudgets)
+class GAS_DEMO_API UGameplayBudgetSubsystem : public UEngineSubsystem, public FUObjectArray::FUObjectCreateListener
+{
+	GENERATED_BODY()
+
+/*
+* Class UGameplayBudgetSubsystem
+* Counts gameplay events every frame (see EGameplayFrameStat), emits them as CSV profiler stats (GASDemo category,
+* captured with -csvCaptureFrames=N or csvprofile start) and checks them against per frame budgets.
+*
+* Budgets are read from the budget file Config/DefaultGameplayBudgets.ini (a stat without budget is never over budget).
+* When the gate is on (bFailOnBudgetExceeded or -GameplayBudgetGate on the command line), exceeding the budgets on more
+* than FramesOverBudgetAllowed frames logs an error and exits with code 1, so headless runs (-nullrhi) catch regressions.
+* Scripts/RunGameplayBudgetGate.bat/.sh run the gate on a map:
+* UnrealEditor GAS_Demo.uproject <Map> -game -nullrhi -unattended -GameplayBudgetGate -csvCaptureFrames=3000 -ExitAfterCsvProfiling
+*
+* Events are counted per context: the game (or the editor world), then one context per PIE instance (told apart with
+* GPlayInEditorID), so a PIE listen server and its clients running in the same process don't add up. Every context
+* is checked against the same budgets, PIE contexts are emitted as CSV stats suffixed with their instance.
+*
+* TransientObjects counts the actors, components, abilities, effects, attribute sets, gameplay tasks and items created
+* on the game thread (engine and editor objects aren't gameplay budgets), objects being loaded are not counted.
+* Use GAS.Budget.Stats to print the per frame maximums, averages and frames over budget ('reset' clears them).
+* Gate runs write the same stats to Saved/Profiling/GameplayBudgets.txt when they end, Docs/Performance.md keeps the
+* observed numbers the budgets are set from.
+*/
+
+public:
+	UGameplayBudgetSubsystem();
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/** Game or editor world, then one context per PIE instance (PIE instances past the last context share it) */
+	static constexpr int32 MaxContexts = 8;
+
+	/** Counts Amount events of Stat in the current frame of the world being processed (game thread only) */
+	static void Record(EGameplayFrameStat Stat, int32 Amount = 1) { FrameCounts[GetCurrentContext()][(int32)Stat] += Amount; }
+
+	/** Context of the world being processed: 0 outside PIE, PIE instance + 1 otherwise */
+	static int32 GetCurrentContext() { return FMath::Clamp(GPlayInEditorID + 1, 0, MaxContexts - 1); }
+
+	/** True if exceeding the budgets fails the run */
+	bool IsGateEnabled() const;
+
+	/** Prints every stat with its budget to the output device */
+	void DumpStats(FOutputDevice& Ar) const;
+
+	/** Clears the accumulated stats (budget violations included) */
+	void ResetStats();
+
+	/** File the gate writes its stats to when a run ends (Saved/Profiling/GameplayBudgets.txt) */
+	static FString GetStatsReportPath();
+
+	//~ Begin FUObjectCreateListener
+	virtual void NotifyUObjectCreated(const class UObjectBase* Object, int32 Index) override;
+	virtual void OnUObjectArrayShutdown() override;
+	//~ End FUObjectCreateListener
+
+protected:
+
+	/** Max events per frame of each stat, can be overriden in DefaultGameplayBudgets.ini under [/Script/GAS_Demo.GameplayBudgetSubsystem] */
+	UPROPERTY(Config)
+	TMap<EGameplayFrameStat, int32> FrameBudgets;
+
+	/** Fail the run when budgets are exceeded, even without -GameplayBudgetGate */
+	UPROPERTY(Config)
+	bool bFailOnBudgetExceeded;
+
+	/** Number of frames allowed over budget before the gate fails the run */
+	UPROPERTY(Config)
+	int32 FramesOverBudgetAllowed;
+
+	/** Frames not checked against budgets after a map load (spawning and initialization spikes) */
+	UPROPERTY(Config)
+	int32 IgnoreFramesAfterMapLoad;
+
+private:
+
+	struct FFrameStatTotals
+	{
+		uint64 Total = 0;
+		int32 MaxPerFrame = 0;
+		int32 FramesOverBudget = 0;
+	};
+
+	struct FContextStats
+	{
+		FFrameStatTotals Totals[(int32)EGameplayFrameStat::Num];
+
+		/** Remaining frames not checked against budgets */
+		int32 FramesToIgnore = 0;
+
+		/** Frames since this context recorded its first event */
+		uint64 Frames = 0;
+		uint64 FramesChecked = 0;
+		int32 FramesOverBudget = 0;
+
+		/** Set once the context recorded an event, only active contexts are emitted and printed */
+		bool bActive = false;
+	};
+
+	/** Emits the frame counts, checks them against the budgets and resets them, bound to FCoreDelegates::OnEndFrame */
+	void OnEndFrame();
+
+	/** OnEndFrame of one context, returns true if it went over budget on more than FramesOverBudgetAllowed frames */
+	bool EndContextFrame(int32 Context);
+
+	void OnPostLoadMap(UWorld* World);
+
+	/** Logs the stats and writes them to GetStatsReportPath, called when a gate run ends (passed or failed) */
+	void SaveStatsReport() const;
+
+	/** Name of a context in the stats and logs */
+	static FString GetContextName(int32 Context);
+
+	/** Events of the current frame, per context */
+	static int32 FrameCounts[MaxContexts][(int32)EGameplayFrameStat::Num];
+
+	FContextStats Contexts[MaxContexts];
+
+	/** CSV stat of every stat of every context (PIE contexts are suffixed with their instance) */
+	FName CsvStatNames[MaxContexts][(int32)EGameplayFrameStat::Num];
+
+	bool bGateFailed;
+	bool bListeningToObjects;
+
+	FDelegateHandle EndFrameHandle;
+	FDelegateHandle PostLoadMapHandle;
+
+	//Stats counters, see DumpStats
+	uint64 StatFrames;
+};
@@ -0,0 +1,106 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+
+#include "GameplayEffectCache.h"
+#include "AbilitySystemComponent.h"
+#include "Engine/Engine.h"
+#include "UObject/Package.h"
+
+FGameplayEffectSpecHandle FGameplayEffectSpecCache::FindOrMake(UAbilitySystemComponent* AbilitySystemComponent, const UGameplayEffect* Effect, float Level, UObject* SourceObject)
+{
+	/* Function FindOrMake
+	* Arguments: UAbilitySystemComponent AbilitySystemComponent - instigator of the spec, UGameplayEffect Effect - effect definition,
+	* float Level - spec level, UObject SourceObject - optional source object for the context
+	* Output: A valid spec handle on success, an invalid handle on failure
+	*/
+
+	if (!AbilitySystemComponent || !Effect)
+	{
+		return FGameplayEffectSpecHandle();
+	}
+
+	const TTuple<TObjectKey<UGameplayEffect>, float, TObjectKey<UObject>> Key(Effect, Level, SourceObject);
+	if (const FGameplayEffectSpecHandle* Found = Specs.Find(Key))
+	{
+		// Source tags and snapshots may have changed since the spec was built (new equipment, buffs...)
+		Found->Data->CaptureDataFromSource();
+		return *Found;
+	}
+
+	// Same steps MakeOutgoingSpec follows, but done once per effect/level instead of once per application
+	FGameplayEffectContextHandle EffectContext = AbilitySystemComponent->MakeEffectContext();
+	if (SourceObject)
+	{
+		EffectContext.AddSourceObject(SourceObject);
+	}
+
+	FGameplayEffectSpecHandle SpecHandle(new FGameplayEffectSpec(Effect, EffectContext, Level));
+	Specs.Add(Key, SpecHandle);
+
+	return SpecHandle;
+}
+
+UGameplayEffectCache& UGameplayEffectCache::Get()
+{
+	check(GEngine);
+
+	UGameplayEffectCache* This = GEngine->GetEngineSubsystem<UGameplayEffectCache>();
+	check(This);
+
+	return *This;
+}
+
+UGameplayEffect* UGameplayEffectCache::FindOrCreateEffect(const FGameplayEffectModSignature& Signature, FName BaseName)
+{
+	/* Function FindOrCreateEffect
+	* Arguments: FGameplayEffectModSignature Signature - attributes and operations to modify, FName BaseName - base object name
+	* Output: A GameplayEffect with one SetByCaller modifier per signature entry
+	*/
+
+	if (UGameplayEffect** Found = EffectsBySignature.Find(Signature))
+	{
+		return *Found;
+	}
+
+	// Names are made unique so effects with the same base name never collide in the transient package
+	const FName EffectName = MakeUniqueObjectName(GetTransientPackage(), UGameplayEffect::StaticClass(), BaseName.IsNone() ? FName(TEXT("CodeEffect")) : BaseName);
+	UGameplayEffect* Effect = NewObject<UGameplayEffect>(GetTransientPackage(), EffectName);
+
+	for (const FGameplayEffectModSignature::FEntry& Entry : Signature.Entries)
+	{
+		FSetByCallerFloat SetByCaller;
+		SetByCaller.DataName = GetMagnitudeName(Entry.Attribute);
+
+		FGameplayModifierInfo ModifierInfo;
+		ModifierInfo.Attribute = Entry.Attribute;
+		ModifierInfo.ModifierOp = Entry.ModifierOp;
+		ModifierInfo.ModifierMagnitude = FGameplayEffectModifierMagnitude(SetByCaller);
+
+		Effect->Modifiers.Add(ModifierInfo);
+	}
+
+	CachedEffects.Add(Effect);
+	EffectsBySignature.Add(Signature, Effect);
+
+	return Effect;
+}
+
+void UGameplayEffectCache::SetModifierMagnitude(FGameplayEffectSpec& Spec, const FGameplayAttribute& Attribute, float Magnitude)
+{
+	Spec.SetSetByCallerMagnitude(GetMagnitudeName(Attribute), Magnitude);
+}
+
+FName UGameplayEffectCache::GetMagnitudeName(const FGameplayAttribute& Attribute)
+{
+	// The attribute's property name is already an FName, so no string conversion happens here
+	const FProperty* Property = Attribute.GetUProperty();
+	return Property ? Property->GetFName() : NAME_None;
+}
+
+void UGameplayEffectCache::Deinitialize()
+{
+	EffectsBySignature.Reset();
+	CachedEffects.Reset();
+
+	Super::Deinitialize();
+}
@@ -0,0 +1,127 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/EngineSubsystem.h"
+#include "GameplayEffect.h"
+#include "UObject/ObjectKey.h"
+#include "GameplayEffectCache.generated.h"
+
+class UAbilitySystemComponent;
+
+/**
+* Struct used to describe the "shape" of a GameplayEffect built in code: which attributes it modifies and how.
+* Magnitudes are NOT part of the signature, they are sent through SetByCaller values on the spec so
+* the same effect can be reused no matter the values we want to apply.
+*/
+struct GAS_DEMO_API FGameplayEffectModSignature
+{
+	struct FEntry
+	{
+		FGameplayAttribute Attribute;
+		EGameplayModOp::Type ModifierOp;
+
+		bool operator==(const FEntry& Other) const
+		{
+			return Attribute == Other.Attribute && ModifierOp == Other.ModifierOp;
+		}
+	};
+
+	/** Adds a modifier entry to the signature, returns itself so entries can be chained */
+	FGameplayEffectModSignature& Add(const FGameplayAttribute& Attribute, EGameplayModOp::Type ModifierOp)
+	{
+		Entries.Add({ Attribute, ModifierOp });
+		return *this;
+	}
+
+	bool operator==(const FGameplayEffectModSignature& Other) const
+	{
+		return Entries == Other.Entries;
+	}
+
+	friend uint32 GetTypeHash(const FGameplayEffectModSignature& Signature)
+	{
+		uint32 Hash = 0;
+		for (const FEntry& Entry : Signature.Entries)
+		{
+			Hash = HashCombine(Hash, HashCombine(GetTypeHash(Entry.Attribute), ::GetTypeHash((uint8)Entry.ModifierOp)));
+		}
+		return Hash;
+	}
+
+	TArray<FEntry, TInlineAllocator<16>> Entries;
+};
+
+/**
+* Per-owner cache of prebuilt FGameplayEffectSpecHandles keyed by effect, level and source object.
+* ApplyGameplayEffectSpecToSelf copies the spec before executing it, so a cached spec can be
+* re-applied as many times as needed. A cached spec is shared by every holder of its handle: callers that
+* fill SetByCaller magnitudes copy it first and change the copy.
+* The source tags and snapshotted source attributes are captured again every time a spec is reused,
+* so a cached spec never applies the state its source had when it was first built.
+* Effects and source objects are keyed by TObjectKey: a spec is never returned for a new object reusing the
+* address of a collected one. Owners Reset the cache when they leave play (ACharacterBase::EndPlay).
+*/
+struct GAS_DEMO_API FGameplayEffectSpecCache
+{
+	/**
+	* Returns the cached spec for Effect at Level, creating it on first use
+	*
+	* @param AbilitySystemComponent  ASC used to create the spec's context (instigator)
+	* @param Effect  GameplayEffect (CDO or code-built effect) the spec is made from
+	* @param Level  Level of the spec
+	* @param SourceObject  Optional source object added to the context
+	*/
+	FGameplayEffectSpecHandle FindOrMake(UAbilitySystemComponent* AbilitySystemComponent, const UGameplayEffect* Effect, float Level, UObject* SourceObject = nullptr);
+
+	/** Drops every cached spec, call when the owner's ASC or source data changes and when it leaves play */
+	void Reset() { Specs.Reset(); }
+
+private:
+	TMap<TTuple<TObjectKey<UGameplayEffect>, float, TObjectKey<UObject>>, FGameplayEffectSpecHandle> Specs;
+};
+
+UCLASS()
+class GAS_DEMO_API UGameplayEffectCache : public UEngineSubsystem
+{
+	GENERATED_BODY()
+
+/*
+* Class UGameplayEffectCache
+* Factory for GameplayEffects that are built in code rather than in Blueprint (such as the
+* FullHeal effect or the effect applied when changing equipment).
+* Every unique modifier signature is built only once and kept alive here, every magnitude
+* is defined as SetByCaller so callers only need to fill in their values on a (cached) spec.
+*/
+
+public:
+
+	/** Utility function to retrieve the cache from GEngine */
+	static UGameplayEffectCache& Get();
+
+	/**
+	* Returns the effect matching Signature, creating it on first use
+	*
+	* @param Signature  Attributes and modifier operations of the effect
+	* @param BaseName  Base name used for the effect object (made unique on creation)
+	*/
+	UGameplayEffect* FindOrCreateEffect(const FGameplayEffectModSignature& Signature, FName BaseName = NAME_None);
+
+	/** Utility function to fill a SetByCaller magnitude created by FindOrCreateEffect for the given attribute */
+	static void SetModifierMagnitude(FGameplayEffectSpec& Spec, const FGameplayAttribute& Attribute, float Magnitude);
+
+	/** Name used for the SetByCaller magnitude of the given attribute */
+	static FName GetMagnitudeName(const FGameplayAttribute& Attribute);
+
+	virtual void Deinitialize() override;
+
+private:
+
+	/** Lookup from signature to built effect */
+	TMap<FGameplayEffectModSignature, UGameplayEffect*> EffectsBySignature;
+
+	/** Keeps every built effect referenced so they are not garbage collected */
+	UPROPERTY()
+	TArray<UGameplayEffect*> CachedEffects;
+};
@@ -0,0 +1,156 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+
+#include "GameplayTagBitset.h"
+#include "GameplayTagsManager.h"
+
+const FGameplayTagBitIndex& FGameplayTagBitIndex::Get()
+{
+	static const FGameplayTagBitIndex Instance;
+	return Instance;
+}
+
+FGameplayTagBitIndex::FGameplayTagBitIndex()
+{
+	//Every node of the tag tree is indexed (not only the explicit tags) so parent tags get their own bit
+	FGameplayTagContainer AllTags;
+	UGameplayTagsManager::Get().RequestAllGameplayTags(AllTags, false);
+
+	TagToBit.Reserve(AllTags.Num());
+	for (const FGameplayTag& Tag : AllTags)
+	{
+		TagToBit.Add(Tag, TagToBit.Num());
+	}
+
+	NumWords = FMath::Max(1, FMath::DivideAndRoundUp(TagToBit.Num(), 64));
+}
+
+void FGameplayTagBitset::Initialize()
+{
+	Words.Reset();
+	Words.AddZeroed(FGameplayTagBitIndex::Get().GetNumWords());
+}
+
+bool FGameplayTagBitset::SetTag(const FGameplayTag& Tag, bool bValue)
+{
+	/* Function SetTag
+	* Arguments: const FGameplayTag& Tag - tag to update, bool bValue - whether the tag is owned
+	* Output: true if the tag is indexed and its bit was updated, false otherwise
+	*/
+
+	const int32 Bit = FGameplayTagBitIndex::Get().GetBitIndex(Tag);
+	if (Bit == INDEX_NONE || !IsInitialized()) return false;
+
+	const uint64 BitMask = 1ull << (Bit & 63);
+	if (bValue)
+		Words[Bit >> 6] |= BitMask;
+	else
+		Words[Bit >> 6] &= ~BitMask;
+
+	return true;
+}
+
+bool FGameplayTagBitset::AddTagWithParents(const FGameplayTag& Tag)
+{
+	bool bAllIndexed = true;
+	for (const FGameplayTag& ParentTag : Tag.GetGameplayTagParents())
+	{
+		bAllIndexed &= SetTag(ParentTag, true);
+	}
+	return bAllIndexed;
+}
+
+void FGameplayTagBitset::Reset()
+{
+	FMemory::Memzero(Words.GetData(), Words.Num() * sizeof(uint64));
+}
+
+bool FGameplayTagBitset::IsEmpty() const
+{
+	for (const uint64 Word : Words)
+	{
+		if (Word != 0) return false;
+	}
+	return true;
+}
+
+FCompiledTagQuery FCompiledTagQuery::FromRequirements(const FGameplayTagContainer& Required, const FGameplayTagContainer& Blocked)
+{
+	FCompiledTagQuery Compiled;
+	Compiled.RequireAll.Initialize();
+	Compiled.Blocked.Initialize();
+
+	Compiled.bValid = AddTagsToMask(Required, Compiled.RequireAll) && AddTagsToMask(Blocked, Compiled.Blocked);
+	return Compiled;
+}
+
+FCompiledTagQuery FCompiledTagQuery::FromQuery(const FGameplayTagQuery& Query)
+{
+	/* Function FromQuery
+	* Arguments: const FGameplayTagQuery& Query - query to compile
+	* Output: the compiled query, invalid if Query is empty or uses expressions that can't be turned into masks
+	*/
+
+	FCompiledTagQuery Compiled;
+	Compiled.RequireAll.Initialize();
+	Compiled.Blocked.Initialize();
+
+	//An empty FGameplayTagQuery never matches, keep it on the regular path
+	if (Query.IsEmpty()) return Compiled;
+
+	FGameplayTagQueryExpression RootExpression;
+	Query.GetQueryExpr(RootExpression);
+
+	if (RootExpression.ExprType == EGameplayTagQueryExprType::AllExprMatch)
+	{
+		for (const FGameplayTagQueryExpression& Expression : RootExpression.ExprSet)
+		{
+			if (!Compiled.CompileExpression(Expression)) return Compiled;
+		}
+		Compiled.bValid = true;
+	}
+	else
+	{
+		Compiled.bValid = Compiled.CompileExpression(RootExpression);
+	}
+
+	return Compiled;
+}
+
+bool FCompiledTagQuery::AddTagsToMask(const FGameplayTagContainer& Tags, FGameplayTagBitset& Mask)
+{
+	//The owned tags mirror includes parents, so the exact bit of each tag is all we need for a hierarchical match
+	for (const FGameplayTag& Tag : Tags)
+	{
+		if (!Mask.SetTag(Tag, true)) return false;
+	}
+	return true;
+}
+
+bool FCompiledTagQuery::CompileExpression(const FGameplayTagQueryExpression& Expression)
+{
+	const FGameplayTagContainer Tags = FGameplayTagContainer::CreateFromArray(Expression.TagSet);
+
+	switch (Expression.ExprType)
+	{
+	case EGameplayTagQueryExprType::AllTagsMatch:
+		return AddTagsToMask(Tags, RequireAll);
+
+	case EGameplayTagQueryExprType::NoTagsMatch:
+		return AddTagsToMask(Tags, Blocked);
+
+	case EGameplayTagQueryExprType::AnyTagsMatch:
+	{
+		//AnyTagsMatch with no tags never matches, leave that edge case to the regular path
+		if (Tags.IsEmpty()) return false;
+
+		FGameplayTagBitset& AnyMask = RequireAny.AddDefaulted_GetRef();
+		AnyMask.Initialize();
+		return AddTagsToMask(Tags, AnyMask);
+	}
+
+	default:
+		//Nested expressions (AnyExprMatch, NoExprMatch...) can't be expressed with these masks
+		return false;
+	}
+}
@@ -0,0 +1,121 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+
+/**
+* Maps every tag of the gameplay tag dictionary (DefaultGameplayTags.ini + native tags) to a bit index.
+* Built once, the first time it is needed: tags registered after that are not indexed and queries using
+* them can't be compiled (callers then fall back to regular FGameplayTagContainer checks).
+*/
+class GAS_DEMO_API FGameplayTagBitIndex
+{
+public:
+	static const FGameplayTagBitIndex& Get();
+
+	/** Returns the bit index of Tag, INDEX_NONE if the tag isn't indexed */
+	int32 GetBitIndex(const FGameplayTag& Tag) const
+	{
+		const int32* Found = TagToBit.Find(Tag);
+		return Found ? *Found : INDEX_NONE;
+	}
+
+	/** Number of 64 bit words needed to store one bit per indexed tag */
+	int32 GetNumWords() const { return NumWords; }
+
+	/** Number of indexed tags */
+	int32 GetNumTags() const { return TagToBit.Num(); }
+
+private:
+	FGameplayTagBitIndex();
+
+	TMap<FGameplayTag, int32> TagToBit;
+	int32 NumWords;
+};
+
+/** Fixed size bitset with one bit per tag of FGameplayTagBitIndex */
+struct GAS_DEMO_API FGameplayTagBitset
+{
+	/** Sizes the bitset for the tag dictionary and clears every bit */
+	void Initialize();
+
+	bool IsInitialized() const { return Words.Num() > 0; }
+
+	/** Sets or clears the bit of Tag, returns false if Tag isn't indexed */
+	bool SetTag(const FGameplayTag& Tag, bool bValue);
+
+	/** Sets the bit of Tag and of all its parents, returns false if any of them isn't indexed */
+	bool AddTagWithParents(const FGameplayTag& Tag);
+
+	void Reset();
+
+	bool IsEmpty() const;
+
+	/** True if every bit set in Mask is also set here */
+	bool HasAll(const FGameplayTagBitset& Mask) const
+	{
+		for (int32 Index = 0; Index < Words.Num(); ++Index)
+		{
+			if ((Words[Index] & Mask.Words[Index]) != Mask.Words[Index]) return false;
+		}
+		return true;
+	}
+
+	/** True if at least one bit set in Mask is also set here */
+	bool HasAny(const FGameplayTagBitset& Mask) const
+	{
+		for (int32 Index = 0; Index < Words.Num(); ++Index)
+		{
+			if ((Words[Index] & Mask.Words[Index]) != 0) return true;
+		}
+		return false;
+	}
+
+private:
+	TArray<uint64, TInlineAllocator<4>> Words;
+};
+
+/**
+* A tag check compiled into bit masks, evaluated against a FGameplayTagBitset that includes parent tags
+* (so hierarchical matching is the same as FGameplayTagContainer::HasTag).
+* Matches when every RequireAll bit is set, at least one bit of each RequireAny mask is set and no Blocked bit is set.
+*/
+struct GAS_DEMO_API FCompiledTagQuery
+{
+	/** Compiles "has all Required and none of Blocked" (ability activation style requirements) */
+	static FCompiledTagQuery FromRequirements(const FGameplayTagContainer& Required, const FGameplayTagContainer& Blocked);
+
+	/**
+	* Compiles a FGameplayTagQuery made of AllTagsMatch, AnyTagsMatch and NoTagsMatch expressions
+	* (on their own or inside an AllExprMatch), any other query shape results in an invalid query.
+	*/
+	static FCompiledTagQuery FromQuery(const FGameplayTagQuery& Query);
+
+	/** False if the query couldn't be compiled: use the regular tag container check instead */
+	bool IsValid() const { return bValid; }
+
+	bool Matches(const FGameplayTagBitset& OwnedTags) const
+	{
+		if (!OwnedTags.HasAll(RequireAll) || OwnedTags.HasAny(Blocked)) return false;
+
+		for (const FGameplayTagBitset& AnyMask : RequireAny)
+		{
+			if (!OwnedTags.HasAny(AnyMask)) return false;
+		}
+		return true;
+	}
+
+private:
+	/** Adds every tag of Tags to Mask, returns false if any of them isn't indexed */
+	static bool AddTagsToMask(const FGameplayTagContainer& Tags, FGameplayTagBitset& Mask);
+
+	/** Compiles one tag expression into this query, returns false if the expression isn't supported */
+	bool CompileExpression(const struct FGameplayTagQueryExpression& Expression);
+
+	FGameplayTagBitset RequireAll;
+	FGameplayTagBitset Blocked;
+	TArray<FGameplayTagBitset, TInlineAllocator<1>> RequireAny;
+	bool bValid = false;
+};
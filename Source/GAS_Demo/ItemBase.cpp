@@ -1,10 +1,68 @@
 // Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
-/*****************************************************
-******************************************************
-****** NOTE: CPP FILE IS EMPTY AS ALL REQUIRED  ******
-***** FUNCTIONALITY IS INCLUDED IN THE .H FILE *******
-******************************************************
-******************************************************/
+
 
 #include "ItemBase.h"
+#include "Abilities/GameplayAbility.h"
+#include "Engine/Texture2D.h"
+
+FSlateBrush UItemBase::GetItemIcon() const
+{
+	FSlateBrush Brush;
+	Brush.SetResourceObject(ItemIconTexture.Get());
+	Brush.ImageSize = ItemIconSize;
+	return Brush;
+}
+
+TSubclassOf<UGameplayAbility> UItemBase::GetGrantedAbilityClass() const
+{
+	return LoadBundleClass(GrantedAbilityClass.ToSoftObjectPath(), UGAS_DemoAssetManager::GameplayBundle);
+}
+
+UClass* UItemBase::LoadBundleClass(const FSoftObjectPath& ClassPath, FName BundleName) const
+{
+	/* Function LoadBundleClass
+	* Arguments: const FSoftObjectPath& ClassPath - soft class to resolve, FName BundleName - bundle it belongs to
+	* Output: the class, nullptr if ClassPath is empty
+	*/
+
+	if (ClassPath.IsNull()) return nullptr;
+
+	if (UClass* LoadedClass = Cast<UClass>(ClassPath.ResolveObject()))
+		return LoadedClass;
+
+	//Kept as a fallback so equipping never fails, but it hitches: every occurrence is a missing LoadItemBundles call
+	UE_LOG(LogTemp, Warning, TEXT("%s: %s loaded synchronously, load the '%s' bundle beforehand (UGAS_DemoAssetManager::LoadItemBundles)"),
+		*GetName(), *ClassPath.ToString(), *BundleName.ToString());
+
+	return Cast<UClass>(ClassPath.TryLoad());
+}
+
+FPrimaryAssetId UItemBase::GetPrimaryAssetId() const
+{
+	return FPrimaryAssetId(ItemType, GetFName());
+}
+
+void UItemBase::PostLoad()
+{
+	Super::PostLoad();
+
+	//Items saved before GrantedAbilityClass existed
+	if (GrantedAbilityClass.IsNull() && GrantedAbility)
+		GrantedAbilityClass = GrantedAbility.Get();
+
+#if WITH_EDITOR
+	//Blueprints may still read the hard references, the commandlet migrates them before clearing
+	if (HasDeprecatedHardReferences())
+		UE_LOG(LogTemp, Warning, TEXT("%s is saved with a hard GrantedAbility/WeaponActor, run the ItemReferenceMigration commandlet"), *GetPathName());
+#endif
 
+#if WITH_EDITORONLY_DATA
+	//Items saved with the old hard brush keep their icon (saved soft once resaved)
+	if (UTexture2D* OldIcon = Cast<UTexture2D>(ItemIcon_DEPRECATED.GetResourceObject()))
+	{
+		ItemIconTexture = OldIcon;
+		ItemIconSize = ItemIcon_DEPRECATED.ImageSize;
+		ItemIcon_DEPRECATED = FSlateBrush();
+	}
+#endif
+}
@@ -10,6 +10,7 @@
 
 class UGASGameplayAbility;
 class UGameplayAbility;
+class UTexture2D;
 
 UCLASS(Abstract, BlueprintType)
 class GAS_DEMO_API UItemBase : public UPrimaryDataAsset
@@ -19,17 +20,28 @@ class GAS_DEMO_API UItemBase : public UPrimaryDataAsset
 /*
 * Class UItemBase
 * Abstract class to be used as a Parent of all Items in the project
+*
+* Heavy references are soft and split in asset bundles (see UGAS_DemoAssetManager) so loading an item
+* only loads what is needed: "UI" for the icon (inventory listings), "Gameplay" for the GrantedAbilityClass
+* and "World" for things spawned in the level (UWeaponBase::WeaponActorClass).
+*
+* The old hard GrantedAbility (and UWeaponBase::WeaponActor) are deprecated but kept, so existing Blueprints
+* still compile. PostLoad copies them into the soft properties. An item keeps loading its ability with it
+* until the hard property is cleared: UItemReferenceMigrationCommandlet moves the Blueprints reading them to
+* GetGrantedAbilityClass/GetWeaponActorClass, then clears them and resaves the items.
 */
 
 public:
-	UItemBase() {};
+	UItemBase()
+	: ItemIconSize(32.f, 32.f)
+	{}
 
 	/** Definition of item Type */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Item)
 	FPrimaryAssetType ItemType;
 
 	/** Item name */
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Item)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, AssetRegistrySearchable, Category = Item)
 	FName ItemName;
 
 	/** Item Description */
@@ -38,15 +50,51 @@ public:
 
 	/** ID number of item : can be useful if there will be a lot of items in the project and need
 	* to keep track of them eventually, could also help making a database out of all items
+	* (searchable: UGAS_DemoAssetManager indexes it from the asset registry without loading items)
 	*/
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Item)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, AssetRegistrySearchable, Category = Item)
 	int32 ItemId;
 
-	/** Definition of item display icon: should be used on Inventory UI */
+	/** Definition of item display icon texture: Inventory UI should stream it through UItemIconCache (UI bundle) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Item, meta = (AssetBundles = "UI"))
+	TSoftObjectPtr<UTexture2D> ItemIconTexture;
+
+	/** Size the item icon is displayed at */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Item)
-	FSlateBrush ItemIcon;
+	FVector2D ItemIconSize;
 
-	/** Definition of item's GrantedAbility */
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item")
+	/** Definition of item's GrantedAbility (hard reference, loaded with the item): kept for existing Blueprints */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item", meta = (DeprecatedProperty, DeprecationMessage = "Loads the ability with the item, use GetGrantedAbilityClass (Gameplay bundle) and clear this."))
 	TSubclassOf<UGameplayAbility> GrantedAbility;
+
+	/** Definition of item's GrantedAbility: use GetGrantedAbilityClass (Gameplay bundle) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item", meta = (AssetBundles = "Gameplay"))
+	TSoftClassPtr<UGameplayAbility> GrantedAbilityClass;
+
+	/** Returns a brush for the item icon, empty until the UI bundle of this item is loaded */
+	UFUNCTION(BlueprintPure, Category = Item)
+	FSlateBrush GetItemIcon() const;
+
+	/** Returns the GrantedAbility class, loading it synchronously (with a warning) if the Gameplay bundle wasn't loaded beforehand */
+	UFUNCTION(BlueprintPure, Category = Item)
+	TSubclassOf<UGameplayAbility> GetGrantedAbilityClass() const;
+
+	/** True while the item is saved with a deprecated hard reference (loaded along with the item) */
+	virtual bool HasDeprecatedHardReferences() const { return GrantedAbility != nullptr; }
+
+	/** Items are identified by ItemType and asset name, the types PrimaryAssetTypesToScan registers in DefaultGame.ini */
+	virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+
+	virtual void PostLoad() override;
+
+protected:
+
+	/** Resolves a soft class of BundleName, warns when it had to be loaded synchronously */
+	UClass* LoadBundleClass(const FSoftObjectPath& ClassPath, FName BundleName) const;
+
+#if WITH_EDITORONLY_DATA
+	/** Hard icon brush used before icons were moved to the UI bundle, migrated to ItemIconTexture on load */
+	UPROPERTY()
+	FSlateBrush ItemIcon_DEPRECATED;
+#endif
 };
@@ -0,0 +1,218 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+
+#include "ItemIconCache.h"
+#include "ItemBase.h"
+#include "GAS_DemoAssetManager.h"
+#include "Engine/GameInstance.h"
+#include "Engine/Texture2D.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CVarItemIconCacheStats(
+	TEXT("GAS.Items.IconCache"),
+	TEXT("Prints item icon cache stats. Use 'GAS.Items.IconCache reset' to clear counters."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+		UItemIconCache* Cache = GameInstance ? GameInstance->GetSubsystem<UItemIconCache>() : nullptr;
+		if (!Cache)
+		{
+			Ar.Log(TEXT("No ItemIconCache for this world"));
+			return;
+		}
+
+		if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+		{
+			Cache->ResetStats();
+			return;
+		}
+
+		Cache->DumpStats(Ar);
+	}));
+
+UItemIconCache::UItemIconCache()
+{
+	//Default values, can be overriden in DefaultGame.ini under [/Script/GAS_Demo.ItemIconCache]
+	MemoryBudgetMB = 32.f;
+
+	ResidentBytes = 0;
+	NextRequestId = 1;
+	StatHits = 0;
+	StatMisses = 0;
+	StatEvictions = 0;
+	StatPeakBytes = 0;
+}
+
+void UItemIconCache::Deinitialize()
+{
+	for (TPair<FSoftObjectPath, FIconEntry>& Pair : Entries)
+	{
+		if (Pair.Value.Handle.IsValid())
+			Pair.Value.Handle->CancelHandle();
+	}
+
+	Entries.Empty();
+	LruList.Empty();
+	Requests.Empty();
+	ResidentBytes = 0;
+
+	Super::Deinitialize();
+}
+
+FSlateBrush UItemIconCache::MakeBrush(UTexture2D* Texture, const FVector2D& Size)
+{
+	FSlateBrush Brush;
+	Brush.SetResourceObject(Texture);
+	Brush.ImageSize = Size;
+	return Brush;
+}
+
+int32 UItemIconCache::RequestIcon(const UItemBase* Item, const FOnItemIconLoaded& OnLoaded)
+{
+	/* Function RequestIcon
+	* Arguments: const UItemBase* Item - item shown by the row, const FOnItemIconLoaded& OnLoaded - receives the icon brush
+	* Output: id of the request, to release it with ReleaseIcon (0 if Item has no icon)
+	*/
+
+	if (!Item || Item->ItemIconTexture.IsNull()) return 0;
+
+	const FSoftObjectPath IconPath = Item->ItemIconTexture.ToSoftObjectPath();
+
+	const int32 RequestId = NextRequestId++;
+	if (NextRequestId <= 0) NextRequestId = 1;
+	Requests.Add(RequestId, IconPath);
+
+	FIconEntry* Entry = Entries.Find(IconPath);
+	if (Entry)
+	{
+		Entry->PinCount++;
+		Touch(*Entry);
+
+		if (Entry->bLoaded)
+		{
+			StatHits++;
+			OnLoaded.ExecuteIfBound(MakeBrush(Cast<UTexture2D>(IconPath.ResolveObject()), Item->ItemIconSize));
+		}
+		else
+		{
+			Entry->PendingCallbacks.Add({ RequestId, OnLoaded, Item->ItemIconSize });
+		}
+		return RequestId;
+	}
+
+	StatMisses++;
+
+	Entry = &Entries.Add(IconPath);
+	Entry->PinCount = 1;
+	Entry->PendingCallbacks.Add({ RequestId, OnLoaded, Item->ItemIconSize });
+	LruList.AddHead(IconPath);
+	Entry->LruNode = LruList.GetHead();
+
+	//The delegate may run before RequestAsyncLoad returns (texture already in memory), so it looks the entry up again
+	TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(IconPath,
+		FStreamableDelegate::CreateUObject(this, &UItemIconCache::OnIconLoaded, IconPath));
+
+	if (FIconEntry* AddedEntry = Entries.Find(IconPath))
+		AddedEntry->Handle = Handle;
+
+	return RequestId;
+}
+
+void UItemIconCache::OnIconLoaded(FSoftObjectPath IconPath)
+{
+	FIconEntry* Entry = Entries.Find(IconPath);
+	if (!Entry || Entry->bLoaded) return;
+
+	UTexture2D* Texture = Cast<UTexture2D>(IconPath.ResolveObject());
+	Entry->bLoaded = true;
+	Entry->Bytes = Texture ? Texture->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal) : 0;
+
+	ResidentBytes += Entry->Bytes;
+	StatPeakBytes = FMath::Max(StatPeakBytes, ResidentBytes);
+
+	//Callbacks may request or release icons, which can reallocate Entries
+	TArray<FPendingIconCallback> Callbacks = MoveTemp(Entry->PendingCallbacks);
+	for (const FPendingIconCallback& Callback : Callbacks)
+	{
+		//Released by an earlier callback of this loop
+		if (Requests.Contains(Callback.RequestId))
+			Callback.OnLoaded.ExecuteIfBound(MakeBrush(Texture, Callback.Size));
+	}
+
+	EnforceBudget();
+}
+
+void UItemIconCache::ReleaseIcon(int32 RequestId)
+{
+	FSoftObjectPath IconPath;
+	if (!Requests.RemoveAndCopyValue(RequestId, IconPath)) return;
+
+	FIconEntry* Entry = Entries.Find(IconPath);
+	if (!Entry || Entry->PinCount == 0) return;
+
+	//A row hidden before its icon streamed in must not receive it
+	Entry->PendingCallbacks.RemoveAll([RequestId](const FPendingIconCallback& Callback) { return Callback.RequestId == RequestId; });
+
+	Entry->PinCount--;
+	EnforceBudget();
+}
+
+void UItemIconCache::Touch(FIconEntry& Entry)
+{
+	if (Entry.LruNode == LruList.GetHead()) return;
+
+	LruList.RemoveNode(Entry.LruNode, false);
+	LruList.AddHead(Entry.LruNode);
+}
+
+void UItemIconCache::EnforceBudget()
+{
+	/* Function EnforceBudget
+	* Arguments: none
+	* Output: none (walks the LRU list from its tail, dropping unpinned loaded icons until under budget)
+	*/
+
+	const int64 BudgetBytes = GetMemoryBudgetBytes();
+
+	TDoubleLinkedList<FSoftObjectPath>::TDoubleLinkedListNode* Node = LruList.GetTail();
+	while (Node && ResidentBytes > BudgetBytes)
+	{
+		TDoubleLinkedList<FSoftObjectPath>::TDoubleLinkedListNode* PreviousNode = Node->GetPrevNode();
+
+		FIconEntry* Entry = Entries.Find(Node->GetValue());
+		if (Entry && Entry->PinCount == 0 && Entry->bLoaded)
+		{
+			ResidentBytes -= Entry->Bytes;
+			if (Entry->Handle.IsValid())
+				Entry->Handle->ReleaseHandle();
+
+			Entries.Remove(Node->GetValue());
+			LruList.RemoveNode(Node);
+			StatEvictions++;
+		}
+
+		Node = PreviousNode;
+	}
+}
+
+void UItemIconCache::DumpStats(FOutputDevice& Ar) const
+{
+	int32 Pinned = 0;
+	for (const TPair<FSoftObjectPath, FIconEntry>& Pair : Entries)
+	{
+		Pinned += Pair.Value.PinCount > 0 ? 1 : 0;
+	}
+
+	Ar.Logf(TEXT("Item icon cache: %d icons (%d pinned), %.2fMB resident (peak %.2fMB, budget %.0fMB)"), Entries.Num(), Pinned,
+		ResidentBytes / (1024.0 * 1024.0), StatPeakBytes / (1024.0 * 1024.0), MemoryBudgetMB);
+	Ar.Logf(TEXT("  %llu hits, %llu misses, %llu evictions"), StatHits, StatMisses, StatEvictions);
+}
+
+void UItemIconCache::ResetStats()
+{
+	StatHits = 0;
+	StatMisses = 0;
+	StatEvictions = 0;
+	StatPeakBytes = ResidentBytes;
+}
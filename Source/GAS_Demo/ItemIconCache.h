@@ -0,0 +1,136 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Engine/StreamableManager.h"
+#include "Containers/List.h"
+#include "Styling/SlateBrush.h"
+#include "ItemIconCache.generated.h"
+
+class UItemBase;
+class UTexture2D;
+
+DECLARE_DYNAMIC_DELEGATE_OneParam(FOnItemIconLoaded, const FSlateBrush&, Icon);
+
+UCLASS(config = Game)
+class GAS_DEMO_API UItemIconCache : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+/*
+* Class UItemIconCache
+* Streams item icons (UItemBase::ItemIconTexture) for the inventory UI, so holding items in
+* ABasePlayerController::InventoryData doesn't keep their textures resident.
+*
+* Rows call RequestIcon when they become visible (the icon is pinned and sent through the callback once
+* streamed in) and ReleaseIcon with the returned request id when they scroll out, which also drops the row's
+* callback if the icon is still streaming. Released icons stay cached in LRU order until the
+* resident icon memory goes over MemoryBudgetMB, then the least recently used ones are dropped.
+*
+* Use GAS.Items.IconCache to check the cache. The GASDemo.Items.IconMemory test compares the texture memory of a
+* 1000 item inventory scrolled through with the cache against every icon resident.
+*/
+
+public:
+	UItemIconCache();
+
+	//~ Begin USubsystem
+	virtual void Deinitialize() override;
+	//~ End USubsystem
+
+	/**
+	* Pins the icon of Item and sends it to OnLoaded (right away if cached, once streamed in otherwise)
+	* Every request must be released with ReleaseIcon once the row using the icon is hidden
+	*
+	* @return Id of the request to pass to ReleaseIcon, 0 if Item has no icon
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Icons")
+	int32 RequestIcon(const UItemBase* Item, const FOnItemIconLoaded& OnLoaded);
+
+	/** Unpins the icon of a request and cancels its callback if the icon isn't loaded yet, the icon stays cached until the memory budget is exceeded */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Icons")
+	void ReleaseIcon(int32 RequestId);
+
+	/** Memory of the icons currently held by the cache */
+	int64 GetResidentBytes() const { return ResidentBytes; }
+
+	/** Highest GetResidentBytes since the last ResetStats */
+	int64 GetPeakBytes() const { return StatPeakBytes; }
+
+	/** Memory the unpinned icons may take, MemoryBudgetMB in bytes */
+	int64 GetMemoryBudgetBytes() const { return (int64)(MemoryBudgetMB * 1024.f * 1024.f); }
+
+	/** Icons dropped to stay under budget since the last ResetStats */
+	uint64 GetNumEvictions() const { return StatEvictions; }
+
+	/** Prints cache stats to the output device */
+	void DumpStats(FOutputDevice& Ar) const;
+
+	/** Clears the counters shown in DumpStats */
+	void ResetStats();
+
+protected:
+
+	/** Memory budget (in MB) of unpinned icons, pinned icons are never dropped, can be overriden in DefaultGame.ini under [/Script/GAS_Demo.ItemIconCache] */
+	UPROPERTY(Config)
+	float MemoryBudgetMB;
+
+private:
+
+	/** Request waiting for its icon, with the size of the requesting item's icon */
+	struct FPendingIconCallback
+	{
+		int32 RequestId;
+		FOnItemIconLoaded OnLoaded;
+		FVector2D Size;
+	};
+
+	struct FIconEntry
+	{
+		/** Keeps the texture loaded while the icon is cached */
+		TSharedPtr<FStreamableHandle> Handle;
+
+		/** Node of this icon in LruList */
+		TDoubleLinkedList<FSoftObjectPath>::TDoubleLinkedListNode* LruNode = nullptr;
+
+		/** Callbacks waiting for the texture */
+		TArray<FPendingIconCallback> PendingCallbacks;
+
+		int64 Bytes = 0;
+		int32 PinCount = 0;
+		bool bLoaded = false;
+	};
+
+	/** Streaming callback of an icon */
+	void OnIconLoaded(FSoftObjectPath IconPath);
+
+	/** Moves IconPath to the front of the LRU list */
+	void Touch(FIconEntry& Entry);
+
+	/** Drops least recently used unpinned icons until under budget */
+	void EnforceBudget();
+
+	static FSlateBrush MakeBrush(UTexture2D* Texture, const FVector2D& Size);
+
+	/** Cached icons by texture path */
+	TMap<FSoftObjectPath, FIconEntry> Entries;
+
+	/** Icon paths, most recently used first */
+	TDoubleLinkedList<FSoftObjectPath> LruList;
+
+	/** Icon of every request not released yet, by request id */
+	TMap<int32, FSoftObjectPath> Requests;
+
+	/** Id given to the next request (0 is never used) */
+	int32 NextRequestId;
+
+	int64 ResidentBytes;
+
+	//Stats counters, see DumpStats
+	uint64 StatHits;
+	uint64 StatMisses;
+	uint64 StatEvictions;
+	int64 StatPeakBytes;
+};
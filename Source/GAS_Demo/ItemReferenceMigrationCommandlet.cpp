@@ -0,0 +1,221 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+
+#include "ItemReferenceMigrationCommandlet.h"
+#include "GAS_DemoAssetManager.h"
+#include "ItemBase.h"
+#include "WeaponBase.h"
+
+#if WITH_EDITOR
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_VariableGet.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Misc/PackageName.h"
+#include "UObject/SavePackage.h"
+#endif
+
+UItemReferenceMigrationCommandlet::UItemReferenceMigrationCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UItemReferenceMigrationCommandlet::Main(const FString& Params)
+{
+	/* Function Main
+	* Arguments: const FString& Params - command line, -DryRun only logs what would change
+	* Output: 0 on success, 1 if a Blueprint or an item couldn't be migrated
+	*/
+
+#if WITH_EDITOR
+	const bool bDryRun = FParse::Param(*Params, TEXT("DryRun"));
+
+	UGAS_DemoAssetManager& AssetManager = UGAS_DemoAssetManager::Get();
+
+	//Commandlets run before the asset registry is done scanning
+	AssetManager.GetAssetRegistry().SearchAllAssets(true);
+	AssetManager.ScanPrimaryAssetTypesFromConfig();
+
+	//Blueprints first (components, characters, anim notifies...)
+	TArray<FAssetData> BlueprintAssets;
+	AssetManager.GetAssetRegistry().GetAssetsByClass(UBlueprint::StaticClass()->GetFName(), BlueprintAssets, true);
+
+	int32 NumNodes = 0;
+	int32 NumBlueprints = 0;
+	int32 NumFailed = 0;
+	for (const FAssetData& AssetData : BlueprintAssets)
+	{
+		if (!AssetData.PackageName.ToString().StartsWith(TEXT("/Game/"))) continue;
+
+		UBlueprint* Blueprint = Cast<UBlueprint>(AssetData.GetAsset());
+		const int32 NumReplaced = Blueprint ? MigrateBlueprint(Blueprint, bDryRun) : 0;
+		if (NumReplaced == INDEX_NONE)
+		{
+			NumFailed++;
+		}
+		else if (NumReplaced > 0)
+		{
+			NumNodes += NumReplaced;
+			NumBlueprints++;
+			if (!bDryRun && !SavePackage(Blueprint->GetOutermost()))
+				NumFailed++;
+		}
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("ItemReferenceMigration: %d reads of the hard item references %s in %d Blueprints"),
+		NumNodes, bDryRun ? TEXT("to replace") : TEXT("replaced"), NumBlueprints);
+
+	if (NumFailed > 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("ItemReferenceMigration: %d Blueprints couldn't be migrated, items keep their hard references"), NumFailed);
+		return 1;
+	}
+
+	int32 NumItems = 0;
+	for (const FPrimaryAssetType& ItemType : UGAS_DemoAssetManager::GetItemTypes())
+	{
+		TArray<FPrimaryAssetId> ItemIds;
+		AssetManager.GetPrimaryAssetIdList(ItemType, ItemIds);
+
+		for (const FPrimaryAssetId& ItemId : ItemIds)
+		{
+			UItemBase* Item = Cast<UItemBase>(AssetManager.GetPrimaryAssetPath(ItemId).TryLoad());
+			if (!Item || !MigrateItem(Item, bDryRun)) continue;
+
+			NumItems++;
+			if (!bDryRun && !SavePackage(Item->GetOutermost()))
+				NumFailed++;
+		}
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("ItemReferenceMigration: %d items %s"), NumItems, bDryRun ? TEXT("to clear") : TEXT("cleared and saved"));
+
+	return NumFailed > 0 ? 1 : 0;
+#else
+	return 1;
+#endif
+}
+
+#if WITH_EDITOR
+int32 UItemReferenceMigrationCommandlet::MigrateBlueprint(UBlueprint* Blueprint, bool bDryRun)
+{
+	/* Function MigrateBlueprint
+	* Arguments: UBlueprint* Blueprint - Blueprint to migrate, bool bDryRun - only count the nodes
+	* Output: number of nodes replaced, INDEX_NONE if one couldn't be or the Blueprint doesn't compile afterwards
+	*/
+
+	const FProperty* GrantedAbilityProperty = FindFProperty<FProperty>(UItemBase::StaticClass(), TEXT("GrantedAbility"));
+	const FProperty* WeaponActorProperty = FindFProperty<FProperty>(UWeaponBase::StaticClass(), TEXT("WeaponActor"));
+	const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+
+	TArray<UK2Node_VariableGet*> GetNodes;
+	FBlueprintEditorUtils::GetAllNodesOfClass(Blueprint, GetNodes);
+
+	int32 NumReplaced = 0;
+	for (UK2Node_VariableGet* GetNode : GetNodes)
+	{
+		const FProperty* Property = GetNode->GetPropertyForVariable();
+		if (!Property || (Property != GrantedAbilityProperty && Property != WeaponActorProperty)) continue;
+
+		//Class properties only have pure gets, anything else needs to be fixed by hand
+		UEdGraphPin* SelfPin = GetNode->FindPin(UEdGraphSchema_K2::PN_Self);
+		UEdGraphPin* ValuePin = GetNode->GetValuePin();
+		if (!SelfPin || !ValuePin || !GetNode->IsNodePure())
+		{
+			UE_LOG(LogTemp, Error, TEXT("ItemReferenceMigration: %s reads %s in a way that can't be replaced, migrate it by hand"),
+				*Blueprint->GetPathName(), *Property->GetName());
+			return INDEX_NONE;
+		}
+
+		NumReplaced++;
+		if (bDryRun) continue;
+
+		const bool bAbility = Property == GrantedAbilityProperty;
+		UEdGraph* Graph = GetNode->GetGraph();
+		UK2Node_CallFunction* CallNode = NewObject<UK2Node_CallFunction>(Graph);
+		if (bAbility)
+			CallNode->FunctionReference.SetExternalMember(GET_FUNCTION_NAME_CHECKED(UItemBase, GetGrantedAbilityClass), UItemBase::StaticClass());
+		else
+			CallNode->FunctionReference.SetExternalMember(GET_FUNCTION_NAME_CHECKED(UWeaponBase, GetWeaponActorClass), UWeaponBase::StaticClass());
+		CallNode->NodePosX = GetNode->NodePosX;
+		CallNode->NodePosY = GetNode->NodePosY;
+
+		Graph->AddNode(CallNode, false, false);
+		CallNode->CreateNewGuid();
+		CallNode->PostPlacedNewNode();
+		CallNode->AllocateDefaultPins();
+
+		//Same target and same return type as the property: the links move over as they are
+		Schema->MovePinLinks(*SelfPin, *CallNode->FindPinChecked(UEdGraphSchema_K2::PN_Self));
+		Schema->MovePinLinks(*ValuePin, *CallNode->GetReturnValuePin());
+		GetNode->DestroyNode();
+	}
+
+	if (NumReplaced == 0 || bDryRun)
+	{
+		if (NumReplaced > 0)
+			UE_LOG(LogTemp, Display, TEXT("ItemReferenceMigration: %s, %d nodes to replace"), *Blueprint->GetPathName(), NumReplaced);
+		return NumReplaced;
+	}
+
+	FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+	FKismetEditorUtilities::CompileBlueprint(Blueprint);
+	if (Blueprint->Status == BS_Error)
+	{
+		UE_LOG(LogTemp, Error, TEXT("ItemReferenceMigration: %s doesn't compile once migrated, not saved"), *Blueprint->GetPathName());
+		return INDEX_NONE;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("ItemReferenceMigration: %s, %d nodes replaced"), *Blueprint->GetPathName(), NumReplaced);
+	return NumReplaced;
+}
+
+bool UItemReferenceMigrationCommandlet::MigrateItem(UItemBase* Item, bool bDryRun)
+{
+	/* Function MigrateItem
+	* Arguments: UItemBase* Item - loaded item, bool bDryRun - only check it
+	* Output: true if the item had hard references (cleared unless bDryRun)
+	*/
+
+	if (!Item->HasDeprecatedHardReferences()) return false;
+
+	UWeaponBase* Weapon = Cast<UWeaponBase>(Item);
+
+	//Soft references set on their own win at runtime, worth a look if they point elsewhere
+	if (Item->GrantedAbility && Item->GrantedAbilityClass.ToSoftObjectPath() != FSoftObjectPath(Item->GrantedAbility.Get()))
+		UE_LOG(LogTemp, Warning, TEXT("ItemReferenceMigration: %s GrantedAbility %s differs from GrantedAbilityClass %s, keeping GrantedAbilityClass"),
+			*Item->GetPathName(), *Item->GrantedAbility->GetPathName(), *Item->GrantedAbilityClass.ToString());
+	if (Weapon && Weapon->WeaponActor && Weapon->WeaponActorClass.ToSoftObjectPath() != FSoftObjectPath(Weapon->WeaponActor.Get()))
+		UE_LOG(LogTemp, Warning, TEXT("ItemReferenceMigration: %s WeaponActor %s differs from WeaponActorClass %s, keeping WeaponActorClass"),
+			*Weapon->GetPathName(), *Weapon->WeaponActor->GetPathName(), *Weapon->WeaponActorClass.ToString());
+
+	UE_LOG(LogTemp, Display, TEXT("ItemReferenceMigration: %s, hard references %s"), *Item->GetPathName(), bDryRun ? TEXT("to clear") : TEXT("cleared"));
+	if (bDryRun) return true;
+
+	Item->Modify();
+	Item->GrantedAbility = nullptr;
+	if (Weapon)
+		Weapon->WeaponActor = nullptr;
+
+	return true;
+}
+
+bool UItemReferenceMigrationCommandlet::SavePackage(UPackage* Package)
+{
+	const FString Filename = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+
+	FSavePackageArgs SaveArgs;
+	SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+	if (!UPackage::SavePackage(Package, nullptr, *Filename, SaveArgs))
+	{
+		UE_LOG(LogTemp, Error, TEXT("ItemReferenceMigration: failed to save %s (read only or not checked out?)"), *Filename);
+		return false;
+	}
+	return true;
+}
+#endif
@@ -0,0 +1,44 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ItemReferenceMigrationCommandlet.generated.h"
+
+class UBlueprint;
+class UItemBase;
+
+UCLASS()
+class GAS_DEMO_API UItemReferenceMigrationCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+/*
+* Class UItemReferenceMigrationCommandlet
+* One-off migration off the deprecated hard item references (UItemBase::GrantedAbility, UWeaponBase::WeaponActor):
+* 1. Every Blueprint of the project reading them gets its variable get nodes replaced by GetGrantedAbilityClass and
+*    GetWeaponActorClass (pure, same target and return type), then is compiled and saved.
+* 2. Every item is loaded (PostLoad copies the hard references into the soft ones), cleared and saved.
+*
+* Items are only cleared once every Blueprint migrated, a Blueprint still reading them would get nullptr.
+* Saved packages must be writable (checked out). -DryRun only lists what would change:
+* UnrealEditor-Cmd GAS_Demo.uproject -run=ItemReferenceMigration [-DryRun]
+*/
+
+public:
+	UItemReferenceMigrationCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+#if WITH_EDITOR
+	/** Replaces the reads of the hard item references in Blueprint by their getters, returns the number of nodes (INDEX_NONE on failure) */
+	static int32 MigrateBlueprint(UBlueprint* Blueprint, bool bDryRun);
+
+	/** Clears the hard references of Item (already copied into the soft ones by PostLoad), returns true if it had any */
+	static bool MigrateItem(UItemBase* Item, bool bDryRun);
+
+	/** Saves Package to its file, false if it couldn't be written */
+	static bool SavePackage(UPackage* Package);
+#endif
+};
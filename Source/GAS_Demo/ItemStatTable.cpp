@@ -0,0 +1,142 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+
+#include "ItemStatTable.h"
+#include "WeaponBase.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Algo/BinarySearch.h"
+
+float FItemStatTable::GetWeaponStat(const UWeaponBase* Weapon, EItemStat Stat)
+{
+	switch (Stat)
+	{
+	case EItemStat::MinDamage: return Weapon->Damage.MinDamage;
+	case EItemStat::MaxDamage: return Weapon->Damage.MaxDamage;
+	case EItemStat::Health: return Weapon->Health;
+	case EItemStat::Stamina: return Weapon->Stamina;
+	case EItemStat::Mana: return Weapon->Mana;
+	case EItemStat::AttackPower: return Weapon->AttackPower;
+	case EItemStat::Defense: return Weapon->Defense;
+	case EItemStat::Strength: return Weapon->Strength;
+	case EItemStat::Dexterity: return Weapon->Dexterity;
+	case EItemStat::Vitality: return Weapon->Vitality;
+	case EItemStat::Endurance: return Weapon->Endurance;
+	case EItemStat::Intelligence: return Weapon->Intelligence;
+	case EItemStat::Mind: return Weapon->Mind;
+	case EItemStat::Agility: return Weapon->Agility;
+	case EItemStat::CriticalRate: return Weapon->CriticalRate;
+	default: return 0.f;
+	}
+}
+
+FString FItemStatTable::GetDefaultPath()
+{
+	return FPaths::ProjectContentDir() / TEXT("Data/ItemStats.bin");
+}
+
+void FItemStatTable::Serialize(const TArray<const UWeaponBase*>& Weapons, TArray<uint8>& OutData)
+{
+	/* Function Serialize
+	* Arguments: const TArray<const UWeaponBase*>& Weapons - weapons to pack, TArray<uint8>& OutData - receives the file
+	* Output: none
+	*/
+
+	//Rows sorted by ItemId for binary search, the first weapon using an ItemId keeps it
+	TArray<const UWeaponBase*> Rows;
+	Rows.Reserve(Weapons.Num());
+	for (const UWeaponBase* Weapon : Weapons)
+	{
+		if (Weapon) Rows.Add(Weapon);
+	}
+	Rows.StableSort([](const UWeaponBase& A, const UWeaponBase& B) { return A.ItemId < B.ItemId; });
+	for (int32 Row = Rows.Num() - 1; Row > 0; --Row)
+	{
+		if (Rows[Row]->ItemId != Rows[Row - 1]->ItemId) continue;
+
+		UE_LOG(LogTemp, Warning, TEXT("ItemStatTable: %s has the same ItemId (%d) as %s, its stats aren't in the table"),
+			*Rows[Row]->GetPathName(), Rows[Row]->ItemId, *Rows[Row - 1]->GetPathName());
+		Rows.RemoveAt(Row, 1, false);
+	}
+
+	const int32 Count = Rows.Num();
+	const int32 NumColumns = (int32)EItemStat::Num;
+
+	OutData.Reset();
+	OutData.AddZeroed(sizeof(FHeader) + Count * sizeof(int32) * (1 + NumColumns));
+
+	FHeader* Header = reinterpret_cast<FHeader*>(OutData.GetData());
+	Header->Magic = FileMagic;
+	Header->Version = FileVersion;
+	Header->NumItems = Count;
+	Header->NumColumns = NumColumns;
+
+	int32* OutIds = reinterpret_cast<int32*>(Header + 1);
+	float* OutColumns = reinterpret_cast<float*>(OutIds + Count);
+	for (int32 Row = 0; Row < Count; ++Row)
+	{
+		OutIds[Row] = Rows[Row]->ItemId;
+		for (int32 Column = 0; Column < NumColumns; ++Column)
+		{
+			OutColumns[Column * Count + Row] = GetWeaponStat(Rows[Row], (EItemStat)Column);
+		}
+	}
+}
+
+bool FItemStatTable::LoadFromFile(const FString& Path)
+{
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *Path, FILEREAD_Silent))
+	{
+		Reset();
+		return false;
+	}
+
+	return LoadFromMemory(MoveTemp(Data));
+}
+
+bool FItemStatTable::LoadFromMemory(TArray<uint8>&& Data)
+{
+	/* Function LoadFromMemory
+	* Arguments: TArray<uint8>&& Data - content of a table file
+	* Output: true if the table is valid and now in use
+	*/
+
+	Reset();
+
+	if (Data.Num() < (int32)sizeof(FHeader)) return false;
+
+	const FHeader* Header = reinterpret_cast<const FHeader*>(Data.GetData());
+	if (Header->Magic != FileMagic || Header->Version != FileVersion || Header->NumColumns != (int32)EItemStat::Num || Header->NumItems < 0)
+		return false;
+
+	const int64 ExpectedSize = sizeof(FHeader) + (int64)Header->NumItems * sizeof(int32) * (1 + Header->NumColumns);
+	if (Data.Num() != ExpectedSize) return false;
+
+	Buffer = MoveTemp(Data);
+	Header = reinterpret_cast<const FHeader*>(Buffer.GetData());
+	NumItems = Header->NumItems;
+	ItemIds = reinterpret_cast<const int32*>(Header + 1);
+
+	const float* FirstColumn = reinterpret_cast<const float*>(ItemIds + NumItems);
+	for (int32 Column = 0; Column < (int32)EItemStat::Num; ++Column)
+	{
+		Columns[Column] = FirstColumn + Column * NumItems;
+	}
+
+	return true;
+}
+
+void FItemStatTable::Reset()
+{
+	Buffer.Empty();
+	ItemIds = nullptr;
+	FMemory::Memzero(Columns);
+	NumItems = 0;
+}
+
+int32 FItemStatTable::FindRow(int32 ItemId) const
+{
+	const int32 Row = Algo::LowerBound(GetItemIds(), ItemId);
+	return Row < NumItems && ItemIds[Row] == ItemId ? Row : INDEX_NONE;
+}
@@ -0,0 +1,101 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UWeaponBase;
+
+/** Columns of FItemStatTable, one per stat of UWeaponBase */
+enum class EItemStat : uint8
+{
+	MinDamage,
+	MaxDamage,
+	Health,
+	Stamina,
+	Mana,
+	AttackPower,
+	Defense,
+	Strength,
+	Dexterity,
+	Vitality,
+	Endurance,
+	Intelligence,
+	Mind,
+	Agility,
+	CriticalRate,
+	Num
+};
+
+/**
+* Stats of every weapon of the catalog packed as a structure of arrays keyed by ItemId, so balance tools and
+* server loot logic can read stats without having the UWeaponBase assets resident.
+*
+* File layout (little endian): FHeader, then NumItems sorted ItemIds (int32), then one column of NumItems
+* floats per EItemStat. The whole file is read in one go and the columns point straight into that buffer.
+* Generated by UItemStatTableCommandlet (at the start of every cook, and by the editor whenever weapons changed since),
+* loaded by UGAS_DemoAssetManager at startup.
+*/
+class GAS_DEMO_API FItemStatTable
+{
+public:
+	static constexpr uint32 FileMagic = 0x42545349; // "ISTB"
+	static constexpr uint32 FileVersion = 1;
+
+	/** Path of the table: Content/Data/ItemStats.bin (staged as a non-asset file) */
+	static FString GetDefaultPath();
+
+	/** Value of Stat on the Weapon asset, what its column holds */
+	static float GetWeaponStat(const UWeaponBase* Weapon, EItemStat Stat);
+
+	/** Packs the stats of Weapons (weapons reusing an ItemId are skipped with a warning) in the file format */
+	static void Serialize(const TArray<const UWeaponBase*>& Weapons, TArray<uint8>& OutData);
+
+	/** Bulk loads a table file, returns false (and leaves the table empty) if missing or invalid */
+	bool LoadFromFile(const FString& Path);
+
+	/** Uses Data as the table buffer, returns false (and leaves the table empty) if it is invalid */
+	bool LoadFromMemory(TArray<uint8>&& Data);
+
+	void Reset();
+
+	bool IsLoaded() const { return NumItems > 0; }
+
+	int32 GetNumItems() const { return NumItems; }
+
+	/** Row of ItemId (binary search over the sorted ids), INDEX_NONE if the item isn't in the table */
+	int32 FindRow(int32 ItemId) const;
+
+	/** Value of Stat for the item at Row */
+	float GetStat(int32 Row, EItemStat Stat) const
+	{
+		check(Row >= 0 && Row < NumItems);
+		return Columns[(int32)Stat][Row];
+	}
+
+	/** Whole column of Stat (NumItems values, in row order) */
+	TArrayView<const float> GetColumn(EItemStat Stat) const { return TArrayView<const float>(Columns[(int32)Stat], NumItems); }
+
+	/** Item ids in row order */
+	TArrayView<const int32> GetItemIds() const { return TArrayView<const int32>(ItemIds, NumItems); }
+
+	/** Bytes held by the table */
+	SIZE_T GetAllocatedSize() const { return Buffer.GetAllocatedSize(); }
+
+private:
+
+	struct FHeader
+	{
+		uint32 Magic;
+		uint32 Version;
+		int32 NumItems;
+		int32 NumColumns;
+	};
+
+	/** Whole file, ItemIds and Columns point into it */
+	TArray<uint8> Buffer;
+
+	const int32* ItemIds = nullptr;
+	const float* Columns[(int32)EItemStat::Num] = {};
+	int32 NumItems = 0;
+};
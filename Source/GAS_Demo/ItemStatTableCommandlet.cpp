@@ -0,0 +1,134 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+
+#include "ItemStatTableCommandlet.h"
+#include "ItemStatTable.h"
+#include "GAS_DemoAssetManager.h"
+#include "WeaponBase.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+
+/** Commandlets and cooks run before the asset registry is done scanning, the editor calls WriteItemStatTable once it is */
+static void ScanItemAssets()
+{
+	UGAS_DemoAssetManager& AssetManager = UGAS_DemoAssetManager::Get();
+	AssetManager.GetAssetRegistry().SearchAllAssets(true);
+	AssetManager.ScanPrimaryAssetTypesFromConfig();
+}
+
+UItemStatTableCommandlet::UItemStatTableCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UItemStatTableCommandlet::Main(const FString& Params)
+{
+	/* Function Main
+	* Arguments: const FString& Params - command line, -Output=Path overrides the table path
+	* Output: 0 on success, 1 on failure
+	*/
+
+	FString OutputPath = FItemStatTable::GetDefaultPath();
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+
+	ScanItemAssets();
+	return WriteItemStatTable(OutputPath) ? 0 : 1;
+}
+
+void UItemStatTableCommandlet::OnModifyCook(TArray<FName>& PackagesToCook, TArray<FName>& PackagesToNeverCook)
+{
+	//Staged from Data as a non-asset file once the cook is done, a stale table is still better than none
+	ScanItemAssets();
+	if (!WriteItemStatTable(FItemStatTable::GetDefaultPath()))
+		UE_LOG(LogTemp, Error, TEXT("ItemStatTable: the cook couldn't regenerate %s"), *FItemStatTable::GetDefaultPath());
+}
+
+bool UItemStatTableCommandlet::WriteItemStatTable(const FString& OutputPath)
+{
+	/* Function WriteItemStatTable
+	* Arguments: const FString& OutputPath - file to write
+	* Output: true if the table was written
+	*/
+
+	UGAS_DemoAssetManager& AssetManager = UGAS_DemoAssetManager::Get();
+
+	TArray<FPrimaryAssetId> WeaponIds;
+	AssetManager.GetPrimaryAssetIdList(UGAS_DemoAssetManager::WeaponItemType, WeaponIds);
+
+	TArray<const UWeaponBase*> Weapons;
+	for (const FPrimaryAssetId& WeaponId : WeaponIds)
+	{
+		const FSoftObjectPath WeaponPath = AssetManager.GetPrimaryAssetPath(WeaponId);
+		if (const UWeaponBase* Weapon = Cast<UWeaponBase>(WeaponPath.TryLoad()))
+			Weapons.Add(Weapon);
+		else
+			UE_LOG(LogTemp, Warning, TEXT("ItemStatTable: failed to load %s"), *WeaponId.ToString());
+	}
+
+	TArray<uint8> Data;
+	FItemStatTable::Serialize(Weapons, Data);
+
+	if (!FFileHelper::SaveArrayToFile(Data, *OutputPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("ItemStatTable: failed to write %s"), *OutputPath);
+		return false;
+	}
+
+	FItemStatTable Table;
+	Table.LoadFromMemory(MoveTemp(Data));
+	UE_LOG(LogTemp, Display, TEXT("ItemStatTable: %d weapons (%d loaded) written to %s (%.1fKB)"),
+		Table.GetNumItems(), Weapons.Num(), *OutputPath, Table.GetAllocatedSize() / 1024.0);
+
+	return true;
+}
+
+bool UItemStatTableCommandlet::IsItemStatTableStale(const FItemStatTable& Table, const FString& Path)
+{
+	/* Function IsItemStatTableStale
+	* Arguments: const FItemStatTable& Table - table loaded from Path, const FString& Path - its file
+	* Output: true if the table should be written again (only reads asset registry tags and file dates, no weapon is loaded)
+	*/
+
+	const FDateTime TableTime = IFileManager::Get().GetTimeStamp(*Path);
+	if (!Table.IsLoaded() || TableTime == FDateTime::MinValue())
+		return true;
+
+	TArray<FAssetData> WeaponAssets;
+	UGAS_DemoAssetManager::Get().GetPrimaryAssetDataList(UGAS_DemoAssetManager::WeaponItemType, WeaponAssets);
+
+	//Added or removed weapons change the set of ItemIds (duplicates are left out of the table either way)
+	TSet<int32> WeaponItemIds;
+	bool bAllTagged = true;
+	for (const FAssetData& AssetData : WeaponAssets)
+	{
+		int32 ItemId = INDEX_NONE;
+		if (AssetData.GetTagValue(UGAS_DemoAssetManager::ItemIdTag, ItemId))
+			WeaponItemIds.Add(ItemId);
+		else
+			bAllTagged = false;
+
+		//Edited weapons: their package was saved after the table was written
+		FString PackageFilename;
+		if (FPackageName::TryConvertLongPackageNameToFilename(AssetData.PackageName.ToString(), PackageFilename, FPackageName::GetAssetPackageExtension())
+			&& IFileManager::Get().GetTimeStamp(*PackageFilename) > TableTime)
+			return true;
+	}
+
+	//Weapons saved before ItemId was searchable can only be compared by date until resaved
+	if (!bAllTagged)
+		return false;
+
+	if (WeaponItemIds.Num() != Table.GetNumItems())
+		return true;
+
+	for (const int32 ItemId : Table.GetItemIds())
+	{
+		if (!WeaponItemIds.Contains(ItemId))
+			return true;
+	}
+	return false;
+}
@@ -0,0 +1,40 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ItemStatTableCommandlet.generated.h"
+
+class FItemStatTable;
+
+UCLASS()
+class GAS_DEMO_API UItemStatTableCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+/*
+* Class UItemStatTableCommandlet
+* Cook step generating the packed item stat table (see FItemStatTable): loads every weapon of the asset manager
+* and writes their stats to Content/Data/ItemStats.bin, which is staged as a non-asset file.
+*
+* Cooks run it by themselves when they start (OnModifyCook, registered by UGAS_DemoAssetManager), so packaged builds
+* always ship a table matching their weapons. The editor rewrites the table once its asset scan is done and before
+* every PIE session when it is stale (see IsItemStatTableStale). It can also be run by hand:
+* UnrealEditor-Cmd GAS_Demo.uproject -run=ItemStatTable [-Output=Path]
+*/
+
+public:
+	UItemStatTableCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+	/** Loads every weapon and writes their table to OutputPath, returns false if the file couldn't be written (the asset registry must be scanned) */
+	static bool WriteItemStatTable(const FString& OutputPath);
+
+	/** True if Table (loaded from Path) is missing, holds other ItemIds than the scanned weapons or is older than one of their packages */
+	static bool IsItemStatTableStale(const FItemStatTable& Table, const FString& Path);
+
+	/** FGameDelegates ModifyCookDelegate handler, regenerates the table at the default path before anything is cooked */
+	static void OnModifyCook(TArray<FName>& PackagesToCook, TArray<FName>& PackagesToNeverCook);
+};
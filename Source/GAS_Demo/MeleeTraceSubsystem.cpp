@@ -0,0 +1,262 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+
+#include "MeleeTraceSubsystem.h"
+#include "GASDemoTrace.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarMeleeSyncTraces(
+	TEXT("GAS.Melee.SyncTraces"),
+	0,
+	TEXT("Run melee sweeps synchronously on the game thread (1) instead of batched async traces (0), for comparison."));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CVarMeleeStats(
+	TEXT("GAS.Melee.Stats"),
+	TEXT("Prints the cost of melee hit detection. Use 'GAS.Melee.Stats reset' to clear counters."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		UMeleeTraceSubsystem* Subsystem = World ? World->GetSubsystem<UMeleeTraceSubsystem>() : nullptr;
+		if (!Subsystem)
+		{
+			Ar.Log(TEXT("No MeleeTraceSubsystem in this world"));
+			return;
+		}
+
+		if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+		{
+			Subsystem->ResetStats();
+			return;
+		}
+
+		Subsystem->DumpStats(Ar);
+	}));
+
+bool UMeleeTraceSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UMeleeTraceSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	NextSwingId = 1;
+	FrameResultCycles = 0;
+	SweepDelegate.BindUObject(this, &UMeleeTraceSubsystem::OnSweepCompleted);
+
+	ResetStats();
+}
+
+void UMeleeTraceSubsystem::Deinitialize()
+{
+	Swings.Reset();
+	SweepDelegate.Unbind();
+
+	Super::Deinitialize();
+}
+
+uint32 UMeleeTraceSubsystem::BeginSwing(const FMeleeSwingParams& Params, FOnMeleeSwingHits OnHits)
+{
+	/* Function BeginSwing
+	* Arguments: const FMeleeSwingParams& Params - blade description, FOnMeleeSwingHits OnHits - hit callback
+	* Output: id of the new swing, 0 if the blade has no mesh
+	*/
+
+	if (!Params.Mesh.IsValid()) return 0;
+
+	const uint32 SwingId = NextSwingId++;
+	if (NextSwingId == 0) NextSwingId = 1;
+
+	FMeleeSwing& Swing = Swings.Add(SwingId);
+	Swing.Params = Params;
+	Swing.Params.NumSamples = FMath::Max(2, Params.NumSamples);
+	Swing.OnHits = MoveTemp(OnHits);
+
+	Swing.QueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(MeleeSweep), false, Params.Attacker.Get());
+	if (AActor* WeaponActor = Params.Mesh->GetOwner())
+		Swing.QueryParams.AddIgnoredActor(WeaponActor);
+
+	//First sweep starts from the blade position at the start of the swing
+	GetSwingPoints(Swing, Swing.PreviousPoints);
+
+	return SwingId;
+}
+
+void UMeleeTraceSubsystem::EndSwing(uint32 SwingId)
+{
+	Swings.Remove(SwingId);
+}
+
+bool UMeleeTraceSubsystem::GetSwingPoints(const FMeleeSwing& Swing, TArray<FVector, TInlineAllocator<8>>& OutPoints) const
+{
+	const USceneComponent* Mesh = Swing.Params.Mesh.Get();
+	if (!Mesh) return false;
+
+	const FVector Start = Mesh->GetSocketLocation(Swing.Params.StartSocket);
+	const FVector End = Mesh->GetSocketLocation(Swing.Params.EndSocket);
+
+	const int32 NumSamples = Swing.Params.NumSamples;
+	OutPoints.SetNumUninitialized(NumSamples, false);
+	for (int32 Sample = 0; Sample < NumSamples; ++Sample)
+	{
+		OutPoints[Sample] = FMath::Lerp(Start, End, (float)Sample / (float)(NumSamples - 1));
+	}
+
+	return true;
+}
+
+bool UMeleeTraceSubsystem::IsTickable() const
+{
+	//Nothing to sweep between attacks, a tick is still needed to account for the results of the last sweeps
+	return Swings.Num() > 0 || FrameResultCycles > 0;
+}
+
+void UMeleeTraceSubsystem::Tick(float DeltaTime)
+{
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	UWorld* World = GetWorld();
+	const bool bSyncTraces = CVarMeleeSyncTraces.GetValueOnGameThread() != 0;
+
+	FinishedSwings.Reset();
+
+	for (TPair<uint32, FMeleeSwing>& Pair : Swings)
+	{
+		FMeleeSwing& Swing = Pair.Value;
+
+		if (!GetSwingPoints(Swing, CurrentPoints))
+		{
+			FinishedSwings.Add(Pair.Key);
+			continue;
+		}
+
+		const FCollisionShape Sphere = FCollisionShape::MakeSphere(Swing.Params.Radius);
+
+		for (int32 Sample = 0; Sample < CurrentPoints.Num(); ++Sample)
+		{
+			if (bSyncTraces)
+			{
+				//Processed after the loop, hit callbacks may end or start swings
+				SweepHits.Reset();
+				World->SweepMultiByChannel(SweepHits, Swing.PreviousPoints[Sample], CurrentPoints[Sample], FQuat::Identity, Swing.Params.TraceChannel, Sphere, Swing.QueryParams);
+				if (SweepHits.Num() > 0)
+				{
+					SyncResults.Add({ Pair.Key, SyncHits.Num(), SweepHits.Num() });
+					SyncHits.Append(SweepHits);
+				}
+			}
+			else
+			{
+				//Every sweep of the frame is queued in the same async trace batch, results come back next frame
+				World->AsyncSweepByChannel(EAsyncTraceType::Multi, Swing.PreviousPoints[Sample], CurrentPoints[Sample], FQuat::Identity,
+					Swing.Params.TraceChannel, Sphere, Swing.QueryParams, FCollisionResponseParams::DefaultResponseParam, &SweepDelegate, Pair.Key);
+			}
+
+			StatSweeps++;
+		}
+
+		Swing.PreviousPoints = CurrentPoints;
+	}
+
+	for (const FSyncSweepResult& Result : SyncResults)
+	{
+		ProcessHits(Result.SwingId, TConstArrayView<FHitResult>(SyncHits.GetData() + Result.FirstHit, Result.NumHits));
+	}
+	SyncResults.Reset();
+	SyncHits.Reset();
+
+	//Swings whose mesh is gone (their task still calls EndSwing)
+	for (const uint32 SwingId : FinishedSwings)
+	{
+		Swings.Remove(SwingId);
+	}
+
+	//Results of last frame's async sweeps were processed before this tick
+	const uint64 IssueCycles = FPlatformTime::Cycles64() - StartCycles;
+	if (Swings.Num() > 0 || FrameResultCycles > 0)
+	{
+		StatFrames++;
+		StatIssueCycles += IssueCycles;
+		StatMaxFrameCycles = FMath::Max(StatMaxFrameCycles, IssueCycles + FrameResultCycles);
+	}
+	FrameResultCycles = 0;
+}
+
+void UMeleeTraceSubsystem::OnSweepCompleted(const FTraceHandle& Handle, FTraceDatum& Datum)
+{
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	ProcessHits(Datum.UserData, Datum.OutHits);
+
+	const uint64 Cycles = FPlatformTime::Cycles64() - StartCycles;
+	StatResultCycles += Cycles;
+	FrameResultCycles += Cycles;
+}
+
+void UMeleeTraceSubsystem::ProcessHits(uint32 SwingId, TConstArrayView<FHitResult> Hits)
+{
+	/* Function ProcessHits
+	* Arguments: uint32 SwingId - swing that swept, TConstArrayView<FHitResult> Hits - sweep results
+	* Output: none (reports actors this swing hasn't hit yet)
+	*/
+
+	//The swing may have ended while its async sweep was running
+	FMeleeSwing* Swing = Swings.Find(SwingId);
+	if (!Swing || Hits.Num() == 0) return;
+
+	NewHits.Reset();
+	for (const FHitResult& Hit : Hits)
+	{
+		AActor* HitActor = Hit.GetActor();
+		if (!HitActor) continue;
+
+		bool bAlreadyHit = false;
+		Swing->HitActors.Add(HitActor, &bAlreadyHit);
+		if (!bAlreadyHit)
+			NewHits.Add(Hit);
+	}
+
+	if (NewHits.Num() > 0)
+	{
+		GASDEMO_TRACE_SCOPE("MeleeTrace::ReportHits");
+		GASDEMO_TRACE_COUNTER_ADD(GASDemo_MeleeHitTargets, NewHits.Num());
+
+		StatHitsReported += NewHits.Num();
+		Swing->OnHits.ExecuteIfBound(NewHits);
+	}
+}
+
+TStatId UMeleeTraceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UMeleeTraceSubsystem, STATGROUP_Tickables);
+}
+
+void UMeleeTraceSubsystem::DumpStats(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("Melee sweeps: %d active swings, %llu sweeps, %llu hits reported (%s traces)"), Swings.Num(), StatSweeps, StatHitsReported,
+		CVarMeleeSyncTraces.GetValueOnGameThread() != 0 ? TEXT("sync") : TEXT("async"));
+
+	if (StatFrames == 0)
+	{
+		Ar.Log(TEXT("  No frames recorded yet"));
+		return;
+	}
+
+	Ar.Logf(TEXT("  Game thread per frame: avg %.4fms (issue %.4fms, results %.4fms), max %.4fms over %llu frames"),
+		FPlatformTime::ToMilliseconds64(StatIssueCycles + StatResultCycles) / (double)StatFrames,
+		FPlatformTime::ToMilliseconds64(StatIssueCycles) / (double)StatFrames,
+		FPlatformTime::ToMilliseconds64(StatResultCycles) / (double)StatFrames,
+		FPlatformTime::ToMilliseconds64(StatMaxFrameCycles), StatFrames);
+}
+
+void UMeleeTraceSubsystem::ResetStats()
+{
+	StatFrames = 0;
+	StatSweeps = 0;
+	StatHitsReported = 0;
+	StatIssueCycles = 0;
+	StatResultCycles = 0;
+	StatMaxFrameCycles = 0;
+}
@@ -0,0 +1,155 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineTypes.h"
+#include "WorldCollision.h"
+#include "MeleeTraceSubsystem.generated.h"
+
+/** Called with the actors newly hit by a swing (each actor is only reported once per swing) */
+DECLARE_DELEGATE_OneParam(FOnMeleeSwingHits, const TArray<FHitResult>& /*NewHits*/);
+
+/** Describes the blade of a melee swing */
+struct FMeleeSwingParams
+{
+	/** Component holding the sockets (weapon mesh, or the character's mesh for unarmed attacks) */
+	TWeakObjectPtr<USceneComponent> Mesh;
+
+	/** Sockets at both ends of the blade */
+	FName StartSocket;
+	FName EndSocket;
+
+	/** Radius of the swept spheres */
+	float Radius = 10.f;
+
+	/** Number of points swept along the blade (at least 2: both ends) */
+	int32 NumSamples = 4;
+
+	ECollisionChannel TraceChannel = ECC_Pawn;
+
+	/** Actor doing the swing, never reported as hit */
+	TWeakObjectPtr<AActor> Attacker;
+};
+
+UCLASS()
+class GAS_DEMO_API UMeleeTraceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+/*
+* Class UMeleeTraceSubsystem
+* Melee hit detection for every attacker in the world: each frame, every active swing sweeps spheres from the
+* previous to the current position of a few points along its blade (between two sockets), so fast swings can't
+* skip through targets between frames.
+*
+* All sweeps of a frame are issued together as async traces and run off the game thread, their results come back
+* at the start of the next frame. Targets are deduplicated per swing before being reported.
+* Async hits are therefore reported one frame after the blade went through the target: damage applied from the hit
+* callback (UAbilityTask_MeleeSweep::OnHit) lands one frame late, and the sweeps of the frame a swing ends in are
+* dropped with it. GAS.Melee.SyncTraces 1 reports hits in the frame they happen.
+* See UAbilityTask_MeleeSweep to use it from an ability (hits are delivered as target data).
+*
+* The subsystem only ticks while swings are active (or their last results are being accounted for).
+*
+* Use GAS.Melee.Stats to check its cost, GAS.Melee.SyncTraces 1 runs the same sweeps synchronously to compare.
+* The automation test GASDemo.Melee.Benchmark swings the meshes of spawned characters with both kinds of traces.
+*/
+
+public:
+
+	//~ Begin USubsystem
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~ End USubsystem
+
+	//~ Begin FTickableGameObject
+	virtual bool IsTickable() const override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject
+
+	/**
+	* Starts sweeping a swing every frame until EndSwing is called
+	*
+	* @param Params  Blade description
+	* @param OnHits  Called with newly hit targets (on the game thread, one frame after the sweep when async)
+	* @return Id of the swing, 0 on failure
+	*/
+	uint32 BeginSwing(const FMeleeSwingParams& Params, FOnMeleeSwingHits OnHits);
+
+	/** Stops a swing started by BeginSwing, pending results for it are dropped */
+	void EndSwing(uint32 SwingId);
+
+	/** Prints sweep stats to the output device */
+	void DumpStats(FOutputDevice& Ar) const;
+
+	/** Clears the counters shown in DumpStats */
+	void ResetStats();
+
+	/** Counters shown in DumpStats: sweeps issued and game thread time spent on them (issue and results) */
+	uint64 GetNumSweeps() const { return StatSweeps; }
+	double GetGameThreadMs() const { return FPlatformTime::ToMilliseconds64(StatIssueCycles + StatResultCycles); }
+
+private:
+
+	struct FMeleeSwing
+	{
+		FMeleeSwingParams Params;
+		FOnMeleeSwingHits OnHits;
+
+		/** Sample positions of the previous frame */
+		TArray<FVector, TInlineAllocator<8>> PreviousPoints;
+
+		/** Actors already reported by this swing */
+		TSet<TObjectKey<AActor>> HitActors;
+
+		FCollisionQueryParams QueryParams;
+	};
+
+	/** Computes the current sample positions of Swing, returns false if its mesh is gone */
+	bool GetSwingPoints(const FMeleeSwing& Swing, TArray<FVector, TInlineAllocator<8>>& OutPoints) const;
+
+	/** Async trace callback, UserData is the swing id */
+	void OnSweepCompleted(const FTraceHandle& Handle, FTraceDatum& Datum);
+
+	/** Deduplicates Hits against Swing's hit actors and reports the new ones */
+	void ProcessHits(uint32 SwingId, TConstArrayView<FHitResult> Hits);
+
+	/** Hits of one synchronous sweep, stored in SyncHits */
+	struct FSyncSweepResult
+	{
+		uint32 SwingId;
+		int32 FirstHit;
+		int32 NumHits;
+	};
+
+	/** Active swings by id */
+	TMap<uint32, FMeleeSwing> Swings;
+
+	/** Id given to the next swing (0 is never used) */
+	uint32 NextSwingId;
+
+	FTraceDelegate SweepDelegate;
+
+	/** Scratch arrays reused every frame */
+	TArray<FVector, TInlineAllocator<8>> CurrentPoints;
+	TArray<FHitResult> NewHits;
+	TArray<uint32> FinishedSwings;
+
+	/** Synchronous sweeps of the frame: output of the current sweep, then the hits of every sweep back to back */
+	TArray<FHitResult> SweepHits;
+	TArray<FHitResult> SyncHits;
+	TArray<FSyncSweepResult> SyncResults;
+
+	//Stats counters, see DumpStats
+	uint64 StatFrames;
+	uint64 StatSweeps;
+	uint64 StatHitsReported;
+	uint64 StatIssueCycles;
+	uint64 StatResultCycles;
+	uint64 StatMaxFrameCycles;
+	uint64 FrameResultCycles;
+};
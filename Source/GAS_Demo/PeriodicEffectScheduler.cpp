@@ -0,0 +1,562 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+
+#include "PeriodicEffectScheduler.h"
+#include "AbilitySystemComponent.h"
+#include "GameplayEffectCache.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+#include "HAL/IConsoleManager.h"
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CVarPeriodicStats(
+	TEXT("GAS.Periodic.Stats"),
+	TEXT("Prints the number of scheduled periodic effects and how many ticks were merged per target. Use 'GAS.Periodic.Stats reset' to clear counters."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		UPeriodicEffectScheduler* Scheduler = World ? World->GetSubsystem<UPeriodicEffectScheduler>() : nullptr;
+		if (!Scheduler)
+		{
+			Ar.Log(TEXT("No PeriodicEffectScheduler in this world"));
+			return;
+		}
+
+		if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+		{
+			Scheduler->ResetStats();
+			return;
+		}
+
+		Scheduler->DumpStats(Ar);
+	}));
+
+static TAutoConsoleVariable<int32> CVarSchedulePeriodicEffects(
+	TEXT("GAS.Periodic.ScheduleEffects"),
+	1,
+	TEXT("Tick the periodic effects listed in ScheduledEffects through the periodic effect scheduler (1) or as regular periodic effects (0)."));
+
+//////////////////////////////////////////////////////////////////////////
+// FPeriodicTimingWheel
+
+FPeriodicTimingWheel::FPeriodicTimingWheel()
+	: CurrentTick(0)
+{
+}
+
+void FPeriodicTimingWheel::Insert(const FEntry& Entry)
+{
+	/* Function Insert
+	* Arguments: FEntry Entry - entry to schedule
+	* Output: none (places the entry in the level that covers its due tick)
+	*/
+
+	//Entries already due go into the next slot so they are never lost
+	Place({ Entry.Id, Entry.Serial, FMath::Max(Entry.DueTick, CurrentTick + 1) });
+}
+
+void FPeriodicTimingWheel::Place(const FEntry& Entry)
+{
+	const uint64 Delta = Entry.DueTick - CurrentTick;
+
+	if (Delta < Level0Slots)
+	{
+		Level0[Entry.DueTick & (Level0Slots - 1)].Add(Entry);
+	}
+	else if (Delta < Level0Slots * Level1Slots)
+	{
+		Level1[(Entry.DueTick >> Level0Bits) & (Level1Slots - 1)].Add(Entry);
+	}
+	else
+	{
+		Overflow.Add(Entry);
+	}
+}
+
+void FPeriodicTimingWheel::Advance(TArray<FEntry>& OutDue)
+{
+	/* Function Advance
+	* Arguments: TArray<FEntry> OutDue - array receiving due entries
+	* Output: none (moves the wheel forward by one tick)
+	*/
+
+	CurrentTick++;
+
+	//Level 0 made a full turn: bring the next level 1 slot down (and the overflow every full turn of level 1).
+	//This happens before the current slot is drained, entries cascaded down that are due on this very tick land in it
+	if ((CurrentTick & (Level0Slots - 1)) == 0)
+	{
+		const uint64 Level1Index = (CurrentTick >> Level0Bits) & (Level1Slots - 1);
+
+		if (Level1Index == 0)
+		{
+			Cascade = MoveTemp(Overflow);
+			Overflow.Reset();
+			for (const FEntry& Entry : Cascade)
+			{
+				Place(Entry);
+			}
+		}
+
+		Cascade = MoveTemp(Level1[Level1Index]);
+		Level1[Level1Index].Reset();
+		for (const FEntry& Entry : Cascade)
+		{
+			Place(Entry);
+		}
+		Cascade.Reset();
+	}
+
+	TArray<FEntry>& Slot = Level0[CurrentTick & (Level0Slots - 1)];
+	OutDue.Append(Slot);
+	Slot.Reset();
+}
+
+void FPeriodicTimingWheel::Reset()
+{
+	for (TArray<FEntry>& Slot : Level0)
+	{
+		Slot.Empty();
+	}
+
+	for (TArray<FEntry>& Slot : Level1)
+	{
+		Slot.Empty();
+	}
+
+	Overflow.Empty();
+	Cascade.Empty();
+	CurrentTick = 0;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// UPeriodicEffectScheduler
+
+UPeriodicEffectScheduler::UPeriodicEffectScheduler()
+{
+	//Default value, can be overriden in DefaultGame.ini under [/Script/GAS_Demo.PeriodicEffectScheduler]
+	WheelResolution = 0.05f;
+
+	AccumulatedTime = 0.f;
+	NextSerial = 1;
+
+	StatTicksFired = 0;
+	StatTargetApplications = 0;
+	StatSingleApplications = 0;
+	StatBatches = 0;
+	StatCarrierInstances = 0;
+}
+
+bool UPeriodicEffectScheduler::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UPeriodicEffectScheduler::Deinitialize()
+{
+	Instances.Empty();
+	InstancesByCarrier.Empty();
+	Wheel.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UPeriodicEffectScheduler::CanMergeTicks(const UGameplayEffect* Effect)
+{
+	/* Function CanMergeTicks
+	* Arguments: UGameplayEffect Effect - tick effect
+	* Output: true if the effect's modifiers can be added to other ticks and applied as one effect
+	*/
+
+	return Effect && Effect->DurationPolicy == EGameplayEffectDurationType::Instant && CanMergeModifiers(Effect);
+}
+
+bool UPeriodicEffectScheduler::CanMergeModifiers(const UGameplayEffect* Effect)
+{
+	if (!Effect) return false;
+
+	//Executions, conditional effects and tag requirements need the effect to be applied on its own
+	if (Effect->Executions.Num() > 0 || Effect->ConditionalGameplayEffects.Num() > 0 || !Effect->ApplicationTagRequirements.IsEmpty())
+		return false;
+
+	for (const FGameplayModifierInfo& Modifier : Effect->Modifiers)
+	{
+		const EGameplayEffectMagnitudeCalculation CalculationType = Modifier.ModifierMagnitude.GetMagnitudeCalculationType();
+
+		if (Modifier.ModifierOp != EGameplayModOp::Additive) return false;
+		if (CalculationType != EGameplayEffectMagnitudeCalculation::ScalableFloat && CalculationType != EGameplayEffectMagnitudeCalculation::SetByCaller) return false;
+		if (!Modifier.SourceTags.IsEmpty() || !Modifier.TargetTags.IsEmpty()) return false;
+	}
+
+	return Effect->Modifiers.Num() > 0;
+}
+
+bool UPeriodicEffectScheduler::ShouldScheduleSpec(const FGameplayEffectSpec& Spec, const UAbilitySystemComponent* Target) const
+{
+	/* Function ShouldScheduleSpec
+	* Arguments: FGameplayEffectSpec Spec - spec being applied, UAbilitySystemComponent Target - ASC it is applied to
+	* Output: true if the spec is a periodic effect listed in ScheduledEffects that the wheel can tick
+	*/
+
+	if (CVarSchedulePeriodicEffects.GetValueOnGameThread() == 0 || ScheduledEffects.Num() == 0) return false;
+
+	const UGameplayEffect* Effect = Spec.Def;
+	if (!Effect || !Target || Spec.GetPeriod() <= UGameplayEffect::NO_PERIOD) return false;
+	if (Effect->DurationPolicy == EGameplayEffectDurationType::Instant || !Target->IsOwnerActorAuthoritative()) return false;
+
+	//Effects with an ongoing tag requirement could be inhibited between ticks, their timer handles it better
+	if (!Effect->OngoingTagRequirements.IsEmpty()) return false;
+
+	const bool bListed = ScheduledEffects.ContainsByPredicate([Effect](const TSoftClassPtr<UGameplayEffect>& ScheduledEffect)
+	{
+		return ScheduledEffect.Get() == Effect->GetClass();
+	});
+
+	return bListed && CanMergeModifiers(Effect);
+}
+
+void UPeriodicEffectScheduler::ScheduleCarrierTicks(const FGameplayEffectSpec& Spec, UAbilitySystemComponent* Target, FActiveGameplayEffectHandle CarrierHandle)
+{
+	/* Function ScheduleCarrierTicks
+	* Arguments: see declaration
+	* Output: none (stops the effect's own period timer and ticks its modifiers through the wheel instead)
+	*/
+
+	const FActiveGameplayEffect* Carrier = Target ? Target->GetActiveGameplayEffect(CarrierHandle) : nullptr;
+	if (!Carrier) return;
+
+	//The effect keeps its period (its modifiers are executed on the base values, they aren't ongoing modifiers),
+	//only the timer executing them is stopped. Stacking can restart it, so this is done on every application
+	FTimerHandle PeriodHandle = Carrier->PeriodHandle;
+	Target->GetWorld()->GetTimerManager().ClearTimer(PeriodHandle);
+
+	if (const int32* Found = InstancesByCarrier.Find(CarrierHandle))
+	{
+		FPeriodicEffectInstance& Existing = Instances[*Found];
+
+		//New stack with a period reset: the old wheel entry is skipped thanks to the new serial
+		if (Spec.Def->StackPeriodResetPolicy == EGameplayEffectStackingPeriodPolicy::ResetOnSuccessfulApplication)
+		{
+			Existing.Serial = NextSerial++;
+			Wheel.Insert({ *Found, Existing.Serial, Wheel.GetCurrentTick() + Existing.PeriodTicks });
+		}
+		return;
+	}
+
+	UAbilitySystemComponent* Source = Spec.GetContext().GetInstigatorAbilitySystemComponent();
+
+	FPeriodicEffectInstance Instance;
+	Instance.Source = Source ? Source : Target;
+	Instance.Target = Target;
+	Instance.CarrierHandle = CarrierHandle;
+	Instance.PeriodTicks = FMath::Max<uint64>(1, (uint64)FMath::RoundToInt(Spec.GetPeriod() / WheelResolution));
+	Instance.Serial = NextSerial++;
+	Instance.bMergeable = true;
+
+	//The execution on application (if any) was already done by the effect itself
+	AddInstance(Instance, false);
+	StatCarrierInstances++;
+}
+
+int32 UPeriodicEffectScheduler::ApplyPeriodicEffect(UAbilitySystemComponent* Source, UAbilitySystemComponent* Target, TSubclassOf<UGameplayEffect> TickEffect, float Period, int32 NumTicks, float Level, TSubclassOf<UGameplayEffect> CarrierEffect, bool bExecuteOnApplication)
+{
+	/* Function ApplyPeriodicEffect
+	* Arguments: see declaration
+	* Output: Handle of the periodic effect, INDEX_NONE on failure
+	*/
+
+	if (!Source || !Target || !TickEffect || Period <= 0.f) return INDEX_NONE;
+
+	//Attributes are only modified on authority, clients get them replicated
+	if (!Target->IsOwnerActorAuthoritative()) return INDEX_NONE;
+
+	//Without a carrier the effect would never end
+	if (NumTicks <= 0 && !CarrierEffect) return INDEX_NONE;
+
+	FPeriodicEffectInstance Instance;
+	Instance.Source = Source;
+	Instance.Target = Target;
+	Instance.TickSpec = Source->MakeOutgoingSpec(TickEffect, Level, Source->MakeEffectContext());
+	Instance.PeriodTicks = FMath::Max<uint64>(1, (uint64)FMath::RoundToInt(Period / WheelResolution));
+	Instance.RemainingTicks = NumTicks;
+	Instance.Serial = NextSerial++;
+	Instance.bMergeable = CanMergeTicks(TickEffect.GetDefaultObject());
+
+	if (!Instance.TickSpec.IsValid()) return INDEX_NONE;
+
+	if (CarrierEffect)
+	{
+		Instance.CarrierHandle = Source->ApplyGameplayEffectToTarget(CarrierEffect.GetDefaultObject(), Target, Level, Source->MakeEffectContext());
+
+		//Carrier was blocked (immunity, tag requirements...): don't tick either
+		if (!Instance.CarrierHandle.IsValid()) return INDEX_NONE;
+	}
+
+	return AddInstance(Instance, bExecuteOnApplication);
+}
+
+int32 UPeriodicEffectScheduler::AddInstance(const FPeriodicEffectInstance& Instance, bool bExecuteOnApplication)
+{
+	const int32 Id = Instances.Add(Instance);
+	if (Instance.CarrierHandle.IsValid())
+		InstancesByCarrier.Add(Instance.CarrierHandle, Id);
+
+	FPeriodicTimingWheel::FEntry Entry;
+	Entry.Id = Id;
+	Entry.Serial = Instance.Serial;
+	Entry.DueTick = Wheel.GetCurrentTick() + (bExecuteOnApplication ? 1 : Instance.PeriodTicks);
+	Wheel.Insert(Entry);
+
+	return Id;
+}
+
+void UPeriodicEffectScheduler::CancelPeriodicEffect(int32 Handle)
+{
+	if (Instances.IsValidIndex(Handle))
+	{
+		RemoveInstance(Handle);
+	}
+}
+
+void UPeriodicEffectScheduler::RemoveInstance(int32 Id)
+{
+	/* Function RemoveInstance
+	* Arguments: int32 Id - instance to remove
+	* Output: none (wheel entries of the instance are skipped later thanks to their serial)
+	*/
+
+	//Instance is removed first: removing the carrier runs gameplay callbacks that could try to cancel it again
+	UAbilitySystemComponent* Target = Instances[Id].Target.Get();
+	const FActiveGameplayEffectHandle CarrierHandle = Instances[Id].CarrierHandle;
+
+	Instances.RemoveAt(Id);
+	InstancesByCarrier.Remove(CarrierHandle);
+
+	if (Target && CarrierHandle.IsValid())
+	{
+		Target->RemoveActiveGameplayEffect(CarrierHandle);
+	}
+}
+
+void UPeriodicEffectScheduler::Tick(float DeltaTime)
+{
+	if (Instances.Num() == 0)
+	{
+		AccumulatedTime = 0.f;
+		return;
+	}
+
+	AccumulatedTime += DeltaTime;
+
+	DueEntries.Reset();
+	while (AccumulatedTime >= WheelResolution)
+	{
+		AccumulatedTime -= WheelResolution;
+		Wheel.Advance(DueEntries);
+	}
+
+	if (DueEntries.Num() > 0)
+	{
+		FireDueTicks();
+	}
+}
+
+void UPeriodicEffectScheduler::FireDueTicks()
+{
+	/* Function FireDueTicks
+	* Arguments: none
+	* Output: none (applies every tick in DueEntries, merging the ticks of each target)
+	*/
+
+	StatBatches++;
+
+	//Step 1: validate due entries and reschedule the ones that keep ticking
+	DueTicks.Reset();
+	for (const FPeriodicTimingWheel::FEntry& Entry : DueEntries)
+	{
+		//Entry of an instance that was cancelled (or whose index got reused)
+		if (!Instances.IsValidIndex(Entry.Id) || Instances[Entry.Id].Serial != Entry.Serial) continue;
+
+		FPeriodicEffectInstance& Instance = Instances[Entry.Id];
+		UAbilitySystemComponent* Target = Instance.Target.Get();
+		UAbilitySystemComponent* Source = Instance.Source.Get();
+
+		//Ticks using the carrier's spec keep going when their instigator is gone, same as a periodic effect would
+		const bool bUsesCarrierSpec = !Instance.TickSpec.IsValid();
+		const bool bCarrierRemoved = Instance.CarrierHandle.IsValid() && Target && !Target->GetActiveGameplayEffect(Instance.CarrierHandle);
+		if (!Target || (!Source && !bUsesCarrierSpec) || bCarrierRemoved)
+		{
+			RemoveInstance(Entry.Id);
+			continue;
+		}
+
+		FDueTick DueTick;
+		DueTick.Target = Target;
+		DueTick.Source = Source;
+		DueTick.Id = Entry.Id;
+		DueTick.Serial = Entry.Serial;
+		DueTick.DueTick = Entry.DueTick;
+		DueTick.bExpired = Instance.RemainingTicks > 0 && --Instance.RemainingTicks == 0;
+		DueTicks.Add(DueTick);
+
+		//Next tick is scheduled from the due tick, not the current one, so periods never drift
+		if (!DueTick.bExpired)
+		{
+			Wheel.Insert({ Entry.Id, Entry.Serial, Entry.DueTick + Instance.PeriodTicks });
+		}
+	}
+
+	//Step 2: group by target (instances in order, so a batch is always applied the same way)
+	DueTicks.Sort([](const FDueTick& A, const FDueTick& B)
+	{
+		return A.Target != B.Target ? A.Target < B.Target : A.Id < B.Id;
+	});
+
+	//Step 3: apply one merged effect per target, plus the ticks that couldn't be merged
+	TArray<TPair<FGameplayAttribute, float>, TInlineAllocator<8>> MergedMagnitudes;
+	FGameplayTagContainer MergedCueTags;
+
+	int32 GroupStart = 0;
+	while (GroupStart < DueTicks.Num())
+	{
+		UAbilitySystemComponent* Target = DueTicks[GroupStart].Target;
+
+		MergedMagnitudes.Reset();
+		MergedCueTags.Reset();
+		FGameplayEffectContextHandle MergedContext;
+		float MergedLevel = 1.f;
+		float LargestContribution = -1.f;
+
+		int32 GroupEnd = GroupStart;
+		for (; GroupEnd < DueTicks.Num() && DueTicks[GroupEnd].Target == Target; ++GroupEnd)
+		{
+			//Applying an unmerged tick runs gameplay callbacks that could cancel other instances
+			if (!Instances.IsValidIndex(DueTicks[GroupEnd].Id) || Instances[DueTicks[GroupEnd].Id].Serial != DueTicks[GroupEnd].Serial) continue;
+
+			const FPeriodicEffectInstance& Instance = Instances[DueTicks[GroupEnd].Id];
+			StatTicksFired++;
+
+			if (!Instance.bMergeable)
+			{
+				DueTicks[GroupEnd].Source->ApplyGameplayEffectSpecToTarget(*Instance.TickSpec.Data.Get(), Target);
+				StatSingleApplications++;
+				continue;
+			}
+
+			//Carrier driven ticks use the active spec: its magnitudes are already calculated and scaled by its stacks
+			const FGameplayEffectSpec* Spec = nullptr;
+			if (Instance.TickSpec.IsValid())
+			{
+				Instance.TickSpec.Data->CalculateModifierMagnitudes();
+				Spec = Instance.TickSpec.Data.Get();
+			}
+			else if (const FActiveGameplayEffect* Carrier = Target->GetActiveGameplayEffect(Instance.CarrierHandle))
+			{
+				Spec = &Carrier->Spec;
+			}
+
+			if (!Spec) continue;
+
+			float Contribution = 0.f;
+			for (int32 ModifierIndex = 0; ModifierIndex < Spec->Def->Modifiers.Num(); ++ModifierIndex)
+			{
+				const FGameplayAttribute& Attribute = Spec->Def->Modifiers[ModifierIndex].Attribute;
+				const float Magnitude = Spec->GetModifierMagnitude(ModifierIndex, true);
+				Contribution += FMath::Abs(Magnitude);
+
+				TPair<FGameplayAttribute, float>* Existing = MergedMagnitudes.FindByPredicate([&Attribute](const TPair<FGameplayAttribute, float>& Pair) { return Pair.Key == Attribute; });
+				if (Existing)
+				{
+					Existing->Value += Magnitude;
+				}
+				else
+				{
+					MergedMagnitudes.Emplace(Attribute, Magnitude);
+				}
+			}
+
+			for (const FGameplayEffectCue& Cue : Spec->Def->GameplayCues)
+			{
+				MergedCueTags.AppendTags(Cue.GameplayCueTags);
+			}
+
+			//The merged effect is attributed to the instigator that contributed the most
+			if (Contribution > LargestContribution)
+			{
+				LargestContribution = Contribution;
+				MergedContext = Spec->GetContext();
+				MergedLevel = Spec->GetLevel();
+			}
+		}
+
+		if (MergedContext.IsValid() && MergedMagnitudes.Num() > 0)
+		{
+			//Keep a stable attribute order so the same attributes always hit the same cached effect
+			MergedMagnitudes.Sort([](const TPair<FGameplayAttribute, float>& A, const TPair<FGameplayAttribute, float>& B)
+			{
+				return A.Key.GetUProperty() < B.Key.GetUProperty();
+			});
+
+			FGameplayEffectModSignature Signature;
+			for (const TPair<FGameplayAttribute, float>& Pair : MergedMagnitudes)
+			{
+				Signature.Add(Pair.Key, EGameplayModOp::Additive);
+			}
+
+			UGameplayEffect* MergedEffect = UGameplayEffectCache::Get().FindOrCreateEffect(Signature, FName(TEXT("PeriodicBatch")));
+			FGameplayEffectSpec MergedSpec(MergedEffect, MergedContext, MergedLevel);
+
+			for (const TPair<FGameplayAttribute, float>& Pair : MergedMagnitudes)
+			{
+				UGameplayEffectCache::SetModifierMagnitude(MergedSpec, Pair.Key, Pair.Value);
+			}
+
+			Target->ApplyGameplayEffectSpecToSelf(MergedSpec);
+			StatTargetApplications++;
+
+			//Cues of the merged ticks are executed once per target instead of once per tick
+			for (const FGameplayTag& CueTag : MergedCueTags)
+			{
+				Target->ExecuteGameplayCue(CueTag, MergedContext);
+			}
+		}
+
+		GroupStart = GroupEnd;
+	}
+
+	//Step 4: remove instances that ran out of ticks
+	for (const FDueTick& DueTick : DueTicks)
+	{
+		if (DueTick.bExpired && Instances.IsValidIndex(DueTick.Id) && Instances[DueTick.Id].Serial == DueTick.Serial)
+		{
+			RemoveInstance(DueTick.Id);
+		}
+	}
+}
+
+TStatId UPeriodicEffectScheduler::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UPeriodicEffectScheduler, STATGROUP_Tickables);
+}
+
+void UPeriodicEffectScheduler::DumpStats(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("Periodic effects: %d scheduled (wheel resolution %.3fs)"), Instances.Num(), WheelResolution);
+
+	const uint64 TotalApplications = StatTargetApplications + StatSingleApplications;
+	Ar.Logf(TEXT("  Batches: %llu, ticks fired: %llu, effect applications: %llu (%llu merged, %llu single), periodic effects routed: %llu"),
+		StatBatches, StatTicksFired, TotalApplications, StatTargetApplications, StatSingleApplications, StatCarrierInstances);
+
+	if (TotalApplications > 0)
+	{
+		Ar.Logf(TEXT("  Ticks per application: %.2f"), (double)StatTicksFired / (double)TotalApplications);
+	}
+}
+
+void UPeriodicEffectScheduler::ResetStats()
+{
+	StatTicksFired = 0;
+	StatTargetApplications = 0;
+	StatSingleApplications = 0;
+	StatBatches = 0;
+	StatCarrierInstances = 0;
+}
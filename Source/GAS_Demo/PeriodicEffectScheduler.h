@@ -0,0 +1,220 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GameplayEffect.h"
+#include "PeriodicEffectScheduler.generated.h"
+
+class UAbilitySystemComponent;
+
+/**
+* Two level hierarchical timing wheel: level 0 has one slot per wheel tick, level 1 has one slot per
+* full turn of level 0, anything further away waits in an overflow list. Inserting and firing are O(1),
+* entries are only moved down a level once (when their level 1 slot comes up). Entries fire on the exact
+* tick they are due, including the ones cascaded down on that same tick.
+*/
+class GAS_DEMO_API FPeriodicTimingWheel
+{
+public:
+	struct FEntry
+	{
+		int32 Id;
+		uint32 Serial;
+		uint64 DueTick;
+	};
+
+	FPeriodicTimingWheel();
+
+	/** Current wheel tick (every entry with DueTick <= CurrentTick has already been fired) */
+	uint64 GetCurrentTick() const { return CurrentTick; }
+
+	/** Schedules Entry, an entry that is already due (DueTick <= CurrentTick) fires on the next tick */
+	void Insert(const FEntry& Entry);
+
+	/** Advances the wheel by one tick and appends every entry that became due to OutDue */
+	void Advance(TArray<FEntry>& OutDue);
+
+	/** Removes every entry */
+	void Reset();
+
+	static constexpr int32 Level0Bits = 8;
+	static constexpr int32 Level1Bits = 6;
+	static constexpr uint64 Level0Slots = 1ull << Level0Bits;
+	static constexpr uint64 Level1Slots = 1ull << Level1Bits;
+
+private:
+	/** Places Entry in the level covering its due tick (DueTick >= CurrentTick, an entry due now goes in the current slot) */
+	void Place(const FEntry& Entry);
+
+	TArray<FEntry> Level0[Level0Slots];
+	TArray<FEntry> Level1[Level1Slots];
+	TArray<FEntry> Overflow;
+
+	/** Scratch array used when cascading entries down a level */
+	TArray<FEntry> Cascade;
+
+	uint64 CurrentTick;
+};
+
+UCLASS(config = Game)
+class GAS_DEMO_API UPeriodicEffectScheduler : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+/*
+* Class UPeriodicEffectScheduler
+* Alternative to periodic GameplayEffects (Poison...) for DoTs/HoTs that stack on a lot of targets:
+* a periodic GameplayEffect registers one timer per active instance, every tick then executes its own
+* spec and updates the target's aggregators.
+*
+* Here every periodic instance lives in a single timing wheel, all the ticks that are due in a frame are
+* fired in one batch grouped by target: modifiers of the ticking effects are added together and applied
+* as ONE instant effect per target (built through UGameplayEffectCache), so each target's attributes are
+* updated once per frame no matter how many DoTs it has. The merged effect is attributed to the instigator
+* whose ticks contributed the most to it.
+* Tick effects can only be merged if they only have Additive ScalableFloat/SetByCaller modifiers and no
+* executions, any other effect is applied on its own (still batched on the same frame).
+*
+* Lifetime is either a fixed number of ticks, or the lifetime of a "carrier" effect (a duration GameplayEffect
+* WITHOUT a period, used to grant tags like Character.Effect.Poision and persistent cues).
+*
+* Periodic effects listed in ScheduledEffects (GE_Poison) are routed here when they are applied
+* (see UBaseAbilitySystemComponent::ApplyGameplayEffectSpecToSelf): the effect is applied as usual and becomes
+* its own carrier (tags, cues, stacking and removal work as usual), but its period timer is stopped and its
+* modifiers are executed by the wheel every period instead. Only effects whose modifiers can be merged are
+* routed, use GAS.Periodic.ScheduleEffects 0 to apply them as regular periodic effects to compare.
+*/
+
+public:
+	UPeriodicEffectScheduler();
+
+	//~ Begin USubsystem
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Deinitialize() override;
+	//~ End USubsystem
+
+	//~ Begin FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject
+
+	/**
+	* Schedules TickEffect to be applied on Target every Period seconds, returns a handle that can be used
+	* to cancel it (INDEX_NONE on failure). Must be called on authority.
+	*
+	* @param Source  Instigator's AbilitySystemComponent
+	* @param Target  AbilitySystemComponent receiving the ticks
+	* @param TickEffect  Instant effect applied on every tick
+	* @param Period  Time between ticks in seconds
+	* @param NumTicks  Number of ticks to apply (0 = until the carrier effect is removed)
+	* @param Level  Level of the tick and carrier effects
+	* @param CarrierEffect  Optional duration effect applied to Target, ticks stop once it is removed
+	* @param bExecuteOnApplication  If true the first tick happens right away (same as periodic GameplayEffects)
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Abilities|Periodic")
+	int32 ApplyPeriodicEffect(UAbilitySystemComponent* Source, UAbilitySystemComponent* Target, TSubclassOf<UGameplayEffect> TickEffect, float Period, int32 NumTicks = 0, float Level = 1.f, TSubclassOf<UGameplayEffect> CarrierEffect = nullptr, bool bExecuteOnApplication = true);
+
+	/** Returns true if Spec should be applied through ScheduleCarrierTicks instead of as a periodic effect on Target */
+	bool ShouldScheduleSpec(const FGameplayEffectSpec& Spec, const UAbilitySystemComponent* Target) const;
+
+	/**
+	* Ticks the modifiers of an applied periodic effect through the wheel, see ShouldScheduleSpec
+	*
+	* @param Spec  Spec that was applied (its period is used for the ticks)
+	* @param Target  AbilitySystemComponent the effect was applied to
+	* @param CarrierHandle  Handle of the applied effect, ticks stop once it is removed
+	*/
+	void ScheduleCarrierTicks(const FGameplayEffectSpec& Spec, UAbilitySystemComponent* Target, FActiveGameplayEffectHandle CarrierHandle);
+
+	/** Stops a periodic effect started by ApplyPeriodicEffect (also removes its carrier effect) */
+	UFUNCTION(BlueprintCallable, Category = "Abilities|Periodic")
+	void CancelPeriodicEffect(int32 Handle);
+
+	/** Number of periodic effects currently scheduled */
+	UFUNCTION(BlueprintCallable, Category = "Abilities|Periodic")
+	int32 GetNumActivePeriodicEffects() const { return Instances.Num(); }
+
+	/** Prints scheduler stats to the output device */
+	void DumpStats(FOutputDevice& Ar) const;
+
+	/** Clears the counters shown in DumpStats */
+	void ResetStats();
+
+protected:
+
+	/** Time (in seconds) covered by one wheel tick: periods are rounded to this resolution */
+	UPROPERTY(Config)
+	float WheelResolution;
+
+	/** Periodic effects applied through the wheel instead of their own timer, see ShouldScheduleSpec */
+	UPROPERTY(Config)
+	TArray<TSoftClassPtr<UGameplayEffect>> ScheduledEffects;
+
+private:
+
+	struct FPeriodicEffectInstance
+	{
+		TWeakObjectPtr<UAbilitySystemComponent> Source;
+		TWeakObjectPtr<UAbilitySystemComponent> Target;
+
+		/** Spec applied on every tick, invalid when the ticks use the modifiers of the carrier's active spec */
+		FGameplayEffectSpecHandle TickSpec;
+		FActiveGameplayEffectHandle CarrierHandle;
+		uint64 PeriodTicks = 1;
+		int32 RemainingTicks = 0;
+		uint32 Serial = 0;
+		bool bMergeable = false;
+	};
+
+	struct FDueTick
+	{
+		UAbilitySystemComponent* Target;
+		UAbilitySystemComponent* Source;
+		int32 Id;
+		uint32 Serial;
+		uint64 DueTick;
+		bool bExpired;
+	};
+
+	/** Returns true if every modifier of Effect can be added up with other ticks */
+	static bool CanMergeTicks(const UGameplayEffect* Effect);
+
+	/** Same as CanMergeTicks, regardless of the effect's duration policy */
+	static bool CanMergeModifiers(const UGameplayEffect* Effect);
+
+	/** Schedules the first tick of a new instance, returns its handle */
+	int32 AddInstance(const FPeriodicEffectInstance& Instance, bool bExecuteOnApplication);
+
+	/** Removes an instance and its carrier effect */
+	void RemoveInstance(int32 Id);
+
+	/** Applies every tick in DueEntries, grouped by target */
+	void FireDueTicks();
+
+	/** Active periodic instances, indices are the handles given to callers */
+	TSparseArray<FPeriodicEffectInstance> Instances;
+
+	/** Index in Instances of every instance with a carrier effect, so reapplying a stacked carrier doesn't scan them all */
+	TMap<FActiveGameplayEffectHandle, int32> InstancesByCarrier;
+
+	FPeriodicTimingWheel Wheel;
+
+	/** Time accumulated since the last wheel tick */
+	float AccumulatedTime;
+
+	/** Serial given to the next instance, used to skip wheel entries of removed instances */
+	uint32 NextSerial;
+
+	/** Scratch arrays reused every frame */
+	TArray<FPeriodicTimingWheel::FEntry> DueEntries;
+	TArray<FDueTick> DueTicks;
+
+	//Stats counters, see DumpStats
+	uint64 StatTicksFired;
+	uint64 StatTargetApplications;
+	uint64 StatSingleApplications;
+	uint64 StatBatches;
+	uint64 StatCarrierInstances;
+};
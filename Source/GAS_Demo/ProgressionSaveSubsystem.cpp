@@ -0,0 +1,1142 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+
+#include "ProgressionSaveSubsystem.h"
+#include "CharacterBase.h"
+#include "BasePlayerController.h"
+#include "EquipmentComponent.h"
+#include "GASAttributeSet.h"
+#include "GameplayEffectCache.h"
+#include "GAS_DemoAssetManager.h"
+#include "ItemBase.h"
+#include "WeaponBase.h"
+#include "AbilitySystemComponent.h"
+#include "Async/Async.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Compression.h"
+#include "Misc/Crc.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/Package.h"
+
+static UProgressionSaveSubsystem* GetProgressionSaveSubsystem(UWorld* World)
+{
+	UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	return GameInstance ? GameInstance->GetSubsystem<UProgressionSaveSubsystem>() : nullptr;
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CVarProgressionSaveStats(
+	TEXT("GAS.Save.Stats"),
+	TEXT("Prints progression save/load stats. Use 'GAS.Save.Stats reset' to clear counters."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		UProgressionSaveSubsystem* SaveSubsystem = GetProgressionSaveSubsystem(World);
+		if (!SaveSubsystem)
+		{
+			Ar.Log(TEXT("No ProgressionSaveSubsystem for this world"));
+			return;
+		}
+
+		if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+		{
+			SaveSubsystem->ResetStats();
+			return;
+		}
+
+		SaveSubsystem->DumpStats(Ar);
+	}));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CVarProgressionSavePlayer(
+	TEXT("GAS.Save.Player"),
+	TEXT("Saves, loads or autosaves the progression of the first local player. Usage: GAS.Save.Player save|load|autosave|stopautosave [SlotName=Default]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		UProgressionSaveSubsystem* SaveSubsystem = GetProgressionSaveSubsystem(World);
+		APlayerController* PlayerController = World ? World->GetFirstPlayerController() : nullptr;
+		ACharacterBase* Character = PlayerController ? Cast<ACharacterBase>(PlayerController->GetPawn()) : nullptr;
+		if (!SaveSubsystem || !Character || Args.Num() == 0)
+		{
+			Ar.Log(TEXT("Usage: GAS.Save.Player save|load|autosave|stopautosave [SlotName=Default] (needs a possessed ACharacterBase)"));
+			return;
+		}
+
+		const FString SlotName = Args.Num() > 1 ? Args[1] : TEXT("Default");
+		if (Args[0] == TEXT("autosave") || Args[0] == TEXT("stopautosave"))
+		{
+			if (Args[0] == TEXT("autosave"))
+				SaveSubsystem->StartAutosave(Character, SlotName);
+			else
+				SaveSubsystem->StopAutosave(Character);
+
+			Ar.Logf(TEXT("Autosave of slot '%s' %s"), *SlotName, Args[0] == TEXT("autosave") ? TEXT("started") : TEXT("stopped"));
+			return;
+		}
+
+		const bool bStarted = Args[0] == TEXT("load") ? SaveSubsystem->LoadProgression(Character, SlotName) : SaveSubsystem->SaveProgression(Character, SlotName);
+		Ar.Logf(TEXT("%s of slot '%s' %s"), Args[0] == TEXT("load") ? TEXT("Load") : TEXT("Save"), *SlotName, bStarted ? TEXT("started") : TEXT("failed to start"));
+	}));
+
+static void SerializePackedInt(FArchive& Ar, int32& Value)
+{
+	//Ids and counts are small positive values, packed they mostly take 1 or 2 bytes (INDEX_NONE takes 5)
+	uint32 Packed = (uint32)Value;
+	Ar.SerializeIntPacked(Packed);
+	Value = (int32)Packed;
+}
+
+static void SerializePackedArray(FArchive& Ar, TArray<int32>& Values)
+{
+	int32 Num = Values.Num();
+	SerializePackedInt(Ar, Num);
+
+	//Every value takes at least one byte: a larger count can only come from a corrupted file
+	if (Ar.IsLoading() && (Num < 0 || Num > Ar.TotalSize() - Ar.Tell()))
+	{
+		Ar.SetError();
+		return;
+	}
+
+	Values.SetNumUninitialized(Num);
+	for (int32& Value : Values)
+	{
+		SerializePackedInt(Ar, Value);
+	}
+}
+
+void FProgressionSnapshot::Serialize(FArchive& Ar, uint32 Version)
+{
+	/* Function Serialize
+	* Arguments: FArchive& Ar - memory archive of the payload, uint32 Version - file version of the payload
+	* Output: none (Ar is flagged with an error if the payload is invalid)
+	*
+	* Fields added in later versions must be read only when Version is recent enough
+	*/
+
+	SerializeSections(Ar, EProgressionDirty::All);
+
+	//Version 2: journal of the slot
+	if (Version >= 2)
+	{
+		Ar << JournalId;
+	}
+	else
+	{
+		JournalId.Invalidate();
+	}
+}
+
+void FProgressionSnapshot::SerializeSections(FArchive& Ar, EProgressionDirty Sections)
+{
+	if (EnumHasAnyFlags(Sections, EProgressionDirty::Level))
+	{
+		SerializePackedInt(Ar, CharacterLevel);
+	}
+
+	if (EnumHasAnyFlags(Sections, EProgressionDirty::Attributes))
+	{
+		int32 NumAttributes = AttributeBaseValues.Num();
+		SerializePackedInt(Ar, NumAttributes);
+		if (Ar.IsLoading() && (NumAttributes < 0 || NumAttributes * (int64)sizeof(float) > Ar.TotalSize() - Ar.Tell()))
+		{
+			Ar.SetError();
+			return;
+		}
+		AttributeBaseValues.SetNumUninitialized(NumAttributes);
+		Ar.Serialize(AttributeBaseValues.GetData(), NumAttributes * sizeof(float));
+	}
+
+	if (EnumHasAnyFlags(Sections, EProgressionDirty::Equipment))
+	{
+		SerializePackedArray(Ar, SlottedWeaponIds);
+		SerializePackedArray(Ar, SlottedConsumableIds);
+		SerializePackedInt(Ar, EquippedWeaponIndex);
+		SerializePackedInt(Ar, EquippedConsumableIndex);
+	}
+
+	if (EnumHasAnyFlags(Sections, EProgressionDirty::Inventory))
+	{
+		int32 NumEntries = Inventory.Num();
+		SerializePackedInt(Ar, NumEntries);
+		if (Ar.IsLoading() && (NumEntries < 0 || NumEntries * 2 > Ar.TotalSize() - Ar.Tell()))
+		{
+			Ar.SetError();
+			return;
+		}
+		Inventory.SetNumUninitialized(NumEntries);
+		for (FInventoryEntry& Entry : Inventory)
+		{
+			SerializePackedInt(Ar, Entry.ItemId);
+			SerializePackedInt(Ar, Entry.Count);
+		}
+	}
+}
+
+void FProgressionSnapshot::MergeDuplicateItems(TArray<FInventoryEntry>& InOutEntries)
+{
+	TMap<int32, int32> FirstIndices;
+	FirstIndices.Reserve(InOutEntries.Num());
+
+	bool bHasDuplicates = false;
+	for (int32 Index = 0; Index < InOutEntries.Num(); ++Index)
+	{
+		FInventoryEntry& Entry = InOutEntries[Index];
+		if (const int32* FirstIndex = FirstIndices.Find(Entry.ItemId))
+		{
+			InOutEntries[*FirstIndex].Count += Entry.Count;
+			Entry.ItemId = INDEX_NONE;
+			bHasDuplicates = true;
+		}
+		else
+		{
+			FirstIndices.Add(Entry.ItemId, Index);
+		}
+	}
+
+	//INDEX_NONE is never a saved ItemId (see CaptureInventory), it only marks the merged entries here
+	if (bHasDuplicates)
+		InOutEntries.RemoveAll([](const FInventoryEntry& Entry) { return Entry.ItemId == INDEX_NONE; });
+}
+
+FString FProgressionJournal::GetJournalPath(const FString& SlotName)
+{
+	return FPaths::ProjectSavedDir() / TEXT("SaveGames") / FPaths::MakeValidFileName(SlotName, TEXT('_')) + TEXT(".journal");
+}
+
+void FProgressionJournal::SerializeRecord(EProgressionDirty Sections, const FProgressionSnapshot& Values, TArray<uint8>& OutRecord)
+{
+	/* Function SerializeRecord
+	* Arguments: EProgressionDirty Sections - sections to write, const FProgressionSnapshot& Values - their values
+	* (Inventory only holding the changed entries), TArray<uint8>& OutRecord - receives the record
+	* Output: none
+	*/
+
+	OutRecord.Reset();
+	OutRecord.AddZeroed(sizeof(FRecordHeader));
+
+	FMemoryWriter Writer(OutRecord);
+	Writer.Seek(sizeof(FRecordHeader));
+
+	uint8 SectionsByte = (uint8)Sections;
+	Writer << SectionsByte;
+	//Writing doesn't modify the snapshot, FArchive just has no const path
+	const_cast<FProgressionSnapshot&>(Values).SerializeSections(Writer, Sections);
+
+	FRecordHeader* Header = reinterpret_cast<FRecordHeader*>(OutRecord.GetData());
+	Header->PayloadSize = OutRecord.Num() - sizeof(FRecordHeader);
+	Header->PayloadCrc = FCrc::MemCrc32(OutRecord.GetData() + sizeof(FRecordHeader), Header->PayloadSize);
+}
+
+bool FProgressionJournal::AppendRecord(const FString& SlotName, const FGuid& JournalId, bool bStartJournal, const TArray<uint8>& Record)
+{
+	const FString Path = GetJournalPath(SlotName);
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*Path, bStartJournal ? FILEWRITE_None : FILEWRITE_Append));
+	if (!Writer) return false;
+
+	if (bStartJournal)
+	{
+		FHeader Header = { FileMagic, FileVersion, JournalId };
+		Writer->Serialize(&Header, sizeof(FHeader));
+	}
+
+	Writer->Serialize(const_cast<uint8*>(Record.GetData()), Record.Num());
+	Writer->Flush();
+	return Writer->Close();
+}
+
+int32 FProgressionJournal::Replay(const TArray<uint8>& Data, FProgressionSnapshot& InOutSnapshot)
+{
+	/* Function Replay
+	* Arguments: const TArray<uint8>& Data - content of a journal file, FProgressionSnapshot& InOutSnapshot - snapshot the journal was started from
+	* Output: number of records applied
+	*/
+
+	if (Data.Num() < (int32)sizeof(FHeader) || !InOutSnapshot.JournalId.IsValid()) return 0;
+
+	FHeader Header;
+	FMemory::Memcpy(&Header, Data.GetData(), sizeof(FHeader));
+	if (Header.Magic != FileMagic || Header.Version != FileVersion || Header.JournalId != InOutSnapshot.JournalId) return 0;
+
+	//Saves written before duplicate ItemIds were merged on capture may still hold several entries per id
+	FProgressionSnapshot::MergeDuplicateItems(InOutSnapshot.Inventory);
+
+	//Index of every item in the snapshot's inventory, built once for the whole journal
+	TMap<int32, int32> InventoryIndices;
+	InventoryIndices.Reserve(InOutSnapshot.Inventory.Num());
+	for (int32 Index = 0; Index < InOutSnapshot.Inventory.Num(); ++Index)
+	{
+		InventoryIndices.Add(InOutSnapshot.Inventory[Index].ItemId, Index);
+	}
+
+	int32 NumRecords = 0;
+	int64 Offset = sizeof(FHeader);
+	while (Offset + (int64)sizeof(FRecordHeader) <= Data.Num())
+	{
+		FRecordHeader RecordHeader;
+		FMemory::Memcpy(&RecordHeader, Data.GetData() + Offset, sizeof(FRecordHeader));
+
+		const int64 PayloadOffset = Offset + sizeof(FRecordHeader);
+		if (PayloadOffset + RecordHeader.PayloadSize > Data.Num()
+			|| FCrc::MemCrc32(Data.GetData() + PayloadOffset, RecordHeader.PayloadSize) != RecordHeader.PayloadCrc)
+			break;
+
+		FMemoryReaderView Reader(MakeArrayView(Data.GetData() + PayloadOffset, RecordHeader.PayloadSize));
+		uint8 SectionsByte = 0;
+		Reader << SectionsByte;
+		const EProgressionDirty Sections = (EProgressionDirty)SectionsByte & EProgressionDirty::All;
+
+		FProgressionSnapshot Values;
+		Values.SerializeSections(Reader, Sections);
+		if (Reader.IsError() || !Reader.AtEnd()) break;
+
+		//Otherwise only the last entry of an id would be kept, each holds the count of a different item
+		FProgressionSnapshot::MergeDuplicateItems(Values.Inventory);
+
+		if (EnumHasAnyFlags(Sections, EProgressionDirty::Level))
+		{
+			InOutSnapshot.CharacterLevel = Values.CharacterLevel;
+		}
+		if (EnumHasAnyFlags(Sections, EProgressionDirty::Attributes))
+		{
+			InOutSnapshot.AttributeBaseValues = MoveTemp(Values.AttributeBaseValues);
+		}
+		if (EnumHasAnyFlags(Sections, EProgressionDirty::Equipment))
+		{
+			InOutSnapshot.SlottedWeaponIds = MoveTemp(Values.SlottedWeaponIds);
+			InOutSnapshot.SlottedConsumableIds = MoveTemp(Values.SlottedConsumableIds);
+			InOutSnapshot.EquippedWeaponIndex = Values.EquippedWeaponIndex;
+			InOutSnapshot.EquippedConsumableIndex = Values.EquippedConsumableIndex;
+		}
+
+		//Removed items keep their entry with a count of 0 until the end, so indices stay valid
+		for (const FProgressionSnapshot::FInventoryEntry& Entry : Values.Inventory)
+		{
+			if (const int32* Index = InventoryIndices.Find(Entry.ItemId))
+			{
+				InOutSnapshot.Inventory[*Index].Count = Entry.Count;
+			}
+			else if (Entry.Count > 0)
+			{
+				InventoryIndices.Add(Entry.ItemId, InOutSnapshot.Inventory.Add(Entry));
+			}
+		}
+
+		NumRecords++;
+		Offset = PayloadOffset + RecordHeader.PayloadSize;
+	}
+
+	InOutSnapshot.Inventory.RemoveAll([](const FProgressionSnapshot::FInventoryEntry& Entry) { return Entry.Count <= 0; });
+	return NumRecords;
+}
+
+const TArray<FGameplayAttribute>& FProgressionSaveFormat::GetSavedAttributes()
+{
+	static const TArray<FGameplayAttribute> Attributes =
+	{
+		UGASAttributeSet::GetMaxHealthAttribute(),
+		UGASAttributeSet::GetMaxManaAttribute(),
+		UGASAttributeSet::GetMaxStaminaAttribute(),
+		UGASAttributeSet::GetHealthAttribute(),
+		UGASAttributeSet::GetManaAttribute(),
+		UGASAttributeSet::GetStaminaAttribute(),
+		UGASAttributeSet::GetAttackPowerAttribute(),
+		UGASAttributeSet::GetMinWeaponDamageAttribute(),
+		UGASAttributeSet::GetMaxWeaponDamageAttribute(),
+		UGASAttributeSet::GetDefenseAttribute(),
+		UGASAttributeSet::GetStrengthAttribute(),
+		UGASAttributeSet::GetDexterityAttribute(),
+		UGASAttributeSet::GetVitalityAttribute(),
+		UGASAttributeSet::GetAgilityAttribute(),
+		UGASAttributeSet::GetCriticalRateAttribute(),
+		UGASAttributeSet::GetEnduranceAttribute(),
+		UGASAttributeSet::GetIntelligenceAttribute(),
+		UGASAttributeSet::GetMindAttribute()
+	};
+	return Attributes;
+}
+
+bool FProgressionSaveFormat::IsValidSlotName(const FString& SlotName)
+{
+	//Slot names become file names under SaveGames: a separator or a drive letter would point the save anywhere else
+	return !SlotName.IsEmpty() && FPaths::MakeValidFileName(SlotName, TEXT('_')) == SlotName;
+}
+
+FString FProgressionSaveFormat::GetSlotPath(const FString& SlotName)
+{
+	return FPaths::ProjectSavedDir() / TEXT("SaveGames") / FPaths::MakeValidFileName(SlotName, TEXT('_')) + TEXT(".prog");
+}
+
+void FProgressionSaveFormat::Serialize(const FProgressionSnapshot& Snapshot, TArray<uint8>& OutData)
+{
+	/* Function Serialize
+	* Arguments: const FProgressionSnapshot& Snapshot - progression to save, TArray<uint8>& OutData - receives the file
+	* Output: none
+	*/
+
+	TArray<uint8> Payload;
+	FMemoryWriter Writer(Payload);
+	//Writing doesn't modify the snapshot, FArchive just has no const path
+	const_cast<FProgressionSnapshot&>(Snapshot).Serialize(Writer, FileVersion);
+
+	const int32 CompressedBound = FCompression::CompressMemoryBound(NAME_Oodle, Payload.Num());
+	OutData.SetNumUninitialized(sizeof(FHeader) + FMath::Max(CompressedBound, Payload.Num()));
+
+	int32 CompressedSize = CompressedBound;
+	const bool bCompressed = FCompression::CompressMemory(NAME_Oodle, OutData.GetData() + sizeof(FHeader), CompressedSize, Payload.GetData(), Payload.Num())
+		&& CompressedSize < Payload.Num();
+
+	//A payload that doesn't shrink is stored as is: CompressedSize == UncompressedSize means uncompressed
+	if (!bCompressed)
+	{
+		CompressedSize = Payload.Num();
+		FMemory::Memcpy(OutData.GetData() + sizeof(FHeader), Payload.GetData(), Payload.Num());
+	}
+	OutData.SetNum(sizeof(FHeader) + CompressedSize, false);
+
+	FHeader* Header = reinterpret_cast<FHeader*>(OutData.GetData());
+	Header->Magic = FileMagic;
+	Header->Version = FileVersion;
+	Header->UncompressedSize = Payload.Num();
+	Header->CompressedSize = CompressedSize;
+	Header->PayloadCrc = FCrc::MemCrc32(Payload.GetData(), Payload.Num());
+}
+
+bool FProgressionSaveFormat::Deserialize(const TArray<uint8>& Data, FProgressionSnapshot& OutSnapshot)
+{
+	/* Function Deserialize
+	* Arguments: const TArray<uint8>& Data - content of a save file, FProgressionSnapshot& OutSnapshot - receives the progression
+	* Output: true if the file is valid and OutSnapshot was filled
+	*/
+
+	if (Data.Num() < (int32)sizeof(FHeader)) return false;
+
+	FHeader Header;
+	FMemory::Memcpy(&Header, Data.GetData(), sizeof(FHeader));
+
+	//The uncompressed size is capped so a corrupted header can't request a huge allocation
+	static constexpr int32 MaxPayloadSize = 64 * 1024 * 1024;
+	if (Header.Magic != FileMagic || Header.Version == 0 || Header.Version > FileVersion
+		|| Header.UncompressedSize < 0 || Header.UncompressedSize > MaxPayloadSize
+		|| Header.CompressedSize < 0 || Header.CompressedSize > Header.UncompressedSize
+		|| Data.Num() != (int32)sizeof(FHeader) + Header.CompressedSize)
+		return false;
+
+	TArray<uint8> Payload;
+	Payload.SetNumUninitialized(Header.UncompressedSize);
+	const uint8* StoredPayload = Data.GetData() + sizeof(FHeader);
+
+	if (Header.CompressedSize == Header.UncompressedSize)
+	{
+		FMemory::Memcpy(Payload.GetData(), StoredPayload, Payload.Num());
+	}
+	else if (!FCompression::UncompressMemory(NAME_Oodle, Payload.GetData(), Payload.Num(), StoredPayload, Header.CompressedSize))
+	{
+		return false;
+	}
+
+	if (FCrc::MemCrc32(Payload.GetData(), Payload.Num()) != Header.PayloadCrc) return false;
+
+	FMemoryReader Reader(Payload);
+	OutSnapshot.Serialize(Reader, Header.Version);
+	return !Reader.IsError() && Reader.AtEnd();
+}
+
+bool FProgressionSaveFormat::WriteSlot(const FString& SlotName, const FProgressionSnapshot& Snapshot, int32& OutFileSize)
+{
+	TArray<uint8> Data;
+	Serialize(Snapshot, Data);
+	OutFileSize = Data.Num();
+
+	const FString Path = GetSlotPath(SlotName);
+	const FString TempPath = Path + TEXT(".tmp");
+	if (!FFileHelper::SaveArrayToFile(Data, *TempPath) || !IFileManager::Get().Move(*Path, *TempPath, true, true)) return false;
+
+	//If this is interrupted, the journal left behind doesn't match Snapshot's JournalId and is ignored on load
+	IFileManager::Get().Delete(*FProgressionJournal::GetJournalPath(SlotName), false, false, true);
+	return true;
+}
+
+UProgressionSaveSubsystem::UProgressionSaveSubsystem()
+{
+	//Default values, can be overriden in DefaultGame.ini under [/Script/GAS_Demo.ProgressionSaveSubsystem]
+	AutosaveInterval = 5.f;
+	CompactAfterRecords = 64;
+	CompactAfterBytes = 64 * 1024;
+	CompactionInterval = 300.f;
+
+	ResetStats();
+}
+
+void UProgressionSaveSubsystem::Deinitialize()
+{
+	if (AutosaveTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(AutosaveTickerHandle);
+		AutosaveTickerHandle.Reset();
+	}
+	Autosaves.Empty();
+
+	//Saves still being written (and snapshots queued behind them) are completed before shutting down
+	for (TFuture<void>& Task : PendingTasks)
+	{
+		Task.Wait();
+	}
+	PendingTasks.Empty();
+
+	for (TPair<FString, FSlotSaveState>& Pair : SlotStates)
+	{
+		if (Pair.Value.QueuedSnapshot.IsSet())
+		{
+			int32 FileSize;
+			FProgressionSaveFormat::WriteSlot(Pair.Key, Pair.Value.QueuedSnapshot.GetValue(), FileSize);
+		}
+	}
+	SlotStates.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UProgressionSaveSubsystem::SaveProgression(ACharacterBase* Character, const FString& SlotName)
+{
+	/* Function SaveProgression
+	* Arguments: ACharacterBase* Character - character to save, const FString& SlotName - save slot
+	* Output: true if the progression was captured (the file is written in the background, see OnSaveComplete)
+	*/
+
+	if (!FProgressionSaveFormat::IsValidSlotName(SlotName))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Invalid progression slot name '%s'"), *SlotName);
+		return false;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	FProgressionSnapshot Snapshot;
+	if (!CaptureSnapshot(Character, Snapshot)) return false;
+
+	const double SnapshotMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	StatSnapshotMsTotal += SnapshotMs;
+	StatSnapshotMsMax = FMath::Max(StatSnapshotMsMax, SnapshotMs);
+	StatSaves++;
+
+	//A full snapshot holds every change: the autosave of this slot starts a new journal on top of it
+	if (FAutosaveState* Autosave = FindAutosaveBySlot(SlotName))
+	{
+		Snapshot.JournalId = FGuid::NewGuid();
+		Autosave->JournalId = Snapshot.JournalId;
+		Autosave->DirtySections = EProgressionDirty::None;
+		Autosave->DirtyItems.Reset();
+		Autosave->NumJournalRecords = 0;
+		Autosave->JournalBytes = 0;
+		Autosave->LastCompactionTime = FPlatformTime::Seconds();
+		Autosave->bNeedsCompaction = false;
+		StatCompactions++;
+	}
+
+	FSlotSaveState& State = SlotStates.FindOrAdd(SlotName);
+	if (State.bInFlight)
+	{
+		//Only the latest snapshot matters: it replaces any snapshot already waiting for this slot
+		if (State.QueuedSnapshot.IsSet()) StatSavesCoalesced++;
+		State.QueuedSnapshot = MoveTemp(Snapshot);
+		return true;
+	}
+
+	StartSaveTask(SlotName, MoveTemp(Snapshot));
+	return true;
+}
+
+void UProgressionSaveSubsystem::StartSaveTask(const FString& SlotName, FProgressionSnapshot&& Snapshot)
+{
+	PrunePendingTasks();
+	SlotStates.FindOrAdd(SlotName).bInFlight = true;
+
+	TWeakObjectPtr<UProgressionSaveSubsystem> WeakThis(this);
+	PendingTasks.Add(Async(EAsyncExecution::ThreadPool, [WeakThis, SlotName, Snapshot = MoveTemp(Snapshot)]()
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		int32 FileSize = 0;
+		const bool bSuccess = FProgressionSaveFormat::WriteSlot(SlotName, Snapshot, FileSize);
+		const double BackgroundSeconds = FPlatformTime::Seconds() - StartTime;
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, SlotName, bSuccess, BackgroundSeconds, FileSize]()
+		{
+			if (UProgressionSaveSubsystem* This = WeakThis.Get())
+			{
+				This->OnSaveTaskComplete(SlotName, bSuccess, BackgroundSeconds, FileSize);
+			}
+		});
+	}));
+}
+
+void UProgressionSaveSubsystem::OnSaveTaskComplete(const FString& SlotName, bool bSuccess, double BackgroundSeconds, int32 FileSize)
+{
+	if (bSuccess) StatSavesWritten++;
+	else StatSavesFailed++;
+	StatSaveBackgroundMsTotal += BackgroundSeconds * 1000.0;
+	StatLastFileSize = FileSize;
+
+	if (!bSuccess)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Failed to write progression save %s"), *FProgressionSaveFormat::GetSlotPath(SlotName));
+
+		//The journal may not match what is on disk anymore, write everything again on the next autosave
+		if (FAutosaveState* Autosave = FindAutosaveBySlot(SlotName))
+			Autosave->bNeedsCompaction = true;
+	}
+
+	//Slot states are cleared on Deinitialize, don't start anything new past that point
+	if (!SlotStates.Contains(SlotName)) return;
+
+	StartQueuedSave(SlotName);
+	OnSaveComplete.Broadcast(SlotName, bSuccess);
+}
+
+void UProgressionSaveSubsystem::StartQueuedSave(const FString& SlotName)
+{
+	FSlotSaveState& State = SlotStates.FindOrAdd(SlotName);
+	State.bInFlight = false;
+
+	if (State.QueuedSnapshot.IsSet())
+	{
+		FProgressionSnapshot QueuedSnapshot = MoveTemp(State.QueuedSnapshot.GetValue());
+		State.QueuedSnapshot.Reset();
+		StartSaveTask(SlotName, MoveTemp(QueuedSnapshot));
+	}
+}
+
+void UProgressionSaveSubsystem::StartJournalTask(const FString& SlotName, const FGuid& JournalId, bool bStartJournal, TArray<uint8>&& Record)
+{
+	PrunePendingTasks();
+	SlotStates.FindOrAdd(SlotName).bInFlight = true;
+
+	TWeakObjectPtr<UProgressionSaveSubsystem> WeakThis(this);
+	PendingTasks.Add(Async(EAsyncExecution::ThreadPool, [WeakThis, SlotName, JournalId, bStartJournal, Record = MoveTemp(Record)]()
+	{
+		const bool bSuccess = FProgressionJournal::AppendRecord(SlotName, JournalId, bStartJournal, Record);
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, SlotName, bSuccess]()
+		{
+			if (UProgressionSaveSubsystem* This = WeakThis.Get())
+			{
+				This->OnJournalTaskComplete(SlotName, bSuccess);
+			}
+		});
+	}));
+}
+
+void UProgressionSaveSubsystem::OnJournalTaskComplete(const FString& SlotName, bool bSuccess)
+{
+	if (!bSuccess)
+	{
+		StatJournalFailures++;
+		UE_LOG(LogTemp, Warning, TEXT("Failed to append to progression journal %s"), *FProgressionJournal::GetJournalPath(SlotName));
+
+		//The changes of that record are lost from the journal, only a full snapshot brings the slot back in sync
+		if (FAutosaveState* Autosave = FindAutosaveBySlot(SlotName))
+			Autosave->bNeedsCompaction = true;
+	}
+
+	if (!SlotStates.Contains(SlotName)) return;
+
+	StartQueuedSave(SlotName);
+}
+
+void UProgressionSaveSubsystem::StartAutosave(ACharacterBase* Character, const FString& SlotName)
+{
+	if (!Character) return;
+
+	if (!FProgressionSaveFormat::IsValidSlotName(SlotName))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Invalid progression slot name '%s'"), *SlotName);
+		return;
+	}
+
+	//A character autosaves to a single slot, and a slot is autosaved by a single character
+	StopAutosave(Character);
+	if (FAutosaveState* SlotOwner = FindAutosaveBySlot(SlotName))
+	{
+		if (ACharacterBase* OtherCharacter = SlotOwner->Character.Get())
+			StopAutosave(OtherCharacter);
+	}
+
+	FAutosaveState& State = Autosaves.AddDefaulted_GetRef();
+	State.Character = Character;
+	State.SlotName = SlotName;
+
+	if (!AutosaveTickerHandle.IsValid())
+	{
+		AutosaveTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UProgressionSaveSubsystem::TickAutosave), AutosaveInterval);
+	}
+}
+
+void UProgressionSaveSubsystem::StopAutosave(ACharacterBase* Character)
+{
+	const int32 Index = Autosaves.IndexOfByPredicate([Character](const FAutosaveState& State) { return State.Character.Get() == Character; });
+	if (Index == INDEX_NONE) return;
+
+	//Pending changes go straight into a full snapshot: it doesn't need the slot to be idle (it is queued otherwise)
+	//Without a controller the inventory can't be captured anymore, the journal then keeps the last autosaved state
+	if (Autosaves[Index].DirtySections != EProgressionDirty::None && Character->GetController())
+	{
+		SaveProgression(Character, Autosaves[Index].SlotName);
+	}
+
+	Autosaves.RemoveAtSwap(Index);
+}
+
+void UProgressionSaveSubsystem::MarkDirty(const AActor* Character, EProgressionDirty Sections, const UItemBase* Item)
+{
+	/* Function MarkDirty
+	* Arguments: const AActor* Character - character whose progression changed, EProgressionDirty Sections - changed sections,
+	* const UItemBase* Item - inventory item whose count changed
+	* Output: none
+	*
+	* Called on every inventory operation and equipment change, returns right away when nothing is autosaved
+	*/
+
+	const UGameInstance* GameInstance = Character ? Character->GetGameInstance() : nullptr;
+	UProgressionSaveSubsystem* This = GameInstance ? GameInstance->GetSubsystem<UProgressionSaveSubsystem>() : nullptr;
+	if (!This || This->Autosaves.Num() == 0) return;
+
+	if (FAutosaveState* State = This->FindAutosave(Character))
+	{
+		State->DirtySections |= Sections;
+		if (Item && EnumHasAnyFlags(Sections, EProgressionDirty::Inventory))
+		{
+			State->DirtyItems.Add(Item, Item->ItemId);
+		}
+	}
+}
+
+bool UProgressionSaveSubsystem::TickAutosave(float DeltaTime)
+{
+	const double Now = FPlatformTime::Seconds();
+	for (int32 Index = Autosaves.Num() - 1; Index >= 0; --Index)
+	{
+		if (!Autosaves[Index].Character.IsValid())
+		{
+			Autosaves.RemoveAtSwap(Index);
+			continue;
+		}
+
+		Autosave(Autosaves[Index], Now);
+	}
+
+	if (Autosaves.Num() == 0)
+	{
+		AutosaveTickerHandle.Reset();
+		return false;
+	}
+	return true;
+}
+
+void UProgressionSaveSubsystem::Autosave(FAutosaveState& State, double Now)
+{
+	/* Function Autosave
+	* Arguments: FAutosaveState& State - autosave to run, double Now - current time
+	* Output: none (appends the dirty sections to the journal, or writes a full snapshot when the journal is due for compaction)
+	*/
+
+	//One write per slot at a time: changes keep accumulating until the current one is done
+	const FSlotSaveState* SlotState = SlotStates.Find(State.SlotName);
+	if (SlotState && SlotState->bInFlight) return;
+
+	ACharacterBase* Character = State.Character.Get();
+
+	const bool bCompact = State.bNeedsCompaction
+		|| State.NumJournalRecords >= CompactAfterRecords
+		|| State.JournalBytes >= CompactAfterBytes
+		|| (State.NumJournalRecords > 0 && Now - State.LastCompactionTime >= CompactionInterval);
+	if (bCompact)
+	{
+		SaveProgression(Character, State.SlotName);
+		return;
+	}
+
+	if (State.DirtySections == EProgressionDirty::None) return;
+
+	FProgressionSnapshot Values;
+	if (!CaptureSnapshot(Character, Values, State.DirtySections & ~EProgressionDirty::Inventory)) return;
+
+	//Only the inventory entries that changed are journaled, a count of 0 removes the item
+	if (EnumHasAnyFlags(State.DirtySections, EProgressionDirty::Inventory))
+	{
+		ABasePlayerController* PlayerController = Cast<ABasePlayerController>(Character->GetController());
+		const TMap<UItemBase*, int32>* Inventory = PlayerController ? &PlayerController->GetInventoryDataMap() : nullptr;
+
+		Values.Inventory.Reserve(State.DirtyItems.Num());
+		for (const TPair<const UItemBase*, int32>& Pair : State.DirtyItems)
+		{
+			const int32* Count = Inventory ? Inventory->Find(const_cast<UItemBase*>(Pair.Key)) : nullptr;
+			Values.Inventory.Add({ Pair.Value, Count ? *Count : 0 });
+		}
+
+		//An id shared with an item that didn't change must still journal the total count of both
+		if (Inventory && UGAS_DemoAssetManager::Get().GetItemRegistry().NumDuplicateIds > 0)
+		{
+			TSet<int32> DirtyItemIds;
+			for (const TPair<const UItemBase*, int32>& Pair : State.DirtyItems)
+			{
+				DirtyItemIds.Add(Pair.Value);
+			}
+
+			for (const TPair<UItemBase*, int32>& Pair : *Inventory)
+			{
+				if (Pair.Key && !State.DirtyItems.Contains(Pair.Key) && DirtyItemIds.Contains(Pair.Key->ItemId))
+					Values.Inventory.Add({ Pair.Key->ItemId, Pair.Value });
+			}
+			FProgressionSnapshot::MergeDuplicateItems(Values.Inventory);
+		}
+	}
+
+	TArray<uint8> Record;
+	FProgressionJournal::SerializeRecord(State.DirtySections, Values, Record);
+
+	const bool bStartJournal = State.NumJournalRecords == 0;
+	State.NumJournalRecords++;
+	State.JournalBytes += Record.Num();
+	State.DirtySections = EProgressionDirty::None;
+	State.DirtyItems.Reset();
+
+	StatJournalRecords++;
+	StatJournalBytes += Record.Num();
+
+	StartJournalTask(State.SlotName, State.JournalId, bStartJournal, MoveTemp(Record));
+}
+
+UProgressionSaveSubsystem::FAutosaveState* UProgressionSaveSubsystem::FindAutosave(const AActor* Character)
+{
+	return Autosaves.FindByPredicate([Character](const FAutosaveState& State) { return State.Character.Get() == Character; });
+}
+
+UProgressionSaveSubsystem::FAutosaveState* UProgressionSaveSubsystem::FindAutosaveBySlot(const FString& SlotName)
+{
+	return Autosaves.FindByPredicate([&SlotName](const FAutosaveState& State) { return State.SlotName == SlotName; });
+}
+
+bool UProgressionSaveSubsystem::LoadProgression(ACharacterBase* Character, const FString& SlotName)
+{
+	/* Function LoadProgression
+	* Arguments: ACharacterBase* Character - character receiving the progression, const FString& SlotName - save slot
+	* Output: true if the load started (the save is applied once read and its items are loaded, see OnLoadComplete)
+	*/
+
+	if (!Character || !Character->HasAuthority()) return false;
+
+	if (!FProgressionSaveFormat::IsValidSlotName(SlotName))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Invalid progression slot name '%s'"), *SlotName);
+		return false;
+	}
+
+	//Saved ItemIds can only be resolved once the registry is built
+	if (!UGAS_DemoAssetManager::Get().IsItemRegistryReady())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Can't load progression %s before the item registry is ready"), *SlotName);
+		return false;
+	}
+
+	PrunePendingTasks();
+
+	const double StartTime = FPlatformTime::Seconds();
+	TWeakObjectPtr<UProgressionSaveSubsystem> WeakThis(this);
+	TWeakObjectPtr<ACharacterBase> WeakCharacter(Character);
+
+	PendingTasks.Add(Async(EAsyncExecution::ThreadPool, [WeakThis, WeakCharacter, SlotName, StartTime]()
+	{
+		const double ReadStartTime = FPlatformTime::Seconds();
+		FProgressionSnapshot Snapshot;
+		TArray<uint8> Data;
+		const bool bSuccess = FFileHelper::LoadFileToArray(Data, *FProgressionSaveFormat::GetSlotPath(SlotName), FILEREAD_Silent)
+			&& FProgressionSaveFormat::Deserialize(Data, Snapshot);
+
+		//Changes autosaved since the snapshot was written (everything up to the last interval before a crash)
+		int32 NumReplayedRecords = 0;
+		TArray<uint8> JournalData;
+		if (bSuccess && Snapshot.JournalId.IsValid() && FFileHelper::LoadFileToArray(JournalData, *FProgressionJournal::GetJournalPath(SlotName), FILEREAD_Silent))
+		{
+			NumReplayedRecords = FProgressionJournal::Replay(JournalData, Snapshot);
+		}
+		const double BackgroundSeconds = FPlatformTime::Seconds() - ReadStartTime;
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, WeakCharacter, SlotName, bSuccess, Snapshot = MoveTemp(Snapshot), NumReplayedRecords, BackgroundSeconds, StartTime]() mutable
+		{
+			if (UProgressionSaveSubsystem* This = WeakThis.Get())
+			{
+				This->OnLoadTaskComplete(WeakCharacter, SlotName, bSuccess, MoveTemp(Snapshot), NumReplayedRecords, BackgroundSeconds, StartTime);
+			}
+		});
+	}));
+
+	return true;
+}
+
+void UProgressionSaveSubsystem::OnLoadTaskComplete(TWeakObjectPtr<ACharacterBase> Character, const FString& SlotName, bool bSuccess, FProgressionSnapshot&& Snapshot, int32 NumReplayedRecords, double BackgroundSeconds, double StartTime)
+{
+	/* Function OnLoadTaskComplete
+	* Arguments: Character - character receiving the progression, SlotName - save slot, bSuccess - whether the file was read,
+	* Snapshot - progression read from the file (journal included), NumReplayedRecords - journal records applied to it,
+	* BackgroundSeconds - time spent on the thread pool, StartTime - time of the load request
+	* Output: none
+	*/
+
+	StatLoadBackgroundMsTotal += BackgroundSeconds * 1000.0;
+	StatReplayedRecords += NumReplayedRecords;
+
+	if (NumReplayedRecords > 0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("Recovered %d autosave journal records for progression %s"), NumReplayedRecords, *SlotName);
+	}
+
+	if (!bSuccess)
+	{
+		StatLoadsFailed++;
+		UE_LOG(LogTemp, Warning, TEXT("Failed to read progression save %s"), *FProgressionSaveFormat::GetSlotPath(SlotName));
+		OnLoadComplete.Broadcast(SlotName, false);
+		return;
+	}
+
+	//Every saved item is loaded in one batch (with its Gameplay bundle, same as slotting it would) before applying the save
+	UGAS_DemoAssetManager& AssetManager = UGAS_DemoAssetManager::Get();
+	TSet<FPrimaryAssetId> AssetIds;
+	auto AddItem = [&AssetManager, &AssetIds](int32 ItemId)
+	{
+		const FPrimaryAssetId AssetId = ItemId != INDEX_NONE ? AssetManager.FindItemAssetId(ItemId) : FPrimaryAssetId();
+		if (AssetId.IsValid()) AssetIds.Add(AssetId);
+	};
+	for (const FProgressionSnapshot::FInventoryEntry& Entry : Snapshot.Inventory) AddItem(Entry.ItemId);
+	for (const int32 ItemId : Snapshot.SlottedWeaponIds) AddItem(ItemId);
+	for (const int32 ItemId : Snapshot.SlottedConsumableIds) AddItem(ItemId);
+
+	TSharedRef<FProgressionSnapshot> SharedSnapshot = MakeShared<FProgressionSnapshot>(MoveTemp(Snapshot));
+	AssetManager.LoadPrimaryAssets(AssetIds.Array(), { UGAS_DemoAssetManager::GameplayBundle }, FStreamableDelegate::CreateWeakLambda(this,
+		[this, Character, SlotName, SharedSnapshot, StartTime]()
+		{
+			ACharacterBase* LoadedCharacter = Character.Get();
+			const bool bApplied = LoadedCharacter && ApplySnapshot(LoadedCharacter, *SharedSnapshot);
+
+			//Restoring marks everything dirty: write the loaded progression as a full snapshot on the next autosave instead
+			if (FAutosaveState* Autosave = FindAutosave(LoadedCharacter))
+			{
+				Autosave->DirtySections = EProgressionDirty::None;
+				Autosave->DirtyItems.Reset();
+				Autosave->bNeedsCompaction = true;
+			}
+
+			if (bApplied)
+			{
+				StatLoads++;
+				StatLoadTotalMsTotal += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+			}
+			else
+			{
+				StatLoadsFailed++;
+			}
+			OnLoadComplete.Broadcast(SlotName, bApplied);
+		}));
+}
+
+bool UProgressionSaveSubsystem::CaptureSnapshot(const ACharacterBase* Character, FProgressionSnapshot& OutSnapshot, EProgressionDirty Sections)
+{
+	/* Function CaptureSnapshot
+	* Arguments: const ACharacterBase* Character - character to capture, FProgressionSnapshot& OutSnapshot - receives the progression,
+	* EProgressionDirty Sections - sections to capture (other fields of OutSnapshot are left untouched)
+	* Output: true on success, false if Character has no AbilitySystemComponent
+	*
+	* Runs on the game thread on every save: only copies ids and values, every array is sized up front
+	*/
+
+	const UAbilitySystemComponent* AbilitySystemComponent = Character ? Character->GetAbilitySystemComponent() : nullptr;
+	if (!AbilitySystemComponent) return false;
+
+	if (EnumHasAnyFlags(Sections, EProgressionDirty::Level))
+	{
+		OutSnapshot.CharacterLevel = Character->GetCharacterLevel();
+	}
+
+	if (EnumHasAnyFlags(Sections, EProgressionDirty::Attributes))
+	{
+		const TArray<FGameplayAttribute>& Attributes = FProgressionSaveFormat::GetSavedAttributes();
+		OutSnapshot.AttributeBaseValues.SetNumUninitialized(Attributes.Num());
+		for (int32 Index = 0; Index < Attributes.Num(); ++Index)
+		{
+			OutSnapshot.AttributeBaseValues[Index] = AbilitySystemComponent->GetNumericAttributeBase(Attributes[Index]);
+		}
+	}
+
+	const UEquipmentComponent* Equipment = EnumHasAnyFlags(Sections, EProgressionDirty::Equipment) ? Character->FindComponentByClass<UEquipmentComponent>() : nullptr;
+	if (EnumHasAnyFlags(Sections, EProgressionDirty::Equipment))
+	{
+		OutSnapshot.SlottedWeaponIds.Reset();
+		OutSnapshot.SlottedConsumableIds.Reset();
+	}
+	if (Equipment)
+	{
+		OutSnapshot.SlottedWeaponIds.Reserve(Equipment->GetSlottedWeapons().Num());
+		for (const UWeaponBase* Weapon : Equipment->GetSlottedWeapons())
+		{
+			OutSnapshot.SlottedWeaponIds.Add(Weapon ? Weapon->ItemId : INDEX_NONE);
+		}
+
+		OutSnapshot.SlottedConsumableIds.Reserve(Equipment->GetSlottedConsumables().Num());
+		for (const UItemBase* Item : Equipment->GetSlottedConsumables())
+		{
+			OutSnapshot.SlottedConsumableIds.Add(Item ? Item->ItemId : INDEX_NONE);
+		}
+
+		OutSnapshot.EquippedWeaponIndex = Equipment->GetEquippedWeaponIndex();
+		OutSnapshot.EquippedConsumableIndex = Equipment->GetEquippedConsumableIndex();
+	}
+
+	//Inventory lives on the player controller, AI characters simply save an empty inventory
+	if (EnumHasAnyFlags(Sections, EProgressionDirty::Inventory))
+	{
+		OutSnapshot.Inventory.Reset();
+		if (ABasePlayerController* PlayerController = Cast<ABasePlayerController>(Character->GetController()))
+		{
+			CaptureInventory(PlayerController->GetInventoryDataMap(), OutSnapshot.Inventory);
+		}
+	}
+
+	return true;
+}
+
+void UProgressionSaveSubsystem::CaptureInventory(const TMap<UItemBase*, int32>& Inventory, TArray<FProgressionSnapshot::FInventoryEntry>& OutEntries)
+{
+	OutEntries.Reserve(OutEntries.Num() + Inventory.Num());
+	for (const TPair<UItemBase*, int32>& Pair : Inventory)
+	{
+		if (Pair.Key && Pair.Key->ItemId != INDEX_NONE) OutEntries.Add({ Pair.Key->ItemId, Pair.Value });
+	}
+
+	if (UGAS_DemoAssetManager::Get().GetItemRegistry().NumDuplicateIds > 0)
+		FProgressionSnapshot::MergeDuplicateItems(OutEntries);
+}
+
+static UItemBase* ResolveSavedItem(int32 ItemId)
+{
+	if (ItemId == INDEX_NONE) return nullptr;
+
+	UGAS_DemoAssetManager& AssetManager = UGAS_DemoAssetManager::Get();
+	const FPrimaryAssetId AssetId = AssetManager.FindItemAssetId(ItemId);
+	return AssetId.IsValid() ? AssetManager.GetPrimaryAssetObject<UItemBase>(AssetId) : nullptr;
+}
+
+bool UProgressionSaveSubsystem::ApplySnapshot(ACharacterBase* Character, const FProgressionSnapshot& Snapshot)
+{
+	/* Function ApplySnapshot
+	* Arguments: ACharacterBase* Character - character receiving the progression, const FProgressionSnapshot& Snapshot - progression to apply
+	* Output: true on success, false if Character has no authority or no AbilitySystemComponent
+	*
+	* Items that can't be resolved anymore (removed from the catalog) are dropped, their slots are left empty
+	*/
+
+	UAbilitySystemComponent* AbilitySystemComponent = Character ? Character->GetAbilitySystemComponent() : nullptr;
+	if (!AbilitySystemComponent || !Character->HasAuthority()) return false;
+
+	//Level first: SetCharacterLevel runs InitializeAttributes again, saved base values override them at the end
+	Character->SetCharacterLevel(Snapshot.CharacterLevel);
+
+	if (ABasePlayerController* PlayerController = Cast<ABasePlayerController>(Character->GetController()))
+	{
+		TMap<UItemBase*, int32> Inventory;
+		Inventory.Reserve(Snapshot.Inventory.Num());
+		for (const FProgressionSnapshot::FInventoryEntry& Entry : Snapshot.Inventory)
+		{
+			UItemBase* Item = ResolveSavedItem(Entry.ItemId);
+			if (Item && Entry.Count > 0) Inventory.FindOrAdd(Item) += Entry.Count;
+		}
+		PlayerController->RestoreInventory(MoveTemp(Inventory));
+	}
+
+	if (UEquipmentComponent* Equipment = Character->FindComponentByClass<UEquipmentComponent>())
+	{
+		TArray<UWeaponBase*> Weapons;
+		Weapons.Reserve(Snapshot.SlottedWeaponIds.Num());
+		for (const int32 ItemId : Snapshot.SlottedWeaponIds)
+		{
+			Weapons.Add(Cast<UWeaponBase>(ResolveSavedItem(ItemId)));
+		}
+
+		TArray<UItemBase*> Consumables;
+		Consumables.Reserve(Snapshot.SlottedConsumableIds.Num());
+		for (const int32 ItemId : Snapshot.SlottedConsumableIds)
+		{
+			Consumables.Add(ResolveSavedItem(ItemId));
+		}
+
+		Equipment->RestoreEquipment(Weapons, Consumables, Snapshot.EquippedWeaponIndex, Snapshot.EquippedConsumableIndex);
+	}
+
+	//Every saved attribute is overriden by ONE instant effect (built once per number of saved attributes by UGameplayEffectCache)
+	const TArray<FGameplayAttribute>& Attributes = FProgressionSaveFormat::GetSavedAttributes();
+	const int32 NumValues = FMath::Min(Attributes.Num(), Snapshot.AttributeBaseValues.Num());
+	if (NumValues > 0)
+	{
+		FGameplayEffectModSignature Signature;
+		for (int32 Index = 0; Index < NumValues; ++Index)
+		{
+			Signature.Add(Attributes[Index], EGameplayModOp::Override);
+		}
+
+		UGameplayEffect* Effect = UGameplayEffectCache::Get().FindOrCreateEffect(Signature, FName(TEXT("LoadProgression")));
+		FGameplayEffectSpec Spec(Effect, AbilitySystemComponent->MakeEffectContext(), 1.f);
+		for (int32 Index = 0; Index < NumValues; ++Index)
+		{
+			UGameplayEffectCache::SetModifierMagnitude(Spec, Attributes[Index], Snapshot.AttributeBaseValues[Index]);
+		}
+		AbilitySystemComponent->ApplyGameplayEffectSpecToSelf(Spec);
+	}
+
+	return true;
+}
+
+void UProgressionSaveSubsystem::PrunePendingTasks()
+{
+	PendingTasks.RemoveAll([](const TFuture<void>& Task) { return Task.IsReady(); });
+}
+
+void UProgressionSaveSubsystem::DumpStats(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("Saves: %llu requested, %llu written, %llu failed, %llu coalesced, last file size: %d bytes"),
+		StatSaves, StatSavesWritten, StatSavesFailed, StatSavesCoalesced, StatLastFileSize);
+	Ar.Logf(TEXT("  Snapshot (game thread) avg: %.3fms, max: %.3fms"),
+		StatSaves > 0 ? StatSnapshotMsTotal / StatSaves : 0.0, StatSnapshotMsMax);
+
+	const uint64 NumWrites = StatSavesWritten + StatSavesFailed;
+	Ar.Logf(TEXT("  Serialize+Compress+Write (background) avg: %.3fms"), NumWrites > 0 ? StatSaveBackgroundMsTotal / NumWrites : 0.0);
+
+	const uint64 NumLoads = StatLoads + StatLoadsFailed;
+	Ar.Logf(TEXT("Loads: %llu applied, %llu failed"), StatLoads, StatLoadsFailed);
+	Ar.Logf(TEXT("  Read+Decompress (background) avg: %.3fms, request to applied avg: %.3fms"),
+		NumLoads > 0 ? StatLoadBackgroundMsTotal / NumLoads : 0.0, StatLoads > 0 ? StatLoadTotalMsTotal / StatLoads : 0.0);
+	Ar.Logf(TEXT("Autosave: %d characters, %llu journal records (%llu bytes), %llu append failures, %llu compactions, %llu records replayed on load"),
+		Autosaves.Num(), StatJournalRecords, StatJournalBytes, StatJournalFailures, StatCompactions, StatReplayedRecords);
+	Ar.Logf(TEXT("Pending background tasks: %d"), PendingTasks.Num());
+}
+
+void UProgressionSaveSubsystem::ResetStats()
+{
+	StatSaves = 0;
+	StatSavesWritten = 0;
+	StatSavesFailed = 0;
+	StatSavesCoalesced = 0;
+	StatLoads = 0;
+	StatLoadsFailed = 0;
+	StatSnapshotMsTotal = 0.0;
+	StatSnapshotMsMax = 0.0;
+	StatSaveBackgroundMsTotal = 0.0;
+	StatLoadBackgroundMsTotal = 0.0;
+	StatLoadTotalMsTotal = 0.0;
+	StatLastFileSize = 0;
+	StatJournalRecords = 0;
+	StatJournalBytes = 0;
+	StatJournalFailures = 0;
+	StatCompactions = 0;
+	StatReplayedRecords = 0;
+}
@@ -0,0 +1,361 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "AttributeSet.h"
+#include "Async/Future.h"
+#include "Containers/Ticker.h"
+#include "ProgressionSaveSubsystem.generated.h"
+
+class ACharacterBase;
+class UItemBase;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnProgressionSlotComplete, const FString&, SlotName, bool, bSuccess);
+
+/** Sections of a character's progression, used both as dirty flags and to tell which sections a journal record holds */
+enum class EProgressionDirty : uint8
+{
+	None = 0,
+	Level = 1 << 0,
+	Attributes = 1 << 1,
+	Equipment = 1 << 2,
+	Inventory = 1 << 3,
+	All = Level | Attributes | Equipment | Inventory
+};
+ENUM_CLASS_FLAGS(EProgressionDirty)
+
+/** Everything persisted for a character, captured on the game thread and serialized on a background task */
+struct GAS_DEMO_API FProgressionSnapshot
+{
+	struct FInventoryEntry
+	{
+		int32 ItemId;
+		int32 Count;
+
+		bool operator==(const FInventoryEntry& Other) const
+		{
+			return ItemId == Other.ItemId && Count == Other.Count;
+		}
+	};
+
+	int32 CharacterLevel = 1;
+
+	/** Base value of every attribute of FProgressionSaveFormat::GetSavedAttributes, in that order */
+	TArray<float> AttributeBaseValues;
+
+	/** ItemId of every weapon/consumable slot (INDEX_NONE for an empty slot, such as the bare-handed weapon slot) */
+	TArray<int32> SlottedWeaponIds;
+	TArray<int32> SlottedConsumableIds;
+
+	int32 EquippedWeaponIndex = 0;
+	int32 EquippedConsumableIndex = 0;
+
+	TArray<FInventoryEntry> Inventory;
+
+	/** Journal holding the changes made on top of this snapshot, invalid if the slot has no autosave (see FProgressionJournal) */
+	FGuid JournalId;
+
+	/** Reads or writes the snapshot payload as laid out in Version */
+	void Serialize(FArchive& Ar, uint32 Version);
+
+	/** Reads or writes only the given sections, in file order */
+	void SerializeSections(FArchive& Ar, EProgressionDirty Sections);
+
+	/**
+	* Sums the counts of entries sharing an ItemId into the first one and removes the others
+	* (items sharing an id are a content error reported when the item registry is built, their counts are saved together)
+	*/
+	static void MergeDuplicateItems(TArray<FInventoryEntry>& InOutEntries);
+};
+
+/**
+* Change journal of a save slot: autosave appends one small record per interval holding only the sections
+* that changed (and only the inventory entries that changed, a count of 0 meaning the item was removed)
+* instead of writing the whole progression again.
+*
+* File layout (little endian): FHeader, then records made of a FRecordHeader followed by their payload
+* (EProgressionDirty sections byte + FProgressionSnapshot::SerializeSections of those sections).
+* The journal only applies to the snapshot with the same JournalId: writing a full snapshot (compaction)
+* starts a new journal, so a journal left behind by an interrupted compaction is simply ignored.
+*/
+class GAS_DEMO_API FProgressionJournal
+{
+public:
+	static constexpr uint32 FileMagic = 0x4C4E4A50; // "PJNL"
+	static constexpr uint32 FileVersion = 1;
+
+	/** Path of SlotName's journal: Saved/SaveGames/<SlotName>.journal (invalid characters replaced, see FProgressionSaveFormat::IsValidSlotName) */
+	static FString GetJournalPath(const FString& SlotName);
+
+	/** Builds a record (record header + payload) holding the Sections of Values */
+	static void SerializeRecord(EProgressionDirty Sections, const FProgressionSnapshot& Values, TArray<uint8>& OutRecord);
+
+	/** Appends Record to SlotName's journal, bStartJournal truncates the file and writes the header of JournalId first */
+	static bool AppendRecord(const FString& SlotName, const FGuid& JournalId, bool bStartJournal, const TArray<uint8>& Record);
+
+	/**
+	* Applies every record of a journal file to InOutSnapshot (crash recovery)
+	* Replay stops at the first incomplete or corrupted record (a write cut short by a crash): records before it still apply
+	*
+	* @return Number of records applied, 0 if Data isn't the journal of InOutSnapshot
+	*/
+	static int32 Replay(const TArray<uint8>& Data, FProgressionSnapshot& InOutSnapshot);
+
+private:
+
+	struct FHeader
+	{
+		uint32 Magic;
+		uint32 Version;
+		FGuid JournalId;
+	};
+
+	struct FRecordHeader
+	{
+		uint32 PayloadSize;
+		uint32 PayloadCrc;
+	};
+};
+
+/**
+* Binary layout of progression save files (little endian): FHeader, then the payload compressed with Oodle
+* (stored as is when it doesn't shrink). Items are saved by ItemId and resolved through the item registry
+* (see UGAS_DemoAssetManager::FindItemAssetId), so renaming or moving item assets doesn't break saves.
+* Counts and ids are written as packed ints, attributes as plain floats in GetSavedAttributes order.
+*/
+class GAS_DEMO_API FProgressionSaveFormat
+{
+public:
+	static constexpr uint32 FileMagic = 0x56415350; // "PSAV"
+	static constexpr uint32 FileVersion = 2;
+
+	/**
+	* Attributes persisted, in file order: Max attributes come first so they are overriden before the
+	* current values they clamp. Only ever append to this list (older saves simply hold fewer values).
+	*/
+	static const TArray<FGameplayAttribute>& GetSavedAttributes();
+
+	/** Whether SlotName can be used as a file name as is (not empty, no path separator or other invalid character) */
+	static bool IsValidSlotName(const FString& SlotName);
+
+	/** Path of SlotName's file: Saved/SaveGames/<SlotName>.prog (invalid characters replaced, see IsValidSlotName) */
+	static FString GetSlotPath(const FString& SlotName);
+
+	/** Serializes and compresses Snapshot in the file format */
+	static void Serialize(const FProgressionSnapshot& Snapshot, TArray<uint8>& OutData);
+
+	/** Decompresses and reads a save file, returns false if Data is invalid, corrupted or from a newer version */
+	static bool Deserialize(const TArray<uint8>& Data, FProgressionSnapshot& OutSnapshot);
+
+	/**
+	* Serializes Snapshot and writes it to SlotName's file (through a temporary file, so a failed write keeps the previous save)
+	* then deletes the slot's journal, whose changes are all part of the new snapshot
+	*/
+	static bool WriteSlot(const FString& SlotName, const FProgressionSnapshot& Snapshot, int32& OutFileSize);
+
+private:
+
+	struct FHeader
+	{
+		uint32 Magic;
+		uint32 Version;
+		int32 UncompressedSize;
+		int32 CompressedSize;
+		uint32 PayloadCrc;
+	};
+};
+
+UCLASS(config = Game)
+class GAS_DEMO_API UProgressionSaveSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+/*
+* Class UProgressionSaveSubsystem
+* Saves and loads a character's progression: CharacterLevel, attribute base values, slotted and equipped
+* items and inventory counts (see FProgressionSaveFormat).
+*
+* Saving only captures a FProgressionSnapshot on the game thread, serialization, compression and the file
+* write run on the thread pool. Saves requested while one is already being written for the same slot are
+* coalesced: only the latest snapshot is written once the current write is done.
+*
+* Loading reads and decompresses the file on the thread pool, loads every saved item in one batch and then
+* restores level, inventory and equipment before overriding every attribute base value with ONE instant effect.
+*
+* Autosave (StartAutosave) relies on dirty tracking: inventory operations, equipment changes, level changes and
+* effects executed on Health, Mana or Stamina call MarkDirty, and every AutosaveInterval only the dirty sections
+* are appended to the slot's journal.
+* The journal is compacted into a full snapshot once it gets too long (or too old), and is replayed on top of
+* the snapshot when loading, so a crash only loses the changes of the last interval.
+*
+* Use GAS.Save.Stats to check timings and GAS.Save.Player to save/load the local player. The
+* GASDemo.Progression.Save.Benchmark test measures save and load latency with large inventories.
+*/
+
+public:
+	UProgressionSaveSubsystem();
+
+	//~ Begin USubsystem
+	virtual void Deinitialize() override;
+	//~ End USubsystem
+
+	/** Captures Character's progression and writes it to SlotName in the background, returns false if nothing could be captured or SlotName isn't a valid file name */
+	UFUNCTION(BlueprintCallable, Category = Progression)
+	bool SaveProgression(ACharacterBase* Character, const FString& SlotName);
+
+	/** Reads SlotName in the background and applies it to Character (authority only), returns false if the load couldn't start or SlotName isn't a valid file name */
+	UFUNCTION(BlueprintCallable, Category = Progression)
+	bool LoadProgression(ACharacterBase* Character, const FString& SlotName);
+
+	/** Called on the game thread once a save was written (or failed) */
+	UPROPERTY(BlueprintAssignable, Category = Progression)
+	FOnProgressionSlotComplete OnSaveComplete;
+
+	/** Called on the game thread once a save was applied (or failed) */
+	UPROPERTY(BlueprintAssignable, Category = Progression)
+	FOnProgressionSlotComplete OnLoadComplete;
+
+	/**
+	* Starts autosaving Character to SlotName: the first autosave writes a full snapshot, later ones only journal changes
+	* Load the slot first to resume from it, any progression already in the slot is overwritten otherwise
+	*/
+	UFUNCTION(BlueprintCallable, Category = Progression)
+	void StartAutosave(ACharacterBase* Character, const FString& SlotName);
+
+	/** Stops autosaving Character, changes not autosaved yet are saved right away */
+	UFUNCTION(BlueprintCallable, Category = Progression)
+	void StopAutosave(ACharacterBase* Character);
+
+	/**
+	* Flags Sections of Character's progression as changed since its last autosave (no-op if it isn't autosaved)
+	*
+	* @param Character  Character whose progression changed
+	* @param Sections  Changed sections
+	* @param Item  Inventory item whose count changed (with EProgressionDirty::Inventory)
+	*/
+	static void MarkDirty(const AActor* Character, EProgressionDirty Sections, const UItemBase* Item = nullptr);
+
+	/** Fills the Sections of OutSnapshot with Character's current progression (game thread), returns false if Character has no AbilitySystemComponent */
+	static bool CaptureSnapshot(const ACharacterBase* Character, FProgressionSnapshot& OutSnapshot, EProgressionDirty Sections = EProgressionDirty::All);
+
+	/** Appends the ItemId and count of every item of Inventory to OutEntries, items sharing an ItemId are merged into one entry */
+	static void CaptureInventory(const TMap<UItemBase*, int32>& Inventory, TArray<FProgressionSnapshot::FInventoryEntry>& OutEntries);
+
+	/** Applies Snapshot to Character (authority only), its items must already be loaded */
+	static bool ApplySnapshot(ACharacterBase* Character, const FProgressionSnapshot& Snapshot);
+
+	/** Prints save/load stats to the output device */
+	void DumpStats(FOutputDevice& Ar) const;
+
+	/** Clears the counters shown in DumpStats */
+	void ResetStats();
+
+protected:
+
+	/** Time (in seconds) between autosaves, can be overriden in DefaultGame.ini under [/Script/GAS_Demo.ProgressionSaveSubsystem] */
+	UPROPERTY(Config)
+	float AutosaveInterval;
+
+	/** The journal is compacted into a full snapshot once it holds this many records... */
+	UPROPERTY(Config)
+	int32 CompactAfterRecords;
+
+	/** ...or this many bytes... */
+	UPROPERTY(Config)
+	int32 CompactAfterBytes;
+
+	/** ...or its first record is older than this (in seconds) */
+	UPROPERTY(Config)
+	float CompactionInterval;
+
+private:
+
+	struct FAutosaveState
+	{
+		TWeakObjectPtr<ACharacterBase> Character;
+		FString SlotName;
+
+		/** Journal of the last full snapshot written for this autosave */
+		FGuid JournalId;
+
+		EProgressionDirty DirtySections = EProgressionDirty::None;
+
+		/** ItemId of every inventory item changed since the last autosave (keys are only used to find their count, never dereferenced) */
+		TMap<const UItemBase*, int32> DirtyItems;
+
+		int32 NumJournalRecords = 0;
+		int64 JournalBytes = 0;
+		double LastCompactionTime = 0.0;
+
+		/** Next autosave writes a full snapshot (first autosave, failed write or progression loaded) */
+		bool bNeedsCompaction = true;
+	};
+
+	struct FSlotSaveState
+	{
+		bool bInFlight = false;
+		TOptional<FProgressionSnapshot> QueuedSnapshot;
+	};
+
+	/** Writes Snapshot to SlotName on the thread pool */
+	void StartSaveTask(const FString& SlotName, FProgressionSnapshot&& Snapshot);
+
+	/** Game thread side of a finished save: starts the queued snapshot of the slot, if any */
+	void OnSaveTaskComplete(const FString& SlotName, bool bSuccess, double BackgroundSeconds, int32 FileSize);
+
+	/** Appends Record to SlotName's journal on the thread pool */
+	void StartJournalTask(const FString& SlotName, const FGuid& JournalId, bool bStartJournal, TArray<uint8>&& Record);
+
+	/** Game thread side of a finished journal append */
+	void OnJournalTaskComplete(const FString& SlotName, bool bSuccess);
+
+	/** Marks SlotName as idle and starts the snapshot queued for it, if any */
+	void StartQueuedSave(const FString& SlotName);
+
+	/** Ticker running every AutosaveInterval */
+	bool TickAutosave(float DeltaTime);
+
+	/** Journals the dirty sections of State's character, or compacts its journal */
+	void Autosave(FAutosaveState& State, double Now);
+
+	FAutosaveState* FindAutosave(const AActor* Character);
+	FAutosaveState* FindAutosaveBySlot(const FString& SlotName);
+
+	/** Game thread side of a finished file read: loads the saved items before applying the snapshot */
+	void OnLoadTaskComplete(TWeakObjectPtr<ACharacterBase> Character, const FString& SlotName, bool bSuccess, FProgressionSnapshot&& Snapshot, int32 NumReplayedRecords, double BackgroundSeconds, double StartTime);
+
+	/** Drops the futures of finished tasks */
+	void PrunePendingTasks();
+
+	/** Save state of every slot written during this session */
+	TMap<FString, FSlotSaveState> SlotStates;
+
+	/** Characters being autosaved */
+	TArray<FAutosaveState> Autosaves;
+
+	FTSTicker::FDelegateHandle AutosaveTickerHandle;
+
+	/** Background tasks still running, waited for on Deinitialize so pending saves reach the disk */
+	TArray<TFuture<void>> PendingTasks;
+
+	//Stats counters, see DumpStats
+	uint64 StatSaves;
+	uint64 StatSavesWritten;
+	uint64 StatSavesFailed;
+	uint64 StatSavesCoalesced;
+	uint64 StatLoads;
+	uint64 StatLoadsFailed;
+	double StatSnapshotMsTotal;
+	double StatSnapshotMsMax;
+	double StatSaveBackgroundMsTotal;
+	double StatLoadBackgroundMsTotal;
+	double StatLoadTotalMsTotal;
+	int32 StatLastFileSize;
+	uint64 StatJournalRecords;
+	uint64 StatJournalBytes;
+	uint64 StatJournalFailures;
+	uint64 StatCompactions;
+	uint64 StatReplayedRecords;
+};
@@ -0,0 +1,216 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+
+#include "RegenerationSubsystem.h"
+#include "AbilitySystemComponent.h"
+#include "GASAttributeSet.h"
+#include "GameplayEffectAggregator.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CVarRegenStats(
+	TEXT("GAS.Regen.Stats"),
+	TEXT("Prints the cost of the batched Stamina/Mana regeneration pass. Use 'GAS.Regen.Stats reset' to clear counters."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		URegenerationSubsystem* Subsystem = World ? World->GetSubsystem<URegenerationSubsystem>() : nullptr;
+		if (!Subsystem)
+		{
+			Ar.Log(TEXT("No RegenerationSubsystem in this world"));
+			return;
+		}
+
+		if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+		{
+			Subsystem->ResetStats();
+			return;
+		}
+
+		Subsystem->DumpStats(Ar);
+	}));
+
+bool URegenerationSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void URegenerationSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	PauseStaminaRechargeTag = FGameplayTag::RequestGameplayTag(FName(TEXT("Character.Attribute.Stamina.PauseRecharge")));
+
+	ResetStats();
+}
+
+void URegenerationSubsystem::Deinitialize()
+{
+	AbilitySystemComponents.Reset();
+	AttributeSets.Reset();
+	StaminaRates.Reset();
+	ManaRates.Reset();
+	EntryIndices.Reset();
+
+	Super::Deinitialize();
+}
+
+void URegenerationSubsystem::RegisterRegeneration(UAbilitySystemComponent* AbilitySystemComponent, float StaminaPerSecond, float ManaPerSecond)
+{
+	/* Function RegisterRegeneration
+	* Arguments: UAbilitySystemComponent AbilitySystemComponent - ASC to regenerate, float StaminaPerSecond, float ManaPerSecond - rates
+	* Output: none (adds or updates the packed entry of the ASC)
+	*/
+
+	if (!AbilitySystemComponent) return;
+
+	if (const int32* Found = EntryIndices.Find(AbilitySystemComponent))
+	{
+		StaminaRates[*Found] = StaminaPerSecond;
+		ManaRates[*Found] = ManaPerSecond;
+		return;
+	}
+
+	const UGASAttributeSet* AttributeSet = AbilitySystemComponent->GetSet<UGASAttributeSet>();
+	if (!AttributeSet) return;
+
+	EntryIndices.Add(AbilitySystemComponent, AbilitySystemComponents.Num());
+	AbilitySystemComponents.Add(AbilitySystemComponent);
+	AttributeSets.Add(AttributeSet);
+	StaminaRates.Add(StaminaPerSecond);
+	ManaRates.Add(ManaPerSecond);
+}
+
+void URegenerationSubsystem::UnregisterRegeneration(UAbilitySystemComponent* AbilitySystemComponent)
+{
+	if (const int32* Found = EntryIndices.Find(AbilitySystemComponent))
+	{
+		RemoveEntryAt(*Found);
+	}
+}
+
+void URegenerationSubsystem::RemoveEntryAt(int32 Index)
+{
+	/* Function RemoveEntryAt
+	* Arguments: int32 Index - index of the entry in the packed arrays
+	* Output: none (swaps the last entry into Index so arrays stay packed)
+	*/
+
+	//Weak pointers are used as keys so stale entries can still be found once their ASC is destroyed
+	EntryIndices.Remove(AbilitySystemComponents[Index]);
+
+	const int32 LastIndex = AbilitySystemComponents.Num() - 1;
+	if (Index != LastIndex)
+	{
+		EntryIndices.Add(AbilitySystemComponents[LastIndex], Index);
+	}
+
+	AbilitySystemComponents.RemoveAtSwap(Index, 1, false);
+	AttributeSets.RemoveAtSwap(Index, 1, false);
+	StaminaRates.RemoveAtSwap(Index, 1, false);
+	ManaRates.RemoveAtSwap(Index, 1, false);
+}
+
+void URegenerationSubsystem::Tick(float DeltaTime)
+{
+	if (AbilitySystemComponents.Num() == 0 || DeltaTime <= 0.f) return;
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	//Owners destroyed without unregistering are dropped first (iterating backwards keeps the swap safe)
+	for (int32 Index = AbilitySystemComponents.Num() - 1; Index >= 0; --Index)
+	{
+		if (!AbilitySystemComponents[Index].IsValid() || !AttributeSets[Index].IsValid())
+			RemoveEntryAt(Index);
+	}
+
+	//Read pass: compute every new value first so the write pass only touches characters that actually changed
+	const int32 NumEntries = AbilitySystemComponents.Num();
+	NewStamina.SetNumUninitialized(NumEntries, false);
+	NewMana.SetNumUninitialized(NumEntries, false);
+	ChangedEntries.Reset();
+
+	for (int32 Index = 0; Index < NumEntries; ++Index)
+	{
+		const UAbilitySystemComponent* AbilitySystemComponent = AbilitySystemComponents[Index].Get();
+		const UGASAttributeSet* AttributeSet = AttributeSets[Index].Get();
+
+		float Stamina = AttributeSet->GetStamina();
+		if (StaminaRates[Index] != 0.f && !AbilitySystemComponent->HasMatchingGameplayTag(PauseStaminaRechargeTag))
+		{
+			Stamina = FMath::Clamp(Stamina + StaminaRates[Index] * DeltaTime, 0.f, AttributeSet->GetMaxStamina());
+		}
+		NewStamina[Index] = Stamina;
+
+		float Mana = AttributeSet->GetMana();
+		if (ManaRates[Index] != 0.f)
+		{
+			Mana = FMath::Clamp(Mana + ManaRates[Index] * DeltaTime, 0.f, AttributeSet->GetMaxMana());
+		}
+		NewMana[Index] = Mana;
+
+		if (Stamina != AttributeSet->GetStamina() || Mana != AttributeSet->GetMana())
+			ChangedEntries.Add(Index);
+	}
+
+	//Write pass: set the new base values of the changed characters only (same path the attribute set SET accessors use).
+	//Aggregator dirty notifications are batched, attributes depending on Stamina/Mana are updated once at the end of the pass
+	{
+		FScopedAggregatorOnDirtyBatch AggregatorBatch;
+
+		for (const int32 Index : ChangedEntries)
+		{
+			UAbilitySystemComponent* AbilitySystemComponent = AbilitySystemComponents[Index].Get();
+			const UGASAttributeSet* AttributeSet = AttributeSets[Index].Get();
+
+			if (NewStamina[Index] != AttributeSet->GetStamina())
+			{
+				AbilitySystemComponent->SetNumericAttributeBase(UGASAttributeSet::GetStaminaAttribute(), NewStamina[Index]);
+				StatAttributeWrites++;
+			}
+
+			if (NewMana[Index] != AttributeSet->GetMana())
+			{
+				AbilitySystemComponent->SetNumericAttributeBase(UGASAttributeSet::GetManaAttribute(), NewMana[Index]);
+				StatAttributeWrites++;
+			}
+		}
+	}
+
+	const uint64 PassCycles = FPlatformTime::Cycles64() - StartCycles;
+	StatPasses++;
+	StatPassCycles += PassCycles;
+	StatMaxPassCycles = FMath::Max(StatMaxPassCycles, PassCycles);
+	StatEntriesProcessed += NumEntries;
+}
+
+TStatId URegenerationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URegenerationSubsystem, STATGROUP_Tickables);
+}
+
+void URegenerationSubsystem::DumpStats(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("Batched regeneration: %d characters"), AbilitySystemComponents.Num());
+
+	if (StatPasses == 0)
+	{
+		Ar.Log(TEXT("  No passes recorded yet"));
+		return;
+	}
+
+	const double AveragePassMs = FPlatformTime::ToMilliseconds64(StatPassCycles) / (double)StatPasses;
+	const double AverageEntryUs = StatEntriesProcessed > 0 ? FPlatformTime::ToMilliseconds64(StatPassCycles) * 1000.0 / (double)StatEntriesProcessed : 0.0;
+
+	Ar.Logf(TEXT("  Passes: %llu, avg pass: %.4fms, max pass: %.4fms"), StatPasses, AveragePassMs, FPlatformTime::ToMilliseconds64(StatMaxPassCycles));
+	Ar.Logf(TEXT("  Avg cost per character: %.3fus, attribute writes: %llu"), AverageEntryUs, StatAttributeWrites);
+}
+
+void URegenerationSubsystem::ResetStats()
+{
+	StatPasses = 0;
+	StatPassCycles = 0;
+	StatMaxPassCycles = 0;
+	StatEntriesProcessed = 0;
+	StatAttributeWrites = 0;
+}
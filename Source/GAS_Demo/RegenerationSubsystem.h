@@ -0,0 +1,98 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GameplayTagContainer.h"
+#include "RegenerationSubsystem.generated.h"
+
+class UAbilitySystemComponent;
+class UGASAttributeSet;
+
+UCLASS()
+class GAS_DEMO_API URegenerationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+/*
+* Class URegenerationSubsystem
+* Regenerates Stamina and Mana for every registered character in a single pass per frame,
+* instead of each character running its own periodic GameplayEffect (one timer and one
+* aggregator update per character and attribute).
+*
+* Regeneration state is kept in packed arrays (one entry per character at the same index in every array),
+* stamina regeneration is paused while the character owns Character.Attribute.Stamina.PauseRecharge.
+* This only runs where attributes are authoritative (server or standalone), clients receive the values
+* through attribute replication as usual.
+*
+* Entries whose ASC or attribute set was destroyed without unregistering are dropped at the start of the next pass.
+* This is the only regeneration mechanism for Stamina and Mana, periodic effects routed to UPeriodicEffectScheduler
+* are damage over time effects only.
+*
+* Use the console command GAS.Regen.Stats to check the cost of the regeneration pass, the automation test
+* GASDemo.Regeneration.Benchmark compares it with one periodic GameplayEffect per character.
+*/
+
+public:
+
+	//~ Begin USubsystem
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~ End USubsystem
+
+	//~ Begin FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject
+
+	/**
+	* Starts regenerating the attributes of AbilitySystemComponent, if already registered only updates the rates
+	*
+	* @param AbilitySystemComponent  ASC owning a UGASAttributeSet
+	* @param StaminaPerSecond  Stamina regenerated per second
+	* @param ManaPerSecond  Mana regenerated per second
+	*/
+	void RegisterRegeneration(UAbilitySystemComponent* AbilitySystemComponent, float StaminaPerSecond, float ManaPerSecond);
+
+	/** Stops regenerating the attributes of AbilitySystemComponent */
+	void UnregisterRegeneration(UAbilitySystemComponent* AbilitySystemComponent);
+
+	/** Prints the regeneration pass stats to the output device */
+	void DumpStats(FOutputDevice& Ar) const;
+
+	/** Clears the counters shown in DumpStats */
+	void ResetStats();
+
+private:
+
+	/** Removes the entry at Index from every packed array */
+	void RemoveEntryAt(int32 Index);
+
+	//Packed regeneration state: same index = same character
+	TArray<TWeakObjectPtr<UAbilitySystemComponent>> AbilitySystemComponents;
+	TArray<TWeakObjectPtr<const UGASAttributeSet>> AttributeSets;
+	TArray<float> StaminaRates;
+	TArray<float> ManaRates;
+
+	/** Lookup from ASC to its index in the packed arrays */
+	TMap<TWeakObjectPtr<UAbilitySystemComponent>, int32> EntryIndices;
+
+	/** Values computed on the read pass, written back on the write pass (reused every frame) */
+	TArray<float> NewStamina;
+	TArray<float> NewMana;
+
+	/** Indices of the entries whose Stamina or Mana changed on the read pass (reused every frame) */
+	TArray<int32> ChangedEntries;
+
+	/** Cached Character.Attribute.Stamina.PauseRecharge tag */
+	FGameplayTag PauseStaminaRechargeTag;
+
+	//Stats counters, see DumpStats
+	uint64 StatPasses;
+	uint64 StatPassCycles;
+	uint64 StatMaxPassCycles;
+	uint64 StatEntriesProcessed;
+	uint64 StatAttributeWrites;
+};
@@ -0,0 +1,225 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+
+#include "BaseAbilitySystemComponent.h"
+#include "GASGameplayAbility.h"
+#include "CharacterBase.h"
+#include "Engine/Engine.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "GameFramework/PlayerController.h"
+#include "GameplayTagsManager.h"
+#include "HAL/IConsoleManager.h"
+#include "GASDemoPIESession.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+/** Client side of the PIE session: the local character, its ASC and the melee spec under test */
+struct FRPCBatchingClient
+{
+	UWorld* World = nullptr;
+	ACharacterBase* Character = nullptr;
+	UBaseAbilitySystemComponent* AbilitySystemComponent = nullptr;
+	FGameplayAbilitySpecHandle MeleeHandle;
+	UGASGameplayAbility* MeleeAbility = nullptr;
+};
+
+/** Results of the attacks made in one mode (batched or not) */
+struct FRPCBatchingRun
+{
+	int32 Attacks = 0;
+	uint64 ServerRPCs = 0;
+	uint64 TargetDataBytes = 0;
+	int64 AttackBytes = 0;
+	double IdleBytesPerFrame = 0.0;
+};
+
+/** Finds the client world of the PIE session and its melee ability, false while the client isn't fully set up */
+static bool FindRPCBatchingClient(FRPCBatchingClient& OutClient)
+{
+	UWorld* World = FGASDemoPIESession::FindWorld(NM_Client);
+	APlayerController* PlayerController = World ? World->GetFirstPlayerController() : nullptr;
+	ACharacterBase* Character = PlayerController ? Cast<ACharacterBase>(PlayerController->GetPawn()) : nullptr;
+	UBaseAbilitySystemComponent* AbilitySystemComponent = Character ? Cast<UBaseAbilitySystemComponent>(Character->GetAbilitySystemComponent()) : nullptr;
+	if (!AbilitySystemComponent) return false;
+
+	//Melee abilities are the ones tagged Character.Attack, or named after melee when untagged
+	TArray<FGameplayAbilitySpec*> AttackSpecs;
+	AbilitySystemComponent->GetActivatableGameplayAbilitySpecsByAllMatchingTags(
+		FGameplayTagContainer(UGameplayTagsManager::Get().RequestGameplayTag(TEXT("Character.Attack"))), AttackSpecs, false);
+	for (FGameplayAbilitySpec& Spec : AbilitySystemComponent->GetActivatableAbilities())
+	{
+		if (AttackSpecs.Num() == 0 && Spec.Ability && Spec.Ability->GetClass()->GetName().Contains(TEXT("Melee")))
+			AttackSpecs.Add(&Spec);
+	}
+
+	UGASGameplayAbility* MeleeAbility = AttackSpecs.Num() > 0 ? Cast<UGASGameplayAbility>(AttackSpecs[0]->Ability) : nullptr;
+	if (!MeleeAbility) return false;
+
+	OutClient.World = World;
+	OutClient.Character = Character;
+	OutClient.AbilitySystemComponent = AbilitySystemComponent;
+	OutClient.MeleeHandle = AttackSpecs[0]->Handle;
+	OutClient.MeleeAbility = MeleeAbility;
+	return true;
+}
+
+/** Bytes the client has sent to the server so far */
+static int64 GetClientOutBytes(const FRPCBatchingClient& Client)
+{
+	const UNetDriver* NetDriver = Client.World ? Client.World->GetNetDriver() : nullptr;
+	return NetDriver && NetDriver->ServerConnection ? (int64)NetDriver->ServerConnection->OutTotalBytes : 0;
+}
+
+/** One hit in front of the attacker, what AbilityTask_MeleeSweep reports for a single target */
+static FGameplayAbilityTargetDataHandle MakeMeleeTargetData(const ACharacterBase* Character)
+{
+	FHitResult Hit;
+	Hit.bBlockingHit = true;
+	Hit.Location = Character->GetActorLocation() + Character->GetActorForwardVector() * 100.f;
+	Hit.ImpactPoint = Hit.Location;
+	Hit.Normal = -Character->GetActorForwardVector();
+	Hit.ImpactNormal = Hit.Normal;
+	Hit.TraceStart = Character->GetActorLocation();
+	Hit.TraceEnd = Hit.Location;
+	return FGameplayAbilityTargetDataHandle(new FGameplayAbilityTargetData_SingleTargetHit(Hit));
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAbilityRPCBatchingTest, "GASDemo.Abilities.RPCBatching",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FAbilityRPCBatchingTest::RunTest(const FString& Parameters)
+{
+	FGASDemoPIESession::Start(TEXT("/Game/Maps/ShowcaseMap"));
+
+	IConsoleVariable* BatchRPCs = IConsoleManager::Get().FindConsoleVariable(TEXT("GAS.Abilities.BatchRPCs"));
+	IConsoleVariable* MeasureTargetDataBytes = IConsoleManager::Get().FindConsoleVariable(TEXT("GAS.Abilities.MeasureTargetDataBytes"));
+	if (!TestNotNull(TEXT("GAS.Abilities.BatchRPCs"), BatchRPCs) || !TestNotNull(TEXT("GAS.Abilities.MeasureTargetDataBytes"), MeasureTargetDataBytes))
+		return false;
+
+	const int32 PreviousBatchRPCs = BatchRPCs->GetInt();
+	const int32 PreviousMeasureTargetDataBytes = MeasureTargetDataBytes->GetInt();
+	MeasureTargetDataBytes->Set(1, ECVF_SetByCode);
+
+	//Frames between two attacks (montage and stamina recovery) and frames of idle traffic measured before each run
+	const int32 NumAttacks = 10;
+	const int32 FramesBetweenAttacks = 30;
+	const int32 IdleFrames = 60;
+	const double ClientTimeout = 30.0;
+
+	struct FState
+	{
+		FRPCBatchingClient Client;
+		bool bPreviousBatchFlag = false;
+		double StartTime = 0.0;
+		int32 Mode = 0;
+		int32 Frame = 0;
+		int32 AttacksStarted = 0;
+		int64 BytesMark = 0;
+		bool bAttackPending = false;
+		FRPCBatchingRun Runs[2];
+	};
+	TSharedRef<FState> State = MakeShared<FState>();
+	State->StartTime = FPlatformTime::Seconds();
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, State, BatchRPCs, NumAttacks, FramesBetweenAttacks, IdleFrames, ClientTimeout]()
+	{
+		FState& S = *State;
+		if (!S.Client.AbilitySystemComponent)
+		{
+			if (FindRPCBatchingClient(S.Client))
+			{
+				//The melee ability opts in for the test (its Blueprint may not), restored once done
+				S.bPreviousBatchFlag = S.Client.MeleeAbility->ShouldBatchRPCs();
+				FBoolProperty* BatchFlag = FindFProperty<FBoolProperty>(UGASGameplayAbility::StaticClass(), TEXT("bBatchActivationRPCs"));
+				BatchFlag->SetPropertyValue_InContainer(S.Client.MeleeAbility, true);
+				AddInfo(FString::Printf(TEXT("Client ready after %.1fs, attacking with %s"), FPlatformTime::Seconds() - S.StartTime, *S.Client.MeleeAbility->GetClass()->GetName()));
+				return false;
+			}
+
+			if (FPlatformTime::Seconds() - S.StartTime > ClientTimeout)
+			{
+				AddError(TEXT("No client character with a melee ability in the PIE session"));
+				return true;
+			}
+			return false;
+		}
+
+		//Mode 0 batched, mode 1 unbatched: idle frames first, then one attack every FramesBetweenAttacks
+		FRPCBatchingRun& Run = S.Runs[S.Mode];
+		if (S.Frame == 0)
+		{
+			BatchRPCs->Set(S.Mode == 0 ? 1 : 0, ECVF_SetByCode);
+			S.BytesMark = GetClientOutBytes(S.Client);
+		}
+		else if (S.Frame == IdleFrames)
+		{
+			Run.IdleBytesPerFrame = (double)(GetClientOutBytes(S.Client) - S.BytesMark) / IdleFrames;
+			UBaseAbilitySystemComponent::ResetRPCStats();
+		}
+		else if (S.Frame > IdleFrames)
+		{
+			const int32 AttackFrame = (S.Frame - IdleFrames - 1) % FramesBetweenAttacks;
+			if (AttackFrame == 0 && S.AttacksStarted < NumAttacks)
+			{
+				S.BytesMark = GetClientOutBytes(S.Client);
+				S.bAttackPending = S.Client.AbilitySystemComponent->BatchRPCTryActivateAbilityWithTargetData(S.Client.MeleeHandle, MakeMeleeTargetData(S.Client.Character), true);
+				Run.Attacks += S.bAttackPending ? 1 : 0;
+				S.AttacksStarted++;
+			}
+			else if (AttackFrame == 0)
+			{
+				Run.ServerRPCs = UBaseAbilitySystemComponent::GetServerRPCCount();
+				Run.TargetDataBytes = UBaseAbilitySystemComponent::GetTargetDataBytes();
+				S.Mode++;
+				S.Frame = 0;
+				S.AttacksStarted = 0;
+				return S.Mode == 2;
+			}
+			else if (AttackFrame == 1 && S.bAttackPending)
+			{
+				//RPCs are flushed at the end of the frame they are called in, the bytes are read on the next one
+				Run.AttackBytes += GetClientOutBytes(S.Client) - S.BytesMark;
+				S.bAttackPending = false;
+			}
+		}
+
+		S.Frame++;
+		return false;
+	}));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, State, BatchRPCs, MeasureTargetDataBytes, PreviousBatchRPCs, PreviousMeasureTargetDataBytes]()
+	{
+		FState& S = *State;
+		BatchRPCs->Set(PreviousBatchRPCs, ECVF_SetByCode);
+		MeasureTargetDataBytes->Set(PreviousMeasureTargetDataBytes, ECVF_SetByCode);
+		if (S.Client.MeleeAbility)
+			FindFProperty<FBoolProperty>(UGASGameplayAbility::StaticClass(), TEXT("bBatchActivationRPCs"))->SetPropertyValue_InContainer(S.Client.MeleeAbility, S.bPreviousBatchFlag);
+
+		FGASDemoPIESession::End();
+
+		const TCHAR* ModeNames[] = { TEXT("Batched"), TEXT("Unbatched") };
+		const uint64 ExpectedRPCs[] = { 1, 3 };
+		for (int32 Mode = 0; Mode < 2 && S.Client.AbilitySystemComponent; ++Mode)
+		{
+			const FRPCBatchingRun& Run = S.Runs[Mode];
+			if (!TestTrue(FString::Printf(TEXT("%s: melee attacks activated"), ModeNames[Mode]), Run.Attacks > 0)) continue;
+
+			//Activation, target data and end: one ServerAbilityRPCBatch, or three RPCs
+			TestEqual(FString::Printf(TEXT("%s: server RPCs per attack"), ModeNames[Mode]), Run.ServerRPCs, ExpectedRPCs[Mode] * Run.Attacks);
+
+			AddInfo(FString::Printf(TEXT("%s: %d attacks, %.2f server RPCs per attack, %.1f bytes sent per attack (%.1f bytes per idle frame subtracted), %.1f target data bytes per attack"),
+				ModeNames[Mode], Run.Attacks, (double)Run.ServerRPCs / Run.Attacks, (double)Run.AttackBytes / Run.Attacks - Run.IdleBytesPerFrame,
+				Run.IdleBytesPerFrame, (double)Run.TargetDataBytes / Run.Attacks));
+		}
+		return true;
+	}));
+
+	//Wait for the session to end before the next test
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([]() { return FGASDemoPIESession::HasEnded(); }));
+
+	return true;
+}
+
+#endif
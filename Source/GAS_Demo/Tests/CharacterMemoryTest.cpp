@@ -0,0 +1,130 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+
+#include "CharacterMemoryReport.h"
+#include "GASDemoTestWorld.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && ENABLE_LOW_LEVEL_MEM_TRACKER
+
+/**
+* Tagged bytes of one spawned and possessed character (every GASDemo_* tag), as reported by this test in a Development
+* editor run with -llm. Recorded in Docs/Performance.md (Character memory) with the run it comes from, 0 until measured.
+*/
+static constexpr int64 MeasuredBytesPerCharacter = 0;
+
+/** Growth over the measured cost allowed before failing: room for an ability or an effect more, not for a new component */
+static constexpr double MeasuredMargin = 0.25;
+
+/** Bound checked until MeasuredBytesPerCharacter is recorded: an estimate of the ASC, attribute set and components, not a measurement */
+static constexpr int64 ProvisionalMaxBytesPerCharacter = 256 * 1024;
+
+/** Part of the tagged bytes that may stay after the characters are destroyed (containers of the world grown by the spawns) */
+static constexpr double MaxRetainedRatio = 0.1;
+
+static const int32 NumCharacterTags = 6;
+
+/** Current amount of every GASDemo_* tag of the default tracker: Character, Camera, AbilitySystem, Effects, Equipment, Inventory */
+static TArray<int64> GetCharacterTagAmounts()
+{
+	//Tag amounts are gathered from the threads once per frame, done right away here
+	FLowLevelMemTracker& Tracker = FLowLevelMemTracker::Get();
+	Tracker.UpdateStatsPerFrame();
+
+	const FName TagNames[NumCharacterTags] = { LLM_TAG_NAME(GASDemo_Character), LLM_TAG_NAME(GASDemo_Camera), LLM_TAG_NAME(GASDemo_AbilitySystem),
+		LLM_TAG_NAME(GASDemo_Effects), LLM_TAG_NAME(GASDemo_Equipment), LLM_TAG_NAME(GASDemo_Inventory) };
+
+	TArray<int64> Amounts;
+	for (const FName& TagName : TagNames)
+	{
+		Amounts.Add(Tracker.GetTagAmountForTracker(ELLMTracker::Default, TagName));
+	}
+	return Amounts;
+}
+
+static int64 SumAmounts(const TArray<int64>& Amounts)
+{
+	int64 Total = 0;
+	for (const int64 Amount : Amounts)
+	{
+		Total += Amount;
+	}
+	return Total;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCharacterSpawnMemoryTest, "GASDemo.Memory.CharacterSpawn",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCharacterSpawnMemoryTest::RunTest(const FString& Parameters)
+{
+	if (!FLowLevelMemTracker::IsEnabled())
+	{
+		AddWarning(TEXT("Low Level Memory tracker disabled, run with -llm to check the memory of characters"));
+		return true;
+	}
+
+	UClass* CharacterClass = FGASDemoTestWorld::GetCharacterClass();
+	if (!TestNotNull(TEXT("Game mode pawn class (ACharacterBase)"), CharacterClass))
+		return false;
+
+	FGASDemoTestWorld TestWorld(TEXT("CharacterMemoryTest"));
+	UWorld* World = TestWorld.Get();
+
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	const TArray<int64> AmountsBefore = GetCharacterTagAmounts();
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	const int32 NumCharacters = 32;
+	TArray<ACharacterBase*> Characters;
+	for (int32 Index = 0; Index < NumCharacters; ++Index)
+	{
+		//Tagged at spawn so the actor object and its Blueprint components count as well, possession grants abilities and effects
+		LLM_SCOPE_BYTAG(GASDemo_Character);
+
+		const FVector Location((Index % 8) * 200.f, (Index / 8) * 200.f, 100.f);
+		if (ACharacterBase* Character = World->SpawnActor<ACharacterBase>(CharacterClass, FTransform(Location), SpawnParams))
+		{
+			Character->SpawnDefaultController();
+			Characters.Add(Character);
+		}
+	}
+
+	const TArray<int64> AmountsSpawned = GetCharacterTagAmounts();
+	if (!TestEqual(TEXT("Spawned characters"), Characters.Num(), NumCharacters))
+		return false;
+
+	TestWorld.DestroyCharacters(Characters);
+	const int64 AmountDestroyed = SumAmounts(GetCharacterTagAmounts());
+
+	const int64 AmountBefore = SumAmounts(AmountsBefore);
+	const int64 Growth = SumAmounts(AmountsSpawned) - AmountBefore;
+	const int64 GrowthPerCharacter = Growth / NumCharacters;
+	const int64 Retained = AmountDestroyed - AmountBefore;
+
+	//Per tag, so a change in the measured cost can be traced to a subsystem
+	const TCHAR* TagLabels[NumCharacterTags] = { TEXT("Character"), TEXT("Camera"), TEXT("AbilitySystem"), TEXT("Effects"), TEXT("Equipment"), TEXT("Inventory") };
+	FString Breakdown;
+	for (int32 Tag = 0; Tag < NumCharacterTags; ++Tag)
+	{
+		Breakdown += FString::Printf(TEXT("%s%s %.1fKB"), Tag > 0 ? TEXT(", ") : TEXT(""), TagLabels[Tag], (AmountsSpawned[Tag] - AmountsBefore[Tag]) / 1024.0 / NumCharacters);
+	}
+
+	AddInfo(FString::Printf(TEXT("%lldB (%.1fKB) tagged per character (%s), %.1fKB still tagged once destroyed"),
+		GrowthPerCharacter, GrowthPerCharacter / 1024.0, *Breakdown, Retained / 1024.0));
+
+	//Measured cost plus margin once recorded, the provisional estimate until then
+	int64 MaxBytesPerCharacter = ProvisionalMaxBytesPerCharacter;
+	if (MeasuredBytesPerCharacter > 0)
+		MaxBytesPerCharacter = (int64)(MeasuredBytesPerCharacter * (1.0 + MeasuredMargin));
+	else
+		AddWarning(FString::Printf(TEXT("No measured cost recorded, checking the provisional %lldB bound: record %lldB as MeasuredBytesPerCharacter if this run is representative"),
+			ProvisionalMaxBytesPerCharacter, GrowthPerCharacter));
+
+	TestTrue(FString::Printf(TEXT("%lldB per character under the %lldB bound"), GrowthPerCharacter, MaxBytesPerCharacter), GrowthPerCharacter <= MaxBytesPerCharacter);
+	TestTrue(TEXT("Tagged memory released with the characters"), Retained <= Growth * MaxRetainedRatio);
+	return true;
+}
+
+#endif
@@ -0,0 +1,132 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+
+#include "CountingMalloc.h"
+#include "ZeroAllocationScope.h"
+#include "GECSampleDamageExecition.h"
+#include "GameplayEffectCache.h"
+#include "AbilitySystemComponent.h"
+#include "GameplayEffect.h"
+#include "Misc/ScopeExit.h"
+#include "GASDemoTestWorld.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && GASDEMO_ZERO_ALLOC_CHECKS
+
+/** Collects the lines of FZeroAllocationScope::Report, added to the test's results once the checks are stopped */
+class FZeroAllocationReportLines : public FOutputDevice
+{
+public:
+	TArray<FString> Lines;
+
+	virtual void Serialize(const TCHAR* V, ELogVerbosity::Type Verbosity, const FName& Category) override
+	{
+		Lines.Add(V);
+	}
+};
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDamageZeroAllocationTest, "GASDemo.ZeroAlloc.Damage",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FDamageZeroAllocationTest::RunTest(const FString& Parameters)
+{
+	if (FZeroAllocationScope::IsRunning())
+	{
+		AddWarning(TEXT("Zero allocation checks already running, stop them with GAS.ZeroAlloc.Stop to run this test"));
+		return true;
+	}
+
+	//Installed before the world is created, and only removed again if this test installed it
+	const bool bInstalledHere = FCountingMalloc::Get() == nullptr;
+	FCountingMalloc* CountingMalloc = FCountingMalloc::Install();
+	if (!CountingMalloc)
+	{
+		AddWarning(TEXT("Allocations are only counted in commandlets, run this test with -run=GASDemoTests -Filter=GASDemo.ZeroAlloc"));
+		return true;
+	}
+	ON_SCOPE_EXIT
+	{
+		if (bInstalledHere)
+			FCountingMalloc::Uninstall();
+	};
+
+	UClass* CharacterClass = FGASDemoTestWorld::GetCharacterClass();
+	if (!TestNotNull(TEXT("Game mode pawn class (ACharacterBase)"), CharacterClass))
+		return false;
+
+	const int32 NumWarmupHits = 100;
+	const int32 NumHits = 1000;
+
+	FGASDemoTestWorld TestWorld(TEXT("DamageZeroAllocation"));
+
+	//Possessed, so PossessedBy applies their DefaultAttributeEffect and the damage has attributes to act on
+	TArray<ACharacterBase*> Characters = TestWorld.SpawnCharacters(CharacterClass, 2, true);
+	if (!TestEqual(TEXT("Spawned characters"), Characters.Num(), 2))
+		return false;
+
+	ACharacterBase* Attacker = Characters[0];
+	ACharacterBase* Target = Characters[1];
+	UAbilitySystemComponent* AttackerAbilitySystem = Attacker->GetAbilitySystemComponent();
+	UAbilitySystemComponent* TargetAbilitySystem = Target->GetAbilitySystemComponent();
+	if (!TestNotNull(TEXT("Attacker ability system"), AttackerAbilitySystem) || !TestNotNull(TEXT("Target ability system"), TargetAbilitySystem))
+		return false;
+
+	//Same effect as the CombatBenchmark commandlet's default: instant, UGECSampleDamageExecition only
+	UGameplayEffect* DamageEffect = NewObject<UGameplayEffect>(GetTransientPackage(), TEXT("GE_ZeroAllocationDamage"));
+	DamageEffect->DurationPolicy = EGameplayEffectDurationType::Instant;
+	FGameplayEffectExecutionDefinition Execution;
+	Execution.CalculationClass = UGECSampleDamageExecition::StaticClass();
+	DamageEffect->Executions.Add(Execution);
+
+	FGameplayEffectSpecCache SpecCache;
+	int32 NumRevives = 0;
+
+	auto ApplyHit = [&]()
+	{
+		const FGameplayEffectSpecHandle SpecHandle = SpecCache.FindOrMake(AttackerAbilitySystem, DamageEffect, Attacker->GetCharacterLevel(), Attacker);
+		AttackerAbilitySystem->ApplyGameplayEffectSpecToTarget(*SpecHandle.Data.Get(), TargetAbilitySystem);
+
+		//Healed back before it dies, the attribute reset goes through the checked health paths as well
+		if (Target->GetCurrentHealth() <= Target->GetMaxHealth() * 0.25f)
+		{
+			Target->ResetAttributes();
+			NumRevives++;
+		}
+	};
+
+	const float HealthBefore = Target->GetCurrentHealth();
+	ApplyHit();
+	TestTrue(TEXT("The damage effect lowers the target's health"), Target->GetCurrentHealth() < HealthBefore || NumRevives > 0);
+
+	for (int32 Hit = 1; Hit < NumWarmupHits; ++Hit)
+	{
+		ApplyHit();
+	}
+
+	//The warmup hits already warmed the hot paths up, every allocation from here on is a violation
+	const uint64 StartAllocations = CountingMalloc->GetNumAllocations();
+	FZeroAllocationScope::Start(0);
+	for (int32 Hit = 0; Hit < NumHits; ++Hit)
+	{
+		ApplyHit();
+	}
+	FZeroAllocationScope::Stop();
+	const uint64 Allocations = CountingMalloc->GetNumAllocations() - StartAllocations;
+
+	//Scopes, calls and the symbolized call stack of every allocation found
+	FZeroAllocationReportLines Report;
+	FZeroAllocationScope::Report(Report);
+	for (const FString& Line : Report.Lines)
+	{
+		AddInfo(Line);
+	}
+
+	TestEqual(FString::Printf(TEXT("Allocations in zero allocation scopes over %d hits"), NumHits), FZeroAllocationScope::GetNumViolations(), (uint64)0);
+	AddInfo(FString::Printf(TEXT("%d hits after %d warmup hits, %d revives, %llu allocations counted in the process meanwhile (every thread, in and out of the scopes)"),
+		NumHits, NumWarmupHits, NumRevives, Allocations));
+
+	TestWorld.DestroyCharacters(Characters);
+	return true;
+}
+
+#endif
@@ -0,0 +1,57 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+#include "Editor.h"
+#include "Settings/LevelEditorPlaySettings.h"
+#include "Tests/AutomationEditorCommon.h"
+
+/**
+* Client/server PIE session for the automation tests that need replication: a dedicated server and its clients run
+* in the editor process, connected over loopback. Sessions start and end over the next frames, tests wait for them
+* with latent commands.
+*/
+class FGASDemoPIESession
+{
+public:
+	/** Loads MapName in the editor and requests a session with a dedicated server and NumClients clients */
+	static void Start(const TCHAR* MapName, int32 NumClients = 1)
+	{
+		FAutomationEditorCommonUtils::LoadMap(MapName);
+
+		ULevelEditorPlaySettings* PlaySettings = NewObject<ULevelEditorPlaySettings>();
+		PlaySettings->SetPlayNetMode(EPlayNetMode::PIE_Client);
+		PlaySettings->SetPlayNumberOfClients(NumClients);
+		PlaySettings->SetRunUnderOneProcess(true);
+
+		FRequestPlaySessionParams SessionParams;
+		SessionParams.WorldType = EPlaySessionWorldType::PlayInEditor;
+		SessionParams.EditorPlaySettings = PlaySettings;
+		GEditor->RequestPlaySession(SessionParams);
+	}
+
+	/** First PIE world running as NetMode (NM_DedicatedServer or NM_Client), nullptr if there is none yet */
+	static UWorld* FindWorld(ENetMode NetMode)
+	{
+		for (const FWorldContext& Context : GEngine->GetWorldContexts())
+		{
+			UWorld* World = Context.World();
+			if (Context.WorldType == EWorldType::PIE && World && World->GetNetMode() == NetMode)
+				return World;
+		}
+		return nullptr;
+	}
+
+	/** Requests the end of the session, HasEnded is true once it is gone */
+	static void End() { GEditor->RequestEndPlayMap(); }
+
+	static bool HasEnded() { return GEditor->PlayWorld == nullptr; }
+};
+
+#endif
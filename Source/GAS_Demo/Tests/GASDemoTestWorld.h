@@ -0,0 +1,96 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CharacterBase.h"
+#include "GAS_DemoGameMode.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/WorldSettings.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+* Empty game world for the automation tests that need characters, set up like the CombatBenchmark commandlet's world
+* (no game mode, BeginPlay dispatched by the world settings). The world is destroyed with this object.
+*/
+class FGASDemoTestWorld
+{
+public:
+	explicit FGASDemoTestWorld(const TCHAR* Name)
+	{
+		World = UWorld::CreateWorld(EWorldType::Game, false, Name);
+		FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+		WorldContext.SetCurrentWorld(World);
+		World->InitializeActorsForPlay(FURL());
+		World->BeginPlay();
+		World->GetWorldSettings()->NotifyBeginPlay();
+	}
+
+	~FGASDemoTestWorld()
+	{
+		World->DestroyWorld(false);
+		GEngine->DestroyWorldContext(World);
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	UWorld* Get() const { return World; }
+
+	/** Game mode pawn class, nullptr if it isn't a ACharacterBase */
+	static UClass* GetCharacterClass()
+	{
+		UClass* CharacterClass = GetDefault<AGAS_DemoGameMode>()->DefaultPawnClass.Get();
+		return CharacterClass && CharacterClass->IsChildOf(ACharacterBase::StaticClass()) ? CharacterClass : nullptr;
+	}
+
+	/** Spawns NumCharacters on a grid (Spacing apart, 32 per row), possessed by their AI controller if bPossess */
+	TArray<ACharacterBase*> SpawnCharacters(UClass* CharacterClass, int32 NumCharacters, bool bPossess, float Spacing = 200.f)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+		TArray<ACharacterBase*> Characters;
+		for (int32 Index = 0; Index < NumCharacters; ++Index)
+		{
+			const FVector Location((Index % 32) * Spacing, (Index / 32) * Spacing, 100.f);
+			if (ACharacterBase* Character = World->SpawnActor<ACharacterBase>(CharacterClass, FTransform(Location), SpawnParams))
+			{
+				if (bPossess)
+					Character->SpawnDefaultController();
+				Characters.Add(Character);
+			}
+		}
+		return Characters;
+	}
+
+	/** Destroys Characters and their controllers, then collects garbage */
+	void DestroyCharacters(TArray<ACharacterBase*>& Characters)
+	{
+		for (ACharacterBase* Character : Characters)
+		{
+			if (AController* Controller = Character->GetController())
+				Controller->Destroy();
+			Character->Destroy();
+		}
+		Characters.Reset();
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	/** Ticks the world NumFrames times (actors, components, tickable subsystems and timers), returns the time it took in ms */
+	double Tick(int32 NumFrames, float DeltaTime)
+	{
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			World->Tick(LEVELTICK_All, DeltaTime);
+		}
+		return FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles);
+	}
+
+private:
+	UWorld* World;
+};
+
+#endif
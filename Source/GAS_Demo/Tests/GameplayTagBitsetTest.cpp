@@ -0,0 +1,168 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+
+#include "GameplayTagBitset.h"
+#include "GASGameplayAbility.h"
+#include "AbilitySystemComponent.h"
+#include "GameplayTagsManager.h"
+#include "GASDemoTestWorld.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Up to MaxTags tags of Dictionary, half of them picked among Preferred (and their parents) when it isn't empty */
+static FGameplayTagContainer PickRandomTags(FRandomStream& Random, const TArray<FGameplayTag>& Dictionary, const FGameplayTagContainer& Preferred, int32 MaxTags)
+{
+	FGameplayTagContainer Tags;
+	const int32 NumTags = Random.RandRange(0, MaxTags);
+	for (int32 Index = 0; Index < NumTags; ++Index)
+	{
+		if (Preferred.Num() > 0 && Random.RandRange(0, 1) == 0)
+		{
+			const FGameplayTag Tag = Preferred.GetByIndex(Random.RandRange(0, Preferred.Num() - 1));
+			const FGameplayTag Parent = Tag.RequestDirectParent();
+			Tags.AddTag(Parent.IsValid() && Random.RandRange(0, 1) == 0 ? Parent : Tag);
+		}
+		else
+		{
+			Tags.AddTag(Dictionary[Random.RandRange(0, Dictionary.Num() - 1)]);
+		}
+	}
+	return Tags;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameplayTagBitsetMatchesContainersTest, "GASDemo.Tags.Bitset.MatchesContainers",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FGameplayTagBitsetMatchesContainersTest::RunTest(const FString& Parameters)
+{
+	FGameplayTagContainer AllTags;
+	UGameplayTagsManager::Get().RequestAllGameplayTags(AllTags, false);
+
+	TArray<FGameplayTag> Dictionary;
+	AllTags.GetGameplayTagArray(Dictionary);
+	if (!TestTrue(TEXT("Tag dictionary isn't empty"), Dictionary.Num() > 0))
+		return false;
+
+	//Random owned tags and requirements, every result of the compiled queries must be the one of the tag containers
+	FRandomStream Random(1234);
+	const int32 NumCases = 5000;
+	int32 NumRequirementMatches = 0;
+	int32 NumMismatches = 0;
+
+	for (int32 Case = 0; Case < NumCases; ++Case)
+	{
+		const FGameplayTagContainer Owned = PickRandomTags(Random, Dictionary, FGameplayTagContainer(), 6);
+
+		FGameplayTagBitset OwnedBits;
+		OwnedBits.Initialize();
+		for (const FGameplayTag& Tag : Owned)
+		{
+			OwnedBits.AddTagWithParents(Tag);
+		}
+
+		//Activation requirements, what UGASGameplayAbility compiles
+		const FGameplayTagContainer Required = PickRandomTags(Random, Dictionary, Owned, 2);
+		const FGameplayTagContainer Blocked = PickRandomTags(Random, Dictionary, Owned, 2);
+
+		const FCompiledTagQuery Requirements = FCompiledTagQuery::FromRequirements(Required, Blocked);
+		if (!Requirements.IsValid()) continue;
+
+		const bool bContainerResult = Owned.HasAll(Required) && !Owned.HasAny(Blocked);
+		if (Requirements.Matches(OwnedBits) != bContainerResult)
+		{
+			NumMismatches++;
+			AddError(FString::Printf(TEXT("Requirements: owned %s, required %s, blocked %s: containers %d, bitset %d"),
+				*Owned.ToStringSimple(), *Required.ToStringSimple(), *Blocked.ToStringSimple(), bContainerResult, !bContainerResult));
+		}
+		NumRequirementMatches += bContainerResult ? 1 : 0;
+
+		//Tag query made of every supported expression
+		const FGameplayTagContainer AnyOf = PickRandomTags(Random, Dictionary, Owned, 3);
+		if (AnyOf.IsEmpty()) continue;
+
+		const FGameplayTagQuery Query = FGameplayTagQuery::BuildQuery(FGameplayTagQueryExpression()
+			.AllExprMatch()
+			.AddExpr(FGameplayTagQueryExpression().AllTagsMatch().AddTags(Required))
+			.AddExpr(FGameplayTagQueryExpression().AnyTagsMatch().AddTags(AnyOf))
+			.AddExpr(FGameplayTagQueryExpression().NoTagsMatch().AddTags(Blocked)));
+
+		const FCompiledTagQuery CompiledQuery = FCompiledTagQuery::FromQuery(Query);
+		if (!TestTrue(TEXT("Query of All/Any/No expressions compiles"), CompiledQuery.IsValid())) continue;
+
+		if (CompiledQuery.Matches(OwnedBits) != Query.Matches(Owned))
+		{
+			NumMismatches++;
+			AddError(FString::Printf(TEXT("Query: owned %s, all of %s, any of %s, none of %s: containers %d"),
+				*Owned.ToStringSimple(), *Required.ToStringSimple(), *AnyOf.ToStringSimple(), *Blocked.ToStringSimple(), Query.Matches(Owned)));
+		}
+	}
+
+	TestEqual(TEXT("Mismatches between the bitset and the tag containers"), NumMismatches, 0);
+	TestTrue(TEXT("Cases cover both matching and failing requirements"), NumRequirementMatches > 0 && NumRequirementMatches < NumCases);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameplayTagBitsetBenchmarkTest, "GASDemo.Tags.Bitset.Benchmark",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FGameplayTagBitsetBenchmarkTest::RunTest(const FString& Parameters)
+{
+	UClass* CharacterClass = FGASDemoTestWorld::GetCharacterClass();
+	if (!TestNotNull(TEXT("Game mode pawn class (ACharacterBase)"), CharacterClass))
+		return false;
+
+	FGASDemoTestWorld TestWorld(TEXT("TagBitsetBenchmark"));
+	TArray<ACharacterBase*> Characters = TestWorld.SpawnCharacters(CharacterClass, 1, true);
+	if (!TestEqual(TEXT("Spawned characters"), Characters.Num(), 1))
+		return false;
+
+	UAbilitySystemComponent* AbilitySystemComponent = Characters[0]->GetAbilitySystemComponent();
+	const int32 Iterations = 100000;
+
+	AddInfo(FString::Printf(TEXT("Tag dictionary: %d tags (%d words per bitset)"), FGameplayTagBitIndex::Get().GetNumTags(), FGameplayTagBitIndex::Get().GetNumWords()));
+
+	for (const FGameplayAbilitySpec& Spec : AbilitySystemComponent->GetActivatableAbilities())
+	{
+		const UGASGameplayAbility* Ability = Cast<UGASGameplayAbility>(Spec.Ability);
+		if (!Ability) continue;
+
+		//Timed as the character is, then with the ability's blocked tags owned (failing checks take the regular path)
+		for (const bool bBlocked : { false, true })
+		{
+			if (bBlocked)
+				AbilitySystemComponent->AddLooseGameplayTags(Ability->GetActivationBlockedTags());
+
+			bool bContainerResult = false;
+			uint64 StartCycles = FPlatformTime::Cycles64();
+			for (int32 Index = 0; Index < Iterations; ++Index)
+			{
+				bContainerResult = Ability->UGameplayAbility::DoesAbilitySatisfyTagRequirements(*AbilitySystemComponent);
+			}
+			const uint64 ContainerCycles = FPlatformTime::Cycles64() - StartCycles;
+
+			bool bBitsetResult = false;
+			StartCycles = FPlatformTime::Cycles64();
+			for (int32 Index = 0; Index < Iterations; ++Index)
+			{
+				bBitsetResult = Ability->DoesAbilitySatisfyTagRequirements(*AbilitySystemComponent);
+			}
+			const uint64 BitsetCycles = FPlatformTime::Cycles64() - StartCycles;
+
+			if (bBlocked)
+				AbilitySystemComponent->RemoveLooseGameplayTags(Ability->GetActivationBlockedTags());
+
+			const FString Label = FString::Printf(TEXT("%s%s"), *Ability->GetName(), bBlocked ? TEXT(" (blocked)") : TEXT(""));
+			TestEqual(Label + TEXT(": bitset and containers agree"), bBitsetResult, bContainerResult);
+
+			AddInfo(FString::Printf(TEXT("%s: containers %.1fns, bitset %.1fns (%s)"), *Label,
+				FPlatformTime::ToMilliseconds64(ContainerCycles) * 1000000.0 / Iterations, FPlatformTime::ToMilliseconds64(BitsetCycles) * 1000000.0 / Iterations,
+				Ability->GetCompiledActivationQuery().IsValid() ? TEXT("compiled") : TEXT("not compiled")));
+		}
+	}
+
+	TestWorld.DestroyCharacters(Characters);
+	return true;
+}
+
+#endif
@@ -0,0 +1,101 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+
+#include "ItemIconCache.h"
+#include "ItemBase.h"
+#include "GAS_DemoAssetManager.h"
+#include "Engine/Texture2D.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FItemIconMemoryTest, "GASDemo.Items.IconMemory",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FItemIconMemoryTest::RunTest(const FString& Parameters)
+{
+	//Inventory of 1000 rows scrolled one page at a time, a page showing as many rows as the inventory widget
+	const int32 NumRows = 1000;
+	const int32 VisibleRows = 12;
+
+	//Items themselves (no bundle), as held by an inventory
+	UGAS_DemoAssetManager& AssetManager = UGAS_DemoAssetManager::Get();
+	TArray<FPrimaryAssetId> ItemIds;
+	for (const FPrimaryAssetType& ItemType : UGAS_DemoAssetManager::GetItemTypes())
+	{
+		AssetManager.GetPrimaryAssetIdList(ItemType, ItemIds);
+	}
+
+	TSharedPtr<FStreamableHandle> ItemsHandle = AssetManager.LoadPrimaryAssets(ItemIds, {});
+	if (ItemsHandle.IsValid())
+		ItemsHandle->WaitUntilComplete();
+
+	TArray<const UItemBase*> Catalog;
+	for (const FPrimaryAssetId& ItemId : ItemIds)
+	{
+		if (const UItemBase* Item = AssetManager.GetPrimaryAssetObject<UItemBase>(ItemId))
+			Catalog.Add(Item);
+	}
+	if (!TestTrue(TEXT("Items in the catalog"), Catalog.Num() > 0))
+		return false;
+
+	//The catalog repeated up to NumRows, what a large inventory holds
+	TArray<const UItemBase*> Rows;
+	Rows.Reserve(NumRows);
+	for (int32 Row = 0; Row < NumRows; ++Row)
+	{
+		Rows.Add(Catalog[Row % Catalog.Num()]);
+	}
+
+	//Own cache with the configured budget, so the game instance's one (and its stats) is left alone
+	UItemIconCache* Cache = NewObject<UItemIconCache>(GetTransientPackage());
+
+	//Scroll one page at a time: the previous page is hidden, the next one requested
+	const FOnItemIconLoaded NoCallback;
+	TArray<int32> RowRequests;
+	RowRequests.SetNumZeroed(NumRows);
+	for (int32 PageStart = 0; PageStart < NumRows; PageStart += VisibleRows)
+	{
+		for (int32 Row = PageStart - VisibleRows; Row >= 0 && Row < PageStart; ++Row)
+		{
+			Cache->ReleaseIcon(RowRequests[Row]);
+		}
+
+		for (int32 Row = PageStart; Row < FMath::Min(PageStart + VisibleRows, NumRows); ++Row)
+		{
+			RowRequests[Row] = Cache->RequestIcon(Rows[Row], NoCallback);
+		}
+
+		FlushAsyncLoading();
+	}
+
+	for (int32 Row = FMath::Max(0, NumRows - VisibleRows); Row < NumRows; ++Row)
+	{
+		Cache->ReleaseIcon(RowRequests[Row]);
+	}
+
+	//Once every row is hidden, only the budget of unpinned icons may stay
+	const int64 CacheBytes = Cache->GetResidentBytes();
+	TestTrue(TEXT("Cached icons within the memory budget once every row is hidden"), CacheBytes <= Cache->GetMemoryBudgetBytes());
+
+	//What the hard brush used to keep resident: every icon of every held item
+	TSet<FSoftObjectPath> UniqueIcons;
+	int64 AllIconsBytes = 0;
+	for (const UItemBase* Item : Catalog)
+	{
+		bool bAlreadyCounted = false;
+		UniqueIcons.Add(Item->ItemIconTexture.ToSoftObjectPath(), &bAlreadyCounted);
+		if (UTexture2D* Texture = !bAlreadyCounted ? Item->ItemIconTexture.LoadSynchronous() : nullptr)
+			AllIconsBytes += Texture->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+	}
+
+	AddInfo(FString::Printf(TEXT("%d inventory rows (%d unique items, %d unique icons), %d visible rows"), NumRows, Catalog.Num(), UniqueIcons.Num(), VisibleRows));
+	AddInfo(FString::Printf(TEXT("Every icon resident: %.2fMB. Cache: peak %.2fMB, %.2fMB once scrolled through (budget %.0fMB), %llu evictions"),
+		AllIconsBytes / (1024.0 * 1024.0), Cache->GetPeakBytes() / (1024.0 * 1024.0), CacheBytes / (1024.0 * 1024.0),
+		Cache->GetMemoryBudgetBytes() / (1024.0 * 1024.0), Cache->GetNumEvictions()));
+
+	Cache->Deinitialize();
+	return true;
+}
+
+#endif
@@ -0,0 +1,39 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+
+#include "GAS_DemoAssetManager.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FItemInventoryMemoryTest, "GASDemo.Items.InventoryMemory",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FItemInventoryMemoryTest::RunTest(const FString& Parameters)
+{
+	UGAS_DemoAssetManager& AssetManager = UGAS_DemoAssetManager::Get();
+
+	//Full inventory listing (UI bundle only), then every bundle as the hard references used to load
+	const TArray<FName> UIBundles = { UGAS_DemoAssetManager::UIBundle };
+	const TArray<FName> AllBundles = { UGAS_DemoAssetManager::UIBundle, UGAS_DemoAssetManager::GameplayBundle, UGAS_DemoAssetManager::WorldBundle };
+	const FItemLoadReport Reports[] = { AssetManager.MeasureItemLoad(UIBundles), AssetManager.MeasureItemLoad(AllBundles) };
+	const TCHAR* ReportNames[] = { TEXT("UI bundle"), TEXT("Every bundle") };
+
+	if (!TestTrue(TEXT("Item assets scanned"), Reports[0].NumItems > 0))
+		return false;
+
+	for (int32 Index = 0; Index < 2; ++Index)
+	{
+		const FItemLoadReport& Report = Reports[Index];
+		AddInfo(FString::Printf(TEXT("%s: %d items in %.2fms, %d assets, %.2fMB resource size, %d new UObjects, %.2fMB physical delta, %d ability and %d weapon actor classes resident"),
+			ReportNames[Index], Report.NumItems, Report.LoadMs, Report.NumAssets, Report.ResourceBytes / (1024.0 * 1024.0), Report.NumNewObjects,
+			Report.PhysicalBytesDelta / (1024.0 * 1024.0), Report.NumAbilityClassesLoaded, Report.NumWeaponActorClassesLoaded));
+	}
+
+	//A hard reference loads its class with the listing whatever the bundles: fails until the ItemReferenceMigration commandlet ran
+	TestEqual(TEXT("Items saved with a hard GrantedAbility/WeaponActor"), Reports[0].NumHardReferences, 0);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,131 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+
+#include "GAS_DemoAssetManager.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Same shape as what the asset registry returns for a scanned weapon: names and string tags only, no ItemId tag if ItemId is INDEX_NONE */
+static FAssetData MakeItemAssetData(int32 Index, int32 ItemId, const FString& ItemName)
+{
+	const FString AssetName = FString::Printf(TEXT("Weapon_Test_%d"), Index);
+	FAssetDataTagMap Tags;
+	if (ItemId != INDEX_NONE)
+		Tags.Add(UGAS_DemoAssetManager::ItemIdTag, FString::FromInt(ItemId));
+	Tags.Add(UGAS_DemoAssetManager::ItemNameTag, ItemName);
+	return FAssetData(FName(*(TEXT("/Game/Test/") + AssetName)), FName(TEXT("/Game/Test")), FName(*AssetName), FName(TEXT("WeaponBase")), MoveTemp(Tags));
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FItemRegistryTest, "GASDemo.Items.Registry",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FItemRegistryTest::RunTest(const FString& Parameters)
+{
+	//Duplicate ids and names keep the first item, untagged items are set aside for the editor fallback
+	TArray<FAssetData> Assets;
+	Assets.Add(MakeItemAssetData(0, 10, TEXT("Zweihander")));
+	Assets.Add(MakeItemAssetData(1, 11, TEXT("Shinken")));
+	Assets.Add(MakeItemAssetData(2, 10, TEXT("Zweihander+4")));
+	Assets.Add(MakeItemAssetData(3, 12, TEXT("Shinken")));
+	Assets.Add(MakeItemAssetData(4, INDEX_NONE, TEXT("Untagged")));
+
+	AddExpectedError(TEXT("Item registry:"), EAutomationExpectedErrorFlags::Contains, 2);
+
+	FItemRegistry Registry;
+	Registry.AddItems(UGAS_DemoAssetManager::WeaponItemType, Assets);
+
+	TestEqual(TEXT("Indexed ItemIds"), Registry.AssetIdsByItemId.Num(), 3);
+	TestEqual(TEXT("ItemId 10 keeps the first item"), Registry.AssetIdsByItemId.FindRef(10), FPrimaryAssetId(UGAS_DemoAssetManager::WeaponItemType, TEXT("Weapon_Test_0")));
+	TestEqual(TEXT("Shinken keeps the first ItemId"), Registry.ItemIdsByName.FindRef(TEXT("Shinken")), 11);
+	TestEqual(TEXT("ItemId 12 is still found by id"), Registry.AssetIdsByItemId.FindRef(12), FPrimaryAssetId(UGAS_DemoAssetManager::WeaponItemType, TEXT("Weapon_Test_3")));
+	TestEqual(TEXT("Duplicate ItemIds"), Registry.NumDuplicateIds, 1);
+	TestEqual(TEXT("Duplicate names"), Registry.NumDuplicateNames, 1);
+	TestEqual(TEXT("Items without ItemId tag"), Registry.NumMissingIds, 1);
+	TestFalse(TEXT("Untagged item indexed by name"), Registry.ItemIdsByName.Contains(TEXT("Untagged")));
+
+	//The startup registry holds every scanned item, each one under its own ItemId
+	UGAS_DemoAssetManager& AssetManager = UGAS_DemoAssetManager::Get();
+	if (!TestTrue(TEXT("Item registry built at startup"), AssetManager.IsItemRegistryReady()))
+		return false;
+
+	int32 NumScannedItems = 0;
+	for (const FPrimaryAssetType& ItemType : UGAS_DemoAssetManager::GetItemTypes())
+	{
+		TArray<FPrimaryAssetId> ItemIds;
+		AssetManager.GetPrimaryAssetIdList(ItemType, ItemIds);
+		NumScannedItems += ItemIds.Num();
+	}
+
+	const FItemRegistry& StartupRegistry = AssetManager.GetItemRegistry();
+	TestEqual(TEXT("Scanned items indexed or reported as duplicates"), StartupRegistry.AssetIdsByItemId.Num() + StartupRegistry.NumDuplicateIds, NumScannedItems);
+	for (const TPair<int32, FPrimaryAssetId>& Item : StartupRegistry.AssetIdsByItemId)
+	{
+		TestEqual(FString::Printf(TEXT("FindItemAssetId(%d)"), Item.Key), AssetManager.FindItemAssetId(Item.Key), Item.Value);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FItemRegistryBenchmarkTest, "GASDemo.Items.RegistryBenchmark",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FItemRegistryBenchmarkTest::RunTest(const FString& Parameters)
+{
+	//Real catalog: same scan as the startup build (asset manager data, tag reads and the editor fallback for untagged items)
+	FItemRegistry ScannedRegistry;
+	const double ScanStart = FPlatformTime::Seconds();
+	UGAS_DemoAssetManager::Get().ScanItemRegistry(ScannedRegistry);
+	const double ScanTime = FPlatformTime::Seconds() - ScanStart;
+
+	AddInfo(FString::Printf(TEXT("Real scan: %d items indexed in %.3fms (%d without ItemId tag, %d duplicate ItemIds)"),
+		ScannedRegistry.AssetIdsByItemId.Num(), ScanTime * 1000.0, ScannedRegistry.NumMissingIds, ScannedRegistry.NumDuplicateIds));
+
+	//Synthetic catalog of the size the registry is meant for
+	const int32 NumItems = 50000;
+	TArray<FAssetData> Assets;
+	Assets.Reserve(NumItems);
+	for (int32 Index = 0; Index < NumItems; ++Index)
+	{
+		Assets.Add(MakeItemAssetData(Index, Index, FString::Printf(TEXT("Weapon_Test_%d"), Index)));
+	}
+
+	const double BuildStart = FPlatformTime::Seconds();
+	FItemRegistry Registry;
+	Registry.AddItems(UGAS_DemoAssetManager::WeaponItemType, Assets);
+	const double BuildTime = FPlatformTime::Seconds() - BuildStart;
+
+	if (!TestEqual(TEXT("Synthetic items indexed"), Registry.AssetIdsByItemId.Num(), NumItems))
+		return false;
+
+	//Lookups in a shuffled order so they don't walk the hash buckets in insertion order
+	TArray<int32> LookupIds;
+	LookupIds.Reserve(NumItems);
+	for (int32 Index = 0; Index < NumItems; ++Index)
+	{
+		LookupIds.Add(Index);
+	}
+	FRandomStream Random(1234);
+	for (int32 Index = NumItems - 1; Index > 0; --Index)
+	{
+		LookupIds.Swap(Index, Random.RandRange(0, Index));
+	}
+
+	const double LookupStart = FPlatformTime::Seconds();
+	int32 Found = 0;
+	for (const int32 ItemId : LookupIds)
+	{
+		Found += Registry.AssetIdsByItemId.Contains(ItemId) ? 1 : 0;
+	}
+	const double LookupTime = FPlatformTime::Seconds() - LookupStart;
+
+	TestEqual(TEXT("Synthetic items found by ItemId"), Found, NumItems);
+
+	AddInfo(FString::Printf(TEXT("Synthetic: %d items built in %.2fms (%.1fKB of tables), %d lookups in %.3fms (%.1fns each)"), NumItems,
+		BuildTime * 1000.0, (Registry.AssetIdsByItemId.GetAllocatedSize() + Registry.ItemIdsByName.GetAllocatedSize()) / 1024.0,
+		Found, LookupTime * 1000.0, LookupTime * 1000000000.0 / NumItems));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,116 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+
+#include "ItemStatTable.h"
+#include "GAS_DemoAssetManager.h"
+#include "WeaponBase.h"
+#include "UObject/UObjectArray.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FItemStatTableTest, "GASDemo.Items.StatTable",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FItemStatTableTest::RunTest(const FString& Parameters)
+{
+	UGAS_DemoAssetManager& AssetManager = UGAS_DemoAssetManager::Get();
+
+	TArray<FPrimaryAssetId> WeaponIds;
+	AssetManager.GetPrimaryAssetIdList(UGAS_DemoAssetManager::WeaponItemType, WeaponIds);
+	if (WeaponIds.Num() == 0)
+	{
+		AddWarning(TEXT("No weapon scanned, nothing to check"));
+		return true;
+	}
+
+	//The table the game uses: staged by the cook, refreshed by the editor once scanned
+	const FItemStatTable& Table = AssetManager.GetItemStatTable();
+	if (!TestTrue(TEXT("Item stat table loaded"), Table.IsLoaded()))
+		return false;
+
+	TArray<const UWeaponBase*> Weapons;
+	TMap<int32, int32> WeaponsPerItemId;
+	for (const FPrimaryAssetId& WeaponId : WeaponIds)
+	{
+		const UWeaponBase* Weapon = Cast<UWeaponBase>(AssetManager.GetPrimaryAssetPath(WeaponId).TryLoad());
+		if (!TestNotNull(FString::Printf(TEXT("%s loaded"), *WeaponId.ToString()), Weapon)) continue;
+
+		Weapons.Add(Weapon);
+		WeaponsPerItemId.FindOrAdd(Weapon->ItemId)++;
+	}
+
+	for (const UWeaponBase* Weapon : Weapons)
+	{
+		const int32 Row = Table.FindRow(Weapon->ItemId);
+		if (!TestNotEqual(FString::Printf(TEXT("%s (ItemId %d) in the table"), *Weapon->GetName(), Weapon->ItemId), Row, (int32)INDEX_NONE)) continue;
+
+		//Weapons sharing an ItemId only have the first one's stats in the table (warned about when generating)
+		if (WeaponsPerItemId[Weapon->ItemId] > 1) continue;
+
+		for (int32 Stat = 0; Stat < (int32)EItemStat::Num; ++Stat)
+		{
+			TestEqual(FString::Printf(TEXT("%s stat %d"), *Weapon->GetName(), Stat), Table.GetStat(Row, (EItemStat)Stat), FItemStatTable::GetWeaponStat(Weapon, (EItemStat)Stat));
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FItemStatTableBenchmarkTest, "GASDemo.Items.StatTableBenchmark",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FItemStatTableBenchmarkTest::RunTest(const FString& Parameters)
+{
+	UGAS_DemoAssetManager& AssetManager = UGAS_DemoAssetManager::Get();
+
+	//Table: what StartInitialLoading does
+	FItemStatTable Table;
+	const double TableStart = FPlatformTime::Seconds();
+	if (!TestTrue(FString::Printf(TEXT("Stat table loaded from %s"), *FItemStatTable::GetDefaultPath()), Table.LoadFromFile(FItemStatTable::GetDefaultPath())))
+		return false;
+	const double TableTime = FPlatformTime::Seconds() - TableStart;
+
+	float TableSum = 0.f;
+	for (const float AttackPower : Table.GetColumn(EItemStat::AttackPower))
+	{
+		TableSum += AttackPower;
+	}
+
+	//Assets: unload, then load every weapon (no bundles) and read the same stat
+	TArray<FPrimaryAssetId> WeaponIds;
+	AssetManager.GetPrimaryAssetIdList(UGAS_DemoAssetManager::WeaponItemType, WeaponIds);
+	AssetManager.UnloadPrimaryAssets(WeaponIds);
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	const int32 ObjectsBefore = GUObjectArray.GetObjectArrayNumMinusAvailable();
+	const uint64 UsedMemoryBefore = FPlatformMemory::GetStats().UsedPhysical;
+	const double AssetsStart = FPlatformTime::Seconds();
+
+	TSharedPtr<FStreamableHandle> Handle = AssetManager.LoadPrimaryAssets(WeaponIds, {});
+	if (Handle.IsValid())
+		Handle->WaitUntilComplete();
+
+	float AssetSum = 0.f;
+	SIZE_T AssetBytes = 0;
+	for (const FPrimaryAssetId& WeaponId : WeaponIds)
+	{
+		if (const UWeaponBase* Weapon = AssetManager.GetPrimaryAssetObject<UWeaponBase>(WeaponId))
+		{
+			AssetSum += Weapon->AttackPower;
+			AssetBytes += Weapon->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+		}
+	}
+	const double AssetsTime = FPlatformTime::Seconds() - AssetsStart;
+
+	TestTrue(TEXT("Same AttackPower total in the table and the assets"), FMath::IsNearlyEqual(TableSum, AssetSum));
+
+	AddInfo(FString::Printf(TEXT("Stat table: %d weapons, %.3fms to load, %.1fKB resident"), Table.GetNumItems(), TableTime * 1000.0, Table.GetAllocatedSize() / 1024.0));
+	AddInfo(FString::Printf(TEXT("Assets: %d weapons, %.3fms to load, %.1fKB estimated, %d new UObjects, %.2fMB physical memory delta"), WeaponIds.Num(),
+		AssetsTime * 1000.0, AssetBytes / 1024.0, GUObjectArray.GetObjectArrayNumMinusAvailable() - ObjectsBefore,
+		((int64)FPlatformMemory::GetStats().UsedPhysical - (int64)UsedMemoryBefore) / (1024.0 * 1024.0)));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,86 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+
+#include "MeleeTraceSubsystem.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "HAL/IConsoleManager.h"
+#include "GASDemoTestWorld.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMeleeTraceBenchmarkTest, "GASDemo.Melee.Benchmark",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FMeleeTraceBenchmarkTest::RunTest(const FString& Parameters)
+{
+	UClass* CharacterClass = FGASDemoTestWorld::GetCharacterClass();
+	if (!TestNotNull(TEXT("Game mode pawn class (ACharacterBase)"), CharacterClass))
+		return false;
+
+	IConsoleVariable* SyncTraces = IConsoleManager::Get().FindConsoleVariable(TEXT("GAS.Melee.SyncTraces"));
+	if (!TestNotNull(TEXT("GAS.Melee.SyncTraces"), SyncTraces))
+		return false;
+
+	//Attackers packed closely enough for their forearms to sweep through their neighbours
+	const int32 NumAttackers = 200;
+	const int32 NumFrames = 120;
+	const float DeltaTime = 1.f / 30.f;
+
+	FGASDemoTestWorld TestWorld(TEXT("MeleeTraceBenchmark"));
+	TArray<ACharacterBase*> Attackers = TestWorld.SpawnCharacters(CharacterClass, NumAttackers, true, 80.f);
+	if (!TestEqual(TEXT("Spawned attackers"), Attackers.Num(), NumAttackers))
+		return false;
+
+	UMeleeTraceSubsystem* MeleeTrace = TestWorld.Get()->GetSubsystem<UMeleeTraceSubsystem>();
+	if (!TestNotNull(TEXT("Melee trace subsystem"), MeleeTrace))
+		return false;
+
+	//Baseline: the same world without swings, the subsystem must not tick at all
+	TestWorld.Tick(30, DeltaTime);
+	TestFalse(TEXT("Melee trace subsystem ticks without swings"), MeleeTrace->IsTickable());
+	const double BaselineMs = TestWorld.Tick(NumFrames, DeltaTime);
+
+	const int32 PreviousSyncTraces = SyncTraces->GetInt();
+	for (const bool bSync : { false, true })
+	{
+		SyncTraces->Set(bSync ? 1 : 0, ECVF_SetByCode);
+		MeleeTrace->ResetStats();
+
+		//Unarmed blade: forearm to hand of every attacker's animated mesh, the swing the unarmed melee ability sweeps
+		int32 NumHits = 0;
+		TArray<uint32> SwingIds;
+		for (ACharacterBase* Attacker : Attackers)
+		{
+			FMeleeSwingParams SwingParams;
+			SwingParams.Mesh = Attacker->GetMesh();
+			SwingParams.StartSocket = TEXT("lowerarm_r");
+			SwingParams.EndSocket = TEXT("hand_r");
+			SwingParams.Attacker = Attacker;
+			SwingIds.Add(MeleeTrace->BeginSwing(SwingParams, FOnMeleeSwingHits::CreateLambda([&NumHits](const TArray<FHitResult>& NewHits)
+			{
+				NumHits += NewHits.Num();
+			})));
+		}
+		TestFalse(TEXT("Every swing started"), SwingIds.Contains(0));
+
+		const double SwingMs = TestWorld.Tick(NumFrames, DeltaTime);
+
+		for (const uint32 SwingId : SwingIds)
+		{
+			MeleeTrace->EndSwing(SwingId);
+		}
+		TestWorld.Tick(2, DeltaTime);
+		TestFalse(TEXT("Melee trace subsystem ticks once the swings ended"), MeleeTrace->IsTickable());
+
+		AddInfo(FString::Printf(TEXT("%s traces, %d attackers: world tick %.3fms per frame (%.3fms without swings), melee game thread %.3fms per frame, %.0f sweeps per frame, %d hits"),
+			bSync ? TEXT("Sync") : TEXT("Async"), NumAttackers, SwingMs / NumFrames, BaselineMs / NumFrames,
+			MeleeTrace->GetGameThreadMs() / NumFrames, (double)MeleeTrace->GetNumSweeps() / NumFrames, NumHits));
+	}
+	SyncTraces->Set(PreviousSyncTraces, ECVF_SetByCode);
+
+	TestWorld.DestroyCharacters(Attackers);
+	return true;
+}
+
+#endif
@@ -0,0 +1,101 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+
+#include "PeriodicEffectScheduler.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPeriodicTimingWheelDueTickTest, "GASDemo.PeriodicEffects.TimingWheel.FiresOnDueTick",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FPeriodicTimingWheelDueTickTest::RunTest(const FString& Parameters)
+{
+	FPeriodicTimingWheel Wheel;
+
+	//Ticks around every level boundary: level 0 turns (256), level 1 turns (16384) and the overflow
+	const uint64 DueTicks[] = { 1, 2, 255, 256, 257, 511, 512, 513, 16383, 16384, 16385, 16640, 32767, 32768, 32769, 50000 };
+	const int32 NumEntries = UE_ARRAY_COUNT(DueTicks);
+
+	for (int32 Index = 0; Index < NumEntries; ++Index)
+	{
+		Wheel.Insert({ Index, 0, DueTicks[Index] });
+	}
+
+	TArray<int64> FiredTicks;
+	FiredTicks.Init(-1, NumEntries);
+
+	TArray<FPeriodicTimingWheel::FEntry> Due;
+	while (Wheel.GetCurrentTick() < 60000)
+	{
+		Due.Reset();
+		Wheel.Advance(Due);
+
+		for (const FPeriodicTimingWheel::FEntry& Entry : Due)
+		{
+			FiredTicks[Entry.Id] = (int64)Wheel.GetCurrentTick();
+		}
+	}
+
+	for (int32 Index = 0; Index < NumEntries; ++Index)
+	{
+		TestEqual(FString::Printf(TEXT("Entry due on tick %llu"), DueTicks[Index]), FiredTicks[Index], (int64)DueTicks[Index]);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPeriodicTimingWheelPeriodTest, "GASDemo.PeriodicEffects.TimingWheel.PeriodsDontDrift",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FPeriodicTimingWheelPeriodTest::RunTest(const FString& Parameters)
+{
+	FPeriodicTimingWheel Wheel;
+
+	//Started off a level boundary, rescheduled from their due tick the same way UPeriodicEffectScheduler does
+	const uint64 StartTick = 100;
+	const uint64 EndTick = 100000;
+	const uint64 Periods[] = { 1, 7, 255, 256, 300, 16384, 20000 };
+	const int32 NumEntries = UE_ARRAY_COUNT(Periods);
+
+	TArray<FPeriodicTimingWheel::FEntry> Due;
+	while (Wheel.GetCurrentTick() < StartTick)
+	{
+		Wheel.Advance(Due);
+	}
+
+	for (int32 Index = 0; Index < NumEntries; ++Index)
+	{
+		Wheel.Insert({ Index, 0, StartTick + Periods[Index] });
+	}
+
+	TArray<int64> NumFired;
+	NumFired.Init(0, NumEntries);
+	int32 NumLate = 0;
+
+	while (Wheel.GetCurrentTick() < EndTick)
+	{
+		Due.Reset();
+		Wheel.Advance(Due);
+
+		for (const FPeriodicTimingWheel::FEntry& Entry : Due)
+		{
+			if (Entry.DueTick != Wheel.GetCurrentTick())
+				NumLate++;
+
+			NumFired[Entry.Id]++;
+			Wheel.Insert({ Entry.Id, 0, Entry.DueTick + Periods[Entry.Id] });
+		}
+	}
+
+	TestEqual(TEXT("Entries fired off their due tick"), NumLate, 0);
+
+	for (int32 Index = 0; Index < NumEntries; ++Index)
+	{
+		TestEqual(FString::Printf(TEXT("Ticks of period %llu"), Periods[Index]), NumFired[Index], (int64)((EndTick - StartTick) / Periods[Index]));
+	}
+
+	return true;
+}
+
+#endif
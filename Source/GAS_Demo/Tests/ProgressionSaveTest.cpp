@@ -0,0 +1,282 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+
+#include "ProgressionSaveSubsystem.h"
+#include "WeaponBase.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Snapshot with every section filled, values differ from FProgressionSnapshot's defaults */
+static FProgressionSnapshot MakeTestSnapshot()
+{
+	FProgressionSnapshot Snapshot;
+	Snapshot.CharacterLevel = 7;
+
+	const int32 NumAttributes = FProgressionSaveFormat::GetSavedAttributes().Num();
+	for (int32 Index = 0; Index < NumAttributes; ++Index)
+	{
+		Snapshot.AttributeBaseValues.Add(10.5f * (Index + 1));
+	}
+
+	Snapshot.SlottedWeaponIds = { INDEX_NONE, 3, 200000 };
+	Snapshot.SlottedConsumableIds = { 12, INDEX_NONE };
+	Snapshot.EquippedWeaponIndex = 2;
+	Snapshot.EquippedConsumableIndex = 1;
+
+	for (int32 Index = 0; Index < 500; ++Index)
+	{
+		Snapshot.Inventory.Add({ Index * 3, 1 + Index % 99 });
+	}
+
+	Snapshot.JournalId = FGuid::NewGuid();
+	return Snapshot;
+}
+
+static void TestSnapshotsEqual(FAutomationTestBase& Test, const FString& What, const FProgressionSnapshot& Expected, const FProgressionSnapshot& Actual)
+{
+	Test.TestEqual(What + TEXT(": CharacterLevel"), Actual.CharacterLevel, Expected.CharacterLevel);
+	Test.TestTrue(What + TEXT(": AttributeBaseValues"), Actual.AttributeBaseValues == Expected.AttributeBaseValues);
+	Test.TestTrue(What + TEXT(": SlottedWeaponIds"), Actual.SlottedWeaponIds == Expected.SlottedWeaponIds);
+	Test.TestTrue(What + TEXT(": SlottedConsumableIds"), Actual.SlottedConsumableIds == Expected.SlottedConsumableIds);
+	Test.TestEqual(What + TEXT(": EquippedWeaponIndex"), Actual.EquippedWeaponIndex, Expected.EquippedWeaponIndex);
+	Test.TestEqual(What + TEXT(": EquippedConsumableIndex"), Actual.EquippedConsumableIndex, Expected.EquippedConsumableIndex);
+	Test.TestTrue(What + TEXT(": Inventory"), Actual.Inventory == Expected.Inventory);
+	Test.TestTrue(What + TEXT(": JournalId"), Actual.JournalId == Expected.JournalId);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProgressionSaveRoundTripTest, "GASDemo.Progression.Save.RoundTrip",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FProgressionSaveRoundTripTest::RunTest(const FString& Parameters)
+{
+	const FProgressionSnapshot Saved = MakeTestSnapshot();
+
+	TArray<uint8> Data;
+	FProgressionSaveFormat::Serialize(Saved, Data);
+
+	FProgressionSnapshot Loaded;
+	TestTrue(TEXT("Deserialize"), FProgressionSaveFormat::Deserialize(Data, Loaded));
+	TestSnapshotsEqual(*this, TEXT("In memory"), Saved, Loaded);
+
+	//Any flipped byte must be caught by the header checks or the payload CRC
+	TArray<uint8> Corrupted = Data;
+	Corrupted.Last() ^= 0xFF;
+	FProgressionSnapshot Ignored;
+	TestFalse(TEXT("Deserialize a corrupted file"), FProgressionSaveFormat::Deserialize(Corrupted, Ignored));
+	TestFalse(TEXT("Deserialize a truncated file"), FProgressionSaveFormat::Deserialize(TArray<uint8>(Data.GetData(), Data.Num() - 1), Ignored));
+
+	const FString SlotName = TEXT("AutomationTest_ProgressionSave");
+	const FString SlotPath = FProgressionSaveFormat::GetSlotPath(SlotName);
+	const FString JournalPath = FProgressionJournal::GetJournalPath(SlotName);
+
+	int32 FileSize = 0;
+	TestTrue(TEXT("WriteSlot"), FProgressionSaveFormat::WriteSlot(SlotName, Saved, FileSize));
+
+	TArray<uint8> FileData;
+	FProgressionSnapshot FromFile;
+	TestTrue(TEXT("Read the slot file"), FFileHelper::LoadFileToArray(FileData, *SlotPath, FILEREAD_Silent));
+	TestEqual(TEXT("Slot file size"), FileData.Num(), FileSize);
+	TestTrue(TEXT("Deserialize the slot file"), FProgressionSaveFormat::Deserialize(FileData, FromFile));
+	TestSnapshotsEqual(*this, TEXT("From file"), Saved, FromFile);
+
+	//Two autosave records on top of the snapshot: a level up with an inventory change, then an item removed
+	FProgressionSnapshot Expected = Saved;
+
+	FProgressionSnapshot FirstChanges;
+	FirstChanges.CharacterLevel = 8;
+	FirstChanges.Inventory = { { 3, 42 }, { 100000, 5 } };
+	Expected.CharacterLevel = 8;
+	Expected.Inventory[1].Count = 42;
+	Expected.Inventory.Add({ 100000, 5 });
+
+	FProgressionSnapshot SecondChanges;
+	SecondChanges.Inventory = { { 0, 0 } };
+	Expected.Inventory.RemoveAt(0);
+
+	TArray<uint8> Record;
+	FProgressionJournal::SerializeRecord(EProgressionDirty::Level | EProgressionDirty::Inventory, FirstChanges, Record);
+	TestTrue(TEXT("Start the journal"), FProgressionJournal::AppendRecord(SlotName, Saved.JournalId, true, Record));
+	FProgressionJournal::SerializeRecord(EProgressionDirty::Inventory, SecondChanges, Record);
+	TestTrue(TEXT("Append to the journal"), FProgressionJournal::AppendRecord(SlotName, Saved.JournalId, false, Record));
+
+	TArray<uint8> JournalData;
+	TestTrue(TEXT("Read the journal file"), FFileHelper::LoadFileToArray(JournalData, *JournalPath, FILEREAD_Silent));
+
+	//Same steps as UProgressionSaveSubsystem::LoadProgression
+	FProgressionSnapshot Replayed = FromFile;
+	TestEqual(TEXT("Replayed records"), FProgressionJournal::Replay(JournalData, Replayed), 2);
+	TestSnapshotsEqual(*this, TEXT("Journal replayed"), Expected, Replayed);
+
+	//A record cut short by a crash is dropped, the records before it still apply
+	Replayed = FromFile;
+	TestEqual(TEXT("Replayed records of a truncated journal"), FProgressionJournal::Replay(TArray<uint8>(JournalData.GetData(), JournalData.Num() - 1), Replayed), 1);
+
+	//A journal started from another snapshot doesn't apply
+	Replayed = FromFile;
+	Replayed.JournalId = FGuid::NewGuid();
+	TestEqual(TEXT("Replayed records of another journal"), FProgressionJournal::Replay(JournalData, Replayed), 0);
+
+	IFileManager::Get().Delete(*SlotPath, false, false, true);
+	IFileManager::Get().Delete(*JournalPath, false, false, true);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProgressionSaveDuplicateItemsTest, "GASDemo.Progression.Save.DuplicateItemIds",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FProgressionSaveDuplicateItemsTest::RunTest(const FString& Parameters)
+{
+	TArray<FProgressionSnapshot::FInventoryEntry> Entries = { { 1, 2 }, { 5, 1 }, { 1, 3 }, { 7, 4 }, { 5, 10 } };
+	FProgressionSnapshot::MergeDuplicateItems(Entries);
+
+	const TArray<FProgressionSnapshot::FInventoryEntry> Merged = { { 1, 5 }, { 5, 11 }, { 7, 4 } };
+	TestTrue(TEXT("Counts summed into the first entry of each id"), Entries == Merged);
+
+	//A snapshot saved with two entries for the same id, then a record with the new count of both items sharing it
+	FProgressionSnapshot Snapshot;
+	Snapshot.JournalId = FGuid::NewGuid();
+	Snapshot.Inventory = { { 1, 2 }, { 1, 3 } };
+
+	FProgressionSnapshot Changes;
+	Changes.Inventory = { { 1, 4 }, { 1, 6 } };
+
+	const FString SlotName = TEXT("AutomationTest_ProgressionDuplicates");
+	const FString JournalPath = FProgressionJournal::GetJournalPath(SlotName);
+
+	TArray<uint8> Record;
+	FProgressionJournal::SerializeRecord(EProgressionDirty::Inventory, Changes, Record);
+	TestTrue(TEXT("Start the journal"), FProgressionJournal::AppendRecord(SlotName, Snapshot.JournalId, true, Record));
+
+	TArray<uint8> JournalData;
+	TestTrue(TEXT("Read the journal file"), FFileHelper::LoadFileToArray(JournalData, *JournalPath, FILEREAD_Silent));
+	IFileManager::Get().Delete(*JournalPath, false, false, true);
+
+	TestEqual(TEXT("Replayed records"), FProgressionJournal::Replay(JournalData, Snapshot), 1);
+	TestEqual(TEXT("Entries left for the id"), Snapshot.Inventory.Num(), 1);
+	if (Snapshot.Inventory.Num() == 1)
+		TestEqual(TEXT("Count of the id"), Snapshot.Inventory[0].Count, 10);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProgressionSaveSlotNameTest, "GASDemo.Progression.Save.SlotNames",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FProgressionSaveSlotNameTest::RunTest(const FString& Parameters)
+{
+	TestTrue(TEXT("Plain name"), FProgressionSaveFormat::IsValidSlotName(TEXT("Default")));
+	TestTrue(TEXT("Name with digits and underscores"), FProgressionSaveFormat::IsValidSlotName(TEXT("Slot_02")));
+
+	const TCHAR* InvalidNames[] = { TEXT(""), TEXT("../Config/DefaultGame"), TEXT("..\\..\\Binaries\\Game"), TEXT("C:/Saves/Slot"), TEXT("Sub/Slot"), TEXT("Slot?"), TEXT("Slot*") };
+	for (const TCHAR* Name : InvalidNames)
+	{
+		TestFalse(FString::Printf(TEXT("Invalid name '%s'"), Name), FProgressionSaveFormat::IsValidSlotName(Name));
+	}
+
+	//Even called directly, paths stay in SaveGames
+	const FString SaveGamesDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir() / TEXT("SaveGames"));
+	const FString SlotPath = FPaths::ConvertRelativePathToFull(FProgressionSaveFormat::GetSlotPath(TEXT("../../Escape")));
+	const FString JournalPath = FPaths::ConvertRelativePathToFull(FProgressionJournal::GetJournalPath(TEXT("../../Escape")));
+	TestEqual(TEXT("Directory of a sanitized slot path"), FPaths::GetPath(SlotPath), SaveGamesDir);
+	TestEqual(TEXT("Directory of a sanitized journal path"), FPaths::GetPath(JournalPath), SaveGamesDir);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProgressionSaveBenchmarkTest, "GASDemo.Progression.Save.Benchmark",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FProgressionSaveBenchmarkTest::RunTest(const FString& Parameters)
+{
+	const int32 NumItems = 10000;
+	const int32 Iterations = 20;
+
+	//Budget of the game thread part of a save, the rest runs on a background task
+	const double MaxSnapshotMs = 1.0;
+
+	//Only ItemId is read from inventory items when saving, so transient items stand in for real ones
+	TMap<UItemBase*, int32> Inventory;
+	Inventory.Reserve(NumItems);
+	for (int32 Index = 0; Index < NumItems; ++Index)
+	{
+		UWeaponBase* Item = NewObject<UWeaponBase>(GetTransientPackage(), NAME_None, RF_Transient);
+		Item->ItemId = Index;
+		Inventory.Add(Item, 1 + Index % 99);
+	}
+
+	enum EStage { Snapshot, Serialize, Write, Read, Deserialize, NumStages };
+	const TCHAR* StageNames[NumStages] = { TEXT("Snapshot (game thread)"), TEXT("Serialize+Compress"), TEXT("Write"), TEXT("Read"), TEXT("Decompress+Deserialize") };
+	double TotalMs[NumStages] = {};
+	double MaxMs[NumStages] = {};
+
+	const FString Path = FProgressionSaveFormat::GetSlotPath(TEXT("AutomationTest_SaveBenchmark"));
+	const int32 NumAttributes = FProgressionSaveFormat::GetSavedAttributes().Num();
+	int32 FileSize = 0;
+
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		double StageStart = FPlatformTime::Seconds();
+		auto EndStage = [&](EStage Stage)
+		{
+			const double Now = FPlatformTime::Seconds();
+			const double Ms = (Now - StageStart) * 1000.0;
+			TotalMs[Stage] += Ms;
+			MaxMs[Stage] = FMath::Max(MaxMs[Stage], Ms);
+			StageStart = Now;
+		};
+
+		//Same work as CaptureSnapshot minus the attribute reads
+		FProgressionSnapshot Saved;
+		Saved.CharacterLevel = 1 + Iteration;
+		Saved.AttributeBaseValues.Init(100.f, NumAttributes);
+		Saved.SlottedWeaponIds = { INDEX_NONE, 0, 1, 2 };
+		Saved.SlottedConsumableIds = { 3, 4 };
+		UProgressionSaveSubsystem::CaptureInventory(Inventory, Saved.Inventory);
+		EndStage(Snapshot);
+
+		TArray<uint8> Data;
+		FProgressionSaveFormat::Serialize(Saved, Data);
+		EndStage(Serialize);
+
+		FFileHelper::SaveArrayToFile(Data, *Path);
+		EndStage(Write);
+
+		TArray<uint8> ReadData;
+		FFileHelper::LoadFileToArray(ReadData, *Path, FILEREAD_Silent);
+		EndStage(Read);
+
+		FProgressionSnapshot Loaded;
+		const bool bValid = FProgressionSaveFormat::Deserialize(ReadData, Loaded);
+		EndStage(Deserialize);
+
+		TestTrue(FString::Printf(TEXT("Iteration %d read back"), Iteration), bValid && Loaded.Inventory == Saved.Inventory
+			&& Loaded.AttributeBaseValues == Saved.AttributeBaseValues && Loaded.CharacterLevel == Saved.CharacterLevel);
+
+		FileSize = Data.Num();
+	}
+
+	IFileManager::Get().Delete(*Path, false, false, true);
+
+	TestTrue(FString::Printf(TEXT("Snapshot of %d items under %.1fms on average"), NumItems, MaxSnapshotMs), TotalMs[Snapshot] / Iterations < MaxSnapshotMs);
+
+	AddInfo(FString::Printf(TEXT("%d inventory items, %d iterations, file size %d bytes (%.2f bytes per item)"), NumItems, Iterations, FileSize, (double)FileSize / NumItems));
+	for (int32 Stage = 0; Stage < NumStages; ++Stage)
+	{
+		AddInfo(FString::Printf(TEXT("%s avg: %.3fms, max: %.3fms"), StageNames[Stage], TotalMs[Stage] / Iterations, MaxMs[Stage]));
+	}
+
+	//What one autosave appends to the journal instead when a single inventory entry changed
+	FProgressionSnapshot Delta;
+	Delta.Inventory.Add({ NumItems / 2, 1 });
+	TArray<uint8> Record;
+	FProgressionJournal::SerializeRecord(EProgressionDirty::Inventory, Delta, Record);
+	AddInfo(FString::Printf(TEXT("Journal record for one inventory change: %d bytes (full snapshot: %d bytes)"), Record.Num(), FileSize));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,121 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+
+#include "RegenerationSubsystem.h"
+#include "GASAttributeSet.h"
+#include "AbilitySystemComponent.h"
+#include "GameplayEffect.h"
+#include "GASDemoTestWorld.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+static constexpr float RegenBenchmarkStaminaPerSecond = 10.f;
+static constexpr float RegenBenchmarkManaPerSecond = 5.f;
+
+/** Infinite effect regenerating Stamina and Mana every DeltaTime, what every character ran before URegenerationSubsystem */
+static UGameplayEffect* CreatePerCharacterRegenEffect(float DeltaTime)
+{
+	UGameplayEffect* Effect = NewObject<UGameplayEffect>(GetTransientPackage(), TEXT("GE_RegenBenchmark"));
+	Effect->DurationPolicy = EGameplayEffectDurationType::Infinite;
+	Effect->Period = FScalableFloat(DeltaTime);
+
+	FGameplayModifierInfo StaminaModifier;
+	StaminaModifier.Attribute = UGASAttributeSet::GetStaminaAttribute();
+	StaminaModifier.ModifierOp = EGameplayModOp::Additive;
+	StaminaModifier.ModifierMagnitude = FGameplayEffectModifierMagnitude(FScalableFloat(RegenBenchmarkStaminaPerSecond * DeltaTime));
+	Effect->Modifiers.Add(StaminaModifier);
+
+	FGameplayModifierInfo ManaModifier = StaminaModifier;
+	ManaModifier.Attribute = UGASAttributeSet::GetManaAttribute();
+	ManaModifier.ModifierMagnitude = FGameplayEffectModifierMagnitude(FScalableFloat(RegenBenchmarkManaPerSecond * DeltaTime));
+	Effect->Modifiers.Add(ManaModifier);
+
+	return Effect;
+}
+
+static void DrainStaminaAndMana(const TArray<ACharacterBase*>& Characters)
+{
+	for (ACharacterBase* Character : Characters)
+	{
+		UAbilitySystemComponent* AbilitySystemComponent = Character->GetAbilitySystemComponent();
+		AbilitySystemComponent->SetNumericAttributeBase(UGASAttributeSet::GetStaminaAttribute(), 0.f);
+		AbilitySystemComponent->SetNumericAttributeBase(UGASAttributeSet::GetManaAttribute(), 0.f);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRegenerationBenchmarkTest, "GASDemo.Regeneration.Benchmark",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FRegenerationBenchmarkTest::RunTest(const FString& Parameters)
+{
+	UClass* CharacterClass = FGASDemoTestWorld::GetCharacterClass();
+	if (!TestNotNull(TEXT("Game mode pawn class (ACharacterBase)"), CharacterClass))
+		return false;
+
+	const int32 NumCharacters = 500;
+	const int32 NumFrames = 300;
+	const float DeltaTime = 1.f / 30.f;
+
+	FGASDemoTestWorld TestWorld(TEXT("RegenerationBenchmark"));
+	TArray<ACharacterBase*> Characters = TestWorld.SpawnCharacters(CharacterClass, NumCharacters, true);
+	if (!TestEqual(TEXT("Spawned characters"), Characters.Num(), NumCharacters))
+		return false;
+
+	URegenerationSubsystem* Regeneration = TestWorld.Get()->GetSubsystem<URegenerationSubsystem>();
+	if (!TestNotNull(TEXT("Regeneration subsystem"), Regeneration))
+		return false;
+
+	//Baseline: the same world without any regeneration, subtracted from both runs below
+	for (ACharacterBase* Character : Characters)
+	{
+		Regeneration->UnregisterRegeneration(Character->GetAbilitySystemComponent());
+	}
+	TestWorld.Tick(30, DeltaTime);
+	const double BaselineMs = TestWorld.Tick(NumFrames, DeltaTime);
+
+	//Batched: one URegenerationSubsystem pass per frame
+	for (ACharacterBase* Character : Characters)
+	{
+		Regeneration->RegisterRegeneration(Character->GetAbilitySystemComponent(), RegenBenchmarkStaminaPerSecond, RegenBenchmarkManaPerSecond);
+	}
+	DrainStaminaAndMana(Characters);
+	const double BatchedMs = TestWorld.Tick(NumFrames, DeltaTime);
+	const float BatchedStamina = Characters[0]->GetAbilitySystemComponent()->GetNumericAttribute(UGASAttributeSet::GetStaminaAttribute());
+
+	for (ACharacterBase* Character : Characters)
+	{
+		Regeneration->UnregisterRegeneration(Character->GetAbilitySystemComponent());
+	}
+
+	//Per effect: one periodic effect per character, its period matches the frame so both run the same number of updates
+	const UGameplayEffect* RegenEffect = CreatePerCharacterRegenEffect(DeltaTime);
+	TArray<FActiveGameplayEffectHandle> RegenHandles;
+	for (ACharacterBase* Character : Characters)
+	{
+		UAbilitySystemComponent* AbilitySystemComponent = Character->GetAbilitySystemComponent();
+		RegenHandles.Add(AbilitySystemComponent->ApplyGameplayEffectToSelf(RegenEffect, 1.f, AbilitySystemComponent->MakeEffectContext()));
+	}
+	DrainStaminaAndMana(Characters);
+	const double PerEffectMs = TestWorld.Tick(NumFrames, DeltaTime);
+	const float PerEffectStamina = Characters[0]->GetAbilitySystemComponent()->GetNumericAttribute(UGASAttributeSet::GetStaminaAttribute());
+
+	for (int32 Index = 0; Index < Characters.Num(); ++Index)
+	{
+		Characters[Index]->GetAbilitySystemComponent()->RemoveActiveGameplayEffect(RegenHandles[Index]);
+	}
+
+	TestWorld.DestroyCharacters(Characters);
+
+	TestTrue(TEXT("Batched regeneration regenerates"), BatchedStamina > 0.f);
+	TestTrue(TEXT("Per effect regeneration regenerates"), PerEffectStamina > 0.f);
+
+	const double CharacterFrames = (double)NumCharacters * NumFrames;
+	AddInfo(FString::Printf(TEXT("%d characters, %d frames: world tick without regeneration %.2fms, batched %.2fms, per effect %.2fms"),
+		NumCharacters, NumFrames, BaselineMs, BatchedMs, PerEffectMs));
+	AddInfo(FString::Printf(TEXT("Regeneration cost per character and frame: batched %.3fus, per effect %.3fus"),
+		(BatchedMs - BaselineMs) * 1000.0 / CharacterFrames, (PerEffectMs - BaselineMs) * 1000.0 / CharacterFrames));
+	return true;
+}
+
+#endif
@@ -0,0 +1,182 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+
+#include "BaseAbilitySystemComponent.h"
+#include "GASAttributeSet.h"
+#include "CharacterBase.h"
+#include "GameplayEffect.h"
+#include "Engine/NetDriver.h"
+#include "EngineUtils.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "GASDemoPIESession.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+/** Infinite effect with one modifier, applied a few times to every NPC so Full and Mixed replication have active effects to send */
+static UGameplayEffect* CreateReplicationBenchmarkEffect()
+{
+	UGameplayEffect* Effect = NewObject<UGameplayEffect>(GetTransientPackage(), TEXT("GE_ReplicationBenchmark"));
+	Effect->DurationPolicy = EGameplayEffectDurationType::Infinite;
+
+	FGameplayModifierInfo Modifier;
+	Modifier.Attribute = UGASAttributeSet::GetStaminaAttribute();
+	Modifier.ModifierOp = EGameplayModOp::Additive;
+	Modifier.ModifierMagnitude = FGameplayEffectModifierMagnitude(FScalableFloat(0.f));
+	Effect->Modifiers.Add(Modifier);
+
+	return Effect;
+}
+
+/** Server bandwidth with the NPCs of one mode */
+struct FReplicationBandwidthRun
+{
+	int32 NumNPCs = 0;
+	int32 NumNPCsInMode = 0;
+	double BytesPerSecond = 0.0;
+	double PacketsPerSecond = 0.0;
+};
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FReplicationBandwidthTest, "GASDemo.Replication.Bandwidth",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FReplicationBandwidthTest::RunTest(const FString& Parameters)
+{
+	IConsoleVariable* AIMode = IConsoleManager::Get().FindConsoleVariable(TEXT("GAS.Replication.AIMode"));
+	if (!TestNotNull(TEXT("GAS.Replication.AIMode"), AIMode))
+		return false;
+
+	FGASDemoPIESession::Start(TEXT("/Game/Maps/ShowcaseMap"));
+
+	//Same NPCs and effects measured with AI on Full (every character, the setup before modes were picked per controller), Mixed and Minimal
+	const int32 NumNPCs = 200;
+	const int32 EffectsPerNPC = 4;
+	const double SettleSeconds = 3.0;
+	const double MeasureSeconds = 10.0;
+	const double ClientTimeout = 30.0;
+	const int32 NumModes = 3;
+
+	struct FState
+	{
+		UWorld* ServerWorld = nullptr;
+		UGameplayEffect* Effect = nullptr;
+		int32 PreviousAIMode = 0;
+		int32 Mode = 0;
+		int32 Phase = 0;
+		double PhaseStartTime = 0.0;
+		uint64 StartBytes = 0;
+		uint64 StartPackets = 0;
+		FReplicationBandwidthRun Runs[NumModes];
+	};
+	TSharedRef<FState> State = MakeShared<FState>();
+	State->PreviousAIMode = AIMode->GetInt();
+	State->PhaseStartTime = FPlatformTime::Seconds();
+
+	const int32 ModeValues[] = { 2, 1, 0 };
+	const EGameplayEffectReplicationMode ExpectedModes[] = { EGameplayEffectReplicationMode::Full, EGameplayEffectReplicationMode::Mixed, EGameplayEffectReplicationMode::Minimal };
+	const TCHAR* ModeNames[] = { TEXT("Full"), TEXT("Mixed"), TEXT("Minimal") };
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, State, AIMode, ModeValues, ExpectedModes, NumNPCs, EffectsPerNPC, SettleSeconds, MeasureSeconds, ClientTimeout, NumModes]()
+	{
+		FState& S = *State;
+		const double Now = FPlatformTime::Seconds();
+
+		//Waits for the server and the client's pawn on it, SpawnReplicationTestNPCs places the NPCs around it
+		if (!S.ServerWorld)
+		{
+			UWorld* ServerWorld = FGASDemoPIESession::FindWorld(NM_DedicatedServer);
+			APlayerController* PlayerController = ServerWorld ? ServerWorld->GetFirstPlayerController() : nullptr;
+			UNetDriver* NetDriver = ServerWorld ? ServerWorld->GetNetDriver() : nullptr;
+			if (PlayerController && PlayerController->GetPawn() && NetDriver && NetDriver->ClientConnections.Num() > 0)
+			{
+				S.ServerWorld = ServerWorld;
+				S.Effect = CreateReplicationBenchmarkEffect();
+				S.Effect->AddToRoot();
+				S.PhaseStartTime = Now;
+				return false;
+			}
+
+			if (Now - S.PhaseStartTime > ClientTimeout)
+			{
+				AddError(TEXT("No server world with a connected client in the PIE session"));
+				return true;
+			}
+			return false;
+		}
+
+		FReplicationBandwidthRun& Run = S.Runs[S.Mode];
+		const UNetDriver* NetDriver = S.ServerWorld->GetNetDriver();
+		if (S.Phase == 0)
+		{
+			//The mode is picked on possession, so it is set before spawning
+			AIMode->Set(ModeValues[S.Mode], ECVF_SetByCode);
+			UBaseAbilitySystemComponent::SpawnReplicationTestNPCs(S.ServerWorld, NumNPCs, nullptr, *GLog);
+
+			for (TActorIterator<ACharacterBase> It(S.ServerWorld); It; ++It)
+			{
+				UBaseAbilitySystemComponent* AbilitySystemComponent = Cast<UBaseAbilitySystemComponent>(It->GetAbilitySystemComponent());
+				if (!AbilitySystemComponent || Cast<APlayerController>(It->GetController())) continue;
+
+				Run.NumNPCs++;
+				Run.NumNPCsInMode += AbilitySystemComponent->GetEffectReplicationMode() == ExpectedModes[S.Mode] ? 1 : 0;
+				for (int32 Index = 0; Index < EffectsPerNPC; ++Index)
+				{
+					AbilitySystemComponent->ApplyGameplayEffectToSelf(S.Effect, 1.f, AbilitySystemComponent->MakeEffectContext());
+				}
+			}
+			S.Phase++;
+			S.PhaseStartTime = Now;
+		}
+		else if (S.Phase == 1 && Now - S.PhaseStartTime >= SettleSeconds)
+		{
+			//The NPCs' initial replication is done, what remains is their steady traffic
+			S.StartBytes = NetDriver->OutTotalBytes;
+			S.StartPackets = NetDriver->OutTotalPackets;
+			S.Phase++;
+			S.PhaseStartTime = Now;
+		}
+		else if (S.Phase == 2 && Now - S.PhaseStartTime >= MeasureSeconds)
+		{
+			const double Elapsed = Now - S.PhaseStartTime;
+			Run.BytesPerSecond = ((uint64)NetDriver->OutTotalBytes - S.StartBytes) / Elapsed;
+			Run.PacketsPerSecond = ((uint64)NetDriver->OutTotalPackets - S.StartPackets) / Elapsed;
+
+			UBaseAbilitySystemComponent::DestroyReplicationTestNPCs(*GLog);
+			S.Phase++;
+			S.PhaseStartTime = Now;
+		}
+		else if (S.Phase == 3 && Now - S.PhaseStartTime >= SettleSeconds)
+		{
+			S.Mode++;
+			S.Phase = 0;
+			return S.Mode == NumModes;
+		}
+		return false;
+	}));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, State, AIMode, ModeNames, NumNPCs, NumModes]()
+	{
+		FState& S = *State;
+		AIMode->Set(S.PreviousAIMode, ECVF_SetByCode);
+		if (S.Effect)
+			S.Effect->RemoveFromRoot();
+		FGASDemoPIESession::End();
+
+		for (int32 Mode = 0; Mode < NumModes && S.ServerWorld; ++Mode)
+		{
+			const FReplicationBandwidthRun& Run = S.Runs[Mode];
+			TestEqual(FString::Printf(TEXT("AI %s: NPCs spawned"), ModeNames[Mode]), Run.NumNPCs, NumNPCs);
+			TestEqual(FString::Printf(TEXT("AI %s: NPCs using the mode"), ModeNames[Mode]), Run.NumNPCsInMode, Run.NumNPCs);
+
+			AddInfo(FString::Printf(TEXT("AI %s: server out %.0f bytes/s, %.1f packets/s with %d NPCs"), ModeNames[Mode], Run.BytesPerSecond, Run.PacketsPerSecond, Run.NumNPCs));
+		}
+		return true;
+	}));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([]() { return FGASDemoPIESession::HasEnded(); }));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,118 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+
+#include "CharacterSpatialGridSubsystem.h"
+#include "GASDemoTestWorld.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Characters spawned at random over a Spread x Spread square centered on the origin, not possessed (queries don't need it) */
+static TArray<ACharacterBase*> SpawnSpreadCharacters(UWorld* World, UClass* CharacterClass, int32 NumCharacters, float Spread, FRandomStream& Random)
+{
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	TArray<ACharacterBase*> Characters;
+	Characters.Reserve(NumCharacters);
+	for (int32 Index = 0; Index < NumCharacters; ++Index)
+	{
+		const FVector Location(Random.FRandRange(-Spread, Spread) * 0.5f, Random.FRandRange(-Spread, Spread) * 0.5f, 100.f);
+		if (ACharacterBase* Character = World->SpawnActor<ACharacterBase>(CharacterClass, FTransform(Location), SpawnParams))
+			Characters.Add(Character);
+	}
+	return Characters;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpatialGridBenchmarkTest, "GASDemo.Spatial.Benchmark",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FSpatialGridBenchmarkTest::RunTest(const FString& Parameters)
+{
+	UClass* CharacterClass = FGASDemoTestWorld::GetCharacterClass();
+	if (!TestNotNull(TEXT("Game mode pawn class (ACharacterBase)"), CharacterClass))
+		return false;
+
+	//Same area for both counts, so 10k characters are ten times as dense
+	const int32 CharacterCounts[] = { 1000, 10000 };
+	const int32 NumQueries = 1000;
+	const float Radius = 1000.f;
+	const float Spread = 20000.f;
+
+	for (const int32 NumCharacters : CharacterCounts)
+	{
+		FGASDemoTestWorld TestWorld(TEXT("SpatialGridBenchmark"));
+		FRandomStream Random(1234);
+
+		TArray<ACharacterBase*> Characters = SpawnSpreadCharacters(TestWorld.Get(), CharacterClass, NumCharacters, Spread, Random);
+		if (!TestEqual(TEXT("Spawned characters"), Characters.Num(), NumCharacters))
+			return false;
+
+		UCharacterSpatialGridSubsystem* Grid = TestWorld.Get()->GetSubsystem<UCharacterSpatialGridSubsystem>();
+		if (!TestNotNull(TEXT("Spatial grid subsystem"), Grid))
+			return false;
+
+		//Characters register on BeginPlay, one tick refreshes the cached locations
+		TestWorld.Tick(1, 1.f / 30.f);
+		TestEqual(TEXT("Characters registered in the grid"), Grid->GetNumCharacters(), NumCharacters);
+
+		//Same query points for both methods, at the characters' height
+		TArray<FVector> Origins;
+		Origins.Reserve(NumQueries);
+		for (int32 Query = 0; Query < NumQueries; ++Query)
+		{
+			Origins.Add(FVector(Random.FRandRange(-Spread, Spread) * 0.5f, Random.FRandRange(-Spread, Spread) * 0.5f, 100.f));
+		}
+
+		FSpatialQueryFilter Filter;
+		TArray<ACharacterBase*> Targets;
+		int64 GridResults = 0;
+
+		uint64 StartCycles = FPlatformTime::Cycles64();
+		for (const FVector& Origin : Origins)
+		{
+			Targets.Reset();
+			Grid->QueryRadius(nullptr, Origin, Radius, Filter, Targets);
+			GridResults += Targets.Num();
+		}
+		const uint64 GridCycles = FPlatformTime::Cycles64() - StartCycles;
+
+		//Physics path: pawn overlap, then the same dedup and filters a caller would need
+		UWorld* World = TestWorld.Get();
+		TArray<FOverlapResult> Overlaps;
+		int64 PhysicsResults = 0;
+		const FCollisionShape Sphere = FCollisionShape::MakeSphere(Radius);
+		const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(SpatialBenchmark), false);
+
+		StartCycles = FPlatformTime::Cycles64();
+		for (const FVector& Origin : Origins)
+		{
+			Overlaps.Reset();
+			Targets.Reset();
+			World->OverlapMultiByObjectType(Overlaps, Origin, FQuat::Identity, FCollisionObjectQueryParams(ECC_Pawn), Sphere, QueryParams);
+			for (const FOverlapResult& Overlap : Overlaps)
+			{
+				ACharacterBase* Character = Cast<ACharacterBase>(Overlap.GetActor());
+				if (Character && Character->IsAlive())
+					Targets.AddUnique(Character);
+			}
+			PhysicsResults += Targets.Num();
+		}
+		const uint64 PhysicsCycles = FPlatformTime::Cycles64() - StartCycles;
+
+		//The grid tests locations, physics the capsules: a few characters right on the edge can differ
+		TestTrue(FString::Printf(TEXT("%d characters: grid and physics find about the same targets"), NumCharacters),
+			FMath::Abs(GridResults - PhysicsResults) <= FMath::Max<int64>(10, PhysicsResults / 10));
+
+		AddInfo(FString::Printf(TEXT("%d characters, %d radius queries (r=%.0f): grid %.2fus/query (%.2f targets), physics %.2fus/query (%.2f targets)"),
+			NumCharacters, NumQueries, Radius,
+			FPlatformTime::ToMilliseconds64(GridCycles) * 1000.0 / NumQueries, (double)GridResults / NumQueries,
+			FPlatformTime::ToMilliseconds64(PhysicsCycles) * 1000.0 / NumQueries, (double)PhysicsResults / NumQueries));
+
+		TestWorld.DestroyCharacters(Characters);
+	}
+
+	return true;
+}
+
+#endif
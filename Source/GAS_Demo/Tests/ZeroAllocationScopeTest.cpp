@@ -0,0 +1,74 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+
+#include "ZeroAllocationScope.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && GASDEMO_ZERO_ALLOC_CHECKS
+
+static FZeroAllocationSite ZeroAllocationTestOuterSite(TEXT("AutomationTest.Outer"));
+static FZeroAllocationSite ZeroAllocationTestInnerSite(TEXT("AutomationTest.Inner"));
+
+/** Enters the outer test scope, with an allocation made in it, in the inner scope nested in it, or none */
+static void RunZeroAllocationTestScopes(bool bAllocateInOuter, bool bAllocateInInner)
+{
+	FZeroAllocationScope OuterScope(ZeroAllocationTestOuterSite);
+	if (bAllocateInOuter)
+		FZeroAllocationScope::OnAllocation(16);
+
+	FZeroAllocationScope InnerScope(ZeroAllocationTestInnerSite);
+	if (bAllocateInInner)
+		FZeroAllocationScope::OnAllocation(32);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FZeroAllocationScopeTest, "GASDemo.ZeroAlloc.Scopes",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FZeroAllocationScopeTest::RunTest(const FString& Parameters)
+{
+	//Allocations are simulated by calling the hook directly, the results of checks started from the console would be lost
+	if (FZeroAllocationScope::IsRunning())
+	{
+		AddWarning(TEXT("Zero allocation checks already running, stop them with GAS.ZeroAlloc.Stop to run this test"));
+		return true;
+	}
+
+	FZeroAllocationScope::Start(2);
+
+	//Warmup: the first two entries of each scope may allocate
+	RunZeroAllocationTestScopes(true, true);
+	RunZeroAllocationTestScopes(true, true);
+	TestEqual(TEXT("Violations during warmup"), FZeroAllocationScope::GetNumViolations(), (uint64)0);
+	TestEqual(TEXT("Outer scope calls"), ZeroAllocationTestOuterSite.Calls, (uint64)2);
+
+	//Warm: an allocation is counted against the innermost scope only
+	RunZeroAllocationTestScopes(false, true);
+	TestEqual(TEXT("Inner scope allocations"), ZeroAllocationTestInnerSite.Allocations, (uint64)1);
+	TestEqual(TEXT("Outer scope allocations with the inner scope allocating"), ZeroAllocationTestOuterSite.Allocations, (uint64)0);
+
+	RunZeroAllocationTestScopes(true, false);
+	TestEqual(TEXT("Outer scope allocations"), ZeroAllocationTestOuterSite.Allocations, (uint64)1);
+	TestEqual(TEXT("Inner scope allocations with the outer scope allocating"), ZeroAllocationTestInnerSite.Allocations, (uint64)1);
+	TestEqual(TEXT("Violations"), FZeroAllocationScope::GetNumViolations(), (uint64)2);
+
+	//Outside of any scope nothing is counted
+	FZeroAllocationScope::OnAllocation(64);
+	TestEqual(TEXT("Violations after an allocation outside of the scopes"), FZeroAllocationScope::GetNumViolations(), (uint64)2);
+
+	//Stopped: scopes are neither entered nor checked, results are kept
+	FZeroAllocationScope::Stop();
+	RunZeroAllocationTestScopes(true, true);
+	TestFalse(TEXT("Running after Stop"), FZeroAllocationScope::IsRunning());
+	TestEqual(TEXT("Outer scope calls after Stop"), ZeroAllocationTestOuterSite.Calls, (uint64)4);
+	TestEqual(TEXT("Violations after Stop"), FZeroAllocationScope::GetNumViolations(), (uint64)2);
+
+	//Start clears the previous results
+	FZeroAllocationScope::Start(0);
+	TestEqual(TEXT("Violations after a new Start"), FZeroAllocationScope::GetNumViolations(), (uint64)0);
+	TestEqual(TEXT("Outer scope calls after a new Start"), ZeroAllocationTestOuterSite.Calls, (uint64)0);
+	FZeroAllocationScope::Stop();
+
+	return true;
+}
+
+#endif
@@ -47,10 +47,29 @@ public:
 		CriticalRate = 0.f;
 	}
 
-	/** Weapon Actor to be spawned when equipping weapon */
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Weapon)
+	/** Weapon Actor to be spawned when equipping weapon (hard reference, loaded with the weapon): kept for existing Blueprints */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Weapon, meta = (DeprecatedProperty, DeprecationMessage = "Loads the actor with the weapon, use GetWeaponActorClass (World bundle) and clear this."))
 	TSubclassOf<AActor> WeaponActor;
 
+	/** Weapon Actor to be spawned when equipping weapon: use GetWeaponActorClass (World bundle) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Weapon, meta = (AssetBundles = "World"))
+	TSoftClassPtr<AActor> WeaponActorClass;
+
+	/** Returns the WeaponActor class, loading it synchronously (with a warning) if the World bundle wasn't loaded beforehand */
+	UFUNCTION(BlueprintPure, Category = Weapon)
+	TSubclassOf<AActor> GetWeaponActorClass() const { return LoadBundleClass(WeaponActorClass.ToSoftObjectPath(), UGAS_DemoAssetManager::WorldBundle); }
+
+	virtual bool HasDeprecatedHardReferences() const override { return Super::HasDeprecatedHardReferences() || WeaponActor != nullptr; }
+
+	virtual void PostLoad() override
+	{
+		Super::PostLoad();
+
+		//Weapons saved before WeaponActorClass existed
+		if (WeaponActorClass.IsNull() && WeaponActor)
+			WeaponActorClass = WeaponActor.Get();
+	}
+
 	//Weapon Base Damage
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Attributes)
 	FWeaponCapturedDamage Damage;
@@ -0,0 +1,208 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+
+#include "ZeroAllocationScope.h"
+
+#if GASDEMO_ZERO_ALLOC_CHECKS
+
+#include "CountingMalloc.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformStackWalk.h"
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CVarZeroAllocStart(
+	TEXT("GAS.ZeroAlloc.Start"),
+	TEXT("Starts the zero allocation checks of the gameplay hot paths, scopes don't fail during their first WarmupCalls entries. Usage: GAS.ZeroAlloc.Start [WarmupCalls=100]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		const int32 WarmupCalls = Args.Num() > 0 ? FMath::Max(0, FCString::Atoi(*Args[0])) : 100;
+
+		//Replacing GMalloc once the engine threads run isn't safe, allocations are only seen in commandlets
+		if (!FCountingMalloc::Get())
+		{
+			Ar.Log(TEXT("GAS.ZeroAlloc.Start: allocations aren't counted in this process, run the CombatBenchmark commandlet with -ZeroAlloc instead"));
+			return;
+		}
+
+		FZeroAllocationScope::Start(WarmupCalls);
+		Ar.Logf(TEXT("Zero allocation checks started (%d warmup calls per scope)"), WarmupCalls);
+	}));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CVarZeroAllocStop(
+	TEXT("GAS.ZeroAlloc.Stop"),
+	TEXT("Stops the zero allocation checks, prints their results and fails if a hot path allocated after warmup."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		FZeroAllocationScope::Stop();
+		FZeroAllocationScope::Report(Ar);
+
+		if (FZeroAllocationScope::GetNumViolations() > 0)
+			UE_LOG(LogTemp, Error, TEXT("GAS.ZeroAlloc: %llu allocations in zero allocation scopes"), FZeroAllocationScope::GetNumViolations());
+	}));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CVarZeroAllocReport(
+	TEXT("GAS.ZeroAlloc.Report"),
+	TEXT("Prints the results of the zero allocation checks without stopping them."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		FZeroAllocationScope::Report(Ar);
+	}));
+
+/** Call stack of an allocation made in a scope after warmup, captured in the allocation hook */
+struct FZeroAllocationRecord
+{
+	static constexpr int32 MaxFrames = 32;
+
+	uint64 Frames[MaxFrames];
+	uint32 NumFrames;
+	const FZeroAllocationSite* Site;
+	SIZE_T Size;
+	uint64 Count;
+};
+
+//Preallocated, the hook can't allocate: stacks past the last record are only counted
+static constexpr int32 MaxZeroAllocationRecords = 64;
+static FZeroAllocationRecord ZeroAllocationRecords[MaxZeroAllocationRecords];
+static int32 NumZeroAllocationRecords = 0;
+
+/** Set while the hook captures a stack, stack walking may allocate on some platforms */
+static bool bInAllocationHook = false;
+
+static FZeroAllocationSite* FirstZeroAllocationSite = nullptr;
+
+bool FZeroAllocationScope::bRunning = false;
+uint64 FZeroAllocationScope::WarmupCalls = 0;
+uint64 FZeroAllocationScope::NumViolations = 0;
+FZeroAllocationSite* FZeroAllocationScope::CurrentSite = nullptr;
+
+FZeroAllocationSite::FZeroAllocationSite(const TCHAR* InName)
+	: Name(InName)
+	, Next(FirstZeroAllocationSite)
+{
+	FirstZeroAllocationSite = this;
+}
+
+void FZeroAllocationScope::Enter(FZeroAllocationSite& Site)
+{
+	Site.Calls++;
+	PreviousSite = CurrentSite;
+	CurrentSite = &Site;
+}
+
+void FZeroAllocationScope::Start(int32 InWarmupCalls)
+{
+	/* Function Start
+	* Arguments: int32 InWarmupCalls - entries of each scope allowed to allocate (caches, first time initializations)
+	* Output: none (installs the allocation hook and clears the previous results)
+	*/
+
+	check(IsInGameThread());
+
+	FPlatformStackWalk::InitStackWalking();
+
+	for (FZeroAllocationSite* Site = FirstZeroAllocationSite; Site; Site = Site->Next)
+	{
+		Site->Calls = 0;
+		Site->Allocations = 0;
+	}
+
+	NumZeroAllocationRecords = 0;
+	NumViolations = 0;
+	WarmupCalls = FMath::Max(InWarmupCalls, 0);
+
+	if (FCountingMalloc* CountingMalloc = FCountingMalloc::Get())
+		CountingMalloc->SetAllocationHook(&FZeroAllocationScope::OnAllocation);
+	bRunning = true;
+}
+
+void FZeroAllocationScope::Stop()
+{
+	check(IsInGameThread());
+
+	bRunning = false;
+	if (FCountingMalloc* CountingMalloc = FCountingMalloc::Get())
+		CountingMalloc->SetAllocationHook(nullptr);
+}
+
+void FZeroAllocationScope::OnAllocation(SIZE_T Size)
+{
+	/* Function OnAllocation
+	* Arguments: SIZE_T Size - bytes requested
+	* Output: none (counts the allocation against the current scope once it is warm and captures its call stack)
+	*/
+
+	//CurrentSite is only set on the game thread, allocations of other threads are never checked
+	if (!IsInGameThread() || bInAllocationHook) return;
+
+	FZeroAllocationSite* Site = CurrentSite;
+	if (!Site || Site->Calls <= WarmupCalls) return;
+
+	bInAllocationHook = true;
+
+	Site->Allocations++;
+	NumViolations++;
+
+	uint64 Frames[FZeroAllocationRecord::MaxFrames];
+	const uint32 NumFrames = FPlatformStackWalk::CaptureStackBackTrace(Frames, FZeroAllocationRecord::MaxFrames);
+
+	bool bFound = false;
+	for (int32 Index = 0; Index < NumZeroAllocationRecords && !bFound; ++Index)
+	{
+		FZeroAllocationRecord& Record = ZeroAllocationRecords[Index];
+		if (Record.Site == Site && Record.NumFrames == NumFrames && FMemory::Memcmp(Record.Frames, Frames, NumFrames * sizeof(uint64)) == 0)
+		{
+			Record.Count++;
+			bFound = true;
+		}
+	}
+
+	if (!bFound && NumZeroAllocationRecords < MaxZeroAllocationRecords)
+	{
+		FZeroAllocationRecord& Record = ZeroAllocationRecords[NumZeroAllocationRecords++];
+		FMemory::Memcpy(Record.Frames, Frames, NumFrames * sizeof(uint64));
+		Record.NumFrames = NumFrames;
+		Record.Site = Site;
+		Record.Size = Size;
+		Record.Count = 1;
+	}
+
+	bInAllocationHook = false;
+}
+
+void FZeroAllocationScope::Report(FOutputDevice& Ar)
+{
+	/* Function Report
+	* Arguments: FOutputDevice& Ar - where the results are printed
+	* Output: none (prints the scopes, PASS/FAIL and the symbolized call stack of every allocation found)
+	*/
+
+	Ar.Logf(TEXT("GAS.ZeroAlloc: %s, %llu allocations after %llu warmup calls per scope (checks %s)"),
+		NumViolations == 0 ? TEXT("PASS") : TEXT("FAIL"), NumViolations, WarmupCalls, bRunning ? TEXT("running") : TEXT("stopped"));
+
+	for (const FZeroAllocationSite* Site = FirstZeroAllocationSite; Site; Site = Site->Next)
+	{
+		if (Site->Calls > 0)
+			Ar.Logf(TEXT("  %-50s calls: %10llu, allocations: %llu"), Site->Name, Site->Calls, Site->Allocations);
+	}
+
+	//Copied first: symbolizing allocates, and the hook may still be recording while the checks are running
+	const int32 NumRecords = NumZeroAllocationRecords;
+	TArray<FZeroAllocationRecord> Records(ZeroAllocationRecords, NumRecords);
+
+	for (const FZeroAllocationRecord& Record : Records)
+	{
+		Ar.Logf(TEXT("Allocation of %llu bytes in %s (%llu times):"), (uint64)Record.Size, Record.Site->Name, Record.Count);
+
+		for (uint32 Frame = 0; Frame < Record.NumFrames; ++Frame)
+		{
+			ANSICHAR Symbol[1024];
+			Symbol[0] = '\0';
+			FPlatformStackWalk::ProgramCounterToHumanReadableString(Frame, Record.Frames[Frame], Symbol, UE_ARRAY_COUNT(Symbol));
+			Ar.Logf(TEXT("    %s"), ANSI_TO_TCHAR(Symbol));
+		}
+	}
+
+	if (NumRecords == MaxZeroAllocationRecords)
+		Ar.Logf(TEXT("Only the first %d call stacks were captured"), MaxZeroAllocationRecords);
+}
+
+#endif
@@ -0,0 +1,101 @@
+// Copyright & Fair Use Notice: This project is for educational and informational purposes only.  (C) 2023 - Gabriel Loaeza.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/*
+* Zero allocation checks of the gameplay hot paths (damage execution, attribute changes, damage and health handling).
+*
+* Hot paths are wrapped in GASDEMO_ZERO_ALLOC_SCOPE. While the checks are running (GAS.ZeroAlloc.Start or the
+* -ZeroAlloc option of the CombatBenchmark commandlet), every heap allocation made on the game thread inside a scope
+* that already ran WarmupCalls times is a violation: it is counted against the scope and its call stack is captured
+* (identical stacks are captured once). GAS.ZeroAlloc.Stop prints the scopes and the symbolized stacks, and fails if
+* there was any violation. While the checks are stopped, a scope is a single bool check.
+*
+* Allocations are seen through FCountingMalloc, which only commandlets install (GAS.ZeroAlloc.Start doesn't start the
+* checks without it). The GASDemo.ZeroAlloc.Damage automation test runs the checks over applied damage effects, through
+* the GASDemoTests commandlet. Scopes nest, an allocation is counted against the innermost one. Checks are compiled out of
+* shipping builds.
+*
+* A scope goes first in the function it checks, so the instrumentation following it (trace scopes, counters, gameplay
+* budget) is checked as well.
+*/
+
+#define GASDEMO_ZERO_ALLOC_CHECKS !UE_BUILD_SHIPPING
+
+#if GASDEMO_ZERO_ALLOC_CHECKS
+
+/** A code path expected not to allocate, one per GASDEMO_ZERO_ALLOC_SCOPE (static, linked in the list of every site) */
+struct GAS_DEMO_API FZeroAllocationSite
+{
+	explicit FZeroAllocationSite(const TCHAR* InName);
+
+	const TCHAR* Name;
+
+	/** Scope entries since the checks were started */
+	uint64 Calls = 0;
+
+	/** Allocations after warmup since the checks were started */
+	uint64 Allocations = 0;
+
+	FZeroAllocationSite* Next = nullptr;
+};
+
+class GAS_DEMO_API FZeroAllocationScope
+{
+public:
+	explicit FZeroAllocationScope(FZeroAllocationSite& Site)
+		: bActive(bRunning && IsInGameThread())
+	{
+		if (bActive)
+			Enter(Site);
+	}
+
+	~FZeroAllocationScope()
+	{
+		if (bActive)
+			CurrentSite = PreviousSite;
+	}
+
+	/** Starts the checks, scopes don't fail during their first WarmupCalls entries (clears the previous results) */
+	static void Start(int32 WarmupCalls);
+
+	/** Stops the checks, results are kept until the next Start */
+	static void Stop();
+
+	static bool IsRunning() { return bRunning; }
+
+	/** Allocations after warmup since the checks were started, in every scope */
+	static uint64 GetNumViolations() { return NumViolations; }
+
+	/** Prints every scope entered since Start with its calls and allocations, then the allocating call stacks */
+	static void Report(FOutputDevice& Ar);
+
+	/** FCountingMalloc allocation hook (any thread, must not allocate), called directly by the automation tests */
+	static void OnAllocation(SIZE_T Size);
+
+private:
+	void Enter(FZeroAllocationSite& Site);
+
+	bool bActive;
+	FZeroAllocationSite* PreviousSite = nullptr;
+
+	static bool bRunning;
+	static uint64 WarmupCalls;
+	static uint64 NumViolations;
+
+	/** Innermost scope entered on the game thread */
+	static FZeroAllocationSite* CurrentSite;
+};
+
+/** Fails the zero allocation checks on any allocation made in the rest of the enclosing block, Name is a string literal */
+#define GASDEMO_ZERO_ALLOC_SCOPE(Name) \
+	static FZeroAllocationSite PREPROCESSOR_JOIN(ZeroAllocationSite, __LINE__)(TEXT(Name)); \
+	FZeroAllocationScope PREPROCESSOR_JOIN(ZeroAllocationScope, __LINE__)(PREPROCESSOR_JOIN(ZeroAllocationSite, __LINE__))
+
+#else
+
+#define GASDEMO_ZERO_ALLOC_SCOPE(Name)
+
+#endif